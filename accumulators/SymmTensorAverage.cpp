@@ -7,6 +7,7 @@
 
 #include "SymmTensorAverage.h"   // class header
 #include <util/space/Tensor.h>
+#include <util/space/VectorKernels.h>
 
 #include <math.h>
 
@@ -139,6 +140,18 @@ namespace Util
       }
    }
 
+   /*
+   * Add a sampled sum of outer products.
+   */
+   void SymmTensorAverage::sampleOuter(Array<Vector> const & a,
+                                       Array<Vector> const & b)
+   {
+      Tensor value;
+      value.zero();
+      VectorKernels::symmOuterAdd(a, b, value);
+      sample(value);
+   }
+
    /*
    * Access accumulator associated with one component.
    */
@@ -18,6 +18,8 @@ namespace Util
 {
 
    class Tensor;
+   class Vector;
+   template <typename Data> class Array;
 
    /**
    * Calculates averages of all components of a Tensor-valued variable.
@@ -102,6 +104,18 @@ namespace Util
       */
       void sample(const Tensor& value);
 
+      /**
+      * Add a sampled sum of outer products of two Vector arrays.
+      *
+      * Samples the symmetrized sum sum_i (a[i] b[i]^T + b[i] a[i]^T)/2,
+      * computed by VectorKernels::symmOuterAdd. With a = pair separations
+      * and b = pair forces, this is a virial stress tensor.
+      *
+      * \param a  first array of vectors
+      * \param b  second array of vectors
+      */
+      void sampleOuter(Array<Vector> const & a, Array<Vector> const & b);
+
       /**
       * Access the Average object for one tensor component.
       *
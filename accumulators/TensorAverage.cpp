@@ -7,6 +7,7 @@
 
 #include "TensorAverage.h"         // class header
 #include <util/space/Tensor.h>
+#include <util/space/VectorKernels.h>
 #include <util/format/Dbl.h>
 #include <util/format/Int.h>
 
@@ -141,6 +142,18 @@ namespace Util
       }
    }
 
+   /*
+   * Add a sampled sum of outer products.
+   */
+   void TensorAverage::sampleOuter(Array<Vector> const & a,
+                                   Array<Vector> const & b)
+   {
+      Tensor value;
+      value.zero();
+      VectorKernels::outerAdd(a, b, value);
+      sample(value);
+   }
+
    /*
    * Access accumulator associated with one component.
    */
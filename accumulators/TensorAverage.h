@@ -19,6 +19,8 @@ namespace Util
 {
 
    class Tensor;
+   class Vector;
+   template <typename Data> class Array;
 
    /**
    * Calculates averages of all components of a Tensor-valued variable.
@@ -103,6 +105,17 @@ namespace Util
       */
       void sample(const Tensor& value);
 
+      /**
+      * Add a sampled sum of outer products of two Vector arrays.
+      *
+      * Samples the sum of outer products sum_i a[i] b[i]^T, computed by
+      * VectorKernels::outerAdd.
+      *
+      * \param a  first array of vectors
+      * \param b  second array of vectors
+      */
+      void sampleOuter(Array<Vector> const & a, Array<Vector> const & b);
+
       /**
       * Access the Average object for one tensor component.
       *
@@ -62,12 +62,9 @@ namespace Util
    void serialize(BinaryFileIArchive& ar, std::string& data, 
                   const unsigned int version)
    {
-      static std::vector<char> charvec;
       size_t size;
       ar.unpack(size);
-      if (size > charvec.capacity()) {
-         charvec.reserve(size + 8);
-      }
+      std::vector<char> charvec(size + 1, '\0');
       ar.unpack(&charvec[0], size);
       data = &charvec[0];
    }
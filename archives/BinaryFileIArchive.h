@@ -15,6 +15,9 @@
 #include <util/space/IntVector.h>
 
 #include <complex>
+#ifdef UTIL_CXX11
+#include <type_traits>
+#endif
 #include <string>
 #include <vector>
 #include <iostream>
@@ -226,23 +229,40 @@ namespace Util
    */
    template <typename T>
    inline void BinaryFileIArchive::unpack(T* array, int n)
+   {  filePtr_->read( (char*)(array), n*sizeof(T)); }
+
+   /*
+   * Unpack a 2D C-array of objects of type T.
+   */
+   template <typename T>
+   inline void BinaryFileIArchive::unpack(T* array, int m, int n, int np)
    {
-      for (int i=0; i < n; ++i) {
-         filePtr_->read( (char*)(&array[i]), sizeof(T));
+      if (n == np) {
+         filePtr_->read( (char*)(array), m*n*sizeof(T));
+         return;
+      }
+      for (int i = 0; i < m; ++i) {
+         filePtr_->read( (char*)(&array[i*np]), n*sizeof(T));
       }
    }
 
+   // Bulk array serialization
+
    /*
-   * Unpack a 2D C-array of objects of type T.
+   * Load a C array from a BinaryFileIArchive, in bulk for primitive types.
    */
    template <typename T>
-   inline void BinaryFileIArchive::unpack(T* array, int m, int n, int np)
+   inline void serializeArray(BinaryFileIArchive& ar, T* array, int n, 
+                              const unsigned int version = 0)
    {
-      int i, j;
-      for (i = 0; i < m; ++i) {
-         for (j = 0; j < n; ++j) {
-            filePtr_->read( (char*)(&array[i*np + j]), sizeof(T));
-         }
+      #ifdef UTIL_CXX11
+      if (std::is_arithmetic<T>::value) {
+         ar.unpack(array, n);
+         return;
+      }
+      #endif
+      for (int i = 0; i < n; ++i) {
+         ar & array[i];
       }
    }
 
@@ -15,6 +15,9 @@
 #include <util/space/IntVector.h>
 
 #include <complex>
+#ifdef UTIL_CXX11
+#include <type_traits>
+#endif
 #include <vector>
 #include <string>
 #include <iostream>
@@ -225,23 +228,40 @@ namespace Util
    */
    template <typename T>
    inline void BinaryFileOArchive::pack(const T* array, int n)
+   {  filePtr_->write( (char*)(array), n*sizeof(T)); }
+
+   /*
+   * Bitwise pack a 2D C-array of objects of type T.
+   */
+   template <typename T>
+   inline void BinaryFileOArchive::pack(const T* array, int m, int n, int np)
    {
-      for (int i=0; i < n; ++i) {
-         filePtr_->write( (char*)(&array[i]), sizeof(T));
+      if (n == np) {
+         filePtr_->write( (char*)(array), m*n*sizeof(T));
+         return;
+      }
+      for (int i = 0; i < m; ++i) {
+         filePtr_->write( (char*)(&array[i*np]), n*sizeof(T));
       }
    }
 
+   // Bulk array serialization
+
    /*
-   * Bitwise pack a 2D C-array of objects of type T.
+   * Save a C array to a BinaryFileOArchive, in bulk for primitive types.
    */
    template <typename T>
-   inline void BinaryFileOArchive::pack(const T* array, int m, int n, int np)
+   inline void serializeArray(BinaryFileOArchive& ar, T* array, int n, 
+                              const unsigned int version = 0)
    {
-      int i, j;
-      for (i=0; i < m; ++i) {
-         for (j=0; j < n; ++j) {
-            filePtr_->write( (char*)(&array[i*np + j]), sizeof(T));
-         }
+      #ifdef UTIL_CXX11
+      if (std::is_arithmetic<T>::value) {
+         ar.pack(array, n);
+         return;
+      }
+      #endif
+      for (int i = 0; i < n; ++i) {
+         ar & array[i];
       }
    }
 
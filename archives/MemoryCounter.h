@@ -14,6 +14,9 @@
 #include <util/space/IntVector.h>
 
 #include <complex>
+#ifdef UTIL_CXX11
+#include <type_traits>
+#endif
 
 namespace Util
 {
@@ -229,6 +232,26 @@ namespace Util
    {  size_ += n*sizeof(T); }
 
 
+   // Bulk array serialization
+
+   /*
+   * Add the size of a C array to a MemoryCounter, in bulk for primitive types.
+   */
+   template <typename T>
+   inline void serializeArray(MemoryCounter& ar, T* array, int n, 
+                              const unsigned int version = 0)
+   {
+      #ifdef UTIL_CXX11
+      if (std::is_arithmetic<T>::value) {
+         ar.count(array, n);
+         return;
+      }
+      #endif
+      for (int i = 0; i < n; ++i) {
+         ar & array[i];
+      }
+   }
+
    // Explicit specializations of serialize function
 
    // Serialize functions for primitive C++ types
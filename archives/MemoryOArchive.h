@@ -15,6 +15,9 @@
 #include <util/space/IntVector.h>
 
 #include <complex>
+#ifdef UTIL_CXX11
+#include <type_traits>
+#endif
 #include <string>
 #include <vector>
 
@@ -354,6 +357,26 @@ namespace Util
       cursor_ = (Byte *)ptr;
    }
 
+   // Bulk array serialization
+
+   /*
+   * Save a C array to a MemoryOArchive, in bulk for primitive types.
+   */
+   template <typename T>
+   inline void serializeArray(MemoryOArchive& ar, T* array, int n, 
+                              const unsigned int version = 0)
+   {
+      #ifdef UTIL_CXX11
+      if (std::is_arithmetic<T>::value) {
+         ar.pack(array, n);
+         return;
+      }
+      #endif
+      for (int i = 0; i < n; ++i) {
+         ar & array[i];
+      }
+   }
+
    // Explicit serialize functions for primitive types
 
    /*
@@ -46,6 +46,29 @@ namespace Util
       }
    }
 
+   /**
+   * Serialize a C array with n elements of type T.
+   *
+   * This default implementation serializes each element in turn.
+   * Binary and memory archives provide overloads that save or load
+   * arrays of primitive types in bulk, producing the same bytes.
+   *
+   * \ingroup Serialize_Module
+   *
+   * \param ar  archive object
+   * \param array  address of first element
+   * \param n  number of elements
+   * \param version archive version id
+   */
+   template <class Archive, typename T>
+   inline void 
+   serializeArray(Archive& ar, T* array, int n, const unsigned int version = 0)
+   {  
+      for (int i = 0; i < n; ++i) {
+         ar & array[i];
+      }
+   }
+
    /**
    * Serialize an enumeration value.
    *
@@ -0,0 +1,584 @@
+#ifndef UTIL_ARRAY_BIT_SET_H
+#define UTIL_ARRAY_BIT_SET_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/Array.h>
+#include <util/containers/ArrayBitSetIterator.h>
+#include <util/misc/Memory.h>
+#include <util/misc/Bit.h>
+#include <util/global.h>
+#include <stdint.h>
+
+namespace Util
+{
+
+   /**
+   * A set of elements of an array, stored as a bitset.
+   *
+   * An ArrayBitSet represents a subset of the elements of an associated
+   * Array container or bare C array, like an ArraySet, but stores set
+   * membership as one bit per array element rather than as an array of
+   * pointers. Insertion, removal and membership queries are O(1), and
+   * iteration with an ArrayBitSetIterator always visits elements in
+   * order of increasing address, however many insertions and removals
+   * have occurred. This preserves the memory locality of the associated
+   * array during traversal of large sets with frequent changes in
+   * membership, for which the pointer order of an ArraySet becomes
+   * effectively random.
+   *
+   * An index of cumulative population counts, one per 64-bit word, is
+   * built on demand and used by index() and operator [] to give the rank
+   * of an element among the elements of the set, and the element with a
+   * given rank, in ascending address order. The index is invalidated by
+   * any change in membership and rebuilt by the next call that needs it,
+   * at a cost proportional to capacity/64.
+   *
+   * The getIds() function writes the array indices of all elements to a
+   * contiguous integer array, for use by loops that gather from several
+   * arrays, and the hasIds() function tests membership of many
+   * array indices in a single loop without branches.
+   *
+   * \ingroup Pointer_Array_Module
+   */
+   template <typename Data>
+   class ArrayBitSet
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      ArrayBitSet();
+
+      /**
+      * Destructor.
+      */
+      virtual ~ArrayBitSet();
+
+      /**
+      * Associate with a C array and allocate required memory.
+      *
+      * An ArrayBitSet may only be allocated once. This method throws an
+      * Exception if it is called more than once.
+      *
+      * \param array    associated C array of Data objects
+      * \param capacity number of elements in the array
+      */
+      void allocate(Data* array, int capacity);
+
+      /**
+      * Associate with an Array container and allocate required memory.
+      *
+      * Invokes allocate(&array[0], array.capacity()) internally.
+      *
+      * \param array associated Array<Data> container
+      */
+      void allocate(Array<Data>& array);
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Add an element to the set.
+      *
+      * Throws an Exception if data is already in this set.
+      *
+      * \param data array element to be added.
+      */
+      void append(Data& data);
+
+      /**
+      * Remove an element from the set.
+      *
+      * Throws an Exception if data is not in this set.
+      *
+      * \param data array element to be removed.
+      */
+      void remove(Data const & data);
+
+      /**
+      * Reset to empty state.
+      */
+      void clear();
+
+      //@}
+      /// \name Accessors
+      //@{
+
+      /**
+      * Set an iterator to the element with the lowest address.
+      *
+      * \param iterator ArrayBitSetIterator, initialized on output.
+      */
+      void begin(ArrayBitSetIterator<Data>& iterator) const;
+
+      /**
+      * Return the element with rank i in ascending address order.
+      *
+      * Cost is O(log(capacity/64)) once the rank index is built.
+      *
+      * \param i rank of element, 0 <= i < size()
+      */
+      Data& operator[] (int i) const;
+
+      /**
+      * Return the rank of an element within the set, if any.
+      *
+      * Returns the number of elements of the set with lower addresses,
+      * or -1 if data is an element of the associated array that is not
+      * in the set. Throws an Exception if data is not in the associated
+      * array.
+      *
+      * \param  data array element of interest.
+      * \return rank of element in ascending address order, or -1.
+      */
+      int index(Data const & data) const;
+
+      /**
+      * Is an element of the associated array in this set?
+      *
+      * \param data array element of interest.
+      */
+      bool isElement(Data const & data) const;
+
+      /**
+      * Is the array element with a specified index in this set?
+      *
+      * \param id array index of element, 0 <= id < capacity()
+      */
+      bool hasId(int id) const;
+
+      /**
+      * Test membership for a list of array indices.
+      *
+      * On output, flags[i] is true iff element ids[i] is in this set.
+      *
+      * \param ids    array indices of elements (input)
+      * \param n      number of indices
+      * \param flags  membership flags (output)
+      */
+      void hasIds(int const * ids, int n, bool* flags) const;
+
+      /**
+      * Write array indices of all elements in ascending order.
+      *
+      * The ids array must have space for at least size() elements.
+      *
+      * \param ids  array of element indices (output)
+      * \return number of elements written, equal to size()
+      */
+      int getIds(int* ids) const;
+
+      /**
+      * Return number of elements in the set.
+      */
+      int size() const;
+
+      /**
+      * Return capacity of the associated array.
+      */
+      int capacity() const;
+
+      /**
+      * Return number of 64-bit words in the bitset.
+      */
+      int nWord() const;
+
+      /**
+      * Return a 64-bit word of the bitset.
+      *
+      * Bit j of word k is set iff element 64*k + j is in the set.
+      *
+      * \param k index of word, 0 <= k < nWord()
+      */
+      uint64_t word(int k) const;
+
+      /**
+      * Return true if the ArrayBitSet is allocated, false otherwise.
+      */
+      bool isAllocated() const;
+
+      /**
+      * Return true if the ArrayBitSet is valid, or throw an exception.
+      */
+      bool isValid() const;
+
+      //@}
+
+   private:
+
+      // Associated C array of Data
+      Data* data_;
+
+      // Membership bitset, one bit per element of data_
+      uint64_t* words_;
+
+      // Number of set elements in words preceding each word (rank index)
+      mutable int* counts_;
+
+      // Number of elements in associated array
+      int capacity_;
+
+      // Number of words in words_
+      int nWord_;
+
+      // Number of elements in set
+      int size_;
+
+      // Is the counts_ rank index up to date?
+      mutable bool hasIndex_;
+
+      // Return the array index in data_ of a Data* pointer
+      int id(Data const * ptr) const;
+
+      // Rebuild the rank index, if necessary
+      void makeIndex() const;
+
+      /// Copy constructor, declared private to prohibit copying.
+      ArrayBitSet(ArrayBitSet const &);
+
+      /// Assignment, declared private to prohibit assignment.
+      ArrayBitSet& operator = (ArrayBitSet const &);
+
+   };
+
+
+   /*
+   * Default constructor.
+   */
+   template <typename Data>
+   ArrayBitSet<Data>::ArrayBitSet()
+    : data_(0),
+      words_(0),
+      counts_(0),
+      capacity_(0),
+      nWord_(0),
+      size_(0),
+      hasIndex_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   template <typename Data>
+   ArrayBitSet<Data>::~ArrayBitSet()
+   {
+      if (words_) {
+         Memory::deallocate<uint64_t>(words_, nWord_);
+      }
+      if (counts_) {
+         Memory::deallocate<int>(counts_, nWord_ + 1);
+      }
+   }
+
+   /*
+   * Create an association with a C array, and allocate required memory.
+   */
+   template <typename Data>
+   void ArrayBitSet<Data>::allocate(Data* array, int capacity)
+   {
+      // Preconditions
+      if (capacity == 0) UTIL_THROW("Zero capacity");
+      if (capacity < 0)  UTIL_THROW("Negative capacity");
+      if (array == 0) UTIL_THROW("Null array pointer");
+      if (words_) UTIL_THROW("ArrayBitSet already allocated");
+
+      data_ = array;
+      capacity_ = capacity;
+      nWord_ = (capacity + 63)/64;
+      Memory::allocate<uint64_t>(words_, nWord_);
+      Memory::allocate<int>(counts_, nWord_ + 1);
+      clear();
+   }
+
+   /*
+   * Create association with an Array, and allocate required memory.
+   */
+   template <typename Data>
+   void ArrayBitSet<Data>::allocate(Array<Data>& array)
+   {  allocate(&array[0], array.capacity()); }
+
+   /*
+   * Add an element to the set.
+   */
+   template <typename Data>
+   void ArrayBitSet<Data>::append(Data& data)
+   {
+      const Data* const ptr = &data;
+      if (ptr < data_ || ptr >= data_ + capacity_) {
+         UTIL_THROW("Pointer out of range");
+      }
+      int i = id(ptr);
+      uint64_t mask = uint64_t(1) << (i & 63);
+      if (words_[i >> 6] & mask) {
+         UTIL_THROW("Attempt to add element that is already in set");
+      }
+      words_[i >> 6] |= mask;
+      ++size_;
+      hasIndex_ = false;
+   }
+
+   /*
+   * Remove a specific element from the set.
+   */
+   template <typename Data>
+   void ArrayBitSet<Data>::remove(Data const & data)
+   {
+      const Data* const ptr = &data;
+      if (ptr < data_ || ptr >= data_ + capacity_) {
+         UTIL_THROW("Pointer out of range");
+      }
+      int i = id(ptr);
+      uint64_t mask = uint64_t(1) << (i & 63);
+      if (!(words_[i >> 6] & mask)) {
+         UTIL_THROW("Element is not in set");
+      }
+      words_[i >> 6] &= ~mask;
+      --size_;
+      hasIndex_ = false;
+   }
+
+   /*
+   * Reset to empty state.
+   */
+   template <typename Data>
+   void ArrayBitSet<Data>::clear()
+   {
+      assert(words_ != 0);
+      for (int k = 0; k < nWord_; ++k) {
+         words_[k] = 0;
+      }
+      size_ = 0;
+      hasIndex_ = false;
+   }
+
+   /*
+   * Set an iterator to the element with the lowest address.
+   */
+   template <typename Data>
+   inline
+   void ArrayBitSet<Data>::begin(ArrayBitSetIterator<Data>& iterator) const
+   {  iterator.setBegin(data_, words_, nWord_); }
+
+   /*
+   * Return element with rank i in ascending address order.
+   */
+   template <typename Data>
+   Data& ArrayBitSet<Data>::operator[] (int i) const
+   {
+      assert(i >= 0);
+      assert(i < size_);
+      makeIndex();
+
+      // Binary search for the last word k with counts_[k] <= i
+      int lo = 0;
+      int hi = nWord_;
+      while (hi - lo > 1) {
+         int mid = (lo + hi)/2;
+         if (counts_[mid] <= i) {
+            lo = mid;
+         } else {
+            hi = mid;
+         }
+      }
+
+      // Select bit within word lo
+      uint64_t bits = words_[lo];
+      for (int j = counts_[lo]; j < i; ++j) {
+         bits &= bits - 1;
+      }
+      assert(bits);
+      return data_[64*lo + lowestBit(bits)];
+   }
+
+   /*
+   * Return rank of an element, or -1 if not in set.
+   */
+   template <typename Data>
+   int ArrayBitSet<Data>::index(Data const & data) const
+   {
+      const Data* const ptr = &data;
+      if (ptr < data_ || ptr >= data_ + capacity_) {
+         UTIL_THROW("Pointer out of range");
+      }
+      int i = id(ptr);
+      int k = i >> 6;
+      uint64_t mask = uint64_t(1) << (i & 63);
+      if (!(words_[k] & mask)) {
+         return -1;
+      }
+      makeIndex();
+      return counts_[k] + bitCount(words_[k] & (mask - 1));
+   }
+
+   /*
+   * Is an element of the associated array in this set?
+   */
+   template <typename Data>
+   inline bool ArrayBitSet<Data>::isElement(Data const & data) const
+   {
+      const Data* const ptr = &data;
+      if (ptr < data_ || ptr >= data_ + capacity_) {
+         UTIL_THROW("Pointer out of range");
+      }
+      return hasId(id(ptr));
+   }
+
+   /*
+   * Is the element with a specified array index in this set?
+   */
+   template <typename Data>
+   inline bool ArrayBitSet<Data>::hasId(int id) const
+   {
+      assert(id >= 0);
+      assert(id < capacity_);
+      return (words_[id >> 6] >> (id & 63)) & 1;
+   }
+
+   /*
+   * Test membership for a list of array indices.
+   */
+   template <typename Data>
+   void
+   ArrayBitSet<Data>::hasIds(int const * ids, int n, bool* flags) const
+   {
+      uint64_t const * words = words_;
+      for (int i = 0; i < n; ++i) {
+         assert(ids[i] >= 0);
+         assert(ids[i] < capacity_);
+         flags[i] = (words[ids[i] >> 6] >> (ids[i] & 63)) & 1;
+      }
+   }
+
+   /*
+   * Write array indices of all elements, in ascending order.
+   */
+   template <typename Data>
+   int ArrayBitSet<Data>::getIds(int* ids) const
+   {
+      int n = 0;
+      for (int k = 0; k < nWord_; ++k) {
+         uint64_t bits = words_[k];
+         while (bits) {
+            ids[n] = 64*k + lowestBit(bits);
+            bits &= bits - 1;
+            ++n;
+         }
+      }
+      assert(n == size_);
+      return n;
+   }
+
+   /*
+   * Return number of elements in the set.
+   */
+   template <typename Data>
+   inline int ArrayBitSet<Data>::size() const
+   {  return size_; }
+
+   /*
+   * Return capacity of the associated array.
+   */
+   template <typename Data>
+   inline int ArrayBitSet<Data>::capacity() const
+   {  return capacity_; }
+
+   /*
+   * Return number of words in the bitset.
+   */
+   template <typename Data>
+   inline int ArrayBitSet<Data>::nWord() const
+   {  return nWord_; }
+
+   /*
+   * Return a word of the bitset.
+   */
+   template <typename Data>
+   inline uint64_t ArrayBitSet<Data>::word(int k) const
+   {
+      assert(k >= 0);
+      assert(k < nWord_);
+      return words_[k];
+   }
+
+   /*
+   * Is this allocated?
+   */
+   template <typename Data>
+   inline bool ArrayBitSet<Data>::isAllocated() const
+   {  return words_ != 0; }
+
+   /*
+   * Return true if valid, or throw an exception.
+   */
+   template <typename Data>
+   bool ArrayBitSet<Data>::isValid() const
+   {
+      if (words_ != 0) {
+         if (counts_ == 0) {
+            UTIL_THROW("words_ is allocated but counts_ is not");
+         }
+         if (nWord_ != (capacity_ + 63)/64) {
+            UTIL_THROW("Inconsistent nWord_ and capacity_");
+         }
+         int size = 0;
+         for (int k = 0; k < nWord_; ++k) {
+            if (hasIndex_ && counts_[k] != size) {
+               UTIL_THROW("Inconsistent rank index");
+            }
+            size += bitCount(words_[k]);
+         }
+         if (size != size_) {
+            UTIL_THROW("Number of set bits != size");
+         }
+         int nExtra = 64*nWord_ - capacity_;
+         if (nExtra > 0) {
+            if (words_[nWord_ - 1] >> (64 - nExtra)) {
+               UTIL_THROW("Bit set beyond capacity");
+            }
+         }
+      } else {
+         if (counts_ != 0) {
+            UTIL_THROW("words_ == 0, but counts_ != 0");
+         }
+         if (capacity_ != 0) {
+            UTIL_THROW("words_ == 0, but capacity_ != 0");
+         }
+         if (size_ != 0) {
+            UTIL_THROW("words_ == 0, but size_ != 0");
+         }
+      }
+      return true;
+   }
+
+   // Private functions
+
+   template <typename Data>
+   inline int ArrayBitSet<Data>::id(Data const * ptr) const
+   {  return int(ptr - data_); }
+
+   /*
+   * Rebuild cumulative population counts, if out of date.
+   */
+   template <typename Data>
+   void ArrayBitSet<Data>::makeIndex() const
+   {
+      if (hasIndex_) return;
+      int count = 0;
+      for (int k = 0; k < nWord_; ++k) {
+         counts_[k] = count;
+         count += bitCount(words_[k]);
+      }
+      counts_[nWord_] = count;
+      hasIndex_ = true;
+   }
+
+}
+#endif
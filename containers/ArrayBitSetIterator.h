@@ -0,0 +1,189 @@
+#ifndef UTIL_ARRAY_BIT_SET_ITERATOR_H
+#define UTIL_ARRAY_BIT_SET_ITERATOR_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/misc/Bit.h>
+#include <util/global.h>
+#include <stdint.h>
+
+namespace Util
+{
+
+   /**
+   * Forward iterator for an ArrayBitSet.
+   *
+   * An ArrayBitSetIterator visits the elements of an ArrayBitSet in
+   * order of increasing address within the associated array. It scans
+   * the membership bitset one 64-bit word at a time, skipping empty
+   * words, so that the cost of a complete traversal is proportional to
+   * the number of elements plus capacity/64.
+   *
+   * As for a PArrayIterator, the isEnd() and notEnd() methods are used
+   * to test for termination of a loop. Adding or removing elements of
+   * the set during iteration invalidates the iterator.
+   *
+   * \ingroup Pointer_Array_Module
+   * \ingroup Iterator_Module
+   */
+   template <typename Data>
+   class ArrayBitSetIterator
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      *
+      * Constructs a null iterator.
+      */
+      ArrayBitSetIterator()
+       : array_(0),
+         words_(0),
+         nWord_(0),
+         wordId_(0),
+         bits_(0),
+         data_(0)
+      {}
+
+      /**
+      * Initialize to the first element of a set.
+      *
+      * \param array  associated array of Data objects
+      * \param words  membership bitset
+      * \param nWord  number of words in bitset
+      */
+      void setBegin(Data* array, uint64_t const * words, int nWord)
+      {
+         array_  = array;
+         words_  = words;
+         nWord_  = nWord;
+         wordId_ = -1;
+         bits_   = 0;
+         advance();
+      }
+
+      /**
+      * Nullify the iterator.
+      */
+      void setNull()
+      {
+         array_  = 0;
+         words_  = 0;
+         nWord_  = 0;
+         wordId_ = 0;
+         bits_   = 0;
+         data_   = 0;
+      }
+
+      /**
+      * Is the iterator at the end of the set?
+      *
+      * \return true if at end, false otherwise.
+      */
+      bool isEnd() const
+      {  return (data_ == 0); }
+
+      /**
+      * Is the iterator not at the end of the set?
+      *
+      * \return true if not at end, false otherwise.
+      */
+      bool notEnd() const
+      {  return (data_ != 0); }
+
+      /**
+      * Return a pointer to the current data.
+      */
+      Data* get() const
+      {  return data_; }
+
+      /**
+      * Return the array index of the current element.
+      */
+      int id() const
+      {
+         assert(data_);
+         return int(data_ - array_);
+      }
+
+      /// \name Operators
+      //@{
+
+      /**
+      * Return a reference to the current Data.
+      */
+      Data& operator* () const
+      {
+         assert(data_);
+         return *data_;
+      }
+
+      /**
+      * Provide a pointer to the current Data object.
+      */
+      Data* operator -> () const
+      {
+         assert(data_);
+         return data_;
+      }
+
+      /**
+      * Increment to the element with the next higher address.
+      *
+      * \return this iterator, after modification.
+      */
+      ArrayBitSetIterator<Data>& operator++ ()
+      {
+         assert(data_);
+         advance();
+         return *this;
+      }
+
+      //@}
+
+   private:
+
+      // Associated array of Data objects.
+      Data* array_;
+
+      // Membership bitset.
+      uint64_t const * words_;
+
+      // Number of words in the bitset.
+      int nWord_;
+
+      // Index of the word containing the current element.
+      int wordId_;
+
+      // Bits of the current word not yet visited.
+      uint64_t bits_;
+
+      // Pointer to current Data object (null at end).
+      Data* data_;
+
+      // Move to the next set bit, or to the end.
+      void advance()
+      {
+         while (bits_ == 0) {
+            ++wordId_;
+            if (wordId_ >= nWord_) {
+               data_ = 0;
+               return;
+            }
+            bits_ = words_[wordId_];
+         }
+         int bit = lowestBit(bits_);
+         bits_ &= bits_ - 1;
+         data_ = array_ + 64*wordId_ + bit;
+      }
+
+   };
+
+}
+#endif
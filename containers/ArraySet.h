@@ -40,6 +40,12 @@ namespace Util
    * set, O(1) insertion and deletion, and O(1) access to a randomly 
    * chosen element.
    *
+   * After many removals, iteration over the pointers of an ArraySet
+   * visits elements of the associated array in an effectively random 
+   * order. The sort() method may be called periodically to restore 
+   * ascending address order. See also ArrayBitSet, which always 
+   * iterates in ascending address order.
+   *
    * \ingroup Pointer_Array_Module
    */
    template <typename Data>
@@ -123,6 +129,14 @@ namespace Util
       */ 
       void clear();
 
+      /**
+      * Reorder pointers in order of increasing address.
+      *
+      * Restores the memory locality of sequential access after many 
+      * calls to remove(). Cost is O(capacity) for any size.
+      */
+      void sort();
+
       //@}
 
       /// \name Accessors
@@ -327,6 +341,25 @@ namespace Util
       }
    }
 
+   /*
+   * Reorder pointers in order of increasing address.
+   */
+   template <typename Data>
+   void ArraySet<Data>::sort() 
+   { 
+      assert(ptrs_ != 0);
+      assert(tags_ != 0);
+      int setId = 0;
+      for (int i = 0; i < capacity_; ++i) {
+         if (tags_[i] >= 0) {
+            ptrs_[setId] = const_cast<Data*>(data_ + i);
+            tags_[i] = setId;
+            ++setId;
+         }
+      }
+      assert(setId == size_);
+   }
+
    /**
    * Return the current index of an element within the set, or return
    * a negative value -1 if the element is not in the set.
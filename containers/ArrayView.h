@@ -0,0 +1,153 @@
+#ifndef UTIL_ARRAY_VIEW_H
+#define UTIL_ARRAY_VIEW_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/archives/serialize.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Non-owning view of a contiguous 1D array.
+   *
+   * An ArrayView holds the address and number of elements of a block
+   * of contiguous elements owned by some other container. Any object
+   * with member functions cArray() and capacity(), such as an Array,
+   * DArray, FArray, RArray or another ArrayView, can be used to
+   * construct a view of all its elements, and slice() returns a view
+   * of a contiguous sub-range. Unlike an RArray, a view is a small
+   * value type that may be copied, returned from functions and
+   * re-pointed by assignment. Use ArrayView<const Data> for read-only
+   * access.
+   *
+   * The subscript operator checks bounds with UTIL_ASSERT, and so
+   * throws an Exception for an invalid index only if UTIL_DEBUG is
+   * defined. Otherwise, access is as cheap as access to a C array.
+   * A view does not itself claim that its elements are unaliased.
+   * Kernels that receive several views and know them to be disjoint
+   * can copy each cArray() pointer into a local variable declared
+   * with the UTIL_RESTRICT qualifier to allow vectorization.
+   *
+   * \ingroup Array_Module
+   */
+   template <typename Data>
+   class ArrayView
+   {
+
+   public:
+
+      /**
+      * Default constructor, creates a null view.
+      */
+      ArrayView()
+       : data_(0),
+         capacity_(0)
+      {}
+
+      /**
+      * Construct a view of a C array.
+      *
+      * \param data  address of first element
+      * \param capacity  number of elements
+      */
+      ArrayView(Data* data, int capacity)
+       : data_(data),
+         capacity_(capacity)
+      {  UTIL_ASSERT(capacity >= 0); }
+
+      /**
+      * Construct a view of all elements of a container.
+      *
+      * \param container  object with cArray() and capacity() members
+      */
+      template <class Container>
+      ArrayView(Container& container)
+       : data_(container.cArray()),
+         capacity_(container.capacity())
+      {}
+
+      /**
+      * Return a view of a contiguous sub-range.
+      *
+      * \param begin  index of first element of sub-range
+      * \param n  number of elements in sub-range
+      */
+      ArrayView<Data> slice(int begin, int n) const
+      {
+         UTIL_ASSERT(begin >= 0);
+         UTIL_ASSERT(n >= 0);
+         UTIL_ASSERT(begin + n <= capacity_);
+         return ArrayView<Data>(data_ + begin, n);
+      }
+
+      /**
+      * Return a reference to element i.
+      *
+      * \param i  array index
+      */
+      Data& operator [] (int i) const
+      {
+         UTIL_ASSERT(data_);
+         UTIL_ASSERT(i >= 0);
+         UTIL_ASSERT(i < capacity_);
+         return data_[i];
+      }
+
+      /**
+      * Return a pointer to the first element.
+      */
+      Data* cArray() const
+      {  return data_; }
+
+      /**
+      * Return number of elements.
+      */
+      int capacity() const
+      {  return capacity_; }
+
+      /**
+      * Is this a null view?
+      */
+      bool isNull() const
+      {  return (data_ == 0); }
+
+      /**
+      * Serialize elements to/from an archive.
+      *
+      * Saves the number of elements followed by the elements. When
+      * loading, the number of elements must equal the capacity of
+      * this view, since a view cannot be resized.
+      *
+      * \param ar       archive
+      * \param version  archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version)
+      {
+         int capacity = capacity_;
+         ar & capacity;
+         if (capacity != capacity_) {
+            UTIL_THROW("Inconsistent ArrayView capacity");
+         }
+         serializeArray(ar, data_, capacity_, version);
+      }
+
+   private:
+
+      /// Pointer to first element.
+      Data* data_;
+
+      /// Number of elements.
+      int capacity_;
+
+   };
+
+}
+#endif
@@ -0,0 +1,33 @@
+#ifndef UTIL_BACK_PRESSURE_H
+#define UTIL_BACK_PRESSURE_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+namespace Util
+{
+
+   /**
+   * Namespace for policies applied by a concurrent queue when full.
+   *
+   * \ingroup Array_Module
+   */
+   namespace BackPressure
+   {
+
+      /**
+      * Enumeration of policies for a push to a full queue.
+      *
+      * Block: wait until a consumer frees space, or the queue is closed.
+      * Reject: return immediately, without adding the element.
+      */
+      enum Type {Block, Reject};
+
+   }
+
+}
+#endif
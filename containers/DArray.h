@@ -10,6 +10,7 @@
 
 #include <util/containers/Array.h>
 #include <util/misc/Memory.h>
+#include <util/archives/serialize.h>
 #include <util/global.h>
 
 namespace Util
@@ -38,6 +39,13 @@ namespace Util
       */
       DArray();
 
+      /**
+      * Constructor with a memory policy for subsequent allocation.
+      *
+      * \param policy  memory policy, e.g. MemoryPolicy::tagged(name)
+      */
+      explicit DArray(MemoryPolicy const & policy);
+
       /**
       * Allocating constructor.
       *
@@ -54,6 +62,18 @@ namespace Util
       */
       DArray(DArray<Data> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move constructor.
+      *
+      * Takes ownership of the memory and memory policy of the other 
+      * DArray, which is left unallocated. No elements are copied.
+      *
+      * \param other  the DArray to be moved (unallocated on output)
+      */
+      DArray(DArray<Data>&& other);
+      #endif
+
       /**
       * Destructor.
       *
@@ -76,6 +96,20 @@ namespace Util
       */
       DArray<Data>& operator = (DArray<Data> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move assignment.
+      *
+      * Deallocates this DArray, if allocated, and then takes ownership
+      * of the memory and memory policy of the other DArray, which is 
+      * left unallocated. Unlike copy assignment, capacities need not be
+      * equal, and the other DArray need not be allocated.
+      *
+      * \param other  the other (RHS) DArray (unallocated on output)
+      */
+      DArray<Data>& operator = (DArray<Data>&& other);
+      #endif
+
       /**
       * Assignment from an Array<Data> container.
       *
@@ -101,6 +135,32 @@ namespace Util
       */
       void allocate(int capacity);
 
+      /**
+      * Allocate the underlying C array with a specified memory policy.
+      *
+      * Sets the memory policy and then allocates, as allocate(capacity).
+      *
+      * \throw Exception if the DArray is already allocated
+      *
+      * \param capacity  number of elements to allocate
+      * \param policy  alignment, page and placement policy
+      */
+      void allocate(int capacity, MemoryPolicy const & policy);
+
+      /**
+      * Set the memory policy used for subsequent allocation.
+      *
+      * \throw Exception if the DArray is already allocated
+      *
+      * \param policy  alignment, page and placement policy
+      */
+      void setMemoryPolicy(MemoryPolicy const & policy);
+
+      /**
+      * Return the memory policy used to allocate this DArray.
+      */
+      MemoryPolicy const & memoryPolicy() const;
+
       /**
       * Deallocate the underlying C array.
       *
@@ -140,6 +200,11 @@ namespace Util
       using Array<Data>::data_;
       using Array<Data>::capacity_;
 
+   private:
+
+      /// Memory policy used to allocate data_.
+      MemoryPolicy policy_;
+
    };
 
    // Inline member function definition
@@ -151,6 +216,13 @@ namespace Util
    bool DArray<Data>::isAllocated() const
    {  return (bool)data_; }
 
+   /*
+   * Return the memory policy.
+   */
+   template <typename Data> inline
+   MemoryPolicy const & DArray<Data>::memoryPolicy() const
+   {  return policy_; }
+
    // Non-inline member function definitions
 
    /*
@@ -158,7 +230,17 @@ namespace Util
    */
    template <typename Data>
    DArray<Data>::DArray()
-    : Array<Data>()
+    : Array<Data>(),
+      policy_()
+   {}
+
+   /*
+   * Constructor with a memory policy.
+   */
+   template <typename Data>
+   DArray<Data>::DArray(MemoryPolicy const & policy)
+    : Array<Data>(),
+      policy_(policy)
    {}
 
    /*
@@ -166,7 +248,8 @@ namespace Util
    */
    template <typename Data>
    DArray<Data>::DArray(int capacity)
-    : Array<Data>()
+    : Array<Data>(),
+      policy_()
    {  allocate(capacity); }
 
    /*
@@ -178,18 +261,35 @@ namespace Util
    */
    template <typename Data>
    DArray<Data>::DArray(DArray<Data> const & other)
-    : Array<Data>()
+    : Array<Data>(),
+      policy_(other.policy_)
    {
       if (!other.isAllocated()) {
          UTIL_THROW("Other DArray must be allocated.");
       }
-      Memory::allocate(data_, other.capacity_);
+      Memory::allocate(data_, other.capacity_, policy_);
       capacity_ = other.capacity_;
       for (int i = 0; i < capacity_; ++i) {
          data_[i] = other.data_[i];
       }
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Move constructor.
+   */
+   template <typename Data>
+   DArray<Data>::DArray(DArray<Data>&& other)
+    : Array<Data>(),
+      policy_(other.policy_)
+   {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      other.data_ = 0;
+      other.capacity_ = 0;
+   }
+   #endif
+
    /*
    * Destructor.
    */
@@ -197,7 +297,7 @@ namespace Util
    DArray<Data>::~DArray()
    {
       if (isAllocated()) {
-         Memory::deallocate<Data>(data_, capacity_);
+         Memory::deallocate<Data>(data_, capacity_, policy_);
          capacity_ = 0;
       }
    }
@@ -236,6 +336,27 @@ namespace Util
       return *this;
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Move assignment, transfers ownership of memory.
+   */
+   template <typename Data>
+   DArray<Data>& DArray<Data>::operator = (DArray<Data>&& other)
+   {
+      if (this == &other) return *this;
+      if (isAllocated()) {
+         Memory::deallocate<Data>(data_, capacity_, policy_);
+         capacity_ = 0;
+      }
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      policy_ = other.policy_;
+      other.data_ = 0;
+      other.capacity_ = 0;
+      return *this;
+   }
+   #endif
+
    /*
    * Assignment from an Array<Data> (deep copy).
    */
@@ -274,10 +395,32 @@ namespace Util
       if (isAllocated()) {
          UTIL_THROW("Attempt to re-allocate a DArray");
       }
-      Memory::allocate<Data>(data_, capacity);
+      Memory::allocate<Data>(data_, capacity, policy_);
       capacity_ = capacity;
    }
 
+   /*
+   * Allocate the underlying C array with a specified memory policy.
+   */
+   template <typename Data>
+   void DArray<Data>::allocate(int capacity, MemoryPolicy const & policy)
+   {
+      setMemoryPolicy(policy);
+      allocate(capacity);
+   }
+
+   /*
+   * Set the memory policy used for subsequent allocation.
+   */
+   template <typename Data>
+   void DArray<Data>::setMemoryPolicy(MemoryPolicy const & policy)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot change memory policy of an allocated DArray");
+      }
+      policy_ = policy;
+   }
+
    /*
    * Deallocate the underlying C array.
    */
@@ -287,7 +430,7 @@ namespace Util
       if (!isAllocated()) {
          UTIL_THROW("Array is not allocated");
       }
-      Memory::deallocate<Data>(data_, capacity_);
+      Memory::deallocate<Data>(data_, capacity_, policy_);
       capacity_ = 0;
    }
 
@@ -301,9 +444,9 @@ namespace Util
       if (capacity == capacity_) return;
       UTIL_CHECK(capacity > capacity_);
       if (isAllocated()) {
-         Memory::reallocate<Data>(data_, capacity_, capacity);
+         Memory::reallocate<Data>(data_, capacity_, capacity, policy_);
       } else {
-         Memory::allocate<Data>(data_, capacity);
+         Memory::allocate<Data>(data_, capacity, policy_);
       }
       capacity_ = capacity;
    }
@@ -332,9 +475,7 @@ namespace Util
          }
       }
       if (isAllocated()) {
-         for (int i = 0; i < capacity_; ++i) {
-            ar & data_[i];
-         }
+         serializeArray(ar, data_, capacity_, version);
       }
    }
 
@@ -10,6 +10,7 @@
 
 #include <util/containers/Matrix.h>
 #include <util/misc/Memory.h>
+#include <util/archives/serialize.h>
 #include <util/global.h>
 
 namespace Util
@@ -35,6 +36,13 @@ namespace Util
       */
       DMatrix();
 
+      /**
+      * Constructor with a memory policy for subsequent allocation.
+      *
+      * \param policy  memory policy, e.g. MemoryPolicy::tagged(name)
+      */
+      explicit DMatrix(MemoryPolicy const & policy);
+
       /**
       * Copy constructor.
       */
@@ -47,6 +55,25 @@ namespace Util
       */
       DMatrix<Data>& operator= (DMatrix<Data> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move constructor.
+      *
+      * Takes ownership of the memory of the other DMatrix, which is
+      * left unallocated.
+      */
+      DMatrix(DMatrix<Data>&& other);
+
+      /**
+      * Move assignment.
+      *
+      * Deallocates this DMatrix, if allocated, and takes ownership of 
+      * the memory of the other DMatrix, which is left unallocated.
+      * Dimensions need not match.
+      */
+      DMatrix<Data>& operator= (DMatrix<Data>&& other);
+      #endif
+
       /**
       * Destructor.
       *
@@ -62,6 +89,30 @@ namespace Util
       */
       void allocate(int capacity1, int capacity2);
 
+      /**
+      * Allocate memory for a matrix with a specified memory policy.
+      *
+      * \param capacity1 number of rows (range of first index)
+      * \param capacity2 number of columns (range of second index)
+      * \param policy  alignment, page and placement policy
+      */
+      void allocate(int capacity1, int capacity2, 
+                    MemoryPolicy const & policy);
+
+      /**
+      * Set the memory policy used for subsequent allocation.
+      *
+      * \throw Exception if the DMatrix is already allocated.
+      *
+      * \param policy  alignment, page and placement policy
+      */
+      void setMemoryPolicy(MemoryPolicy const & policy);
+
+      /**
+      * Return the memory policy used to allocate this DMatrix.
+      */
+      MemoryPolicy const & memoryPolicy() const;
+
       /**
       * Deallocate the underlying memory block.
       *
@@ -83,6 +134,11 @@ namespace Util
       template <class Archive>
       void serialize(Archive& ar, const unsigned int version);
 
+   private:
+
+      /// Memory policy used to allocate data_.
+      MemoryPolicy policy_;
+
    };
 
    // Method definitions
@@ -92,15 +148,26 @@ namespace Util
    */
    template <typename Data>
    DMatrix<Data>::DMatrix() :
-      Matrix<Data>()
+      Matrix<Data>(),
+      policy_()
    {}
       
+   /*
+   * Constructor with a memory policy.
+   */
+   template <typename Data>
+   DMatrix<Data>::DMatrix(MemoryPolicy const & policy) :
+      Matrix<Data>(),
+      policy_(policy)
+   {}
+
    /*
    * Copy constructor.
    */
    template <typename Data>
    DMatrix<Data>::DMatrix(DMatrix<Data> const & other) 
-     : Matrix<Data>()
+     : Matrix<Data>(),
+       policy_(other.policy_)
    {
       // Precondition
       if (other.data_ == 0) {
@@ -147,6 +214,44 @@ namespace Util
       return *this;
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Move constructor.
+   */
+   template <typename Data>
+   DMatrix<Data>::DMatrix(DMatrix<Data>&& other) 
+     : Matrix<Data>(),
+       policy_(other.policy_)
+   {
+      data_ = other.data_;
+      capacity1_ = other.capacity1_;
+      capacity2_ = other.capacity2_;
+      other.data_ = 0;
+      other.capacity1_ = 0;
+      other.capacity2_ = 0;
+   }
+
+   /*
+   * Move assignment.
+   */
+   template <typename Data>
+   DMatrix<Data>& DMatrix<Data>::operator = (DMatrix<Data>&& other) 
+   {
+      if (this == &other) return *this;
+      if (data_) {
+         Memory::deallocate<Data>(data_, capacity1_*capacity2_, policy_);
+      }
+      data_ = other.data_;
+      capacity1_ = other.capacity1_;
+      capacity2_ = other.capacity2_;
+      policy_ = other.policy_;
+      other.data_ = 0;
+      other.capacity1_ = 0;
+      other.capacity2_ = 0;
+      return *this;
+   }
+   #endif
+
    /*
    * Destructor.
    *
@@ -156,7 +261,7 @@ namespace Util
    DMatrix<Data>::~DMatrix()
    {
       if (data_) {
-         Memory::deallocate<Data>(data_, capacity1_*capacity2_);
+         Memory::deallocate<Data>(data_, capacity1_*capacity2_, policy_);
       }
    }
 
@@ -174,11 +279,41 @@ namespace Util
       if (capacity2 <= 0) UTIL_THROW("Capacity2 must be positive");
       if (data_  != 0) UTIL_THROW("Attempt to re-allocate a Matrix");
 
-      Memory::allocate<Data>(data_, capacity1*capacity2);
+      Memory::allocate<Data>(data_, capacity1*capacity2, policy_);
       capacity1_ = capacity1;
       capacity2_ = capacity2;
    }
 
+   /*
+   * Allocate memory for a matrix with a specified memory policy.
+   */
+   template <typename Data>
+   void DMatrix<Data>::allocate(int capacity1, int capacity2, 
+                                MemoryPolicy const & policy)
+   {
+      setMemoryPolicy(policy);
+      allocate(capacity1, capacity2);
+   }
+
+   /*
+   * Set the memory policy used for subsequent allocation.
+   */
+   template <typename Data>
+   void DMatrix<Data>::setMemoryPolicy(MemoryPolicy const & policy)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot change memory policy of an allocated DMatrix");
+      }
+      policy_ = policy;
+   }
+
+   /*
+   * Return the memory policy.
+   */
+   template <typename Data>
+   inline MemoryPolicy const & DMatrix<Data>::memoryPolicy() const
+   {  return policy_; }
+
    /*
    * Deallocate the underlying C array.
    *
@@ -190,7 +325,7 @@ namespace Util
       if (!isAllocated()) {
          UTIL_THROW("Array is not allocated");
       }
-      Memory::deallocate<Data>(data_, capacity1_*capacity2_);
+      Memory::deallocate<Data>(data_, capacity1_*capacity2_, policy_);
       capacity1_ = 0;
       capacity2_ = 0;
    }
@@ -235,9 +370,7 @@ namespace Util
             }
          }
       }
-      for (int i = 0; i < capacity1_*capacity2_; ++i) {
-         ar & data_[i];
-      }
+      serializeArray(ar, data_, capacity1_*capacity2_, version);
    }
 
 }
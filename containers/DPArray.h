@@ -59,6 +59,28 @@ namespace Util
       */
       DPArray<Data>& operator=(DPArray<Data> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move constructor.
+      *
+      * Takes ownership of the pointer array of the other DPArray, 
+      * which is left unallocated.
+      *
+      *\param other the DPArray to be moved.
+      */
+      DPArray(DPArray<Data>&& other);
+
+      /**
+      * Move assignment.
+      *
+      * Deallocates the pointer array of this DPArray, if any, and takes
+      * ownership of that of the other DPArray, which is left unallocated.
+      *
+      * \param other the rhs DPArray 
+      */
+      DPArray<Data>& operator=(DPArray<Data>&& other);
+      #endif
+
       /**
       * Allocate an array of pointers to Data.
       *
@@ -69,6 +91,20 @@ namespace Util
       */
       void allocate(int capacity);
 
+      /**
+      * Set the memory policy used for subsequent allocation.
+      *
+      * \throw Exception if the DPArray is already allocated.
+      *
+      * \param policy  alignment, page, placement or arena policy
+      */
+      void setMemoryPolicy(MemoryPolicy const & policy);
+
+      /**
+      * Return the memory policy used to allocate this DPArray.
+      */
+      MemoryPolicy const & memoryPolicy() const;
+
       /**
       * Append an element to the end of the sequence.
       *
@@ -92,6 +128,11 @@ namespace Util
       using PArray<Data>::capacity_;
       using PArray<Data>::size_;
 
+   private:
+
+      /// Memory policy used to allocate ptrs_.
+      MemoryPolicy policy_;
+
    };
 
    /*
@@ -99,7 +140,8 @@ namespace Util
    */
    template <typename Data>
    inline DPArray<Data>::DPArray()
-    : PArray<Data>()
+    : PArray<Data>(),
+      policy_()
    {}
 
    /*
@@ -109,14 +151,15 @@ namespace Util
    */
    template <typename Data>
    DPArray<Data>::DPArray(DPArray<Data> const & other) 
-    : PArray<Data>()
+    : PArray<Data>(),
+      policy_(other.policy_)
    {
       if (other.size_ > other.capacity_) {
          UTIL_THROW("Inconsistent size and capacity");
       }
       if (other.isAllocated()) {
          // Allocate array of Data* pointers
-         Memory::allocate<Data*>(ptrs_, other.capacity_);
+         Memory::allocate<Data*>(ptrs_, other.capacity_, policy_);
          capacity_ = other.capacity_;
          // Copy pointers
          for (int i = 0; i < other.size_; ++i) {
@@ -170,6 +213,44 @@ namespace Util
       return *this;
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Move constructor, transfers ownership of pointer array.
+   */
+   template <typename Data>
+   DPArray<Data>::DPArray(DPArray<Data>&& other) 
+    : PArray<Data>(),
+      policy_(other.policy_)
+   {
+      ptrs_ = other.ptrs_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.ptrs_ = 0;
+      other.capacity_ = 0;
+      other.size_ = 0;
+   }
+
+   /*
+   * Move assignment, transfers ownership of pointer array.
+   */
+   template <typename Data>
+   DPArray<Data>& DPArray<Data>::operator=(DPArray<Data>&& other) 
+   {
+      if (this == &other) return *this;
+      if (ptrs_) {
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
+      }
+      ptrs_ = other.ptrs_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      policy_ = other.policy_;
+      other.ptrs_ = 0;
+      other.capacity_ = 0;
+      other.size_ = 0;
+      return *this;
+   }
+   #endif
+
    /*
    * Destructor.
    */
@@ -179,7 +260,7 @@ namespace Util
       size_ = 0;
       if (ptrs_) {
          assert(capacity_ > 0);
-         Memory::deallocate<Data*>(ptrs_, capacity_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          capacity_ = 0;
       }
    }
@@ -197,7 +278,7 @@ namespace Util
       if (capacity <= 0) {
          UTIL_THROW("Cannot allocate a DPArray with capacity <=0");
       }
-      Memory::allocate<Data*>(ptrs_, capacity);
+      Memory::allocate<Data*>(ptrs_, capacity, policy_);
       capacity_ = capacity;
    }
 
@@ -227,6 +308,25 @@ namespace Util
       size_ = 0;
    }
 
+   /*
+   * Set the memory policy used for subsequent allocation.
+   */
+   template <typename Data>
+   void DPArray<Data>::setMemoryPolicy(MemoryPolicy const & policy)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot change memory policy of an allocated DPArray");
+      }
+      policy_ = policy;
+   }
+
+   /*
+   * Return the memory policy.
+   */
+   template <typename Data>
+   inline MemoryPolicy const & DPArray<Data>::memoryPolicy() const
+   {  return policy_; }
+
    /*
    * Is this DPArray allocated?
    */ 
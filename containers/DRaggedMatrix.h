@@ -10,14 +10,44 @@
 
 #include <util/containers/RaggedMatrix.h>
 #include <util/containers/DArray.h>
+#include <util/archives/serialize.h>
 #include <util/global.h>
 
+#include <algorithm>
+
 namespace Util
 {
 
    /**
    * Dynamically allocated RaggedMatrix.
    *
+   * A DRaggedMatrix stores all rows contiguously in one C array, in
+   * compressed sparse row (CSR) order. It may either be allocated
+   * once with known row sizes, by allocate(), or rebuilt any number
+   * of times by a two-pass count and fill protocol:
+   * \code
+   *    matrix.beginCount(nRow);
+   *    // for each element to be added to row i:
+   *    matrix.addCount(i);
+   *    matrix.endCount();
+   *    // for each element to be added to row i:
+   *    matrix.append(i, value);
+   *    matrix.endFill();
+   *    matrix.sortRows();  // optional
+   * \endcode
+   * endCount() computes row offsets by a prefix sum over the counts.
+   * Memory for rows and elements is retained between rebuilds, and is
+   * reallocated only when a rebuild requires more than the current
+   * capacity.
+   *
+   * The addCount() and append() functions may be called concurrently
+   * from several threads, for any rows, when compiled with a compiler
+   * that provides GCC-style atomic builtins. The order of elements
+   * within a row then depends on thread scheduling, and can be made
+   * deterministic by sorting. The sortRows(begin, end) function sorts
+   * a range of rows, so that threads may sort disjoint ranges. All
+   * other functions must be called by one thread.
+   *
    * \ingroup Matrix_Module
    */
    template <typename Data>
@@ -49,11 +79,127 @@ namespace Util
       */
       void allocate(DArray<int> const & rowSizes);
 
+      /// \name Count and fill (CSR build) protocol
+      //@{
+
+      /**
+      * Begin counting the elements of each row, discarding contents.
+      *
+      * Sets the number of rows and zeroes all counts, reallocating
+      * row arrays only if nRow exceeds the current row capacity.
+      *
+      * \param nRow  number of rows
+      */
+      void beginCount(int nRow);
+
+      /**
+      * Add n to the element count of row i (thread safe).
+      *
+      * \param i  row index
+      * \param n  number of elements to be added to row i
+      */
+      void addCount(int i, int n = 1);
+
+      /**
+      * Finish counting: compute row offsets and reserve elements.
+      *
+      * After this, capacity2(i) returns the number of elements
+      * appended so far to row i, which is initially zero.
+      */
+      void endCount();
+
+      /**
+      * Append an element to row i (thread safe).
+      *
+      * If row i is already full, the element is discarded and -1 is
+      * returned. The excess is still counted, so that endFill() then
+      * throws an Exception.
+      *
+      * \param i  row index
+      * \param value  value of element
+      * \return column index of the new element within row i, or -1
+      */
+      int append(int i, Data const & value);
+
+      /**
+      * Finish filling, checking that every row is completely filled.
+      *
+      * \throw Exception if the number of elements appended to any row
+      * differs from the number counted.
+      */
+      void endFill();
+
+      /**
+      * Sort elements within each of a range of rows.
+      *
+      * Uses operator < for Data.
+      *
+      * \param begin  index of first row to sort
+      * \param end  one past index of last row to sort
+      */
+      void sortRows(int begin, int end);
+
+      /**
+      * Sort elements within every row.
+      */
+      void sortRows();
+
+      //@}
+
+      /**
+      * Return offset of the first element of row i within the array.
+      *
+      * \param i  row index
+      */
+      int offset(int i) const;
+
+      /**
+      * Return number of rows for which memory is allocated.
+      */
+      int rowCapacity() const;
+
+      /**
+      * Return number of elements for which memory is allocated.
+      */
+      int dataCapacity() const;
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * Saves the number of rows, the row sizes and the elements, with
+      * bulk array writes when supported by the archive.
+      *
+      * \param ar       archive
+      * \param version  archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
       /**
       * Return true iff this DRaggedMatrix has been allocated.
       */
       bool isAllocated() const;
 
+   private:
+
+      /// Number of rows for which rows_ and capacity2_ are allocated.
+      int rowCapacity_;
+
+      /// Number of elements for which data_ is allocated.
+      int dataCapacity_;
+
+      /// Ensure row arrays can hold nRow rows.
+      void reserveRows(int nRow);
+
+      /// Ensure element array can hold n elements.
+      void reserveData(int n);
+
+      /// Return address one past the last element of row i.
+      Data* rowEnd(int i) const;
+
+      /// Atomically add n to counter, return previous value.
+      static int fetchAdd(int& counter, int n);
+
    };
 
    // Method definitions
@@ -63,9 +209,11 @@ namespace Util
    */
    template <typename Data>
    DRaggedMatrix<Data>::DRaggedMatrix() :
-      RaggedMatrix<Data>()
+      RaggedMatrix<Data>(),
+      rowCapacity_(0),
+      dataCapacity_(0)
    {}
-     
+
    /*
    * Destructor.
    */
@@ -73,13 +221,13 @@ namespace Util
    DRaggedMatrix<Data>::~DRaggedMatrix()
    {
       if (data_) {
-         Memory::deallocate<Data>(data_, capacity_);
+         Memory::deallocate<Data>(data_, dataCapacity_);
       }
       if (rows_) {
-         Memory::deallocate<Data*>(rows_, capacity1_);
+         Memory::deallocate<Data*>(rows_, rowCapacity_);
       }
       if (capacity2_) {
-         Memory::deallocate<int>(capacity2_, capacity1_);
+         Memory::deallocate<int>(capacity2_, rowCapacity_);
       }
    }
 
@@ -89,28 +237,26 @@ namespace Util
    template <typename Data>
    void DRaggedMatrix<Data>::allocate(DArray<int> const & rowSizes)
    {
-      if (data_ != 0) 
+      if (rows_ != 0)
          UTIL_THROW("Attempt to re-allocate a RaggedMatrix");
-
-      if (rowSizes.capacity() <= 0) 
+      if (rowSizes.capacity() <= 0)
          UTIL_THROW("rowSizes.capacity() must be positive");
 
       // Calculate total number of elements (all rows)
-      capacity_ = 0; 
+      int capacity = 0;
       for (int i = 0; i < rowSizes.capacity(); ++i) {
-         if (rowSizes[i] < 0) 
+         if (rowSizes[i] < 0)
             UTIL_THROW("rowSizes must all be nonnegative");
-         capacity_ += rowSizes[i];
+         capacity += rowSizes[i];
       }
-
-      if (capacity_ == 0) 
+      if (capacity == 0)
          UTIL_THROW("Sum of row sizes must be positive");
 
       // Allocate all memory
+      reserveRows(rowSizes.capacity());
+      reserveData(capacity);
       capacity1_ = rowSizes.capacity();
-      Memory::allocate<int>(capacity2_, capacity1_);
-      Memory::allocate<Data*>(rows_, capacity1_);
-      Memory::allocate<Data>(data_, capacity_);
+      capacity_ = capacity;
 
       // Set row sizes and pointers to rows
       Data* ptr = data_;
@@ -119,15 +265,234 @@ namespace Util
          rows_[i] = ptr;
          ptr += rowSizes[i];
       }
-      
+   }
+
+   /*
+   * Begin counting elements of each row.
+   */
+   template <typename Data>
+   void DRaggedMatrix<Data>::beginCount(int nRow)
+   {
+      if (nRow <= 0)
+         UTIL_THROW("Number of rows must be positive");
+      reserveRows(nRow);
+      capacity1_ = nRow;
+      capacity_ = 0;
+      for (int i = 0; i < nRow; ++i) {
+         capacity2_[i] = 0;
+      }
+   }
+
+   /*
+   * Add n to the count for row i.
+   */
+   template <typename Data>
+   inline void DRaggedMatrix<Data>::addCount(int i, int n)
+   {
+      assert(i >= 0);
+      assert(i < capacity1_);
+      fetchAdd(capacity2_[i], n);
+   }
+
+   /*
+   * Compute row offsets from counts, and reset fill cursors.
+   */
+   template <typename Data>
+   void DRaggedMatrix<Data>::endCount()
+   {
+      // Exclusive prefix sum of row counts
+      int capacity = 0;
+      for (int i = 0; i < capacity1_; ++i) {
+         if (capacity2_[i] < 0)
+            UTIL_THROW("Negative row count");
+         int size = capacity2_[i];
+         capacity2_[i] = capacity;
+         capacity += size;
+      }
+      reserveData(capacity);
+      capacity_ = capacity;
+
+      // Set row pointers, and use capacity2_ as fill cursors
+      for (int i = 0; i < capacity1_; ++i) {
+         rows_[i] = data_ + capacity2_[i];
+         capacity2_[i] = 0;
+      }
+   }
+
+   /*
+   * Append an element to row i.
+   */
+   template <typename Data>
+   inline int DRaggedMatrix<Data>::append(int i, Data const & value)
+   {
+      assert(i >= 0);
+      assert(i < capacity1_);
+      int j = fetchAdd(capacity2_[i], 1);
+      if (j >= rowEnd(i) - rows_[i]) {
+         // Row is full: discard, and leave endFill() to report it
+         return -1;
+      }
+      rows_[i][j] = value;
+      return j;
+   }
+
+   /*
+   * Check that every row is completely filled.
+   */
+   template <typename Data>
+   void DRaggedMatrix<Data>::endFill()
+   {
+      for (int i = 0; i < capacity1_; ++i) {
+         if (capacity2_[i] != rowEnd(i) - rows_[i]) {
+            UTIL_THROW("Number of appended elements differs from count");
+         }
+      }
+   }
+
+   /*
+   * Sort elements within each of a range of rows.
+   */
+   template <typename Data>
+   void DRaggedMatrix<Data>::sortRows(int begin, int end)
+   {
+      assert(begin >= 0);
+      assert(end <= capacity1_);
+      for (int i = begin; i < end; ++i) {
+         std::sort(rows_[i], rows_[i] + capacity2_[i]);
+      }
+   }
+
+   /*
+   * Sort elements within every row.
+   */
+   template <typename Data>
+   void DRaggedMatrix<Data>::sortRows()
+   {  sortRows(0, capacity1_); }
+
+   /*
+   * Return offset of first element of row i.
+   */
+   template <typename Data>
+   inline int DRaggedMatrix<Data>::offset(int i) const
+   {
+      assert(i >= 0);
+      assert(i < capacity1_);
+      return int(rows_[i] - data_);
+   }
+
+   /*
+   * Return number of rows for which memory is allocated.
+   */
+   template <typename Data>
+   inline int DRaggedMatrix<Data>::rowCapacity() const
+   {  return rowCapacity_; }
+
+   /*
+   * Return number of elements for which memory is allocated.
+   */
+   template <typename Data>
+   inline int DRaggedMatrix<Data>::dataCapacity() const
+   {  return dataCapacity_; }
+
+   /*
+   * Serialize to/from an archive.
+   */
+   template <typename Data>
+   template <class Archive>
+   void DRaggedMatrix<Data>::serialize(Archive& ar,
+                                       const unsigned int version)
+   {
+      int nRow = capacity1_;
+      ar & nRow;
+      if (Archive::is_loading()) {
+         reserveRows(nRow);
+         capacity1_ = nRow;
+      }
+      serializeArray(ar, capacity2_, capacity1_, version);
+      if (Archive::is_loading()) {
+         int capacity = 0;
+         for (int i = 0; i < capacity1_; ++i) {
+            capacity += capacity2_[i];
+         }
+         reserveData(capacity);
+         capacity_ = capacity;
+         Data* ptr = data_;
+         for (int i = 0; i < capacity1_; ++i) {
+            rows_[i] = ptr;
+            ptr += capacity2_[i];
+         }
+         serializeArray(ar, data_, capacity_, version);
+      } else {
+         for (int i = 0; i < capacity1_; ++i) {
+            serializeArray(ar, rows_[i], capacity2_[i], version);
+         }
+      }
    }
 
    /*
    * Return true if the DRaggedMatrix has been allocated, false otherwise.
    */
    template <typename Data>
-   inline bool DRaggedMatrix<Data>::isAllocated() const 
-   {  return !(data_ == 0); }
+   inline bool DRaggedMatrix<Data>::isAllocated() const
+   {  return !(rows_ == 0); }
+
+   /*
+   * Ensure row arrays can hold nRow rows.
+   */
+   template <typename Data>
+   void DRaggedMatrix<Data>::reserveRows(int nRow)
+   {
+      if (nRow <= rowCapacity_) return;
+      if (rows_) {
+         Memory::deallocate<Data*>(rows_, rowCapacity_);
+         Memory::deallocate<int>(capacity2_, rowCapacity_);
+      }
+      Memory::allocate<Data*>(rows_, nRow);
+      Memory::allocate<int>(capacity2_, nRow);
+      rowCapacity_ = nRow;
+   }
+
+   /*
+   * Ensure element array can hold n elements.
+   */
+   template <typename Data>
+   void DRaggedMatrix<Data>::reserveData(int n)
+   {
+      if (n <= dataCapacity_) return;
+      if (data_) {
+         Memory::deallocate<Data>(data_, dataCapacity_);
+      }
+      Memory::allocate<Data>(data_, n);
+      dataCapacity_ = n;
+   }
+
+   /*
+   * Return address one past the last element of row i.
+   */
+   template <typename Data>
+   inline Data* DRaggedMatrix<Data>::rowEnd(int i) const
+   {
+      if (i + 1 < capacity1_) {
+         return rows_[i+1];
+      } else {
+         return data_ + capacity_;
+      }
+   }
+
+   /*
+   * Atomically add n to counter and return previous value.
+   */
+   template <typename Data>
+   inline int DRaggedMatrix<Data>::fetchAdd(int& counter, int n)
+   {
+      #if defined(__GNUC__) || defined(__clang__)
+      return __atomic_fetch_add(&counter, n, __ATOMIC_RELAXED);
+      #else
+      int old = counter;
+      counter += n;
+      return old;
+      #endif
+   }
 
 }
 #endif
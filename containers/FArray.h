@@ -10,6 +10,7 @@
 
 #include <util/containers/ArrayIterator.h>
 #include <util/containers/ConstArrayIterator.h>
+#include <util/archives/serialize.h>
 #include <util/global.h>
 
 #ifdef UTIL_MPI
@@ -271,11 +272,7 @@ namespace Util
    template <class Archive>
    void FArray<Data, Capacity>::serialize(Archive& ar, 
                                           const unsigned int version)
-   {
-      for (int i = 0; i < Capacity; ++i) {
-         ar & data_[i];
-      }
-   }
+   {  serializeArray(ar, data_, Capacity, version); }
 
    /*
    * Packed size of FArray in a MemoryArchive, in bytes.
@@ -40,6 +40,13 @@ namespace Util
       */
       GArray();
 
+      /**
+      * Constructor with a memory policy for subsequent allocation.
+      *
+      * \param policy  memory policy, e.g. MemoryPolicy::tagged(name)
+      */
+      explicit GArray(MemoryPolicy const & policy);
+
       /**
       * Copy constructor, copy pointers.
       *
@@ -56,6 +63,28 @@ namespace Util
       */
       GArray<Data>& operator = (GArray<Data> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move constructor.
+      *
+      * Takes ownership of the memory of the other GArray, which is left
+      * empty and unallocated. No elements are copied.
+      *
+      *\param other the GArray to be moved.
+      */
+      GArray(GArray<Data>&& other);
+
+      /**
+      * Move assignment.
+      *
+      * Deallocates this GArray, if allocated, and takes ownership of the
+      * memory of the other GArray, which is left empty and unallocated.
+      *
+      * \param other the rhs GArray 
+      */
+      GArray<Data>& operator = (GArray<Data>&& other);
+      #endif
+
       /**
       * Destructor.
       *
@@ -75,6 +104,20 @@ namespace Util
       */
       void reserve(int capacity);
 
+      /**
+      * Set the memory policy used for subsequent allocation.
+      *
+      * \throw Exception if the GArray is already allocated.
+      *
+      * \param policy  alignment, page and placement policy
+      */
+      void setMemoryPolicy(MemoryPolicy const & policy);
+
+      /**
+      * Return the memory policy used to allocate this GArray.
+      */
+      MemoryPolicy const & memoryPolicy() const;
+
       /**
       * Deallocate (delete) underlying array of pointers.
       *
@@ -122,6 +165,17 @@ namespace Util
       */
       void append(Data const & data);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Append an element to the end of the sequence by moving it.
+      *
+      * Resizes array if space is inadequate. 
+      *
+      * \param data Data object to be moved into the array
+      */
+      void append(Data&& data);
+      #endif
+
       /**
       * Resizes array so that it contains n elements.
       *
@@ -180,6 +234,9 @@ namespace Util
       /// Maxium size of array
       int capacity_;
 
+      /// Memory policy used to allocate data_.
+      MemoryPolicy policy_;
+
    }; // class GArray
 
    // Method definitions
@@ -191,7 +248,19 @@ namespace Util
    GArray<Data>::GArray()
     : data_(0),
       size_(0),
-      capacity_(0)
+      capacity_(0),
+      policy_()
+   {}
+
+   /*
+   * Constructor with a memory policy.
+   */
+   template <typename Data>
+   GArray<Data>::GArray(MemoryPolicy const & policy)
+    : data_(0),
+      size_(0),
+      capacity_(0),
+      policy_(policy)
    {}
 
    /*
@@ -203,13 +272,14 @@ namespace Util
    GArray<Data>::GArray(GArray<Data> const & other) 
     : data_(0),
       size_(0),
-      capacity_(0)
+      capacity_(0),
+      policy_(other.policy_)
    {
       assert(other.size_ <= other.capacity_);
       if (other.isAllocated()) {
          assert(other.capacity_ > 0);
          // Allocate new array
-         Memory::allocate<Data>(data_, other.capacity_);
+         Memory::allocate<Data>(data_, other.capacity_, policy_);
          capacity_ = other.capacity_;
          // Copy objects
          for (int i = 0; i < other.size_; ++i) {
@@ -219,6 +289,43 @@ namespace Util
       }
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Move constructor, transfers ownership of memory.
+   */
+   template <typename Data>
+   GArray<Data>::GArray(GArray<Data>&& other) 
+    : data_(other.data_),
+      size_(other.size_),
+      capacity_(other.capacity_),
+      policy_(other.policy_)
+   {
+      other.data_ = 0;
+      other.size_ = 0;
+      other.capacity_ = 0;
+   }
+
+   /*
+   * Move assignment, transfers ownership of memory.
+   */
+   template <typename Data>
+   GArray<Data>& GArray<Data>::operator = (GArray<Data>&& other) 
+   {
+      if (this == &other) return *this;
+      if (isAllocated()) {
+         Memory::deallocate<Data>(data_, capacity_, policy_);
+      }
+      data_ = other.data_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      policy_ = other.policy_;
+      other.data_ = 0;
+      other.size_ = 0;
+      other.capacity_ = 0;
+      return *this;
+   }
+   #endif
+
    /*
    * Destructor.
    */
@@ -227,7 +334,7 @@ namespace Util
    {
       size_ = 0;
       if (isAllocated()) {
-         Memory::deallocate<Data>(data_, capacity_);
+         Memory::deallocate<Data>(data_, capacity_, policy_);
          capacity_ = 0;
       }
    }
@@ -260,25 +367,33 @@ namespace Util
       if (!isAllocated()) {
          assert(capacity_ == 0);
          assert(size_ == 0);
-         Memory::allocate<Data>(data_, capacity);
+         Memory::allocate<Data>(data_, capacity, policy_);
          capacity_ = capacity;
          size_ = 0;
       } else if (capacity > capacity_) {
          assert(capacity_ > 0);
          assert(capacity_ >= size_);
          Data* newPtr = 0;
-         Memory::allocate<Data>(newPtr, capacity);
-         if (size_ > 0) {
-            for (int i = 0; i < size_; ++i) {
-               newPtr[i] = data_[i];
-            }
-         }
-         Memory::deallocate<Data>(data_, capacity_);
+         Memory::allocate<Data>(newPtr, capacity, policy_);
+         Memory::relocate<Data>(newPtr, data_, size_);
+         Memory::deallocate<Data>(data_, capacity_, policy_);
          data_ = newPtr;
          capacity_ = capacity;
       }
    }
 
+   /*
+   * Set the memory policy used for subsequent allocation.
+   */
+   template <typename Data>
+   void GArray<Data>::setMemoryPolicy(MemoryPolicy const & policy)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot change memory policy of an allocated GArray");
+      }
+      policy_ = policy;
+   }
+
    /*
    * Delete associated C array.
    */
@@ -287,7 +402,7 @@ namespace Util
    {
       size_ = 0;
       if (isAllocated()) {
-         Memory::deallocate<Data>(data_, capacity_);
+         Memory::deallocate<Data>(data_, capacity_, policy_);
          capacity_ = 0; 
       }
    }
@@ -309,21 +424,22 @@ namespace Util
       if (size_ == capacity_) {
          if (capacity_ == 0) {
             assert(data_ == 0); 
-            Memory::allocate<Data>(data_, 64);
+            Memory::allocate<Data>(data_, 64, policy_);
             capacity_ = 64;
          } else {
             assert(data_); 
             assert(capacity_ > 0); 
+            // Set new element before relocating, in case data is an
+            // element of this array
             Data* newPtr = 0;
-            Memory::allocate<Data>(newPtr, 2*capacity_);
-            if (size_ > 0) {
-               for (int i = 0; i < size_; ++i) {
-                  newPtr[i] = data_[i];
-               }
-            }
-            Memory::deallocate<Data>(data_, capacity_);
+            Memory::allocate<Data>(newPtr, 2*capacity_, policy_);
+            newPtr[size_] = data;
+            Memory::relocate<Data>(newPtr, data_, size_);
+            Memory::deallocate<Data>(data_, capacity_, policy_);
             data_ = newPtr;
             capacity_ = 2*capacity_;
+            ++size_;
+            return;
          }
       }
       // Append new element
@@ -332,6 +448,42 @@ namespace Util
       assert(size_ <= capacity_);
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Append an element to the end of the Array by moving it.
+   */
+   template <typename Data>
+   void GArray<Data>::append(Data&& data) 
+   {
+      assert(size_ <= capacity_);
+      if (size_ == capacity_) {
+         if (capacity_ == 0) {
+            assert(data_ == 0); 
+            Memory::allocate<Data>(data_, 64, policy_);
+            capacity_ = 64;
+         } else {
+            assert(data_); 
+            assert(capacity_ > 0); 
+            // Set new element before relocating, in case data is an
+            // element of this array
+            Data* newPtr = 0;
+            Memory::allocate<Data>(newPtr, 2*capacity_, policy_);
+            newPtr[size_] = std::move(data);
+            Memory::relocate<Data>(newPtr, data_, size_);
+            Memory::deallocate<Data>(data_, capacity_, policy_);
+            data_ = newPtr;
+            capacity_ = 2*capacity_;
+            ++size_;
+            return;
+         }
+      }
+      // Append new element
+      data_[size_] = std::move(data);
+      ++size_;
+      assert(size_ <= capacity_);
+   }
+   #endif
+
    /*
    * Resize the array.
    */
@@ -353,13 +505,11 @@ namespace Util
                }
             }
             Data* newPtr = 0;
-            Memory::allocate<Data>(newPtr, m);
+            Memory::allocate<Data>(newPtr, m, policy_);
             if (data_) {
                assert(capacity_ > 0);
-               for (int i = 0; i < size_; ++i) {
-                  newPtr[i] = data_[i];
-               }
-               Memory::deallocate<Data>(data_, capacity_);
+               Memory::relocate<Data>(newPtr, data_, size_);
+               Memory::deallocate<Data>(data_, capacity_, policy_);
             }
             data_ = newPtr;
             capacity_ = m;
@@ -462,5 +612,12 @@ namespace Util
    inline bool GArray<Data>::isAllocated() const
    {  return (bool)data_; }
 
+   /*
+   * Return the memory policy.
+   */
+   template <typename Data>
+   inline MemoryPolicy const & GArray<Data>::memoryPolicy() const
+   {  return policy_; }
+
 } 
 #endif
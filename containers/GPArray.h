@@ -9,6 +9,7 @@
 */
 
 #include <util/containers/PArray.h>
+#include <util/misc/Memory.h>
 #include <util/global.h>
 
 namespace Util
@@ -55,6 +56,28 @@ namespace Util
       */
       GPArray<Data>& operator=(GPArray<Data> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move constructor.
+      *
+      * Takes ownership of the pointer array of the other GPArray,
+      * which is left empty and unallocated.
+      *
+      *\param other the GPArray to be moved.
+      */
+      GPArray(GPArray<Data>&& other);
+
+      /**
+      * Move assignment.
+      *
+      * Deallocates the pointer array of this GPArray, if any, and takes
+      * ownership of that of the other GPArray, which is left empty.
+      *
+      * \param other the rhs GPArray 
+      */
+      GPArray<Data>& operator=(GPArray<Data>&& other);
+      #endif
+
       /**
       * Destructor.
       *
@@ -83,6 +106,20 @@ namespace Util
       */
       void reserve(int capacity);
 
+      /**
+      * Set the memory policy used for subsequent allocation.
+      *
+      * \throw Exception if the GPArray is already allocated.
+      *
+      * \param policy  alignment, page, placement or arena policy
+      */
+      void setMemoryPolicy(MemoryPolicy const & policy);
+
+      /**
+      * Return the memory policy used to allocate this GPArray.
+      */
+      MemoryPolicy const & memoryPolicy() const;
+
       /**
       * Deallocate (delete) underlying array of pointers.
       */
@@ -104,6 +141,11 @@ namespace Util
       using PArray<Data>::capacity_;
       using PArray<Data>::size_;
 
+   private:
+
+      /// Memory policy used to allocate ptrs_.
+      MemoryPolicy policy_;
+
    };
 
    /*
@@ -111,7 +153,8 @@ namespace Util
    */
    template <typename Data>
    inline GPArray<Data>::GPArray()
-    : PArray<Data>()
+    : PArray<Data>(),
+      policy_()
    {}
 
    /*
@@ -121,7 +164,8 @@ namespace Util
    */
    template <typename Data>
    GPArray<Data>::GPArray(GPArray<Data> const & other) 
-    : PArray<Data>()
+    : PArray<Data>(),
+      policy_(other.policy_)
    {
       assert(other.capacity_ >= other.size_);
       if (other.ptrs_ == 0) {
@@ -133,7 +177,7 @@ namespace Util
       } else { 
          assert(other.capacity_ > 0);
          // Allocate array of Data* pointers
-         Memory::allocate<Data*>(ptrs_, other.capacity_);
+         Memory::allocate<Data*>(ptrs_, other.capacity_, policy_);
          capacity_ = other.capacity_;
          size_ = other.size_;
          // Copy pointers
@@ -167,6 +211,44 @@ namespace Util
       return *this;
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Move constructor, transfers ownership of pointer array.
+   */
+   template <typename Data>
+   GPArray<Data>::GPArray(GPArray<Data>&& other) 
+    : PArray<Data>(),
+      policy_(other.policy_)
+   {
+      ptrs_ = other.ptrs_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.ptrs_ = 0;
+      other.capacity_ = 0;
+      other.size_ = 0;
+   }
+
+   /*
+   * Move assignment, transfers ownership of pointer array.
+   */
+   template <typename Data>
+   GPArray<Data>& GPArray<Data>::operator=(GPArray<Data>&& other) 
+   {
+      if (this == &other) return *this;
+      if (ptrs_) {
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
+      }
+      ptrs_ = other.ptrs_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      policy_ = other.policy_;
+      other.ptrs_ = 0;
+      other.capacity_ = 0;
+      other.size_ = 0;
+      return *this;
+   }
+   #endif
+
    /*
    * Destructor.
    */
@@ -175,7 +257,7 @@ namespace Util
    {
       size_ = 0; 
       if (isAllocated()) {
-         Memory::deallocate(ptrs_, capacity_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          capacity_ = 0; 
       }
    }
@@ -192,7 +274,7 @@ namespace Util
       if (ptrs_ == 0) {
          assert(capacity_ == 0);
          assert(size_ == 0);
-         Memory::allocate<Data*>(ptrs_, capacity);
+         Memory::allocate<Data*>(ptrs_, capacity, policy_);
          capacity_ = capacity;
          size_ = 0;
       } else if (capacity > capacity_) {
@@ -200,13 +282,9 @@ namespace Util
          assert(capacity_ >= size_);
          assert(size_ >= 0);
          Data** newPtr = 0;
-         Memory::allocate<Data*>(newPtr, capacity);
-         if (size_ > 0) {
-            for (int i = 0; i < size_; ++i) {
-               newPtr[i] = ptrs_[i];
-            }
-         }
-         Memory::deallocate<Data*>(ptrs_, capacity_);
+         Memory::allocate<Data*>(newPtr, capacity, policy_);
+         Memory::relocate<Data*>(newPtr, ptrs_, size_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          ptrs_ = newPtr;
          capacity_ = capacity;
       }
@@ -221,7 +299,7 @@ namespace Util
       size_ = 0; 
       if (isAllocated()) {
          assert(capacity_ > 0);
-         Memory::deallocate<Data*>(ptrs_, capacity_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          capacity_ = 0; 
       } 
    }
@@ -234,7 +312,7 @@ namespace Util
    {
       if (!isAllocated()) {
          assert(capacity_ == 0);
-         Memory::allocate<Data*>(ptrs_, 64);
+         Memory::allocate<Data*>(ptrs_, 64, policy_);
          capacity_ = 64;
          size_ = 0;
       } else if (size_ == capacity_) {
@@ -242,13 +320,9 @@ namespace Util
          assert(capacity_ >= size_);
          assert(size_ >= 0);
          Data** newPtr = 0;
-         Memory::allocate<Data*>(newPtr, 2*capacity_);
-         if (size_ > 0) {
-            for (int i = 0; i < size_; ++i) {
-               newPtr[i] = ptrs_[i];
-            }
-         }
-         Memory::deallocate<Data*>(ptrs_, capacity_);
+         Memory::allocate<Data*>(newPtr, 2*capacity_, policy_);
+         Memory::relocate<Data*>(newPtr, ptrs_, size_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          ptrs_ = newPtr;
          capacity_ = 2*capacity_;
          // size_ is unchanged
@@ -266,6 +340,25 @@ namespace Util
    inline void GPArray<Data>::clear()
    {  size_ = 0; }
 
+   /*
+   * Set the memory policy used for subsequent allocation.
+   */
+   template <typename Data>
+   void GPArray<Data>::setMemoryPolicy(MemoryPolicy const & policy)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot change memory policy of an allocated GPArray");
+      }
+      policy_ = policy;
+   }
+
+   /*
+   * Return the memory policy.
+   */
+   template <typename Data>
+   inline MemoryPolicy const & GPArray<Data>::memoryPolicy() const
+   {  return policy_; }
+
    /*
    * Is this GPArray allocated?
    */
@@ -9,6 +9,7 @@
 */
 
 #include <util/containers/GStack.h>
+#include <util/misc/Memory.h>
 #include <util/global.h>
 
 namespace Util
@@ -63,6 +64,28 @@ namespace Util
       */
       GStack<Data>& operator=(GStack<Data> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move constructor.
+      *
+      * Takes ownership of the pointer array of the other GStack,
+      * which is left empty and unallocated.
+      *
+      *\param other the GStack to be moved.
+      */
+      GStack(GStack<Data>&& other);
+
+      /**
+      * Move assignment.
+      *
+      * Deallocates the pointer array of this GStack, if any, and takes
+      * ownership of that of the other GStack, which is left empty.
+      *
+      * \param other the rhs GStack 
+      */
+      GStack<Data>& operator=(GStack<Data>&& other);
+      #endif
+
       /**
       * Reserve memory for specified number of elements.
       *
@@ -74,6 +97,20 @@ namespace Util
       */
       void reserve(int capacity);
 
+      /**
+      * Set the memory policy used for subsequent allocation.
+      *
+      * \throw Exception if the GStack is already allocated.
+      *
+      * \param policy  alignment, page, placement or arena policy
+      */
+      void setMemoryPolicy(MemoryPolicy const & policy);
+
+      /**
+      * Return the memory policy used to allocate this GStack.
+      */
+      MemoryPolicy const & memoryPolicy() const;
+
       /**
       * Deallocate (delete) underlying array of pointers.
       */
@@ -148,6 +185,9 @@ namespace Util
       /// Logical size (number of elements with initialized data).
       int size_;
 
+      /// Memory policy used to allocate ptrs_.
+      MemoryPolicy policy_;
+
    };
 
    /*
@@ -157,7 +197,8 @@ namespace Util
    inline GStack<Data>::GStack()
     : ptrs_(0),
       capacity_(0),
-      size_(0)
+      size_(0),
+      policy_()
    {}
 
    /*
@@ -169,7 +210,8 @@ namespace Util
    GStack<Data>::GStack(GStack<Data> const & other) 
     : ptrs_(0),
       capacity_(0),
-      size_(0)
+      size_(0),
+      policy_(other.policy_)
    {
       assert(other.capacity_ >= other.size_);
       if (other.ptrs_ == 0) {
@@ -181,7 +223,7 @@ namespace Util
       } else { 
          assert(other.capacity_ > 0);
          // Allocate array of Data* pointers
-         Memory::allocate<Data*>(ptrs_, other.capacity_);
+         Memory::allocate<Data*>(ptrs_, other.capacity_, policy_);
          capacity_ = other.capacity_;
          size_ = other.size_;
          // Copy pointers
@@ -199,6 +241,46 @@ namespace Util
       }
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Move constructor, transfers ownership of pointer array.
+   */
+   template <typename Data>
+   GStack<Data>::GStack(GStack<Data>&& other) 
+    : ptrs_(0),
+      capacity_(0),
+      size_(0),
+      policy_(other.policy_)
+   {
+      ptrs_ = other.ptrs_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.ptrs_ = 0;
+      other.capacity_ = 0;
+      other.size_ = 0;
+   }
+
+   /*
+   * Move assignment, transfers ownership of pointer array.
+   */
+   template <typename Data>
+   GStack<Data>& GStack<Data>::operator=(GStack<Data>&& other) 
+   {
+      if (this == &other) return *this;
+      if (ptrs_) {
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
+      }
+      ptrs_ = other.ptrs_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      policy_ = other.policy_;
+      other.ptrs_ = 0;
+      other.capacity_ = 0;
+      other.size_ = 0;
+      return *this;
+   }
+   #endif
+
    /*
    * Destructor.
    */
@@ -207,7 +289,7 @@ namespace Util
    {
       size_ = 0; 
       if (isAllocated()) {
-         Memory::deallocate(ptrs_, capacity_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          capacity_ = 0; 
       }
    }
@@ -240,7 +322,7 @@ namespace Util
       if (ptrs_ == 0) {
          assert(capacity_ == 0);
          assert(size_ == 0);
-         Memory::allocate<Data*>(ptrs_, capacity);
+         Memory::allocate<Data*>(ptrs_, capacity, policy_);
          capacity_ = capacity;
          size_ = 0;
          for (int i = 0; i < capacity_; ++i) {
@@ -251,18 +333,14 @@ namespace Util
          assert(capacity_ >= size_);
          assert(size_ >= 0);
          Data** newPtr = 0;
-         Memory::allocate<Data*>(newPtr, capacity);
-         if (size_ > 0) {
-            for (int i = 0; i < size_; ++i) {
-               newPtr[i] = ptrs_[i];
-            }
-         }
+         Memory::allocate<Data*>(newPtr, capacity, policy_);
+         Memory::relocate<Data*>(newPtr, ptrs_, size_);
          if (size_ < capacity) {
             for (int i = size_; i < capacity; ++i) {
                newPtr[i] = 0;
             }
          }
-         Memory::deallocate<Data*>(ptrs_, capacity_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          ptrs_ = newPtr;
          capacity_ = capacity;
       }
@@ -277,7 +355,7 @@ namespace Util
       size_ = 0; 
       if (isAllocated()) {
          assert(capacity_ > 0);
-         Memory::deallocate<Data*>(ptrs_, capacity_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          capacity_ = 0; 
       } 
    }
@@ -297,7 +375,7 @@ namespace Util
    {
       if (!isAllocated()) {
          assert(capacity_ == 0);
-         Memory::allocate<Data*>(ptrs_, 64);
+         Memory::allocate<Data*>(ptrs_, 64, policy_);
          capacity_ = 64;
          size_ = 0;
          for (int i = 0; i < capacity_; ++i) {
@@ -308,18 +386,14 @@ namespace Util
          assert(capacity_ >= size_);
          assert(size_ >= 0);
          Data** newPtr = 0;
-         Memory::allocate<Data*>(newPtr, 2*capacity_);
-         if (size_ > 0) {
-            for (int i = 0; i < size_; ++i) {
-               newPtr[i] = ptrs_[i];
-            }
-         }
+         Memory::allocate<Data*>(newPtr, 2*capacity_, policy_);
+         Memory::relocate<Data*>(newPtr, ptrs_, size_);
          if (size_ < 2*capacity_) {
             for (int i = size_; i < 2*capacity_; ++i) {
                newPtr[i] = 0;
             }
          }
-         Memory::deallocate<Data*>(ptrs_, capacity_);
+         Memory::deallocate<Data*>(ptrs_, capacity_, policy_);
          ptrs_ = newPtr;
          capacity_ = 2*capacity_;
          // size_ is unchanged
@@ -374,6 +448,25 @@ namespace Util
    inline int GStack<Data>::size() const
    {  return size_; }
 
+   /*
+   * Set the memory policy used for subsequent allocation.
+   */
+   template <typename Data>
+   void GStack<Data>::setMemoryPolicy(MemoryPolicy const & policy)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot change memory policy of an allocated GStack");
+      }
+      policy_ = policy;
+   }
+
+   /*
+   * Return the memory policy.
+   */
+   template <typename Data>
+   inline MemoryPolicy const & GStack<Data>::memoryPolicy() const
+   {  return policy_; }
+
    /*
    * Is this GStack allocated?
    */
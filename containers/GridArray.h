@@ -9,6 +9,7 @@
 */
 
 #include <util/misc/Memory.h>
+#include <util/space/SpaceFillingCurve.h>
 #include <util/global.h>
 
 namespace Util
@@ -22,6 +23,16 @@ namespace Util
    * a one-dimensional rank, and the () operator is overloaded to return an
    * element indexed by an IntVector of grid coordinates.
    *
+   * By default, elements are stored in row-major (C array) order, in
+   * which the last coordinate varies most rapidly. Alternatively, a
+   * Morton or Hilbert space filling curve order may be selected with
+   * setLayout() before allocation, so that grid points that are close
+   * in space are also close in memory. The rank of a grid point is
+   * always its index in the underlying C array, so rank() and position()
+   * depend on the layout, and code that computes ranks directly from
+   * dimensions assumes the default row-major layout. Serialization
+   * always uses row-major order, independent of layout.
+   *
    * \ingroup Array_Module
    */
    template <typename Data>
@@ -35,6 +46,13 @@ namespace Util
       */
       GridArray();
 
+      /**
+      * Constructor with a memory policy for subsequent allocation.
+      *
+      * \param policy  memory policy, e.g. MemoryPolicy::tagged(name)
+      */
+      explicit GridArray(MemoryPolicy const & policy);
+
       /**
       * Copy constructor.
       */
@@ -52,6 +70,25 @@ namespace Util
       */
       GridArray<Data>& operator = (GridArray<Data> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move constructor.
+      *
+      * Takes ownership of the memory of the other GridArray, which is
+      * left unallocated.
+      */
+      GridArray(GridArray<Data>&& other);
+
+      /**
+      * Move assignment.
+      *
+      * Deallocates this GridArray, if allocated, and takes ownership of
+      * the memory of the other GridArray, which is left unallocated.
+      * Dimensions need not match.
+      */
+      GridArray<Data>& operator = (GridArray<Data>&& other);
+      #endif
+
       // Initialization
 
       /**
@@ -61,6 +98,43 @@ namespace Util
       */
       void allocate(IntVector const & dimensions);
 
+      /**
+      * Allocate memory for a matrix with a specified memory policy.
+      *
+      * \param dimensions IntVector containing dimensions
+      * \param policy  alignment, page and placement policy
+      */
+      void allocate(IntVector const & dimensions, 
+                    MemoryPolicy const & policy);
+
+      /**
+      * Set the memory policy used for subsequent allocation.
+      *
+      * \throw Exception if the GridArray is already allocated.
+      *
+      * \param policy  alignment, page and placement policy
+      */
+      void setMemoryPolicy(MemoryPolicy const & policy);
+
+      /**
+      * Return the memory policy used to allocate this GridArray.
+      */
+      MemoryPolicy const & memoryPolicy() const;
+
+      /**
+      * Set the order in which elements are stored.
+      *
+      * \throw Exception if the GridArray is already allocated.
+      *
+      * \param layout  RowMajor (default), Morton or Hilbert
+      */
+      void setLayout(SpaceFillingCurve::Type layout);
+
+      /**
+      * Return the order in which elements are stored.
+      */
+      SpaceFillingCurve::Type layout() const;
+
       /**
       * Serialize a GridArray to/from an Archive.
       *
@@ -82,7 +156,7 @@ namespace Util
       *
       * \return IntVector containing number of elements in each direction.
       */
-      IntVector const & dimensions();
+      IntVector const & dimensions() const;
 
       /**
       * Get number of grid points along direction i.
@@ -192,6 +266,11 @@ namespace Util
       */
       Data* data();
 
+      /*
+      * Return const pointer to underlying 1D C-array.
+      */
+      Data const * data() const;
+
    private:
 
       /// Pointer to 1D C array of all elements.
@@ -206,6 +285,21 @@ namespace Util
       /// Total number of grid points
       int size_;
 
+      /// Memory policy used to allocate data_.
+      MemoryPolicy policy_;
+
+      /// Storage rank of each row-major rank (null if RowMajor).
+      int* curveRanks_;
+
+      /// Row-major rank of each storage rank (null if RowMajor).
+      int* rowMajorRanks_;
+
+      /// Order in which elements are stored.
+      SpaceFillingCurve::Type layout_;
+
+      /// Deallocate all memory.
+      void deallocateAll();
+
    };
 
    // Method definitions
@@ -218,7 +312,26 @@ namespace Util
     : data_(0),
       offsets_(),
       dimensions_(),
-      size_(0)
+      size_(0),
+      policy_(),
+      curveRanks_(0),
+      rowMajorRanks_(0),
+      layout_(SpaceFillingCurve::RowMajor)
+   {}
+
+   /*
+   * Constructor with a memory policy.
+   */
+   template <typename Data>
+   GridArray<Data>::GridArray(MemoryPolicy const & policy)
+    : data_(0),
+      offsets_(),
+      dimensions_(),
+      size_(0),
+      policy_(policy),
+      curveRanks_(0),
+      rowMajorRanks_(0),
+      layout_(SpaceFillingCurve::RowMajor)
    {}
 
    /*
@@ -228,11 +341,24 @@ namespace Util
    */
    template <typename Data>
    GridArray<Data>::~GridArray()
+   {  deallocateAll(); }
+
+   /*
+   * Deallocate data and curve order tables.
+   */
+   template <typename Data>
+   void GridArray<Data>::deallocateAll()
    {
       if (data_) {
-         Memory::deallocate<Data>(data_, size_);
-         size_ = 0;
+         Memory::deallocate<Data>(data_, size_, policy_);
+      }
+      if (curveRanks_) {
+         MemoryPolicy tables;
+         tables.setTag(policy_.tag());
+         Memory::deallocate<int>(curveRanks_, size_, tables);
+         Memory::deallocate<int>(rowMajorRanks_, size_, tables);
       }
+      size_ = 0;
    }
 
    /*
@@ -243,7 +369,11 @@ namespace Util
     : data_(0),
       offsets_(),
       dimensions_(),
-      size_(0)
+      size_(0),
+      policy_(other.policy_),
+      curveRanks_(0),
+      rowMajorRanks_(0),
+      layout_(other.layout_)
    {
       // Precondition
       if (other.data_ == 0) {
@@ -265,6 +395,58 @@ namespace Util
       }
    }
 
+   #ifdef UTIL_CXX11
+   /*
+   * Move constructor.
+   */
+   template <typename Data>
+   GridArray<Data>::GridArray(GridArray<Data>&& other)
+    : data_(other.data_),
+      offsets_(other.offsets_),
+      dimensions_(other.dimensions_),
+      size_(other.size_),
+      policy_(other.policy_),
+      curveRanks_(other.curveRanks_),
+      rowMajorRanks_(other.rowMajorRanks_),
+      layout_(other.layout_)
+   {
+      other.data_ = 0;
+      other.offsets_ = IntVector::Zero;
+      other.dimensions_ = IntVector::Zero;
+      other.size_ = 0;
+      other.curveRanks_ = 0;
+      other.rowMajorRanks_ = 0;
+   }
+
+   /*
+   * Move assignment.
+   */
+   template <typename Data>
+   GridArray<Data>& 
+   GridArray<Data>::operator= (GridArray<Data>&& other)
+   {
+      if (this == &other) {
+         return *this;
+      }
+      deallocateAll();
+      data_ = other.data_;
+      offsets_ = other.offsets_;
+      dimensions_ = other.dimensions_;
+      size_ = other.size_;
+      policy_ = other.policy_;
+      curveRanks_ = other.curveRanks_;
+      rowMajorRanks_ = other.rowMajorRanks_;
+      layout_ = other.layout_;
+      other.data_ = 0;
+      other.offsets_ = IntVector::Zero;
+      other.dimensions_ = IntVector::Zero;
+      other.size_ = 0;
+      other.curveRanks_ = 0;
+      other.rowMajorRanks_ = 0;
+      return *this;
+   }
+   #endif
+
    /*
    * Assignment.
    */
@@ -298,9 +480,17 @@ namespace Util
          UTIL_THROW("Unequal sizes");
       }
 
-      // Copy elements
-      for (int i = 0; i < size_; ++i) {
-         data_[i] = other.data_[i];
+      // Copy elements, by row-major rank if layouts differ
+      if (layout_ == other.layout_) {
+         for (int i = 0; i < size_; ++i) {
+            data_[i] = other.data_[i];
+         }
+      } else {
+         for (int i = 0; i < size_; ++i) {
+            int j = curveRanks_ ? curveRanks_[i] : i;
+            int k = other.curveRanks_ ? other.curveRanks_[i] : i;
+            data_[j] = other.data_[k];
+         }
       }
 
       return *this;
@@ -326,9 +516,67 @@ namespace Util
          offsets_[i-1] = offsets_[i]*dimensions_[i];
       }
       size_ = offsets_[0]*dimensions_[0];
-      Memory::allocate<Data>(data_, size_);
+      Memory::allocate<Data>(data_, size_, policy_);
+      if (layout_ != SpaceFillingCurve::RowMajor) {
+         // Curve order tables have the same tag as the data
+         MemoryPolicy tables;
+         tables.setTag(policy_.tag());
+         Memory::allocate<int>(curveRanks_, size_, tables);
+         Memory::allocate<int>(rowMajorRanks_, size_, tables);
+         SpaceFillingCurve::order(layout_, dimensions_, 
+                                  curveRanks_, rowMajorRanks_);
+      }
    }
 
+   /*
+   * Set dimensions and allocate memory with a specified memory policy.
+   */
+   template <typename Data>
+   void GridArray<Data>::allocate(IntVector const & dimensions,
+                                  MemoryPolicy const & policy)
+   {
+      setMemoryPolicy(policy);
+      allocate(dimensions);
+   }
+
+   /*
+   * Set the memory policy used for subsequent allocation.
+   */
+   template <typename Data>
+   void GridArray<Data>::setMemoryPolicy(MemoryPolicy const & policy)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot change memory policy of an allocated GridArray");
+      }
+      policy_ = policy;
+   }
+
+   /*
+   * Return the memory policy.
+   */
+   template <typename Data>
+   inline MemoryPolicy const & GridArray<Data>::memoryPolicy() const
+   {  return policy_; }
+
+   /*
+   * Set the order in which elements are stored.
+   */
+   template <typename Data>
+   void GridArray<Data>::setLayout(SpaceFillingCurve::Type layout)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("Cannot change layout of an allocated GridArray");
+      }
+      layout_ = layout;
+   }
+
+   /*
+   * Return the order in which elements are stored.
+   */
+   template <typename Data>
+   inline SpaceFillingCurve::Type GridArray<Data>::layout() const
+   {  return layout_; }
+
    /*
    * Serialize a GridArray to/from an Archive.
    */
@@ -346,8 +594,14 @@ namespace Util
             allocate(dimensions);
          }
       }
-      for (int i = 0; i < size_; ++i) {
-         ar & data_[i];
+      if (curveRanks_) {
+         for (int i = 0; i < size_; ++i) {
+            ar & data_[curveRanks_[i]];
+         }
+      } else {
+         for (int i = 0; i < size_; ++i) {
+            ar & data_[i];
+         }
       }
    }
 
@@ -355,7 +609,7 @@ namespace Util
    * Get IntVector of dimensions.
    */
    template <typename Data>
-   inline IntVector const & GridArray<Data>::dimensions()
+   inline IntVector const & GridArray<Data>::dimensions() const
    {  return dimensions_; }
 
    /*
@@ -389,12 +643,17 @@ namespace Util
       assert(position[i] >= 0);
       assert(position[i] < dimensions_[i]);
       result += position[i];
+      if (curveRanks_) {
+         result = curveRanks_[result];
+      }
       return result;
    }
    #else
    inline int GridArray<Data>::rank(IntVector const & position) const
    {
-      return (position[0]*offsets_[0] + position[1]*offsets_[1] + position[2]);
+      int result = position[0]*offsets_[0] + position[1]*offsets_[1] 
+                 + position[2];
+      return curveRanks_ ? curveRanks_[result] : result;
    }
    #endif
 
@@ -405,7 +664,7 @@ namespace Util
    IntVector GridArray<Data>::position(int rank) const
    {
       IntVector position;
-      int remainder = rank;
+      int remainder = rowMajorRanks_ ? rowMajorRanks_[rank] : rank;
 
       int i;
       for (i = 0; i < Dimension - 1; ++i) {
@@ -512,6 +771,13 @@ namespace Util
    inline Data * GridArray<Data>::data() 
    {  return data_;}
 
+   /*
+   * Return const pointer to underlying 1D C-array.
+   */
+   template <typename Data>
+   inline Data const * GridArray<Data>::data() const
+   {  return data_;}
+
    /*
    * Return true if the GridArray has been allocated, false otherwise.
    */
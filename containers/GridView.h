@@ -0,0 +1,254 @@
+#ifndef UTIL_GRID_VIEW_H
+#define UTIL_GRID_VIEW_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/ArrayView.h>
+#include <util/containers/GridArray.h>
+#include <util/archives/serialize.h>
+#include <util/space/IntVector.h>
+#include <util/space/Dimension.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Non-owning view of a Dimension-dimensional grid of elements.
+   *
+   * A GridView refers to the elements of a grid stored in row-major
+   * order, in which the last coordinate varies most rapidly. Any object
+   * with member functions data() and dimensions(), such as a GridArray
+   * or another GridView, can be used to construct a view of the whole
+   * grid. A GridArray must use the default SpaceFillingCurve::RowMajor
+   * layout, which is checked by the constructor. Use GridView<const
+   * Data> for read-only access.
+   *
+   * Grid coordinates and ranks are checked with UTIL_ASSERT, and so
+   * only if UTIL_DEBUG is defined.
+   *
+   * \ingroup Array_Module
+   */
+   template <typename Data>
+   class GridView
+   {
+
+   public:
+
+      /**
+      * Default constructor, creates a null view.
+      */
+      GridView()
+       : data_(0),
+         offsets_(IntVector::Zero),
+         dimensions_(IntVector::Zero),
+         size_(0)
+      {}
+
+      /**
+      * Construct a view of a C array.
+      *
+      * \param data  address of element at the origin
+      * \param dimensions  number of grid points in each direction
+      */
+      GridView(Data* data, IntVector const & dimensions)
+       : data_(data)
+      {  setDimensions(dimensions); }
+
+      /**
+      * Construct a view of all elements of a grid container.
+      *
+      * \throw Exception if grid is a GridArray with a layout other
+      *        than SpaceFillingCurve::RowMajor.
+      *
+      * \param grid  object with data() and dimensions() members
+      */
+      template <class Container>
+      GridView(Container& grid)
+       : data_(grid.data())
+      {
+         checkLayout(grid);
+         setDimensions(grid.dimensions());
+      }
+
+      /**
+      * Return a reference to the element with a specified 1D rank.
+      *
+      * \param rank  rank of grid point
+      */
+      Data& operator [] (int rank) const
+      {
+         UTIL_ASSERT(data_);
+         UTIL_ASSERT(rank >= 0);
+         UTIL_ASSERT(rank < size_);
+         return data_[rank];
+      }
+
+      /**
+      * Return a reference to the element at a grid position.
+      *
+      * \param position  grid coordinates
+      */
+      Data& operator () (IntVector const & position) const
+      {  return data_[rank(position)]; }
+
+      /**
+      * Return the 1D rank of a grid position.
+      *
+      * \param position  grid coordinates
+      */
+      int rank(IntVector const & position) const
+      {
+         int result = 0;
+         for (int i = 0; i < Dimension; ++i) {
+            UTIL_ASSERT(position[i] >= 0);
+            UTIL_ASSERT(position[i] < dimensions_[i]);
+            result += position[i]*offsets_[i];
+         }
+         return result;
+      }
+
+      /**
+      * Return the grid position of a 1D rank.
+      *
+      * \param rank  rank of grid point
+      */
+      IntVector position(int rank) const
+      {
+         UTIL_ASSERT(rank >= 0);
+         UTIL_ASSERT(rank < size_);
+         IntVector position;
+         int remainder = rank;
+         for (int i = 0; i < Dimension - 1; ++i) {
+            position[i] = remainder/offsets_[i];
+            remainder -= position[i]*offsets_[i];
+         }
+         position[Dimension - 1] = remainder;
+         return position;
+      }
+
+      /**
+      * Return a contiguous view of the line of grid points along the
+      * last direction, through a specified position.
+      *
+      * \param position  grid coordinates; the last component is ignored
+      */
+      ArrayView<Data> line(IntVector const & position) const
+      {
+         IntVector start(position);
+         start[Dimension - 1] = 0;
+         return ArrayView<Data>(data_ + rank(start),
+                                dimensions_[Dimension - 1]);
+      }
+
+      /**
+      * Return a view of all elements as a 1D array, in order of rank.
+      */
+      ArrayView<Data> array() const
+      {  return ArrayView<Data>(data_, size_); }
+
+      /**
+      * Return a pointer to the element at the origin.
+      */
+      Data* data() const
+      {  return data_; }
+
+      /**
+      * Return the number of grid points in each direction.
+      */
+      IntVector const & dimensions() const
+      {  return dimensions_; }
+
+      /**
+      * Return the number of grid points in direction i.
+      *
+      * \param i  direction index
+      */
+      int dimension(int i) const
+      {  return dimensions_[i]; }
+
+      /**
+      * Return the number of elements per increment in direction i.
+      *
+      * \param i  direction index
+      */
+      int offset(int i) const
+      {  return offsets_[i]; }
+
+      /**
+      * Return the total number of grid points.
+      */
+      int size() const
+      {  return size_; }
+
+      /**
+      * Is this a null view?
+      */
+      bool isNull() const
+      {  return (data_ == 0); }
+
+      /**
+      * Serialize elements to/from an archive.
+      *
+      * Saves the dimensions followed by the elements in order of rank.
+      * When loading, the dimensions must equal those of this view.
+      *
+      * \param ar       archive
+      * \param version  archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version)
+      {
+         IntVector dimensions = dimensions_;
+         ar & dimensions;
+         if (dimensions != dimensions_) {
+            UTIL_THROW("Inconsistent GridView dimensions");
+         }
+         serializeArray(ar, data_, size_, version);
+      }
+
+   private:
+
+      /// Check layout of a container other than a GridArray (no-op).
+      template <class Container>
+      static void checkLayout(Container const & grid)
+      {}
+
+      /// Check that a GridArray uses the row-major layout.
+      template <typename T>
+      static void checkLayout(GridArray<T> const & grid)
+      {  UTIL_CHECK(grid.layout() == SpaceFillingCurve::RowMajor); }
+
+      /// Pointer to element at the origin.
+      Data* data_;
+
+      /// Number of elements per increment in each direction.
+      IntVector offsets_;
+
+      /// Number of grid points in each direction.
+      IntVector dimensions_;
+
+      /// Total number of grid points.
+      int size_;
+
+      /// Set dimensions, offsets and size.
+      void setDimensions(IntVector const & dimensions)
+      {
+         dimensions_ = dimensions;
+         offsets_[Dimension - 1] = 1;
+         for (int i = Dimension - 1; i > 0; --i) {
+            UTIL_ASSERT(dimensions[i] >= 0);
+            offsets_[i-1] = offsets_[i]*dimensions[i];
+         }
+         size_ = offsets_[0]*dimensions[0];
+      }
+
+   };
+
+}
+#endif
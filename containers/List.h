@@ -10,7 +10,9 @@
 
 #include <util/containers/Node.h>
 #include <util/containers/ListIterator.h>
+#include <util/misc/Bit.h>
 #include <util/global.h>
+#include <stdint.h>
 
 class ListTest;
 
@@ -26,6 +28,17 @@ namespace Util
    * objects.  This array may be used by several List objects, and so must be
    * allocated outside the Link class and provided via the initialize method.
    *
+   * The insert() method keeps nodes in order of increasing address. By 
+   * default, it finds the preceding node of the same list by walking 
+   * backwards through the node array, at a cost proportional to the 
+   * distance in the array, which can be large for sparse lists. If an
+   * occupancy index is provided by setIndex(), the list also maintains
+   * a two-level bitmap of the array indices of its nodes, and insert()
+   * and remove() find neighboring nodes by searching this bitmap for
+   * the previous or next set bit, at a cost of O(1 + capacity/4096) 
+   * word operations. The index must be set while the list is empty.
+   * ListArray::setIndexed() provides indices for all of its lists.
+   *
    * \ingroup List_Module
    */
    template <typename Data>
@@ -50,6 +63,40 @@ namespace Util
       */
       void initialize(Node<Data>* nodes, int capacity);
 
+      /**
+      * Provide storage for an occupancy index, and enable its use.
+      *
+      * The bits array must have at least nIndexWord(capacity) words, and
+      * the summary array at least nSummaryWord(capacity) words. Both are
+      * cleared by this function, and are owned by the caller. Passing 
+      * null pointers disables the index.
+      *
+      * \throw Exception if this list is not empty.
+      *
+      * \param bits  bitmap with one bit per node of the array
+      * \param summary  bitmap with one bit per nonzero word of bits
+      */
+      void setIndex(uint64_t* bits, uint64_t* summary);
+
+      /**
+      * Does this list maintain an occupancy index?
+      */
+      bool isIndexed() const;
+
+      /**
+      * Return number of 64-bit words in the bitmap for a node array.
+      *
+      * \param capacity  number of nodes in the array
+      */
+      static int nIndexWord(int capacity);
+
+      /**
+      * Return number of 64-bit words in the summary bitmap.
+      *
+      * \param capacity  number of nodes in the array
+      */
+      static int nSummaryWord(int capacity);
+
       /**
       * Get the number of elements.
       *
@@ -159,6 +206,32 @@ namespace Util
       /// Number of elements currently in this linked list.
       int size_;
 
+      /// Occupancy bitmap, one bit per node of array (null if not indexed).
+      uint64_t* bits_;
+
+      /// Summary bitmap, one bit per nonzero word of bits_.
+      uint64_t* summary_;
+
+      /**
+      * Set the index bit for a node that has been added to this list.
+      */
+      void mark(Node<Data>& node);
+
+      /**
+      * Clear the index bit for a node that is being removed.
+      */
+      void unmark(Node<Data>& node);
+
+      /**
+      * Return array index of highest indexed node below id, or -1.
+      */
+      int findPrev(int id) const;
+
+      /**
+      * Return array index of lowest indexed node above id, or -1.
+      */
+      int findNext(int id) const;
+
       /**
       * Set List to empty state.
       */
@@ -196,7 +269,9 @@ namespace Util
       lower_(0),
       upper_(0),
       capacity_(0),
-      size_(0)
+      size_(0),
+      bits_(0),
+      summary_(0)
    {}
 
    /*
@@ -207,9 +282,58 @@ namespace Util
    {
       nodes_    = nodes;
       capacity_ = capacity;
+      bits_     = 0;
+      summary_  = 0;
       setEmpty();
    }
 
+   /*
+   * Provide storage for an occupancy index.
+   */
+   template <typename Data>
+   void List<Data>::setIndex(uint64_t* bits, uint64_t* summary)
+   {
+      if (size_ != 0) {
+         UTIL_THROW("Cannot set index of a non-empty List");
+      }
+      if ((bits == 0) != (summary == 0)) {
+         UTIL_THROW("Index bits and summary must both be null or non-null");
+      }
+      bits_ = bits;
+      summary_ = summary;
+      if (bits_) {
+         int nWord = nIndexWord(capacity_);
+         for (int k = 0; k < nWord; ++k) {
+            bits_[k] = 0;
+         }
+         int nSummary = nSummaryWord(capacity_);
+         for (int k = 0; k < nSummary; ++k) {
+            summary_[k] = 0;
+         }
+      }
+   }
+
+   /*
+   * Does this list maintain an occupancy index?
+   */
+   template <typename Data>
+   inline bool List<Data>::isIndexed() const
+   {  return (bits_ != 0); }
+
+   /*
+   * Number of words in bitmap.
+   */
+   template <typename Data>
+   inline int List<Data>::nIndexWord(int capacity)
+   {  return (capacity + 63)/64; }
+
+   /*
+   * Number of words in summary bitmap.
+   */
+   template <typename Data>
+   inline int List<Data>::nSummaryWord(int capacity)
+   {  return (nIndexWord(capacity) + 63)/64; }
+
    /*
    * Get number of elements in list.
    */
@@ -242,6 +366,7 @@ namespace Util
       back_ = &node;
       node.setNext(0);
       ++size_;
+      mark(node);
    }
 
    /*
@@ -264,6 +389,7 @@ namespace Util
          ++size_;
       }
       node.setPrev(0);
+      mark(node);
    }
 
    /*
@@ -278,6 +404,7 @@ namespace Util
       assert(back_  != 0);
       assert(front_ != 0);
       Node<Data>& oldBack = *back_;
+      unmark(oldBack);
       if (back_ == front_) {
          back_->clear();
          setEmpty();
@@ -303,6 +430,7 @@ namespace Util
       assert(front_ != 0);
       assert(back_  != 0);
       Node<Data>& oldFront = *front_;
+      unmark(oldFront);
       if (front_ == back_) {
          front_->clear();
          setEmpty();
@@ -331,6 +459,7 @@ namespace Util
       previous.attachNext(newNode);
       expandBounds(newNode);
       ++size_;
+      mark(newNode);
    }
 
    /*
@@ -348,6 +477,7 @@ namespace Util
       next.attachPrev(newNode);
       expandBounds(newNode);
       ++size_;
+      mark(newNode);
    }
 
    /*
@@ -357,6 +487,7 @@ namespace Util
    void List<Data>::remove(Node<Data>& node)
    {
       assert( &node.list() == this );
+      unmark(node);
       if (&node == back_) {
          if (back_ == front_) {
             back_->clear();
@@ -400,6 +531,7 @@ namespace Util
          lower_ = &node;
          upper_ = &node;
          size_  = 1;
+         mark(node);
          return;
       }
 
@@ -422,11 +554,17 @@ namespace Util
          lower_ = &node;
       } else // If between lowest and highest addresses
       {
-         current = &node;
-         do {
-            assert(current > lower_);
-            --current;
-         } while (&current->list() != this);
+         if (bits_) {
+            int id = findPrev(int(&node - nodes_));
+            assert(id >= 0);
+            current = nodes_ + id;
+         } else {
+            current = &node;
+            do {
+               assert(current > lower_);
+               --current;
+            } while (&current->list() != this);
+         }
          target = current->next();
          current->attachNext(node);
       }
@@ -440,6 +578,7 @@ namespace Util
       }
 
       ++size_;
+      mark(node);
    }
 
    /*
@@ -524,6 +663,30 @@ namespace Util
             return false;
          }
 
+         // Check consistency of occupancy index
+         if (bits_) {
+            int nSet = 0;
+            int nWord = nIndexWord(capacity_);
+            for (int k = 0; k < nWord; ++k) {
+               nSet += bitCount(bits_[k]);
+               bool isSet = (summary_[k >> 6] >> (k & 63)) & 1;
+               if (isSet != (bits_[k] != 0)) {
+                  UTIL_THROW("List<Data>::isValid: Inconsistent summary.");
+               }
+            }
+            if (nSet != size_) {
+               UTIL_THROW("List<Data>::isValid: # index bits != size_.");
+            }
+            node = front_;
+            while (node) {
+               int id = int(node - nodes_);
+               if (!((bits_[id >> 6] >> (id & 63)) & 1)) {
+                  UTIL_THROW("List<Data>::isValid: Node missing in index.");
+               }
+               node = node->next();
+            }
+         }
+
       }
       // If no errors were detected to this point, the list is valid.
       return true;
@@ -568,6 +731,16 @@ namespace Util
    template <typename Data>
    void List<Data>::contractBounds(Node<Data>& node)
    {
+      if (bits_) {
+         int id = int(&node - nodes_);
+         if (&node == upper_) {
+            upper_ = nodes_ + findPrev(id);
+         }
+         if (&node == lower_) {
+            lower_ = nodes_ + findNext(id);
+         }
+         return;
+      }
       if (&node == upper_) {
          do {
             --upper_;
@@ -580,5 +753,85 @@ namespace Util
       }
    }
 
+   /*
+   * Set the index bit for a node.
+   */
+   template <typename Data>
+   inline void List<Data>::mark(Node<Data>& node)
+   {
+      if (bits_) {
+         int id = int(&node - nodes_);
+         int k = id >> 6;
+         bits_[k] |= uint64_t(1) << (id & 63);
+         summary_[k >> 6] |= uint64_t(1) << (k & 63);
+      }
+   }
+
+   /*
+   * Clear the index bit for a node.
+   */
+   template <typename Data>
+   inline void List<Data>::unmark(Node<Data>& node)
+   {
+      if (bits_) {
+         int id = int(&node - nodes_);
+         int k = id >> 6;
+         bits_[k] &= ~(uint64_t(1) << (id & 63));
+         if (bits_[k] == 0) {
+            summary_[k >> 6] &= ~(uint64_t(1) << (k & 63));
+         }
+      }
+   }
+
+   /*
+   * Return array index of highest indexed node below id, or -1.
+   */
+   template <typename Data>
+   int List<Data>::findPrev(int id) const
+   {
+      assert(bits_);
+      int k = id >> 6;
+      uint64_t word = bits_[k] & ((uint64_t(1) << (id & 63)) - 1);
+      if (word) {
+         return 64*k + highestBit(word);
+      }
+      int s = k >> 6;
+      uint64_t summary = summary_[s] & ((uint64_t(1) << (k & 63)) - 1);
+      while (summary == 0) {
+         if (s == 0) return -1;
+         --s;
+         summary = summary_[s];
+      }
+      k = 64*s + highestBit(summary);
+      return 64*k + highestBit(bits_[k]);
+   }
+
+   /*
+   * Return array index of lowest indexed node above id, or -1.
+   */
+   template <typename Data>
+   int List<Data>::findNext(int id) const
+   {
+      assert(bits_);
+      int k = id >> 6;
+      int b = id & 63;
+      uint64_t word = (b == 63) ? 0 : bits_[k] & (~uint64_t(0) << (b + 1));
+      if (word) {
+         return 64*k + lowestBit(word);
+      }
+      int s = k >> 6;
+      int c = k & 63;
+      int nSummary = nSummaryWord(capacity_);
+      uint64_t summary = (c == 63) ? 
+                         0 : summary_[s] & (~uint64_t(0) << (c + 1));
+      while (summary == 0) {
+         ++s;
+         if (s >= nSummary) return -1;
+         summary = summary_[s];
+      }
+      k = 64*s + lowestBit(summary);
+      return 64*k + lowestBit(bits_[k]);
+   }
+
 } 
 #endif
@@ -24,6 +24,11 @@ namespace Util
    * to some or all of its via one or more associated List objects. Each element 
    * of the array may be part of at most one List.
    *
+   * If setIndexed(true) is called before allocation, each List maintains
+   * an occupancy bitmap of its nodes, so that List::insert() keeps nodes
+   * in address order at bounded cost, even for sparse lists. The bitmaps
+   * require about nList*capacity/8 bytes.
+   *
    * \ingroup List_Module
    */
    template <typename Data>
@@ -51,6 +56,34 @@ namespace Util
       * \param nList    size of array of List<Data> linked list objects
       */
       void allocate(int capacity, int nList);
+
+      /**
+      * Allocate arrays of Node and List objects with a memory policy.
+      *
+      * \param capacity size of array Node<Data> objects
+      * \param nList    size of array of List<Data> linked list objects
+      * \param policy   alignment, page, placement or arena policy
+      */
+      void allocate(int capacity, int nList, MemoryPolicy const & policy);
+
+      /**
+      * Enable or disable occupancy indices for all lists.
+      *
+      * \throw Exception if the ListArray is already allocated.
+      *
+      * \param isIndexed  true to allocate an index for each List
+      */
+      void setIndexed(bool isIndexed);
+
+      /**
+      * Do lists of this ListArray maintain occupancy indices?
+      */
+      bool isIndexed() const;
+
+      /**
+      * Return the memory policy used to allocate this ListArray.
+      */
+      MemoryPolicy const & memoryPolicy() const;
    
       /**
       * Get the number of associated linked lists.
@@ -137,6 +170,18 @@ namespace Util
    
       // Number of lists.
       int         nList_;
+
+      // C array of occupancy bitmaps for all lists (or null)
+      uint64_t *index_;
+
+      // Number of words in index_ array
+      int         nIndexWord_;
+
+      // Are lists indexed?
+      bool        isIndexed_;
+
+      // Memory policy used to allocate nodes_ and lists_.
+      MemoryPolicy policy_;
    
    }; 
 
@@ -149,7 +194,11 @@ namespace Util
     : nodes_(0),    
       lists_(0),
       capacity_(0),
-      nList_(0)
+      nList_(0),
+      index_(0),
+      nIndexWord_(0),
+      isIndexed_(false),
+      policy_()
    {}
 
    /* 
@@ -161,10 +210,13 @@ namespace Util
    ListArray<Data>::~ListArray()
    {
       if (nodes_) {
-         Memory::deallocate< Node<Data> >(nodes_, capacity_);
+         Memory::deallocate< Node<Data> >(nodes_, capacity_, policy_);
       }
       if (lists_) {
-         Memory::deallocate< List<Data> >(lists_, nList_);
+         Memory::deallocate< List<Data> >(lists_, nList_, policy_);
+      }
+      if (index_) {
+         Memory::deallocate<uint64_t>(index_, nIndexWord_, policy_);
       }
    }
  
@@ -182,16 +234,69 @@ namespace Util
       nList_    = nList;
 
       // Allocate array of nodes
-      Memory::allocate< Node<Data> >(nodes_, capacity_);
+      Memory::allocate< Node<Data> >(nodes_, capacity_, policy_);
 
       // Allocate and initialize array of lists
-      Memory::allocate< List<Data> >(lists_, nList_);
+      Memory::allocate< List<Data> >(lists_, nList_, policy_);
       for (i=0; i < nList_; ++i) {
          lists_[i].initialize(nodes_, capacity_);
       }
 
+      // Allocate and assign occupancy indices, if requested
+      if (isIndexed_) {
+         int nWord = List<Data>::nIndexWord(capacity_);
+         int nSummary = List<Data>::nSummaryWord(capacity_);
+         nIndexWord_ = nList_*(nWord + nSummary);
+         Memory::allocate<uint64_t>(index_, nIndexWord_, policy_);
+         uint64_t* ptr = index_;
+         for (i=0; i < nList_; ++i) {
+            lists_[i].setIndex(ptr, ptr + nWord);
+            ptr += nWord + nSummary;
+         }
+      }
+
    }
 
+   /* 
+   * Allocate arrays with a specified memory policy.
+   */
+   template <typename Data>
+   void ListArray<Data>::allocate(int capacity, int nList, 
+                                  MemoryPolicy const & policy)
+   {
+      if (nodes_) {
+         UTIL_THROW("Attempt to re-allocate a ListArray");
+      }
+      policy_ = policy;
+      allocate(capacity, nList);
+   }
+
+   /* 
+   * Enable or disable occupancy indices.
+   */
+   template <typename Data>
+   void ListArray<Data>::setIndexed(bool isIndexed)
+   {
+      if (nodes_) {
+         UTIL_THROW("Cannot change indexing of an allocated ListArray");
+      }
+      isIndexed_ = isIndexed;
+   }
+
+   /* 
+   * Do lists maintain occupancy indices?
+   */
+   template <typename Data>
+   inline bool ListArray<Data>::isIndexed() const
+   {  return isIndexed_; }
+
+   /* 
+   * Return the memory policy.
+   */
+   template <typename Data>
+   inline MemoryPolicy const & ListArray<Data>::memoryPolicy() const
+   {  return policy_; }
+
    /* 
    * Get the number of associated linked lists.
    *
@@ -0,0 +1,221 @@
+#ifndef UTIL_MATRIX_VIEW_H
+#define UTIL_MATRIX_VIEW_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/ArrayView.h>
+#include <util/archives/serialize.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Non-owning view of a 2D array with a row stride.
+   *
+   * A MatrixView refers to a capacity1() x capacity2() block of a
+   * row-major 2D array in which the start of successive rows are
+   * separated by stride() elements, with stride() >= capacity2().
+   * Any object with member functions cArray(), capacity1() and
+   * capacity2(), such as a Matrix, DMatrix or FMatrix, can be used to
+   * construct a view of all its elements. Sub-blocks and single rows
+   * are obtained from block() and row(). Use MatrixView<const Data>
+   * for read-only access.
+   *
+   * As for ArrayView, indices are checked with UTIL_ASSERT, and so
+   * only if UTIL_DEBUG is defined.
+   *
+   * \ingroup Matrix_Module
+   */
+   template <typename Data>
+   class MatrixView
+   {
+
+   public:
+
+      /**
+      * Default constructor, creates a null view.
+      */
+      MatrixView()
+       : data_(0),
+         capacity1_(0),
+         capacity2_(0),
+         stride_(0)
+      {}
+
+      /**
+      * Construct a view of a strided C array.
+      *
+      * \param data  address of element (0,0)
+      * \param capacity1  number of rows
+      * \param capacity2  number of columns
+      * \param stride  distance between rows (>= capacity2)
+      */
+      MatrixView(Data* data, int capacity1, int capacity2, int stride)
+       : data_(data),
+         capacity1_(capacity1),
+         capacity2_(capacity2),
+         stride_(stride)
+      {
+         UTIL_ASSERT(capacity1 >= 0);
+         UTIL_ASSERT(capacity2 >= 0);
+         UTIL_ASSERT(stride >= capacity2);
+      }
+
+      /**
+      * Construct a view of all elements of a matrix container.
+      *
+      * If the container is itself a MatrixView, possibly of non-const
+      * Data, its stride is preserved.
+      *
+      * \param matrix  object with cArray(), capacity1(), capacity2()
+      */
+      template <class Container>
+      MatrixView(Container& matrix)
+       : data_(matrix.cArray()),
+         capacity1_(matrix.capacity1()),
+         capacity2_(matrix.capacity2()),
+         stride_(strideOf(matrix))
+      {}
+
+      /**
+      * Return a view of a rectangular sub-block.
+      *
+      * \param i  row index of first element of block
+      * \param j  column index of first element of block
+      * \param m  number of rows in block
+      * \param n  number of columns in block
+      */
+      MatrixView<Data> block(int i, int j, int m, int n) const
+      {
+         UTIL_ASSERT(i >= 0 && m >= 0 && i + m <= capacity1_);
+         UTIL_ASSERT(j >= 0 && n >= 0 && j + n <= capacity2_);
+         return MatrixView<Data>(data_ + i*stride_ + j, m, n, stride_);
+      }
+
+      /**
+      * Return a view of row i.
+      *
+      * \param i  row index
+      */
+      ArrayView<Data> row(int i) const
+      {
+         UTIL_ASSERT(i >= 0);
+         UTIL_ASSERT(i < capacity1_);
+         return ArrayView<Data>(data_ + i*stride_, capacity2_);
+      }
+
+      /**
+      * Return a reference to element (i, j).
+      *
+      * \param i  row index
+      * \param j  column index
+      */
+      Data& operator () (int i, int j) const
+      {
+         UTIL_ASSERT(data_);
+         UTIL_ASSERT(i >= 0);
+         UTIL_ASSERT(i < capacity1_);
+         UTIL_ASSERT(j >= 0);
+         UTIL_ASSERT(j < capacity2_);
+         return data_[i*stride_ + j];
+      }
+
+      /**
+      * Return a pointer to element (0, 0).
+      */
+      Data* cArray() const
+      {  return data_; }
+
+      /**
+      * Return number of rows.
+      */
+      int capacity1() const
+      {  return capacity1_; }
+
+      /**
+      * Return number of columns.
+      */
+      int capacity2() const
+      {  return capacity2_; }
+
+      /**
+      * Return distance between the starts of successive rows.
+      */
+      int stride() const
+      {  return stride_; }
+
+      /**
+      * Are all elements stored in one contiguous block?
+      */
+      bool isContiguous() const
+      {  return (stride_ == capacity2_ || capacity1_ <= 1); }
+
+      /**
+      * Is this a null view?
+      */
+      bool isNull() const
+      {  return (data_ == 0); }
+
+      /**
+      * Serialize elements to/from an archive.
+      *
+      * Saves both dimensions, followed by the elements in row-major
+      * order. When loading, the dimensions must equal those of this
+      * view.
+      *
+      * \param ar       archive
+      * \param version  archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version)
+      {
+         int capacity1 = capacity1_;
+         int capacity2 = capacity2_;
+         ar & capacity1;
+         ar & capacity2;
+         if (capacity1 != capacity1_ || capacity2 != capacity2_) {
+            UTIL_THROW("Inconsistent MatrixView dimensions");
+         }
+         if (isContiguous()) {
+            serializeArray(ar, data_, capacity1_*capacity2_, version);
+         } else {
+            for (int i = 0; i < capacity1_; ++i) {
+               serializeArray(ar, data_ + i*stride_, capacity2_, version);
+            }
+         }
+      }
+
+   private:
+
+      /// Pointer to element (0, 0).
+      Data* data_;
+
+      /// Number of rows.
+      int capacity1_;
+
+      /// Number of columns.
+      int capacity2_;
+
+      /// Distance between starts of successive rows.
+      int stride_;
+
+      /// Return the row stride of a contiguous matrix container.
+      template <class Container>
+      static int strideOf(Container const & matrix)
+      {  return matrix.capacity2(); }
+
+      /// Return the row stride of another view.
+      template <typename Other>
+      static int strideOf(MatrixView<Other> const & view)
+      {  return view.stride(); }
+
+   };
+
+}
+#endif
@@ -0,0 +1,500 @@
+#ifndef UTIL_MPMC_RING_BUFFER_H
+#define UTIL_MPMC_RING_BUFFER_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#ifdef UTIL_CXX11
+
+#include <util/containers/BackPressure.h>
+#include <util/misc/Memory.h>
+#include <util/global.h>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <stddef.h>
+
+namespace Util
+{
+
+   /**
+   * Bounded lock-free queue for many producer and consumer threads.
+   *
+   * An MpmcRingBuffer is a bounded first-in first-out queue that may
+   * be used concurrently by any number of producer threads, which call
+   * push(), and consumer threads, which call pop(), tryPop() or drain().
+   * It is typically used to distribute snapshots produced by a
+   * simulation thread among several analysis workers. Each worker may
+   * call drain() to pass every value it receives to the sample()
+   * function of its own accumulator until the queue is closed.
+   *
+   * The implementation is the bounded queue of D. Vyukov: each slot
+   * carries a sequence number that tells producers and consumers
+   * whether it is free or full, so that a push or pop only requires
+   * one compare-and-swap on the shared producer or consumer index.
+   * The two indices are stored on separate cache lines, and slots are
+   * cache-line aligned. The batch push and pop functions are loops
+   * over the single-value operations. When the queue is full, push()
+   * either waits or fails, according to the BackPressure policy set
+   * by allocate().
+   *
+   * This class requires C++11, and is only defined when UTIL_CXX11 is
+   * defined. Use an SpscRingBuffer for a single producer and single
+   * consumer, since it requires no atomic read-modify-write operations.
+   *
+   * \ingroup Array_Module
+   */
+   template <typename Data>
+   class MpmcRingBuffer
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      MpmcRingBuffer();
+
+      /**
+      * Destructor.
+      */
+      ~MpmcRingBuffer();
+
+      /**
+      * Allocate an empty buffer.
+      *
+      * \param capacity  minimum number of elements (rounded up to 2^n)
+      * \param policy  action taken by push() on a full buffer
+      */
+      void allocate(int capacity,
+                    BackPressure::Type policy = BackPressure::Block);
+
+      /**
+      * Add a copy of a value.
+      *
+      * \param value  value to be added
+      * \return true if added, false if rejected or closed
+      */
+      bool push(Data const & value);
+
+      /**
+      * Move a value into the buffer.
+      *
+      * \param value  value to be moved
+      * \return true if added, false if rejected or closed
+      */
+      bool push(Data&& value);
+
+      /**
+      * Add copies of n values.
+      *
+      * Values pushed by one call may be interleaved with values pushed
+      * concurrently by other producers.
+      *
+      * \param values  array of values
+      * \param n  number of values
+      * \return number of values added
+      */
+      int push(Data const * values, int n);
+
+      /**
+      * Close the buffer: no further values will be pushed.
+      *
+      * Values already in the buffer may still be popped. Producers
+      * should stop pushing before close() is called, since a value
+      * pushed concurrently with close() may never be popped.
+      */
+      void close();
+
+      /**
+      * Remove the oldest value, waiting until one is available.
+      *
+      * \param value  on return, the removed value
+      * \return true if a value was removed, false if closed and empty
+      */
+      bool pop(Data& value);
+
+      /**
+      * Remove the oldest value, if one is available, without waiting.
+      *
+      * \param value  on return, the removed value
+      * \return true if a value was removed, false otherwise
+      */
+      bool tryPop(Data& value);
+
+      /**
+      * Remove up to n values, waiting until at least one is available.
+      *
+      * \param values  array of at least n elements (output)
+      * \param n  maximum number of values
+      * \return number of values removed, zero if closed and empty
+      */
+      int pop(Data* values, int n);
+
+      /**
+      * Pop values and pass each to sampler.sample(), until closed.
+      *
+      * \param sampler  object with a sample(Data const &) function
+      * \return number of values sampled by this thread
+      */
+      template <class Sampler>
+      long drain(Sampler& sampler);
+
+      /**
+      * Return approximate number of values in the buffer.
+      */
+      int size() const;
+
+      /**
+      * Return capacity of the buffer.
+      */
+      int capacity() const;
+
+      /**
+      * Has close() been called?
+      */
+      bool isClosed() const;
+
+      /**
+      * Has memory been allocated?
+      */
+      bool isAllocated() const;
+
+   private:
+
+      // Slot containing a value and its sequence number.
+      struct alignas(MemoryPolicy::CacheLineSize) Slot
+      {
+         std::atomic<size_t> sequence;
+         Data data;
+      };
+
+      // Cache-line padded index.
+      struct alignas(MemoryPolicy::CacheLineSize) Index
+      {
+         std::atomic<size_t> value;
+      };
+
+      /// Index of next slot to be claimed by a producer.
+      Index tail_;
+
+      /// Index of next slot to be claimed by a consumer.
+      Index head_;
+
+      /// Array of slots.
+      Slot* slots_;
+
+      /// Number of slots (a power of 2).
+      size_t capacity_;
+
+      /// capacity_ - 1.
+      size_t mask_;
+
+      /// Set true by close().
+      std::atomic<bool> isClosed_;
+
+      /// Action for push to a full buffer.
+      BackPressure::Type policy_;
+
+      /// Claim a free slot, or return 0 if full or closed.
+      Slot* claimFree();
+
+      /// Claim a full slot, or return 0 if empty; set pos.
+      Slot* claimFull(size_t& pos);
+
+      /// Claim a full slot, waiting until available or closed.
+      Slot* waitFull(size_t& pos);
+
+      /// Copy constructor, declared private to prohibit copying.
+      MpmcRingBuffer(MpmcRingBuffer<Data> const & other);
+
+      /// Assignment, declared private to prohibit assignment.
+      MpmcRingBuffer<Data>& operator = (MpmcRingBuffer<Data> const & other);
+
+   };
+
+   // Method definitions
+
+   /*
+   * Constructor.
+   */
+   template <typename Data>
+   MpmcRingBuffer<Data>::MpmcRingBuffer()
+    : slots_(0),
+      capacity_(0),
+      mask_(0),
+      isClosed_(false),
+      policy_(BackPressure::Block)
+   {
+      tail_.value.store(0);
+      head_.value.store(0);
+   }
+
+   /*
+   * Destructor.
+   */
+   template <typename Data>
+   MpmcRingBuffer<Data>::~MpmcRingBuffer()
+   {
+      if (slots_) {
+         Memory::deallocate<Slot>(slots_, capacity_,
+                                  MemoryPolicy::cacheLine());
+      }
+   }
+
+   /*
+   * Allocate an empty buffer.
+   */
+   template <typename Data>
+   void MpmcRingBuffer<Data>::allocate(int capacity,
+                                       BackPressure::Type policy)
+   {
+      if (slots_) {
+         UTIL_THROW("Attempt to re-allocate an MpmcRingBuffer");
+      }
+      if (capacity <= 0) {
+         UTIL_THROW("Attempt to allocate with capacity <= 0");
+      }
+      size_t n = 1;
+      while (n < (size_t)capacity) {
+         n *= 2;
+      }
+      Memory::allocate<Slot>(slots_, n, MemoryPolicy::cacheLine());
+      UTIL_CHECK((size_t)slots_ % MemoryPolicy::CacheLineSize == 0);
+      for (size_t i = 0; i < n; ++i) {
+         slots_[i].sequence.store(i, std::memory_order_relaxed);
+      }
+      capacity_ = n;
+      mask_ = n - 1;
+      policy_ = policy;
+   }
+
+   /*
+   * Claim a free slot for writing.
+   */
+   template <typename Data>
+   typename MpmcRingBuffer<Data>::Slot* MpmcRingBuffer<Data>::claimFree()
+   {
+      size_t pos = tail_.value.load(std::memory_order_relaxed);
+      for (;;) {
+         if (isClosed_.load(std::memory_order_relaxed)) return 0;
+         Slot* slot = &slots_[pos & mask_];
+         size_t seq = slot->sequence.load(std::memory_order_acquire);
+         ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)pos;
+         if (diff == 0) {
+            if (tail_.value.compare_exchange_weak(pos, pos + 1,
+                                          std::memory_order_relaxed)) {
+               return slot;
+            }
+         } else if (diff < 0) {
+            // Full
+            if (policy_ == BackPressure::Reject) return 0;
+            std::this_thread::yield();
+            pos = tail_.value.load(std::memory_order_relaxed);
+         } else {
+            pos = tail_.value.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   /*
+   * Add a copy of a value.
+   */
+   template <typename Data>
+   bool MpmcRingBuffer<Data>::push(Data const & value)
+   {
+      assert(slots_);
+      Slot* slot = claimFree();
+      if (!slot) return false;
+      size_t seq = slot->sequence.load(std::memory_order_relaxed);
+      slot->data = value;
+      slot->sequence.store(seq + 1, std::memory_order_release);
+      return true;
+   }
+
+   /*
+   * Move a value into the buffer.
+   */
+   template <typename Data>
+   bool MpmcRingBuffer<Data>::push(Data&& value)
+   {
+      assert(slots_);
+      Slot* slot = claimFree();
+      if (!slot) return false;
+      size_t seq = slot->sequence.load(std::memory_order_relaxed);
+      slot->data = std::move(value);
+      slot->sequence.store(seq + 1, std::memory_order_release);
+      return true;
+   }
+
+   /*
+   * Add copies of n values.
+   */
+   template <typename Data>
+   int MpmcRingBuffer<Data>::push(Data const * values, int n)
+   {
+      int count = 0;
+      while (count < n && push(values[count])) {
+         ++count;
+      }
+      return count;
+   }
+
+   /*
+   * Close the buffer.
+   */
+   template <typename Data>
+   void MpmcRingBuffer<Data>::close()
+   {  isClosed_.store(true, std::memory_order_release); }
+
+   /*
+   * Claim a full slot for reading, without waiting.
+   */
+   template <typename Data>
+   typename MpmcRingBuffer<Data>::Slot*
+   MpmcRingBuffer<Data>::claimFull(size_t& pos)
+   {
+      pos = head_.value.load(std::memory_order_relaxed);
+      for (;;) {
+         Slot* slot = &slots_[pos & mask_];
+         size_t seq = slot->sequence.load(std::memory_order_acquire);
+         ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+         if (diff == 0) {
+            if (head_.value.compare_exchange_weak(pos, pos + 1,
+                                          std::memory_order_relaxed)) {
+               return slot;
+            }
+         } else if (diff < 0) {
+            // Empty
+            return 0;
+         } else {
+            pos = head_.value.load(std::memory_order_relaxed);
+         }
+      }
+   }
+
+   /*
+   * Claim a full slot for reading, waiting until available or closed.
+   */
+   template <typename Data>
+   typename MpmcRingBuffer<Data>::Slot*
+   MpmcRingBuffer<Data>::waitFull(size_t& pos)
+   {
+      for (;;) {
+         // Read closed flag before looking for data, so that no value
+         // pushed before close() can be missed.
+         bool closed = isClosed_.load(std::memory_order_acquire);
+         Slot* slot = claimFull(pos);
+         if (slot) return slot;
+         if (closed) {
+            // A producer that claimed a slot before close() may not
+            // yet have published it. Finish only when none is pending.
+            size_t tail = tail_.value.load(std::memory_order_acquire);
+            size_t head = head_.value.load(std::memory_order_acquire);
+            if (tail == head) return 0;
+         }
+         std::this_thread::yield();
+      }
+   }
+
+   /*
+   * Remove the oldest value, waiting if necessary.
+   */
+   template <typename Data>
+   bool MpmcRingBuffer<Data>::pop(Data& value)
+   {
+      assert(slots_);
+      size_t pos;
+      Slot* slot = waitFull(pos);
+      if (!slot) return false;
+      value = std::move(slot->data);
+      slot->sequence.store(pos + capacity_, std::memory_order_release);
+      return true;
+   }
+
+   /*
+   * Remove the oldest value, without waiting.
+   */
+   template <typename Data>
+   bool MpmcRingBuffer<Data>::tryPop(Data& value)
+   {
+      assert(slots_);
+      size_t pos;
+      Slot* slot = claimFull(pos);
+      if (!slot) return false;
+      value = std::move(slot->data);
+      slot->sequence.store(pos + capacity_, std::memory_order_release);
+      return true;
+   }
+
+   /*
+   * Remove up to n values.
+   */
+   template <typename Data>
+   int MpmcRingBuffer<Data>::pop(Data* values, int n)
+   {
+      if (n <= 0) return 0;
+      if (!pop(values[0])) return 0;
+      int count = 1;
+      while (count < n && tryPop(values[count])) {
+         ++count;
+      }
+      return count;
+   }
+
+   /*
+   * Sample values until the buffer is closed and empty.
+   */
+   template <typename Data>
+   template <class Sampler>
+   long MpmcRingBuffer<Data>::drain(Sampler& sampler)
+   {
+      Data value;
+      long count = 0;
+      while (pop(value)) {
+         sampler.sample(value);
+         ++count;
+      }
+      return count;
+   }
+
+   /*
+   * Return approximate number of values.
+   */
+   template <typename Data>
+   inline int MpmcRingBuffer<Data>::size() const
+   {
+      size_t tail = tail_.value.load(std::memory_order_acquire);
+      size_t head = head_.value.load(std::memory_order_acquire);
+      return (tail > head) ? (int)(tail - head) : 0;
+   }
+
+   /*
+   * Return capacity.
+   */
+   template <typename Data>
+   inline int MpmcRingBuffer<Data>::capacity() const
+   {  return (int)capacity_; }
+
+   /*
+   * Has close() been called?
+   */
+   template <typename Data>
+   inline bool MpmcRingBuffer<Data>::isClosed() const
+   {  return isClosed_.load(std::memory_order_acquire); }
+
+   /*
+   * Has memory been allocated?
+   */
+   template <typename Data>
+   inline bool MpmcRingBuffer<Data>::isAllocated() const
+   {  return (bool)slots_; }
+
+}
+#endif // UTIL_CXX11
+#endif
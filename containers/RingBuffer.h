@@ -62,6 +62,19 @@ namespace Util
       */
       void allocate(int capacity);
 
+      /**
+      * Allocate a new empty buffer with a specified memory policy.
+      *
+      * \param capacity number of elements to allocate.
+      * \param policy  alignment, page and placement policy
+      */
+      void allocate(int capacity, MemoryPolicy const & policy);
+
+      /**
+      * Return the memory policy used to allocate this RingBuffer.
+      */
+      MemoryPolicy const & memoryPolicy() const;
+
       /**
       * Set previously allocated buffer to empty state.
       */
@@ -160,6 +173,9 @@ namespace Util
       /// Integer array index of the most recently added value.
       int   last_;
 
+      /// Memory policy used to allocate data_.
+      MemoryPolicy policy_;
+
    };
 
    /*
@@ -170,7 +186,8 @@ namespace Util
     : data_(0),
       capacity_(0),
       size_(0),
-      last_(0)
+      last_(0),
+      policy_()
    {}
 
    /*
@@ -185,11 +202,12 @@ namespace Util
     : data_(0),
       capacity_(0),
       size_(0),
-      last_(0)
+      last_(0),
+      policy_(other.policy_)
    {
       if (other.capacity_ > 0) {
          assert(other.data_ != 0);
-         Memory::allocate<Data>(data_, other.capacity_);
+         Memory::allocate<Data>(data_, other.capacity_, policy_);
          capacity_ = other.capacity_;
          size_ = other.size_;
          last_ = other.last_;
@@ -220,7 +238,7 @@ namespace Util
 
          if (!isAllocated()) {
 
-            Memory::allocate<Data>(data_, other.capacity_);
+            Memory::allocate<Data>(data_, other.capacity_, policy_);
             capacity_ = other.capacity_;
 
          } else if (capacity_ != other.capacity_) {
@@ -248,7 +266,7 @@ namespace Util
    RingBuffer<Data>::~RingBuffer()
    {
       if (data_) {
-         Memory::deallocate<Data>(data_, capacity_);
+         Memory::deallocate<Data>(data_, capacity_, policy_);
       }
    }
 
@@ -257,7 +275,7 @@ namespace Util
    void  RingBuffer<Data>::allocate(int capacity)
    {
       if (data_ == 0) {
-         Memory::allocate<Data>(data_, capacity);
+         Memory::allocate<Data>(data_, capacity, policy_);
          capacity_ = capacity;
       } else {
          UTIL_THROW("Error: Attempt to re-allocate a RingBuffer");
@@ -266,6 +284,26 @@ namespace Util
       size_ = 0;        // No values in buffer
    }
 
+   /*
+   * Allocate a new array with a specified memory policy.
+   */
+   template <typename Data>
+   void RingBuffer<Data>::allocate(int capacity, MemoryPolicy const & policy)
+   {
+      if (data_ != 0) {
+         UTIL_THROW("Error: Attempt to re-allocate a RingBuffer");
+      }
+      policy_ = policy;
+      allocate(capacity);
+   }
+
+   /*
+   * Return the memory policy.
+   */
+   template <typename Data>
+   inline MemoryPolicy const & RingBuffer<Data>::memoryPolicy() const
+   {  return policy_; }
+
    /*
    * Set buffer to empty state, by resetting counters.
    */
@@ -0,0 +1,552 @@
+#ifndef UTIL_SOA_ARRAY_H
+#define UTIL_SOA_ARRAY_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/Array.h>
+#include <util/space/SoATraits.h>
+#include <util/misc/Memory.h>
+#include <util/archives/serialize.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Reference to an element of an SoAArray.
+   *
+   * An SoAReference is a proxy returned by the non-const subscript
+   * operator of an SoAArray<T>. It may be converted to a T value, and
+   * assigned or incremented by a T value, so that expressions such as
+   * "Vector v = a[i]", "a[i] = v" and "a[i] += dv" behave as for an
+   * array of T objects. Individual components are accessed by the
+   * subscript operator, so that "a[i][j]" is a reference to component j
+   * of element i, as for a Vector or IntVector. For a Tensor, component
+   * (j, k) is accessed by "a[i](j, k)".
+   *
+   * \ingroup Array_Module
+   */
+   template <typename T>
+   class SoAReference
+   {
+
+   public:
+
+      /// Type of each component.
+      typedef typename SoATraits<T>::Scalar Scalar;
+
+      /**
+      * Constructor.
+      *
+      * \param ptr  address of component 0 of the element
+      * \param stride  distance between components (padded capacity)
+      */
+      SoAReference(Scalar* ptr, int stride)
+       : ptr_(ptr),
+         stride_(stride)
+      {}
+
+      /**
+      * Return the value of the element.
+      */
+      operator T () const
+      {
+         T value;
+         for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+            SoATraits<T>::set(value, k, ptr_[k*stride_]);
+         }
+         return value;
+      }
+
+      /**
+      * Assign a value to the element.
+      *
+      * \param value  new value
+      */
+      SoAReference<T>& operator = (T const & value)
+      {
+         for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+            ptr_[k*stride_] = SoATraits<T>::get(value, k);
+         }
+         return *this;
+      }
+
+      /**
+      * Assign the value of an element referred to by another proxy.
+      *
+      * \param other  proxy for the element to be copied
+      */
+      SoAReference<T>& operator = (SoAReference<T> const & other)
+      {
+         for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+            ptr_[k*stride_] = other.ptr_[k*other.stride_];
+         }
+         return *this;
+      }
+
+      /**
+      * Increment the element by a value.
+      *
+      * \param dv  increment
+      */
+      SoAReference<T>& operator += (T const & dv)
+      {
+         for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+            ptr_[k*stride_] += SoATraits<T>::get(dv, k);
+         }
+         return *this;
+      }
+
+      /**
+      * Decrement the element by a value.
+      *
+      * \param dv  decrement
+      */
+      SoAReference<T>& operator -= (T const & dv)
+      {
+         for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+            ptr_[k*stride_] -= SoATraits<T>::get(dv, k);
+         }
+         return *this;
+      }
+
+      /**
+      * Return a reference to component k.
+      *
+      * \param k  flat component index, 0 <= k < NComponent
+      */
+      Scalar& operator [] (int k) const
+      {
+         assert(k >= 0);
+         assert(k < SoATraits<T>::NComponent);
+         return ptr_[k*stride_];
+      }
+
+      /**
+      * Return a reference to tensor component (i, j).
+      *
+      * \param i  row index
+      * \param j  column index
+      */
+      Scalar& operator () (int i, int j) const
+      {
+         assert(i >= 0 && i < Dimension);
+         assert(j >= 0 && j < Dimension);
+         return ptr_[(i*Dimension + j)*stride_];
+      }
+
+   private:
+
+      // Address of component 0 of the element.
+      Scalar* ptr_;
+
+      // Distance between successive components of one element.
+      int stride_;
+
+   };
+
+   /**
+   * Dynamically allocated array of T objects in structure-of-arrays layout.
+   *
+   * An SoAArray<T> stores an array of objects of a type T with several
+   * components of the same scalar type, such as Vector, IntVector or
+   * Tensor, as a set of separate arrays, one per component. Component
+   * k of element i is stored at component(k)[i]. Each component array
+   * begins on a 64 byte boundary and is padded to a multiple of 64
+   * bytes, with zeroed padding, so that loops over the components of
+   * many elements can use aligned SIMD loads without remainder loops.
+   * Any type T with an explicit specialization of SoATraits may be used.
+   *
+   * The non-const subscript operator returns an SoAReference proxy that
+   * may be used much like a reference to a T object. The const
+   * subscript operator returns a T by value.
+   *
+   * \ingroup Array_Module
+   */
+   template <typename T>
+   class SoAArray
+   {
+
+   public:
+
+      /// Type of each component.
+      typedef typename SoATraits<T>::Scalar Scalar;
+
+      /**
+      * Constructor.
+      */
+      SoAArray();
+
+      /**
+      * Destructor.
+      *
+      * Deletes underlying memory, if allocated previously.
+      */
+      ~SoAArray();
+
+      /**
+      * Allocate memory for a specified number of elements.
+      *
+      * All components are initialized to zero.
+      *
+      * \throw Exception if the SoAArray is already allocated
+      *
+      * \param capacity  number of elements
+      */
+      void allocate(int capacity);
+
+      /**
+      * Deallocate the underlying memory.
+      *
+      * \throw Exception if the SoAArray is not allocated
+      */
+      void deallocate();
+
+      /**
+      * Copy all elements from an array of T objects.
+      *
+      * Allocates this SoAArray if not allocated on entry. Otherwise,
+      * the capacities must be equal.
+      *
+      * \param array  array of T objects (input)
+      */
+      void copyFrom(Array<T> const & array);
+
+      /**
+      * Copy all elements to an array of T objects.
+      *
+      * \throw Exception if the capacities are not equal
+      *
+      * \param array  array of T objects (output)
+      */
+      void copyTo(Array<T>& array) const;
+
+      /**
+      * Return a proxy reference to element i.
+      *
+      * \param i  array index
+      */
+      SoAReference<T> operator [] (int i);
+
+      /**
+      * Return the value of element i.
+      *
+      * \param i  array index
+      */
+      T operator [] (int i) const;
+
+      /**
+      * Return a reference to component k of element i.
+      *
+      * \param i  array index
+      * \param k  flat component index
+      */
+      Scalar& operator () (int i, int k);
+
+      /**
+      * Return a const reference to component k of element i.
+      *
+      * \param i  array index
+      * \param k  flat component index
+      */
+      Scalar const & operator () (int i, int k) const;
+
+      /**
+      * Return a pointer to the array of component k of all elements.
+      *
+      * The array is aligned to 64 bytes, and has stride() elements.
+      *
+      * \param k  flat component index
+      */
+      Scalar* component(int k);
+
+      /**
+      * Return a const pointer to the array of component k.
+      *
+      * \param k  flat component index
+      */
+      Scalar const * component(int k) const;
+
+      /**
+      * Return number of elements.
+      */
+      int capacity() const;
+
+      /**
+      * Return padded length of each component array.
+      */
+      int stride() const;
+
+      /**
+      * Return true if this SoAArray is allocated, false otherwise.
+      */
+      bool isAllocated() const;
+
+      /**
+      * Serialize an SoAArray to/from an Archive.
+      *
+      * Saves the capacity and then each component array in turn.
+      *
+      * \param ar       archive
+      * \param version  archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+   private:
+
+      /// Block containing all component arrays.
+      Scalar* data_;
+
+      /// Number of elements.
+      int capacity_;
+
+      /// Padded length of each component array.
+      int stride_;
+
+      /// Copy constructor, declared private to prohibit copying.
+      SoAArray(SoAArray<T> const & other);
+
+      /// Assignment, declared private to prohibit assignment.
+      SoAArray<T>& operator = (SoAArray<T> const & other);
+
+   };
+
+   /*
+   * Default constructor.
+   */
+   template <typename T>
+   SoAArray<T>::SoAArray()
+    : data_(0),
+      capacity_(0),
+      stride_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   template <typename T>
+   SoAArray<T>::~SoAArray()
+   {
+      if (data_) {
+         Memory::deallocate<Scalar>(data_,
+                                    SoATraits<T>::NComponent*stride_,
+                                    MemoryPolicy::simd());
+      }
+   }
+
+   /*
+   * Allocate all component arrays in a single aligned block.
+   */
+   template <typename T>
+   void SoAArray<T>::allocate(int capacity)
+   {
+      if (capacity <= 0) {
+         UTIL_THROW("Attempt to allocate with capacity <= 0");
+      }
+      if (data_) {
+         UTIL_THROW("Attempt to re-allocate an SoAArray");
+      }
+
+      // Pad each component array to a multiple of the SIMD alignment
+      int block = int(MemoryPolicy::SimdAlignment/sizeof(Scalar));
+      if (block < 1) block = 1;
+      int stride = ((capacity + block - 1)/block)*block;
+      int size = SoATraits<T>::NComponent*stride;
+
+      Memory::allocate<Scalar>(data_, size, MemoryPolicy::simd());
+      for (int i = 0; i < size; ++i) {
+         data_[i] = Scalar(0);
+      }
+      capacity_ = capacity;
+      stride_ = stride;
+   }
+
+   /*
+   * Deallocate the underlying memory.
+   */
+   template <typename T>
+   void SoAArray<T>::deallocate()
+   {
+      if (!data_) {
+         UTIL_THROW("SoAArray is not allocated");
+      }
+      Memory::deallocate<Scalar>(data_,
+                                 SoATraits<T>::NComponent*stride_,
+                                 MemoryPolicy::simd());
+      capacity_ = 0;
+      stride_ = 0;
+   }
+
+   /*
+   * Copy all elements from an array of T objects.
+   */
+   template <typename T>
+   void SoAArray<T>::copyFrom(Array<T> const & array)
+   {
+      if (!data_) {
+         allocate(array.capacity());
+      }
+      if (capacity_ != array.capacity()) {
+         UTIL_THROW("Unequal capacities in SoAArray::copyFrom");
+      }
+      for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+         Scalar* ptr = data_ + k*stride_;
+         for (int i = 0; i < capacity_; ++i) {
+            ptr[i] = SoATraits<T>::get(array[i], k);
+         }
+      }
+   }
+
+   /*
+   * Copy all elements to an array of T objects.
+   */
+   template <typename T>
+   void SoAArray<T>::copyTo(Array<T>& array) const
+   {
+      if (capacity_ != array.capacity()) {
+         UTIL_THROW("Unequal capacities in SoAArray::copyTo");
+      }
+      for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+         Scalar const * ptr = data_ + k*stride_;
+         for (int i = 0; i < capacity_; ++i) {
+            SoATraits<T>::set(array[i], k, ptr[i]);
+         }
+      }
+   }
+
+   /*
+   * Return a proxy reference to element i.
+   */
+   template <typename T>
+   inline SoAReference<T> SoAArray<T>::operator [] (int i)
+   {
+      assert(data_);
+      assert(i >= 0);
+      assert(i < capacity_);
+      return SoAReference<T>(data_ + i, stride_);
+   }
+
+   /*
+   * Return the value of element i.
+   */
+   template <typename T>
+   inline T SoAArray<T>::operator [] (int i) const
+   {
+      assert(data_);
+      assert(i >= 0);
+      assert(i < capacity_);
+      T value;
+      for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+         SoATraits<T>::set(value, k, data_[k*stride_ + i]);
+      }
+      return value;
+   }
+
+   /*
+   * Return a reference to component k of element i.
+   */
+   template <typename T>
+   inline
+   typename SoAArray<T>::Scalar& SoAArray<T>::operator () (int i, int k)
+   {
+      assert(data_);
+      assert(i >= 0 && i < capacity_);
+      assert(k >= 0 && k < SoATraits<T>::NComponent);
+      return data_[k*stride_ + i];
+   }
+
+   /*
+   * Return a const reference to component k of element i.
+   */
+   template <typename T>
+   inline typename SoAArray<T>::Scalar const &
+   SoAArray<T>::operator () (int i, int k) const
+   {
+      assert(data_);
+      assert(i >= 0 && i < capacity_);
+      assert(k >= 0 && k < SoATraits<T>::NComponent);
+      return data_[k*stride_ + i];
+   }
+
+   /*
+   * Return a pointer to the array of component k.
+   */
+   template <typename T>
+   inline typename SoAArray<T>::Scalar* SoAArray<T>::component(int k)
+   {
+      assert(data_);
+      assert(k >= 0 && k < SoATraits<T>::NComponent);
+      return data_ + k*stride_;
+   }
+
+   /*
+   * Return a const pointer to the array of component k.
+   */
+   template <typename T>
+   inline typename SoAArray<T>::Scalar const *
+   SoAArray<T>::component(int k) const
+   {
+      assert(data_);
+      assert(k >= 0 && k < SoATraits<T>::NComponent);
+      return data_ + k*stride_;
+   }
+
+   /*
+   * Return number of elements.
+   */
+   template <typename T>
+   inline int SoAArray<T>::capacity() const
+   {  return capacity_; }
+
+   /*
+   * Return padded length of each component array.
+   */
+   template <typename T>
+   inline int SoAArray<T>::stride() const
+   {  return stride_; }
+
+   /*
+   * Return true if allocated.
+   */
+   template <typename T>
+   inline bool SoAArray<T>::isAllocated() const
+   {  return (bool)data_; }
+
+   /*
+   * Serialize an SoAArray to/from an Archive.
+   */
+   template <typename T>
+   template <class Archive>
+   void SoAArray<T>::serialize(Archive& ar, const unsigned int version)
+   {
+      int capacity;
+      if (Archive::is_saving()) {
+         capacity = capacity_;
+      }
+      ar & capacity;
+      if (Archive::is_loading()) {
+         if (!data_) {
+            if (capacity > 0) {
+               allocate(capacity);
+            }
+         } else {
+            if (capacity != capacity_) {
+               UTIL_THROW("Inconsistent SoAArray capacities");
+            }
+         }
+      }
+      if (data_) {
+         for (int k = 0; k < SoATraits<T>::NComponent; ++k) {
+            serializeArray(ar, data_ + k*stride_, capacity_, version);
+         }
+      }
+   }
+
+}
+#endif
@@ -0,0 +1,504 @@
+#ifndef UTIL_SPSC_RING_BUFFER_H
+#define UTIL_SPSC_RING_BUFFER_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#ifdef UTIL_CXX11
+
+#include <util/containers/BackPressure.h>
+#include <util/misc/Memory.h>
+#include <util/global.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <stddef.h>
+
+namespace Util
+{
+
+   /**
+   * Bounded lock-free queue for one producer thread and one consumer.
+   *
+   * An SpscRingBuffer passes values from exactly one producer thread,
+   * which calls push(), to exactly one consumer thread, which calls
+   * pop(), tryPop() or drain(). It is intended to decouple a simulation
+   * thread that generates snapshots from an analysis thread that
+   * processes them, e.g.:
+   * \code
+   *    // Consumer thread
+   *    AutoCorrelation<double, double> accumulator;
+   *    buffer.drain(accumulator);  // sample every value until closed
+   *
+   *    // Producer thread
+   *    buffer.push(value);         // for each snapshot
+   *    buffer.close();             // when done
+   * \endcode
+   * The drain() function calls sample(value) on its argument for each
+   * value, and so works with any accumulator with a sample() function
+   * that accepts Data, such as AutoCorrelation<Data, Product>, or
+   * MeanSqDispArray<T> for Data = DArray<T>.
+   *
+   * The capacity is rounded up to a power of two. The producer and
+   * consumer indices are stored on separate cache lines, and each
+   * thread keeps a private copy of the other thread's index, so that
+   * they communicate only when the queue appears full or empty.
+   * Batch push and pop functions publish their index once per batch.
+   * When the buffer is full, push() either waits or fails, according
+   * to the BackPressure policy set by allocate().
+   *
+   * Values are stored by assignment, or by move assignment for push()
+   * and pop() of rvalues, so large snapshots such as DArray objects
+   * can be passed without copying their elements. This class requires
+   * C++11, and is only defined when UTIL_CXX11 is defined.
+   *
+   * \ingroup Array_Module
+   */
+   template <typename Data>
+   class SpscRingBuffer
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      SpscRingBuffer();
+
+      /**
+      * Destructor.
+      */
+      ~SpscRingBuffer();
+
+      /**
+      * Allocate an empty buffer.
+      *
+      * \param capacity  minimum number of elements (rounded up to 2^n)
+      * \param policy  action taken by push() on a full buffer
+      */
+      void allocate(int capacity,
+                    BackPressure::Type policy = BackPressure::Block);
+
+      /// \name Producer interface
+      //@{
+
+      /**
+      * Add a copy of a value (producer thread only).
+      *
+      * \param value  value to be added
+      * \return true if added, false if rejected or closed
+      */
+      bool push(Data const & value);
+
+      /**
+      * Move a value into the buffer (producer thread only).
+      *
+      * \param value  value to be moved
+      * \return true if added, false if rejected or closed
+      */
+      bool push(Data&& value);
+
+      /**
+      * Add copies of n values (producer thread only).
+      *
+      * With the Block policy, waits until all n values are added or
+      * the buffer is closed. With the Reject policy, adds as many as
+      * fit without waiting.
+      *
+      * \param values  array of values
+      * \param n  number of values
+      * \return number of values added
+      */
+      int push(Data const * values, int n);
+
+      /**
+      * Close the buffer: no further values will be pushed.
+      *
+      * Values already in the buffer may still be popped. May be
+      * called by any thread.
+      */
+      void close();
+
+      //@}
+      /// \name Consumer interface
+      //@{
+
+      /**
+      * Remove the oldest value, waiting until one is available.
+      *
+      * \param value  on return, the removed value
+      * \return true if a value was removed, false if closed and empty
+      */
+      bool pop(Data& value);
+
+      /**
+      * Remove the oldest value, if one is available, without waiting.
+      *
+      * \param value  on return, the removed value
+      * \return true if a value was removed, false otherwise
+      */
+      bool tryPop(Data& value);
+
+      /**
+      * Remove up to n values, waiting until at least one is available.
+      *
+      * \param values  array of at least n elements (output)
+      * \param n  maximum number of values
+      * \return number of values removed, zero if closed and empty
+      */
+      int pop(Data* values, int n);
+
+      /**
+      * Pop every value and pass it to sampler.sample(), until closed.
+      *
+      * \param sampler  object with a sample(Data const &) function
+      * \return number of values sampled
+      */
+      template <class Sampler>
+      long drain(Sampler& sampler);
+
+      //@}
+
+      /**
+      * Return approximate number of values in the buffer.
+      */
+      int size() const;
+
+      /**
+      * Return capacity of the buffer.
+      */
+      int capacity() const;
+
+      /**
+      * Has close() been called?
+      */
+      bool isClosed() const;
+
+      /**
+      * Has memory been allocated?
+      */
+      bool isAllocated() const;
+
+   private:
+
+      // Cache-line padded producer index, with cached consumer index.
+      struct alignas(MemoryPolicy::CacheLineSize) ProducerIndex
+      {
+         std::atomic<size_t> tail;
+         size_t headCache;
+      };
+
+      // Cache-line padded consumer index, with cached producer index.
+      struct alignas(MemoryPolicy::CacheLineSize) ConsumerIndex
+      {
+         std::atomic<size_t> head;
+         size_t tailCache;
+      };
+
+      /// Index of next slot to be written, modified by producer.
+      ProducerIndex producer_;
+
+      /// Index of next slot to be read, modified by consumer.
+      ConsumerIndex consumer_;
+
+      /// Array of slots.
+      Data* data_;
+
+      /// Number of slots (a power of 2).
+      size_t capacity_;
+
+      /// capacity_ - 1.
+      size_t mask_;
+
+      /// Set true by close().
+      std::atomic<bool> isClosed_;
+
+      /// Action for push to a full buffer.
+      BackPressure::Type policy_;
+
+      /// Wait until at least one slot is free, return number free.
+      size_t waitForSpace(size_t wanted);
+
+      /// Wait until at least one value is present, return number present.
+      size_t waitForData(size_t wanted);
+
+      /// Copy constructor, declared private to prohibit copying.
+      SpscRingBuffer(SpscRingBuffer<Data> const & other);
+
+      /// Assignment, declared private to prohibit assignment.
+      SpscRingBuffer<Data>& operator = (SpscRingBuffer<Data> const & other);
+
+   };
+
+   // Method definitions
+
+   /*
+   * Constructor.
+   */
+   template <typename Data>
+   SpscRingBuffer<Data>::SpscRingBuffer()
+    : data_(0),
+      capacity_(0),
+      mask_(0),
+      isClosed_(false),
+      policy_(BackPressure::Block)
+   {
+      producer_.tail.store(0);
+      producer_.headCache = 0;
+      consumer_.head.store(0);
+      consumer_.tailCache = 0;
+   }
+
+   /*
+   * Destructor.
+   */
+   template <typename Data>
+   SpscRingBuffer<Data>::~SpscRingBuffer()
+   {
+      if (data_) {
+         Memory::deallocate<Data>(data_, capacity_,
+                                  MemoryPolicy::cacheLine());
+      }
+   }
+
+   /*
+   * Allocate an empty buffer.
+   */
+   template <typename Data>
+   void SpscRingBuffer<Data>::allocate(int capacity,
+                                       BackPressure::Type policy)
+   {
+      if (data_) {
+         UTIL_THROW("Attempt to re-allocate an SpscRingBuffer");
+      }
+      if (capacity <= 0) {
+         UTIL_THROW("Attempt to allocate with capacity <= 0");
+      }
+      size_t n = 1;
+      while (n < (size_t)capacity) {
+         n *= 2;
+      }
+      Memory::allocate<Data>(data_, n, MemoryPolicy::cacheLine());
+      capacity_ = n;
+      mask_ = n - 1;
+      policy_ = policy;
+   }
+
+   /*
+   * Wait for free space (producer).
+   */
+   template <typename Data>
+   size_t SpscRingBuffer<Data>::waitForSpace(size_t wanted)
+   {
+      size_t tail = producer_.tail.load(std::memory_order_relaxed);
+      size_t free = capacity_ - (tail - producer_.headCache);
+      if (free < wanted) {
+         producer_.headCache =
+                         consumer_.head.load(std::memory_order_acquire);
+         free = capacity_ - (tail - producer_.headCache);
+      }
+      while (free == 0) {
+         producer_.headCache =
+                         consumer_.head.load(std::memory_order_acquire);
+         free = capacity_ - (tail - producer_.headCache);
+         if (free > 0) break;
+         if (policy_ == BackPressure::Reject) return 0;
+         if (isClosed_.load(std::memory_order_relaxed)) return 0;
+         std::this_thread::yield();
+      }
+      return free;
+   }
+
+   /*
+   * Add a copy of a value.
+   */
+   template <typename Data>
+   bool SpscRingBuffer<Data>::push(Data const & value)
+   {
+      assert(data_);
+      if (isClosed_.load(std::memory_order_relaxed)) return false;
+      if (waitForSpace(1) == 0) return false;
+      size_t tail = producer_.tail.load(std::memory_order_relaxed);
+      data_[tail & mask_] = value;
+      producer_.tail.store(tail + 1, std::memory_order_release);
+      return true;
+   }
+
+   /*
+   * Move a value into the buffer.
+   */
+   template <typename Data>
+   bool SpscRingBuffer<Data>::push(Data&& value)
+   {
+      assert(data_);
+      if (isClosed_.load(std::memory_order_relaxed)) return false;
+      if (waitForSpace(1) == 0) return false;
+      size_t tail = producer_.tail.load(std::memory_order_relaxed);
+      data_[tail & mask_] = std::move(value);
+      producer_.tail.store(tail + 1, std::memory_order_release);
+      return true;
+   }
+
+   /*
+   * Add copies of n values.
+   */
+   template <typename Data>
+   int SpscRingBuffer<Data>::push(Data const * values, int n)
+   {
+      assert(data_);
+      int count = 0;
+      while (count < n) {
+         if (isClosed_.load(std::memory_order_relaxed)) break;
+         size_t free = waitForSpace((size_t)(n - count));
+         if (free == 0) break;
+         size_t tail = producer_.tail.load(std::memory_order_relaxed);
+         size_t m = std::min(free, (size_t)(n - count));
+         for (size_t i = 0; i < m; ++i) {
+            data_[(tail + i) & mask_] = values[count + i];
+         }
+         producer_.tail.store(tail + m, std::memory_order_release);
+         count += (int)m;
+      }
+      return count;
+   }
+
+   /*
+   * Close the buffer.
+   */
+   template <typename Data>
+   void SpscRingBuffer<Data>::close()
+   {  isClosed_.store(true, std::memory_order_release); }
+
+   /*
+   * Wait for data (consumer).
+   */
+   template <typename Data>
+   size_t SpscRingBuffer<Data>::waitForData(size_t wanted)
+   {
+      size_t head = consumer_.head.load(std::memory_order_relaxed);
+      size_t present = consumer_.tailCache - head;
+      if (present > 0 && present < wanted) {
+         consumer_.tailCache =
+                         producer_.tail.load(std::memory_order_acquire);
+         present = consumer_.tailCache - head;
+      }
+      while (present == 0) {
+         // Read closed flag before tail, so that no value pushed
+         // before close() can be missed.
+         bool closed = isClosed_.load(std::memory_order_acquire);
+         consumer_.tailCache =
+                         producer_.tail.load(std::memory_order_acquire);
+         present = consumer_.tailCache - head;
+         if (present > 0 || closed) break;
+         std::this_thread::yield();
+      }
+      return present;
+   }
+
+   /*
+   * Remove the oldest value, waiting if necessary.
+   */
+   template <typename Data>
+   bool SpscRingBuffer<Data>::pop(Data& value)
+   {
+      assert(data_);
+      if (waitForData(1) == 0) return false;
+      size_t head = consumer_.head.load(std::memory_order_relaxed);
+      value = std::move(data_[head & mask_]);
+      consumer_.head.store(head + 1, std::memory_order_release);
+      return true;
+   }
+
+   /*
+   * Remove the oldest value, without waiting.
+   */
+   template <typename Data>
+   bool SpscRingBuffer<Data>::tryPop(Data& value)
+   {
+      assert(data_);
+      size_t head = consumer_.head.load(std::memory_order_relaxed);
+      if (consumer_.tailCache == head) {
+         consumer_.tailCache =
+                         producer_.tail.load(std::memory_order_acquire);
+         if (consumer_.tailCache == head) return false;
+      }
+      value = std::move(data_[head & mask_]);
+      consumer_.head.store(head + 1, std::memory_order_release);
+      return true;
+   }
+
+   /*
+   * Remove up to n values.
+   */
+   template <typename Data>
+   int SpscRingBuffer<Data>::pop(Data* values, int n)
+   {
+      assert(data_);
+      size_t present = waitForData((size_t)n);
+      if (present == 0) return 0;
+      size_t head = consumer_.head.load(std::memory_order_relaxed);
+      size_t m = std::min(present, (size_t)n);
+      for (size_t i = 0; i < m; ++i) {
+         values[i] = std::move(data_[(head + i) & mask_]);
+      }
+      consumer_.head.store(head + m, std::memory_order_release);
+      return (int)m;
+   }
+
+   /*
+   * Sample every value until the buffer is closed and empty.
+   */
+   template <typename Data>
+   template <class Sampler>
+   long SpscRingBuffer<Data>::drain(Sampler& sampler)
+   {
+      Data value;
+      long count = 0;
+      while (pop(value)) {
+         sampler.sample(value);
+         ++count;
+      }
+      return count;
+   }
+
+   /*
+   * Return approximate number of values.
+   */
+   template <typename Data>
+   inline int SpscRingBuffer<Data>::size() const
+   {
+      size_t tail = producer_.tail.load(std::memory_order_acquire);
+      size_t head = consumer_.head.load(std::memory_order_acquire);
+      return (int)(tail - head);
+   }
+
+   /*
+   * Return capacity.
+   */
+   template <typename Data>
+   inline int SpscRingBuffer<Data>::capacity() const
+   {  return (int)capacity_; }
+
+   /*
+   * Has close() been called?
+   */
+   template <typename Data>
+   inline bool SpscRingBuffer<Data>::isClosed() const
+   {  return isClosed_.load(std::memory_order_acquire); }
+
+   /*
+   * Has memory been allocated?
+   */
+   template <typename Data>
+   inline bool SpscRingBuffer<Data>::isAllocated() const
+   {  return (bool)data_; }
+
+}
+#endif // UTIL_CXX11
+#endif
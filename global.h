@@ -78,4 +78,18 @@
   if (!(condition)) { UTIL_THROW("Failed assertion: " #condition); }
 #endif
 
+/**
+* Qualifier for pointers that are not aliased by any other pointer in scope.
+*
+* Expands to the compiler-specific form of the C99 restrict keyword, or to
+* nothing for compilers that do not provide one.
+*/
+#if defined(__GNUC__) || defined(__clang__) || defined(__INTEL_COMPILER)
+#define UTIL_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define UTIL_RESTRICT __restrict
+#else
+#define UTIL_RESTRICT
+#endif
+
 #endif
@@ -0,0 +1,338 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "BSplineSpreader.h"
+
+#include <cmath>
+#ifdef UTIL_CXX11
+#include <thread>
+#include <vector>
+#endif
+
+namespace Util
+{
+
+   namespace {
+
+      /*
+      * Compute grid indices and spline weights for one particle.
+      *
+      * On return, index[d*order + j] is the index of the grid point
+      * g_d - j in direction d, wrapped into [0, N_d), where g_d is the
+      * integer part of the wrapped coordinate, and w and dw contain the
+      * corresponding spline weights and derivatives in the same layout.
+      * If dw is null, derivatives are not computed.
+      */
+      inline
+      void splineStencil(CardinalBSpline const & spline, int order,
+                         Vector const & position,
+                         IntVector const & dimensions,
+                         int* index, double* w, double* dw)
+      {
+         double u[Dimension];
+         for (int d = 0; d < Dimension; ++d) {
+            int n = dimensions[d];
+            double f = std::floor(position[d]);
+            u[d] = position[d] - f;
+            int g = ((int)f) % n;
+            if (g < 0) g += n;
+            int* id = index + d*order;
+            for (int j = 0; j < order; ++j) {
+               id[j] = (g - j >= 0) ? g - j : g - j + n;
+            }
+         }
+         spline.weights(u, Dimension, w, dw);
+      }
+
+      /*
+      * Return the wrapped grid index in direction 0 of a position.
+      */
+      inline int baseIndex(double x, int n)
+      {
+         int g = ((int)std::floor(x)) % n;
+         return (g < 0) ? g + n : g;
+      }
+
+   }
+
+   /*
+   * Constructor.
+   */
+   BSplineSpreader::BSplineSpreader(CardinalBSpline const & spline)
+    : splinePtr_(&spline),
+      order_(spline.degree() + 1),
+      nThread_(1),
+      slabParticles_(),
+      slabOffsets_()
+   {  UTIL_CHECK(order_ <= MaxOrder); }
+
+   /*
+   * Destructor.
+   */
+   BSplineSpreader::~BSplineSpreader()
+   {}
+
+   /*
+   * Set number of threads.
+   */
+   void BSplineSpreader::setNThread(int nThread)
+   {
+      UTIL_CHECK(nThread >= 1);
+      nThread_ = nThread;
+   }
+
+   /*
+   * Add particle charges to a grid.
+   */
+   void BSplineSpreader::spread(Array<Vector> const & positions,
+                                Array<double> const & charges,
+                                GridArray<double>& grid)
+   {
+      int n = positions.capacity();
+      UTIL_CHECK(charges.capacity() >= n);
+      UTIL_CHECK(grid.isAllocated());
+      UTIL_CHECK(grid.layout() == SpaceFillingCurve::RowMajor);
+      IntVector const & dimensions = grid.dimensions();
+      for (int d = 0; d < Dimension; ++d) {
+         UTIL_CHECK(dimensions[d] >= order_);
+      }
+
+      // Allocate or grow the array of particle indices
+      if (slabParticles_.capacity() < n) {
+         if (slabParticles_.isAllocated()) {
+            slabParticles_.deallocate();
+         }
+         slabParticles_.allocate(n);
+      }
+
+      // Use an even number of slabs, each at least order_ planes thick
+      int nSlab = dimensions[0]/order_;
+      nSlab -= nSlab % 2;
+      int nThread = nThread_;
+      #ifndef UTIL_CXX11
+      nThread = 1;
+      #endif
+      if (nThread == 1 || nSlab < 2) {
+         for (int i = 0; i < n; ++i) {
+            slabParticles_[i] = i;
+         }
+         spreadRange(positions, charges, grid, 0, n);
+         return;
+      }
+
+      // Bin particles by slab (counting sort)
+      if (slabOffsets_.capacity() < nSlab + 1) {
+         if (slabOffsets_.isAllocated()) {
+            slabOffsets_.deallocate();
+         }
+         slabOffsets_.allocate(nSlab + 1);
+      }
+      int width = dimensions[0]/nSlab;
+      for (int s = 0; s <= nSlab; ++s) {
+         slabOffsets_[s] = 0;
+      }
+      for (int i = 0; i < n; ++i) {
+         int s = baseIndex(positions[i][0], dimensions[0])/width;
+         if (s >= nSlab) s = nSlab - 1;
+         ++slabOffsets_[s + 1];
+      }
+      for (int s = 0; s < nSlab; ++s) {
+         slabOffsets_[s + 1] += slabOffsets_[s];
+      }
+      for (int i = 0; i < n; ++i) {
+         int s = baseIndex(positions[i][0], dimensions[0])/width;
+         if (s >= nSlab) s = nSlab - 1;
+         slabParticles_[slabOffsets_[s]] = i;
+         ++slabOffsets_[s];
+      }
+      for (int s = nSlab; s > 0; --s) {
+         slabOffsets_[s] = slabOffsets_[s-1];
+      }
+      slabOffsets_[0] = 0;
+
+      #ifdef UTIL_CXX11
+      // Process slabs of each color concurrently, one color at a time
+      if (nThread > nSlab/2) nThread = nSlab/2;
+      for (int color = 0; color < 2; ++color) {
+         std::vector<std::thread> threads;
+         for (int t = 1; t < nThread; ++t) {
+            threads.push_back(std::thread(&BSplineSpreader::spreadColor,
+                                          this, std::cref(positions),
+                                          std::cref(charges),
+                                          std::ref(grid),
+                                          nSlab, color, t));
+         }
+         spreadColor(positions, charges, grid, nSlab, color, 0);
+         for (size_t t = 0; t < threads.size(); ++t) {
+            threads[t].join();
+         }
+      }
+      #endif
+   }
+
+   /*
+   * Spread all particles in slabs of one color assigned to a thread.
+   */
+   void BSplineSpreader::spreadColor(Array<Vector> const & positions,
+                                     Array<double> const & charges,
+                                     GridArray<double>& grid,
+                                     int nSlab, int color, int thread) const
+   {
+      int stride = 2*nThread_;
+      if (stride > nSlab) stride = nSlab;
+      for (int s = color + 2*thread; s < nSlab; s += stride) {
+         spreadRange(positions, charges, grid,
+                     slabOffsets_[s], slabOffsets_[s+1]);
+      }
+   }
+
+   /*
+   * Spread particles slabParticles_[begin], ..., slabParticles_[end-1].
+   */
+   void BSplineSpreader::spreadRange(Array<Vector> const & positions,
+                                     Array<double> const & charges,
+                                     GridArray<double>& grid,
+                                     int begin, int end) const
+   {
+      IntVector const & dimensions = grid.dimensions();
+      int offset0 = dimensions[1]*dimensions[2];
+      int offset1 = dimensions[2];
+      double* data = grid.data();
+
+      int index[Dimension*MaxOrder];
+      double w[Dimension*MaxOrder];
+      int const * id0 = index;
+      int const * id1 = index + order_;
+      int const * id2 = index + 2*order_;
+      double const * w0 = w;
+      double const * w1 = w + order_;
+      double const * w2 = w + 2*order_;
+
+      for (int m = begin; m < end; ++m) {
+         int i = slabParticles_[m];
+         splineStencil(*splinePtr_, order_, positions[i], dimensions,
+                       index, w, 0);
+         double q = charges[i];
+         for (int j0 = 0; j0 < order_; ++j0) {
+            int r0 = id0[j0]*offset0;
+            double q0 = q*w0[j0];
+            for (int j1 = 0; j1 < order_; ++j1) {
+               double* row = data + r0 + id1[j1]*offset1;
+               double q1 = q0*w1[j1];
+               for (int j2 = 0; j2 < order_; ++j2) {
+                  row[id2[j2]] += q1*w2[j2];
+               }
+            }
+         }
+      }
+   }
+
+   /*
+   * Interpolate grid values and gradients to particle positions.
+   */
+   void BSplineSpreader::interpolate(GridArray<double> const & grid,
+                                     Array<Vector> const & positions,
+                                     Array<double>& values,
+                                     Array<Vector>& gradients) const
+   {
+      int n = positions.capacity();
+      UTIL_CHECK(values.capacity() >= n);
+      UTIL_CHECK(gradients.capacity() >= n);
+      UTIL_CHECK(grid.isAllocated());
+      UTIL_CHECK(grid.layout() == SpaceFillingCurve::RowMajor);
+      for (int d = 0; d < Dimension; ++d) {
+         UTIL_CHECK(grid.dimension(d) >= order_);
+      }
+
+      #ifdef UTIL_CXX11
+      int nThread = nThread_;
+      if (nThread > n) nThread = n;
+      if (nThread > 1) {
+         std::vector<std::thread> threads;
+         int chunk = (n + nThread - 1)/nThread;
+         for (int t = 1; t < nThread; ++t) {
+            int begin = t*chunk;
+            int end = begin + chunk < n ? begin + chunk : n;
+            if (begin >= end) break;
+            threads.push_back(std::thread(
+                                &BSplineSpreader::interpolateRange,
+                                this, std::cref(grid), std::cref(positions),
+                                std::ref(values), std::ref(gradients),
+                                begin, end));
+         }
+         interpolateRange(grid, positions, values, gradients, 0, chunk);
+         for (size_t t = 0; t < threads.size(); ++t) {
+            threads[t].join();
+         }
+         return;
+      }
+      #endif
+      interpolateRange(grid, positions, values, gradients, 0, n);
+   }
+
+   /*
+   * Interpolate for particles begin, ..., end - 1.
+   */
+   void
+   BSplineSpreader::interpolateRange(GridArray<double> const & grid,
+                                     Array<Vector> const & positions,
+                                     Array<double>& values,
+                                     Array<Vector>& gradients,
+                                     int begin, int end) const
+   {
+      IntVector const & dimensions = grid.dimensions();
+      int offset0 = dimensions[1]*dimensions[2];
+      int offset1 = dimensions[2];
+      double const * data = grid.data();
+
+      int index[Dimension*MaxOrder];
+      double w[Dimension*MaxOrder];
+      double dw[Dimension*MaxOrder];
+      int const * id0 = index;
+      int const * id1 = index + order_;
+      int const * id2 = index + 2*order_;
+      double const * w0 = w;
+      double const * w1 = w + order_;
+      double const * w2 = w + 2*order_;
+      double const * dw0 = dw;
+      double const * dw1 = dw + order_;
+      double const * dw2 = dw + 2*order_;
+
+      // The weight of grid point g - j is b(u + j), so its derivative
+      // with respect to the position is b'(u + j).
+      for (int i = begin; i < end; ++i) {
+         splineStencil(*splinePtr_, order_, positions[i], dimensions,
+                       index, w, dw);
+         double value = 0.0;
+         double g0 = 0.0;
+         double g1 = 0.0;
+         double g2 = 0.0;
+         for (int j0 = 0; j0 < order_; ++j0) {
+            int r0 = id0[j0]*offset0;
+            for (int j1 = 0; j1 < order_; ++j1) {
+               double const * row = data + r0 + id1[j1]*offset1;
+               double s = 0.0;
+               double ds = 0.0;
+               for (int j2 = 0; j2 < order_; ++j2) {
+                  double x = row[id2[j2]];
+                  s += w2[j2]*x;
+                  ds += dw2[j2]*x;
+               }
+               value += w0[j0]*w1[j1]*s;
+               g0 += dw0[j0]*w1[j1]*s;
+               g1 += w0[j0]*dw1[j1]*s;
+               g2 += w0[j0]*w1[j1]*ds;
+            }
+         }
+         values[i] = value;
+         gradients[i][0] = g0;
+         gradients[i][1] = g1;
+         gradients[i][2] = g2;
+      }
+   }
+
+}
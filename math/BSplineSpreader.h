@@ -0,0 +1,166 @@
+#ifndef UTIL_B_SPLINE_SPREADER_H
+#define UTIL_B_SPLINE_SPREADER_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/math/CardinalBSpline.h>
+#include <util/containers/Array.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+#include <util/space/IntVector.h>
+#include <util/containers/GridArray.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Spreads point charges onto a periodic grid with B-spline weights.
+   *
+   * A BSplineSpreader implements the two grid operations of a
+   * particle-mesh method, for a CardinalBSpline of degree k:
+   *
+   *  - spread() adds the charge q of each particle to the (k+1)^3
+   *    nearest grid points of a GridArray<double>, with weight equal
+   *    to a product of spline weights in each direction.
+   *
+   *  - interpolate() computes the inverse operation, the weighted sum
+   *    of grid values around each particle, and its gradient with
+   *    respect to the particle position.
+   *
+   * Particle positions are given in units of the grid spacing, so that
+   * component d of a position lies in [0, N_d) for a grid with N_d
+   * points in direction d. Positions outside this range are wrapped
+   * periodically, as are the grid points to which they contribute.
+   *
+   * Both operations may use several threads, when compiled with
+   * UTIL_CXX11. For spread(), the grid is divided into an even number
+   * of slabs along direction 0, each at least k+1 planes thick, and
+   * particles are binned by slab. A particle only writes to its own
+   * slab and the preceding one, so slabs with indices of equal parity
+   * ("colors") never write to the same grid point and can be processed
+   * concurrently without locks or per-thread grid copies. The two
+   * colors are processed one after the other.
+   *
+   * Grids must use the default row-major layout.
+   *
+   * \ingroup Math_Module
+   */
+   class BSplineSpreader
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param spline  B-spline basis function (degree < MaxOrder)
+      */
+      BSplineSpreader(CardinalBSpline const & spline);
+
+      /**
+      * Destructor.
+      */
+      ~BSplineSpreader();
+
+      /**
+      * Set the number of threads used by spread() and interpolate().
+      *
+      * Without UTIL_CXX11, all work is done by the calling thread.
+      *
+      * \param nThread  number of threads (>= 1)
+      */
+      void setNThread(int nThread);
+
+      /**
+      * Add particle charges to a grid.
+      *
+      * The grid is not zeroed: charges are added to its contents.
+      *
+      * \param positions  particle positions, in units of grid spacing
+      * \param charges  particle charges
+      * \param grid  periodic grid (modified)
+      */
+      void spread(Array<Vector> const & positions,
+                  Array<double> const & charges,
+                  GridArray<double>& grid);
+
+      /**
+      * Interpolate grid values and gradients to particle positions.
+      *
+      * For each particle, values[i] is the sum of grid values around
+      * the particle weighted as in spread(), and gradients[i] is its
+      * gradient with respect to the position, in units of inverse grid
+      * spacing.
+      *
+      * \param grid  periodic grid
+      * \param positions  particle positions, in units of grid spacing
+      * \param values  interpolated values (output)
+      * \param gradients  gradients of interpolated values (output)
+      */
+      void interpolate(GridArray<double> const & grid,
+                       Array<Vector> const & positions,
+                       Array<double>& values,
+                       Array<Vector>& gradients) const;
+
+      /**
+      * Return number of threads.
+      */
+      int nThread() const;
+
+      /// Maximum supported spline order (degree + 1).
+      static const int MaxOrder = 16;
+
+   private:
+
+      /// Spline basis function.
+      CardinalBSpline const * splinePtr_;
+
+      /// Spline order (degree + 1).
+      int order_;
+
+      /// Number of threads.
+      int nThread_;
+
+      /// Particle indices sorted by slab.
+      DArray<int> slabParticles_;
+
+      /// Offsets of each slab within slabParticles_ (nSlab + 1).
+      DArray<int> slabOffsets_;
+
+      /// Spread particles with indices slabParticles_[begin, end).
+      void spreadRange(Array<Vector> const & positions,
+                       Array<double> const & charges,
+                       GridArray<double>& grid,
+                       int begin, int end) const;
+
+      /// Spread all particles in slabs of one color.
+      void spreadColor(Array<Vector> const & positions,
+                       Array<double> const & charges,
+                       GridArray<double>& grid,
+                       int nSlab, int color, int thread) const;
+
+      /// Interpolate for particles with indices [begin, end).
+      void interpolateRange(GridArray<double> const & grid,
+                            Array<Vector> const & positions,
+                            Array<double>& values,
+                            Array<Vector>& gradients,
+                            int begin, int end) const;
+
+   };
+
+   // Inline member function
+
+   /*
+   * Return number of threads.
+   */
+   inline int BSplineSpreader::nThread() const
+   {  return nThread_; }
+
+}
+#endif
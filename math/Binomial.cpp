@@ -6,58 +6,222 @@
 */
 
 #include "Binomial.h"
+#include <util/misc/Memory.h>
 #include <util/global.h>
 
+#include <climits>
+#include <math.h>
+
+#ifdef UTIL_CXX11
+#include <atomic>
+#include <mutex>
+#endif
+
 namespace Util
 {
 
-   int Binomial::maxN_ = -1;
-   GArray<int> Binomial::coeffs_;
-
-   void Binomial::setup(int maxN)
-   {
-      UTIL_CHECK(maxN >= 0);
-      if (maxN <= maxN_) return;
-      maxN_ = maxN;
-
-      // Create coeff array of correct size , all zero elements
-      int size = (maxN + 1)*(maxN +2)/2;
-      coeffs_.resize(size);
-      for (int i = 0; i < size; ++i) {
-         coeffs_[i] = 0;
-      }
-
-      // Generate Pascal's triangle to set coefficients
-      coeffs_[0] = 1;
-      if (maxN == 0) return;
-      int n, m, bc, bp;
-      for (n = 1; n <= maxN; ++n) {
-         bc = n*(n+1)/2;
-         coeffs_[bc] = 1;
-         if (n > 1) {
-            bp = (n-1)*n/2;
-            for (m = 1; m < n; ++m) {
-               coeffs_[bc + m] = coeffs_[bp + m - 1] + coeffs_[bp + m];
+   const int Binomial::MaxInt;
+   const int Binomial::MaxExact;
+
+   namespace {
+
+      /*
+      * Rows 0, ..., MaxExact of Pascal's triangle, as 64-bit integers.
+      */
+      struct PascalTable
+      {
+         uint64_t data[(Binomial::MaxExact + 1)*(Binomial::MaxExact + 2)/2];
+
+         PascalTable()
+         {
+            int n, m, bc, bp;
+            data[0] = 1;
+            for (n = 1; n <= Binomial::MaxExact; ++n) {
+               bc = n*(n+1)/2;
+               bp = (n-1)*n/2;
+               data[bc] = 1;
+               for (m = 1; m < n; ++m) {
+                  data[bc + m] = data[bp + m - 1] + data[bp + m];
+               }
+               data[bc + n] = 1;
             }
          }
-         coeffs_[bc + n] = 1;
+      };
+
+      /*
+      * Return the table, building it on first use.
+      *
+      * Initialization of a function local static is thread safe in
+      * C++11.
+      */
+      PascalTable const & pascal()
+      {
+         static PascalTable table;
+         return table;
+      }
+
+      /*
+      * Blocks of the table of ln(n!). Block b holds n = b*BlockSize,
+      * ..., (b+1)*BlockSize - 1.
+      */
+      const int BlockSize = 1024;
+      const int MaxBlock = 4096;
+
+      #ifdef UTIL_CXX11
+      std::atomic<double*> blocks_[MaxBlock];
+      std::mutex mutex_;
+      #else
+      double* blocks_[MaxBlock];
+      #endif
+
+      /*
+      * Allocate and fill one block of logarithms of factorials.
+      */
+      double* makeBlock(int b)
+      {
+         double* ptr = 0;
+         Memory::allocate<double>(ptr, BlockSize);
+         double n = double(b)*double(BlockSize);
+         for (int i = 0; i < BlockSize; ++i) {
+            ptr[i] = lgamma(n + double(i) + 1.0);
+         }
+         return ptr;
       }
+
+      /*
+      * Return block b, creating it if necessary.
+      */
+      double const * block(int b)
+      {
+         UTIL_CHECK(b < MaxBlock);
+         #ifdef UTIL_CXX11
+         double* ptr = blocks_[b].load(std::memory_order_acquire);
+         if (ptr) return ptr;
+         std::lock_guard<std::mutex> lock(mutex_);
+         ptr = blocks_[b].load(std::memory_order_relaxed);
+         if (!ptr) {
+            ptr = makeBlock(b);
+            blocks_[b].store(ptr, std::memory_order_release);
+         }
+         return ptr;
+         #else
+         if (!blocks_[b]) {
+            blocks_[b] = makeBlock(b);
+         }
+         return blocks_[b];
+         #endif
+      }
+
    }
 
+   /*
+   * Precompute logarithms of factorials up to nMax.
+   */
+   void Binomial::setup(int nMax)
+   {
+      UTIL_CHECK(nMax >= 0);
+      pascal();
+      for (int b = 0; b <= nMax/BlockSize; ++b) {
+         block(b);
+      }
+   }
+
+   /*
+   * Release all blocks of the logarithm table.
+   */
    void Binomial::clear()
-   {  
-      if (coeffs_.capacity() > 0) {
-         coeffs_.deallocate(); 
+   {
+      double* ptr;
+      for (int b = 0; b < MaxBlock; ++b) {
+         #ifdef UTIL_CXX11
+         ptr = blocks_[b].exchange(0);
+         #else
+         ptr = blocks_[b];
+         blocks_[b] = 0;
+         #endif
+         if (ptr) {
+            Memory::deallocate<double>(ptr, BlockSize);
+         }
       }
-      maxN_ = -1;
    }
 
-   int Binomial::coeff(int n, int m) 
+   /*
+   * Return C(n, m) as an int.
+   */
+   int Binomial::coeff(int n, int m)
+   {
+      uint64_t c = coeff64(n, m);
+      if (c > (uint64_t) INT_MAX) {
+         UTIL_THROW("Binomial coefficient does not fit in an int");
+      }
+      return (int) c;
+   }
+
+   /*
+   * Return C(n, m) as a 64-bit unsigned integer.
+   */
+   uint64_t Binomial::coeff64(int n, int m)
+   {
+      UTIL_CHECK(n >= 0);
+      UTIL_CHECK(m >= 0 && m <= n);
+      if (n <= MaxExact) {
+         return pascal().data[n*(n+1)/2 + m];
+      }
+
+      // Multiplicative formula, with an overflow check at each step
+      int k = m < n - m ? m : n - m;
+      uint64_t c = 1;
+      uint64_t a, f;
+      for (int j = 0; j < k; ++j) {
+         uint64_t g = gcd(c, j + 1);
+         a = c/g;
+         f = (uint64_t)(n - j)/((uint64_t)(j + 1)/g);
+         if (a > ~uint64_t(0)/f) {
+            UTIL_THROW("Binomial coefficient does not fit in 64 bits");
+         }
+         c = a*f;
+      }
+      return c;
+   }
+
+   /*
+   * Return a row of Pascal's triangle.
+   */
+   uint64_t const * Binomial::row(int n)
+   {
+      UTIL_CHECK(n >= 0 && n <= MaxExact);
+      return pascal().data + n*(n+1)/2;
+   }
+
+   /*
+   * Return ln(n!).
+   */
+   double Binomial::logFactorial(int n)
    {
       UTIL_CHECK(n >= 0);
-      UTIL_CHECK(m >= 0 && m <= m);
-      if (n > maxN_) setup(n);
-      return coeffs_[(n*(n+1)/2) + m] ;
+      return block(n/BlockSize)[n % BlockSize];
+   }
+
+   /*
+   * Return ln C(n, m).
+   */
+   double Binomial::logCoeff(int n, int m)
+   {
+      UTIL_CHECK(m >= 0 && m <= n);
+      return logFactorial(n) - logFactorial(m) - logFactorial(n - m);
+   }
+
+   /*
+   * Compute ln C(n, m) for m = 0, ..., n.
+   */
+   void Binomial::logRow(int n, Array<double>& out)
+   {
+      UTIL_CHECK(n >= 0);
+      UTIL_CHECK(out.capacity() > n);
+      double ln = logFactorial(n);
+      for (int m = 0; m <= n; ++m) {
+         out[m] = ln - logFactorial(m) - logFactorial(n - m);
+      }
    }
 
 }
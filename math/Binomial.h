@@ -8,13 +8,16 @@
 * Distributed under the terms of the GNU General Public License.
 */
 
-#include <util/containers/GArray.h>  // base class
-#include <util/math/Rational.h>      // default template argument
 #include <util/containers/Array.h>   // function argument
 #include <util/global.h>
 
+#include <stdint.h>
 
-#include <iostream>
+#ifdef UTIL_CXX11
+#define UTIL_BINOMIAL_CONSTEXPR constexpr
+#else
+#define UTIL_BINOMIAL_CONSTEXPR
+#endif
 
 namespace Util
 {
@@ -22,50 +25,151 @@ namespace Util
    /**
    * Class for binomial coefficients (all static members)
    *
+   * Exact coefficients are available in three forms:
+   *
+   *  - exact(n, m) computes C(n, m) as a 64-bit unsigned integer. It is
+   *    constexpr when compiled with UTIL_CXX11, so that coefficients
+   *    with constant arguments are evaluated at compile time.
+   *
+   *  - coeff64(n, m) and row(n) read from a table of rows n <= MaxExact
+   *    of Pascal's triangle, which is the largest n for which all C(n, m)
+   *    fit in 64 bits. For larger n, coeff64 computes C(n, m) directly,
+   *    and throws an Exception if it does not fit.
+   *
+   *  - coeff(n, m) returns an int, and throws if C(n, m) does not fit.
+   *    All C(n, m) fit for n <= MaxInt.
+   *
+   * For arbitrarily large n, logCoeff(n, m) returns ln C(n, m) from a
+   * table of logarithms of factorials that is extended as needed, in
+   * blocks that are never moved once created.
+   *
+   * When compiled with UTIL_CXX11, all functions except clear() may be
+   * called concurrently from several threads. The 64-bit table is built
+   * once, on first use, and blocks of the logarithm table are created
+   * under a lock and published atomically, so that readers never lock.
+   *
    * \ingroup Math_Module
    */
-   class Binomial 
+   class Binomial
    {
 
    public:
-  
+
+      /// Largest n for which all C(n, m) fit in an int.
+      static const int MaxInt = 33;
+
+      /// Largest n for which all C(n, m) fit in a uint64_t.
+      static const int MaxExact = 67;
+
       /**
-      * Precompute all combinations C(n, m) up to n = nMax.
+      * Precompute logarithms of factorials up to n = nMax.
       *
-      * Algorithm: Construct rows [0,...,nMax] of Pascal's triangle.
+      * Calling this before starting threads is never required, but
+      * avoids locking on first use.
       *
       * \param nMax maximum value of n to precompute.
-      */ 
+      */
       static void setup(int nMax);
-     
+
       /**
       * Release all static memory.
-      */ 
+      *
+      * Not thread safe: no other thread may use this class during a call.
+      */
       static void clear();
-     
+
       /**
       * Return coefficient "n choose m", or C(n, m) = n!/(m!(n-m)!).
       *
-      * Algorithm: Returns precomputed value C(n,m) if already known. 
-      * Otherwise, calls setup(n) to computes and stores values of
-      * C(n', m) for all n' <= n, then returns desired value.
+      * \throw Exception if C(n, m) does not fit in an int.
       *
       * \param n larger integer (overall power in binomial)
       * \param m parameter in range [0,n]
-      */ 
-      static int coeff(int n, int m); 
+      */
+      static int coeff(int n, int m);
 
-   private:
+      /**
+      * Return C(n, m) as a 64-bit unsigned integer.
+      *
+      * \throw Exception if C(n, m) does not fit in 64 bits.
+      *
+      * \param n larger integer (overall power in binomial)
+      * \param m parameter in range [0,n]
+      */
+      static uint64_t coeff64(int n, int m);
+
+      /**
+      * Return a row of Pascal's triangle, C(n, m) for m = 0, ..., n.
+      *
+      * The returned array is owned by this class and is never modified
+      * or released, and so may be used to evaluate whole polynomial
+      * expansions without further function calls.
+      *
+      * \param n row index, 0 <= n <= MaxExact
+      */
+      static uint64_t const * row(int n);
+
+      /**
+      * Return natural logarithm ln(n!) of a factorial.
+      *
+      * \param n non-negative integer
+      */
+      static double logFactorial(int n);
+
+      /**
+      * Return natural logarithm of C(n, m), for any n.
+      *
+      * \param n larger integer (overall power in binomial)
+      * \param m parameter in range [0,n]
+      */
+      static double logCoeff(int n, int m);
 
       /**
-      * Integer binomial coefficients.
+      * Compute a row of logarithms of coefficients, ln C(n, m).
+      *
+      * \param n row index, n >= 0
+      * \param out array of capacity >= n + 1 (output)
       */
-      static GArray<int> coeffs_;
+      static void logRow(int n, Array<double>& out);
 
       /**
-      * Maximum value of n index (order of polynomial).
+      * Compute C(n, m) exactly, without tables.
+      *
+      * Uses the multiplicative formula C(n, k) = C(n, k-1)*(n-k+1)/k
+      * for k <= min(m, n - m), dividing before multiplying, so that no
+      * intermediate value exceeds the result. The result is therefore
+      * exact whenever C(n, m) < 2^64, and in particular for any m if
+      * n <= MaxExact. No checks are performed.
+      *
+      * \param n larger integer (overall power in binomial)
+      * \param m parameter in range [0,n]
       */
-      static int maxN_;
+      static UTIL_BINOMIAL_CONSTEXPR
+      uint64_t exact(int n, int m)
+      {
+         return (m < 0 || m > n) ? 0 :
+                step(n, (m < n - m) ? m : n - m, 0, 1);
+      }
+
+   private:
+
+      /// Greatest common divisor (Euclid).
+      static UTIL_BINOMIAL_CONSTEXPR
+      uint64_t gcd(uint64_t a, uint64_t b)
+      {  return b == 0 ? a : gcd(b, a % b); }
+
+      /// C(n, k+1), given c = C(n, k) and g = gcd(c, k+1).
+      static UTIL_BINOMIAL_CONSTEXPR
+      uint64_t next(int n, int k, uint64_t c, uint64_t g)
+      {  return (c/g)*((uint64_t)(n - k)/((uint64_t)(k + 1)/g)); }
+
+      /// C(n, m), given c = C(n, k).
+      static UTIL_BINOMIAL_CONSTEXPR
+      uint64_t step(int n, int m, int k, uint64_t c)
+      {
+         return k == m ? c :
+                step(n, m, k + 1, next(n, k, c, gcd(c, k + 1)));
+      }
 
       /**
       * Constructor (private & not implemented, to prevents instantiation)
@@ -75,4 +179,5 @@ namespace Util
    };
 
 }
+#undef UTIL_BINOMIAL_CONSTEXPR
 #endif
@@ -110,11 +110,30 @@ namespace Util
             }
          }
 
-         // Convert polynomials coefficients from Rational to double.
-         for (n = 0; n <= degree_; ++n) {
-            floatPolynomials_[n] = exactPolynomials[n];
-         }
+      }
 
+      // Convert polynomials coefficients from Rational to double.
+      for (int n = 0; n <= degree_; ++n) {
+         floatPolynomials_[n] = exactPolynomials[n];
+      }
+
+      // Coefficients of b(u + j) and b'(u + j), as polynomials in u.
+      weightCoeffs_.allocate(size*size);
+      derivCoeffs_.allocate(size*size);
+      for (int j = 0; j <= degree_; ++j) {
+         Polynomial<Rational> shifted;
+         shifted = exactPolynomials[j].shift(Rational(j));
+         for (int k = 0; k < size; ++k) {
+            Rational c = k < shifted.size() ? shifted[k] : Rational(0);
+            weightCoeffs_[j*size + k] = (double) c;
+         }
+         for (int k = 0; k < size; ++k) {
+            derivCoeffs_[j*size + k] = 0.0;
+            if (k + 1 < size) {
+               derivCoeffs_[j*size + k] = 
+                                    (k + 1)*weightCoeffs_[j*size + k + 1];
+            }
+         }
       }
 
    }
@@ -125,4 +144,112 @@ namespace Util
    CardinalBSpline::~CardinalBSpline()
    {}
 
+   namespace {
+
+      /*
+      * Weights and derivatives for a fixed order (degree + 1).
+      *
+      * The powers of u are computed once per coordinate, after which
+      * each weight is a dot product with a row of coefficients. With
+      * Order known at compile time, all inner loops are unrolled.
+      */
+      template <int Order>
+      void splineWeights(double const * c, double const * dc,
+                         double const * u, int n,
+                         double* w, double* dw)
+      {
+         double p[Order];
+         for (int i = 0; i < n; ++i) {
+            p[0] = 1.0;
+            for (int k = 1; k < Order; ++k) {
+               p[k] = p[k-1]*u[i];
+            }
+            double* wi = w + i*Order;
+            for (int j = 0; j < Order; ++j) {
+               double sum = 0.0;
+               for (int k = 0; k < Order; ++k) {
+                  sum += c[j*Order + k]*p[k];
+               }
+               wi[j] = sum;
+            }
+            if (dw) {
+               double* dwi = dw + i*Order;
+               for (int j = 0; j < Order; ++j) {
+                  double sum = 0.0;
+                  for (int k = 0; k < Order - 1; ++k) {
+                     sum += dc[j*Order + k]*p[k];
+                  }
+                  dwi[j] = sum;
+               }
+            }
+         }
+      }
+
+      /*
+      * Weights and derivatives for any order, by Horner's method.
+      */
+      void splineWeights(int order, double const * c, double const * dc,
+                         double const * u, int n,
+                         double* w, double* dw)
+      {
+         for (int i = 0; i < n; ++i) {
+            double x = u[i];
+            for (int j = 0; j < order; ++j) {
+               double const * cj = c + j*order;
+               double sum = cj[order - 1];
+               for (int k = order - 2; k >= 0; --k) {
+                  sum = sum*x + cj[k];
+               }
+               w[i*order + j] = sum;
+               if (dw) {
+                  double const * dcj = dc + j*order;
+                  sum = dcj[order - 1];
+                  for (int k = order - 2; k >= 0; --k) {
+                     sum = sum*x + dcj[k];
+                  }
+                  dw[i*order + j] = sum;
+               }
+            }
+         }
+      }
+
+   }
+
+   /*
+   * Compute weights for an array of fractional coordinates.
+   */
+   void 
+   CardinalBSpline::weights(double const * u, int n, double* weights) const
+   {  CardinalBSpline::weights(u, n, weights, 0); }
+
+   /*
+   * Compute weights and derivatives for an array of coordinates.
+   */
+   void CardinalBSpline::weights(double const * u, int n, 
+                                 double* weights, double* derivatives) const
+   {
+      double const * c = weightCoeffs_.cArray();
+      double const * dc = derivCoeffs_.cArray();
+      switch (degree_ + 1) {
+         case 1: 
+            splineWeights<1>(c, dc, u, n, weights, derivatives); break;
+         case 2: 
+            splineWeights<2>(c, dc, u, n, weights, derivatives); break;
+         case 3: 
+            splineWeights<3>(c, dc, u, n, weights, derivatives); break;
+         case 4: 
+            splineWeights<4>(c, dc, u, n, weights, derivatives); break;
+         case 5: 
+            splineWeights<5>(c, dc, u, n, weights, derivatives); break;
+         case 6: 
+            splineWeights<6>(c, dc, u, n, weights, derivatives); break;
+         case 7: 
+            splineWeights<7>(c, dc, u, n, weights, derivatives); break;
+         case 8: 
+            splineWeights<8>(c, dc, u, n, weights, derivatives); break;
+         default:
+            splineWeights(degree_ + 1, c, dc, u, n, weights, derivatives);
+      }
+   }
+
 }
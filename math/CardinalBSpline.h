@@ -90,6 +90,51 @@ namespace Util
       */
       int degree() const;
 
+      /// \name Batch Evaluation
+      //@{
+
+      /**
+      * Compute all degree + 1 nonzero weights for one coordinate.
+      *
+      * For a point at coordinate s in units of the grid spacing, with
+      * integer part g = floor(s) and fractional part u = s - g, the
+      * value weights[j] = b(u + j) is the weight of grid point g - j,
+      * for 0 <= j <= degree.
+      *
+      * \param u  fractional coordinate, 0 <= u < 1
+      * \param weights  array of degree + 1 weights (output)
+      */
+      void weights(double u, double* weights) const;
+
+      /**
+      * Compute weights for an array of fractional coordinates.
+      *
+      * On output, weights[i*(degree+1) + j] = b(u[i] + j). Common
+      * degrees use kernels specialized at compile time, in which
+      * powers of u are computed once and shared by all weights.
+      *
+      * \param u  array of n fractional coordinates, 0 <= u[i] < 1
+      * \param n  number of coordinates
+      * \param weights  array of n*(degree+1) weights (output)
+      */
+      void weights(double const * u, int n, double* weights) const;
+
+      /**
+      * Compute weights and derivatives for an array of coordinates.
+      *
+      * As for weights(u, n, weights), and also sets derivatives[i*(degree
+      * + 1) + j] to the first derivative b'(u[i] + j).
+      *
+      * \param u  array of n fractional coordinates, 0 <= u[i] < 1
+      * \param n  number of coordinates
+      * \param weights  array of n*(degree+1) weights (output)
+      * \param derivatives  array of n*(degree+1) derivatives (output)
+      */
+      void weights(double const * u, int n, 
+                   double* weights, double* derivatives) const;
+
+      //@}
+
    private:
 
       /**
@@ -110,6 +155,22 @@ namespace Util
       */
       int degree_;
 
+      /**
+      * Coefficients of polynomials shifted to the domain [0,1].
+      *
+      * Element j*(degree+1) + k is coefficient k of the polynomial
+      * b(u + j) of u, for 0 <= u <= 1 and 0 <= j <= degree.
+      */
+      DArray<double> weightCoeffs_;
+
+      /**
+      * Coefficients of the derivatives of the shifted polynomials.
+      *
+      * Element j*(degree+1) + k is coefficient k of b'(u + j). The
+      * coefficient with k = degree is zero.
+      */
+      DArray<double> derivCoeffs_;
+
    };
 
    /*
@@ -139,5 +200,12 @@ namespace Util
    int CardinalBSpline::degree() const
    {  return degree_; }
 
+   /*
+   * Compute all weights for one fractional coordinate.
+   */
+   inline
+   void CardinalBSpline::weights(double u, double* weights) const
+   {  CardinalBSpline::weights(&u, 1, weights); }
+
 }
 #endif
@@ -0,0 +1,401 @@
+#ifndef UTIL_FIXED_POLYNOMIAL_H
+#define UTIL_FIXED_POLYNOMIAL_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/math/Polynomial.h>
+#include <util/global.h>
+
+#ifdef UTIL_CXX11
+#define UTIL_FIXED_POLYNOMIAL_CONSTEXPR constexpr
+#else
+#define UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+#endif
+
+namespace Util
+{
+
+   namespace FixedPolynomialDetail
+   {
+
+      /*
+      * Horner evaluation of c[I] + c[I+1]*x + ... + c[N]*x^{N-I}.
+      */
+      template <int I, int N>
+      struct Horner
+      {
+         static UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+         double eval(double const * c, double x)
+         {  return c[I] + x*Horner<I+1, N>::eval(c, x); }
+      };
+
+      template <int N>
+      struct Horner<N, N>
+      {
+         static UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+         double eval(double const * c, double x)
+         {  return c[N]; }
+      };
+
+      /*
+      * Largest power of 2 strictly less than M, for M >= 2.
+      */
+      template <int M, int H = 1>
+      struct Split
+      {  enum { value = (2*H < M) ? Split<M, 2*H>::value : H }; };
+
+      template <int M>
+      struct Split<M, 64>
+      {  enum { value = 64 }; };
+
+      /*
+      * x^{H} for H a power of 2, given powers p[k] = x^{2^k}.
+      */
+      template <int H, int K = 0>
+      struct Power
+      {
+         static UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+         double get(double const * p)
+         {  return Power<H/2, K+1>::get(p); }
+      };
+
+      template <int K>
+      struct Power<1, K>
+      {
+         static UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+         double get(double const * p)
+         {  return p[K]; }
+      };
+
+      /*
+      * Estrin evaluation of the M coefficients c[I], ..., c[I+M-1].
+      *
+      * The coefficients are split into a low block of H coefficients,
+      * where H is the largest power of 2 less than M, and a high block,
+      * which are evaluated independently and combined as low + x^H*high.
+      */
+      template <int I, int M>
+      struct Estrin
+      {
+         enum { H = Split<M>::value };
+
+         static UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+         double eval(double const * c, double const * p)
+         {
+            return Estrin<I, H>::eval(c, p)
+                   + Power<H>::get(p)*Estrin<I + H, M - H>::eval(c, p);
+         }
+      };
+
+      template <int I>
+      struct Estrin<I, 1>
+      {
+         static UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+         double eval(double const * c, double const * p)
+         {  return c[I]; }
+      };
+
+   }
+
+   /**
+   * A polynomial of fixed maximum degree with double coefficients.
+   *
+   * A FixedPolynomial<N> stores N+1 coefficients c[0], ..., c[N] of
+   * f(x) = c[0] + c[1] x + ... + c[N] x^N in a fixed size array, with
+   * no dynamic memory. Because the degree is known at compile time,
+   * all evaluation loops are fully unrolled. It is intended for use
+   * when the same low degree polynomial is evaluated at many points,
+   * e.g., in tabulated potentials and spline basis functions, and may
+   * be constructed from any Polynomial<T> of degree <= N.
+   *
+   * Two evaluation schemes are provided. Horner's method (operator ()
+   * and evaluate()) uses the fewest operations, but each step depends
+   * on the previous one. Estrin's method (estrin()) evaluates blocks
+   * of coefficients independently and combines them with powers x^2,
+   * x^4, ..., which shortens the chain of dependent operations and is
+   * usually faster for degree >= 4. The array forms of evaluate()
+   * apply one scheme to every element of an array of arguments, in a
+   * loop the compiler can vectorize across arguments.
+   *
+   * When compiled with UTIL_CXX11, construction from a list of
+   * coefficients and evaluation are constexpr, so polynomials with
+   * constant coefficients may be evaluated at compile time.
+   *
+   * \ingroup Math_Module
+   */
+   template <int N>
+   class FixedPolynomial
+   {
+
+   public:
+
+      /**
+      * Construct a zero polynomial.
+      */
+      FixedPolynomial();
+
+      #ifdef UTIL_CXX11
+      /**
+      * Construct from a list of coefficients, lowest power first.
+      *
+      * Coefficients that are not given are set to zero.
+      *
+      * \param c0  constant coefficient c[0]
+      * \param c  coefficients c[1], c[2], ... (at most N)
+      */
+      template <typename ... Args>
+      constexpr explicit FixedPolynomial(double c0, Args ... c)
+       : c_{c0, double(c)...}
+      {
+         static_assert(sizeof...(Args) <= N,
+                       "Too many coefficients for FixedPolynomial");
+      }
+      #endif
+
+      /**
+      * Construct from a Polynomial with any coefficient type.
+      *
+      * Throws an Exception if p.degree() > N.
+      *
+      * \param p  Polynomial with coefficients convertible to double
+      */
+      template <typename T>
+      explicit FixedPolynomial(Polynomial<T> const & p);
+
+      /**
+      * Assign from a Polynomial with any coefficient type.
+      *
+      * Throws an Exception if p.degree() > N.
+      *
+      * \param p  Polynomial with coefficients convertible to double
+      */
+      template <typename T>
+      FixedPolynomial<N>& operator = (Polynomial<T> const & p);
+
+      /**
+      * Get a coefficient by reference.
+      *
+      * \param i  power of x (0 <= i <= N)
+      */
+      double& operator [] (int i);
+
+      /**
+      * Get a coefficient by value.
+      *
+      * \param i  power of x (0 <= i <= N)
+      */
+      UTIL_FIXED_POLYNOMIAL_CONSTEXPR double operator [] (int i) const;
+
+      /**
+      * Evaluate at x by Horner's method.
+      *
+      * \param x  argument
+      */
+      UTIL_FIXED_POLYNOMIAL_CONSTEXPR double operator () (double x) const;
+
+      /**
+      * Evaluate at x by Estrin's method.
+      *
+      * \param x  argument
+      */
+      double estrin(double x) const;
+
+      /**
+      * Evaluate the polynomial and its first derivative at x.
+      *
+      * Both values are computed in a single Horner pass.
+      *
+      * \param x  argument
+      * \param f  value f(x) (output)
+      * \param df  derivative f'(x) (output)
+      */
+      void evaluate(double x, double& f, double& df) const;
+
+      /**
+      * Evaluate at an array of arguments by Estrin's method.
+      *
+      * \param x  array of n arguments
+      * \param n  number of arguments
+      * \param f  array of n values f(x[i]) (output)
+      */
+      void evaluate(double const * x, int n, double* f) const;
+
+      /**
+      * Evaluate values and first derivatives at an array of arguments.
+      *
+      * Values and derivatives are computed in a single Horner pass.
+      *
+      * \param x  array of n arguments
+      * \param n  number of arguments
+      * \param f  array of n values f(x[i]) (output)
+      * \param df  array of n derivatives f'(x[i]) (output)
+      */
+      void evaluate(double const * x, int n, double* f, double* df) const;
+
+      /**
+      * Return the maximum degree N.
+      */
+      static int maxDegree()
+      {  return N; }
+
+   private:
+
+      /// Coefficients, with c_[i] the coefficient of x^i.
+      double c_[N+1];
+
+      /// Compute powers p[k] = x^{2^k} needed by Estrin's method.
+      static void powers(double x, double* p);
+
+      /// Number of powers x^{2^k} needed by Estrin's method.
+      enum { NPower = (N < 1) ? 1 : (N < 2) ? 1 : (N < 4) ? 2
+                    : (N < 8) ? 3 : (N < 16) ? 4 : (N < 32) ? 5 : 6 };
+
+   };
+
+   // Member function definitions
+
+   /*
+   * Construct a zero polynomial.
+   */
+   template <int N>
+   inline FixedPolynomial<N>::FixedPolynomial()
+   {
+      for (int i = 0; i <= N; ++i) {
+         c_[i] = 0.0;
+      }
+   }
+
+   /*
+   * Construct from a Polynomial.
+   */
+   template <int N>
+   template <typename T>
+   FixedPolynomial<N>::FixedPolynomial(Polynomial<T> const & p)
+   {  *this = p; }
+
+   /*
+   * Assign from a Polynomial.
+   */
+   template <int N>
+   template <typename T>
+   FixedPolynomial<N>& FixedPolynomial<N>::operator =
+                                              (Polynomial<T> const & p)
+   {
+      if (p.degree() > N) {
+         UTIL_THROW("Polynomial degree exceeds FixedPolynomial maximum");
+      }
+      int size = p.size();
+      for (int i = 0; i < size; ++i) {
+         c_[i] = (double)p[i];
+      }
+      for (int i = size; i <= N; ++i) {
+         c_[i] = 0.0;
+      }
+      return *this;
+   }
+
+   /*
+   * Get a coefficient by reference.
+   */
+   template <int N>
+   inline double& FixedPolynomial<N>::operator [] (int i)
+   {
+      UTIL_ASSERT(i >= 0);
+      UTIL_ASSERT(i <= N);
+      return c_[i];
+   }
+
+   /*
+   * Get a coefficient by value.
+   */
+   template <int N>
+   inline UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+   double FixedPolynomial<N>::operator [] (int i) const
+   {  return c_[i]; }
+
+   /*
+   * Evaluate by Horner's method.
+   */
+   template <int N>
+   inline UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+   double FixedPolynomial<N>::operator () (double x) const
+   {  return FixedPolynomialDetail::Horner<0, N>::eval(c_, x); }
+
+   /*
+   * Compute powers x, x^2, x^4, ... for Estrin's method.
+   */
+   template <int N>
+   inline void FixedPolynomial<N>::powers(double x, double* p)
+   {
+      p[0] = x;
+      for (int k = 1; k < NPower; ++k) {
+         p[k] = p[k-1]*p[k-1];
+      }
+   }
+
+   /*
+   * Evaluate by Estrin's method.
+   */
+   template <int N>
+   inline double FixedPolynomial<N>::estrin(double x) const
+   {
+      double p[NPower];
+      powers(x, p);
+      return FixedPolynomialDetail::Estrin<0, N+1>::eval(c_, p);
+   }
+
+   /*
+   * Evaluate value and derivative in one Horner pass.
+   */
+   template <int N>
+   inline
+   void FixedPolynomial<N>::evaluate(double x, double& f, double& df)
+   const
+   {
+      double value = c_[N];
+      double deriv = 0.0;
+      for (int k = N - 1; k >= 0; --k) {
+         deriv = deriv*x + value;
+         value = value*x + c_[k];
+      }
+      f = value;
+      df = deriv;
+   }
+
+   /*
+   * Evaluate at an array of arguments.
+   */
+   template <int N>
+   void FixedPolynomial<N>::evaluate(double const * x, int n, double* f)
+   const
+   {
+      double const * UTIL_RESTRICT xp = x;
+      double* UTIL_RESTRICT fp = f;
+      for (int i = 0; i < n; ++i) {
+         fp[i] = estrin(xp[i]);
+      }
+   }
+
+   /*
+   * Evaluate values and derivatives at an array of arguments.
+   */
+   template <int N>
+   void FixedPolynomial<N>::evaluate(double const * x, int n,
+                                     double* f, double* df) const
+   {
+      double const * UTIL_RESTRICT xp = x;
+      double* UTIL_RESTRICT fp = f;
+      double* UTIL_RESTRICT dfp = df;
+      for (int i = 0; i < n; ++i) {
+         evaluate(xp[i], fp[i], dfp[i]);
+      }
+   }
+
+}
+#undef UTIL_FIXED_POLYNOMIAL_CONSTEXPR
+#endif
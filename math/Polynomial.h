@@ -72,6 +72,13 @@ namespace Util
       */
       Polynomial(Polynomial<T> const & other);
 
+      /**
+      * Assignment from another polynomial of the same type.
+      *
+      * \param other Polynomial to assign.
+      */
+      Polynomial<T>& operator = (Polynomial<T> const & other);
+
       /**
       * Assignment from another polynomial.
       *
@@ -80,6 +87,25 @@ namespace Util
       template <typename U>
       Polynomial<T>& operator = (Polynomial<U> const & other);
 
+      #ifdef UTIL_CXX11
+      /**
+      * Move constructor.
+      *
+      * Takes ownership of the coefficient array of the other polynomial,
+      * which is left equal to zero, with no allocated coefficients.
+      *
+      * \param other Polynomial to be moved
+      */
+      Polynomial(Polynomial<T>&& other);
+
+      /**
+      * Move assignment.
+      *
+      * \param other Polynomial to move (zero on output)
+      */
+      Polynomial<T>& operator = (Polynomial<T>&& other);
+      #endif
+
       /**
       * Assign this polynomial a value of zero.
       *
@@ -214,7 +240,8 @@ namespace Util
       * Compute and return shifted polynomial f(x+a).
       *
       * If this polynomial is f(x), this returns a polynomial g(x) = f(x+a) 
-      * created by the shift operation x-> x + a. 
+      * created by the shift operation x-> x + a. The degree may not
+      * exceed Binomial::MaxExact.
       *
       * \return polynomial created by shift operation x -> x + a.
       */
@@ -296,7 +323,9 @@ namespace Util
    inline
    Polynomial<T>::Polynomial(Polynomial<T> const & other)
    {
-      GArray<T>::reserve(other.capacity());
+      if (other.capacity() > 0) {
+         GArray<T>::reserve(other.capacity());
+      }
       if (other.size() > 0) {
         for (int i = 0; i < other.size(); ++i) {
             GArray<T>::append(other[i]);
@@ -304,6 +333,39 @@ namespace Util
       }
    }
 
+   /*
+   * Assignment from another polynomial of the same type.
+   */
+   template <typename T>
+   inline
+   Polynomial<T>& Polynomial<T>::operator = (Polynomial<T> const & other)
+   {
+      GArray<T>::operator = (other);
+      return *this;
+   }
+
+   #ifdef UTIL_CXX11
+   /*
+   * Move constructor.
+   */
+   template <typename T>
+   inline
+   Polynomial<T>::Polynomial(Polynomial<T>&& other)
+    : GArray<T>(std::move(other))
+   {}
+
+   /*
+   * Move assignment.
+   */
+   template <typename T>
+   inline
+   Polynomial<T>& Polynomial<T>::operator = (Polynomial<T>&& other)
+   {
+      GArray<T>::operator = (std::move(other));
+      return *this;
+   }
+   #endif
+
    /*
    * Assignment from another polynomial.
    */
@@ -579,13 +641,14 @@ namespace Util
 
       int degree = size() - 1;
       if (degree > 0) {
-         Binomial::setup(degree);
          int n, m;
          T p;
+         uint64_t const * c;
          for (n = 1; n <= degree; ++n) {
+            c = Binomial::row(n);
             p = b[n]*a;
             for (m = 1; m <= n; ++m) {
-               b[n -m] += Binomial::coeff(n, m)*p;
+               b[n -m] += T(c[m])*p;
                p *= a;
             }
          }
@@ -0,0 +1,188 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TabulatedFunction.h"
+#include <util/math/CardinalBSpline.h>
+#include <util/math/Polynomial.h>
+
+namespace Util
+{
+
+   /*
+   * Constructor.
+   */
+   TabulatedFunction::TabulatedFunction()
+    : coeffs_(),
+      rMin_(0.0),
+      rMax_(0.0),
+      dr_(0.0),
+      drInv_(0.0),
+      nInterval_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   TabulatedFunction::~TabulatedFunction()
+   {}
+
+   /*
+   * Set domain and allocate coefficients.
+   */
+   void TabulatedFunction::setDomain(double rMin, double rMax,
+                                     int nInterval)
+   {
+      UTIL_CHECK(rMax > rMin);
+      UTIL_CHECK(nInterval > 0);
+      if (coeffs_.isAllocated() && coeffs_.capacity() != 4*nInterval) {
+         coeffs_.deallocate();
+      }
+      if (!coeffs_.isAllocated()) {
+         coeffs_.allocate(4*nInterval, MemoryPolicy::simd());
+      }
+      rMin_ = rMin;
+      rMax_ = rMax;
+      nInterval_ = nInterval;
+      dr_ = (rMax - rMin)/double(nInterval);
+      drInv_ = 1.0/dr_;
+   }
+
+   /*
+   * Construct an interpolating cubic B-spline of tabulated values.
+   *
+   * The spline is s(t) = sum_m a[m] b(t - m + 2), in which t is the
+   * argument in units of dr measured from rMin, b is the cardinal cubic
+   * B-spline with support [0,4], and -1 <= m <= n + 1 for n intervals.
+   * Interpolation of the n + 1 values, with end derivatives clamped
+   * to third order one-sided finite differences, gives a tridiagonal
+   * system for a[0], ..., a[n], which is solved by Thomas' algorithm.
+   */
+   void TabulatedFunction::setupBSpline(Array<double> const & values,
+                                        double rMin, double rMax)
+   {
+      int n = values.capacity() - 1;
+      UTIL_CHECK(n >= 3);
+      setDomain(rMin, rMax, n);
+
+      // End derivatives, multiplied by dr
+      double d0 = (-11.0*values[0] + 18.0*values[1]
+                   - 9.0*values[2] + 2.0*values[3])/6.0;
+      double dn = (11.0*values[n] - 18.0*values[n-1]
+                   + 9.0*values[n-2] - 2.0*values[n-3])/6.0;
+
+      // Solve for a[m] = a(m + 1), for -1 <= m <= n + 1
+      DArray<double> a;
+      DArray<double> work;
+      a.allocate(n + 3);
+      work.allocate(n + 1);
+
+      // Forward elimination: row i is sub*a[i-1] + 4 a[i] + sup*a[i+1]
+      double diag = 4.0;
+      work[0] = 2.0/diag;
+      a[1] = (6.0*values[0] + 2.0*d0)/diag;
+      for (int i = 1; i <= n; ++i) {
+         double sub = (i == n) ? 2.0 : 1.0;
+         double rhs = (i == n) ? 6.0*values[n] - 2.0*dn : 6.0*values[i];
+         diag = 4.0 - sub*work[i-1];
+         work[i] = 1.0/diag;
+         a[i + 1] = (rhs - sub*a[i])/diag;
+      }
+
+      // Back substitution
+      for (int i = n - 1; i >= 0; --i) {
+         a[i + 1] -= work[i]*a[i + 2];
+      }
+
+      // Coefficients outside the grid, from clamped end derivatives
+      a[0] = a[2] - 2.0*d0;
+      a[n + 2] = a[n] + 2.0*dn;
+
+      // Coefficients of b(u + j) as polynomials in u, for 0 <= u <= 1
+      CardinalBSpline spline(3);
+      double basis[4][4];
+      for (int j = 0; j < 4; ++j) {
+         Polynomial<double> p = spline[j].shift(double(j));
+         for (int k = 0; k < 4; ++k) {
+            basis[j][k] = k < p.size() ? p[k] : 0.0;
+         }
+      }
+
+      // On interval i, a[m] contributes with weight b(u + i - m + 2)
+      for (int i = 0; i < n; ++i) {
+         double* c = coeffs_.cArray() + 4*i;
+         for (int k = 0; k < 4; ++k) {
+            double sum = 0.0;
+            for (int j = 0; j < 4; ++j) {
+               sum += a[i + 3 - j]*basis[j][k];
+            }
+            c[k] = sum;
+         }
+      }
+   }
+
+   /*
+   * Construct a cubic Hermite interpolant of tabulated values.
+   */
+   void TabulatedFunction::setupHermite(Array<double> const & values,
+                                        Array<double> const & derivatives,
+                                        double rMin, double rMax)
+   {
+      int n = values.capacity() - 1;
+      UTIL_CHECK(n >= 1);
+      UTIL_CHECK(derivatives.capacity() == n + 1);
+      setDomain(rMin, rMax, n);
+
+      for (int i = 0; i < n; ++i) {
+         double f0 = values[i];
+         double f1 = values[i+1];
+         double d0 = derivatives[i]*dr_;
+         double d1 = derivatives[i+1]*dr_;
+         double* c = coeffs_.cArray() + 4*i;
+         c[0] = f0;
+         c[1] = d0;
+         c[2] = 3.0*(f1 - f0) - 2.0*d0 - d1;
+         c[3] = 2.0*(f0 - f1) + d0 + d1;
+      }
+   }
+
+   /*
+   * Compute interpolated values at an array of arguments.
+   */
+   void TabulatedFunction::evaluate(double const * r, int n, double* f)
+   const
+   {
+      UTIL_CHECK(isSetup());
+      double const * UTIL_RESTRICT rp = r;
+      double* UTIL_RESTRICT fp = f;
+      double const * UTIL_RESTRICT coeffs = coeffs_.cArray();
+      double u;
+      for (int i = 0; i < n; ++i) {
+         double const * c = coeffs + 4*locate(rp[i], u);
+         fp[i] = c[0] + u*(c[1] + u*(c[2] + u*c[3]));
+      }
+   }
+
+   /*
+   * Compute interpolated values and derivatives at an array.
+   */
+   void TabulatedFunction::evaluate(double const * r, int n,
+                                    double* f, double* df) const
+   {
+      UTIL_CHECK(isSetup());
+      double const * UTIL_RESTRICT rp = r;
+      double* UTIL_RESTRICT fp = f;
+      double* UTIL_RESTRICT dfp = df;
+      double const * UTIL_RESTRICT coeffs = coeffs_.cArray();
+      double u;
+      for (int i = 0; i < n; ++i) {
+         double const * c = coeffs + 4*locate(rp[i], u);
+         fp[i] = c[0] + u*(c[1] + u*(c[2] + u*c[3]));
+         dfp[i] = (c[1] + u*(2.0*c[2] + u*3.0*c[3]))*drInv_;
+      }
+   }
+
+}
@@ -0,0 +1,383 @@
+#ifndef UTIL_TABULATED_FUNCTION_H
+#define UTIL_TABULATED_FUNCTION_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/DArray.h>
+#include <util/archives/serialize.h>
+#include <util/global.h>
+
+#include <cmath>
+
+namespace Util
+{
+
+   /**
+   * A piecewise cubic interpolation table for a function of one variable.
+   *
+   * A TabulatedFunction replaces an expensive function f(r) on an
+   * interval [rMin, rMax] by a piecewise cubic polynomial defined on
+   * nInterval intervals of equal width. Each interval stores the four
+   * coefficients of its cubic in the local variable u = (r - r_i)/dr,
+   * so evaluation requires only an index computation and one Horner
+   * step per coefficient, with no branches.
+   *
+   * Coefficients may be constructed in either of two ways:
+   *
+   *  - setupBSpline() constructs the interpolating cubic B-spline,
+   *    which is twice continuously differentiable. The spline basis
+   *    polynomials are obtained from a CardinalBSpline of degree 3,
+   *    and end derivatives are clamped to finite difference estimates.
+   *
+   *  - setupHermite() constructs the cubic Hermite interpolant of
+   *    given values and first derivatives, which is once continuously
+   *    differentiable and exact for the derivatives at grid points.
+   *
+   * Each method may be given either a function object, which is then
+   * sampled at the nInterval + 1 grid points, or arrays of values.
+   * The accuracy of a table may be checked with estimateError().
+   *
+   * Arguments outside [rMin, rMax] are evaluated by extrapolating the
+   * cubic of the first or last interval. Tables may be serialized, so
+   * that they need not be rebuilt on restart.
+   *
+   * \ingroup Math_Module
+   */
+   class TabulatedFunction
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      TabulatedFunction();
+
+      /**
+      * Destructor.
+      */
+      ~TabulatedFunction();
+
+      /// \name Construction of Coefficients
+      //@{
+
+      /**
+      * Construct an interpolating cubic B-spline of a function.
+      *
+      * \param f  function object, with double operator () (double)
+      * \param rMin  lower bound of tabulated domain
+      * \param rMax  upper bound of tabulated domain
+      * \param nInterval  number of intervals (>= 3)
+      */
+      template <class F>
+      void setupBSpline(F const & f, double rMin, double rMax,
+                        int nInterval);
+
+      /**
+      * Construct an interpolating cubic B-spline of tabulated values.
+      *
+      * \param values  values at rMin + i*dr, for i = 0, ..., nInterval
+      * \param rMin  lower bound of tabulated domain
+      * \param rMax  upper bound of tabulated domain
+      */
+      void setupBSpline(Array<double> const & values,
+                        double rMin, double rMax);
+
+      /**
+      * Construct the cubic Hermite interpolant of a function.
+      *
+      * \param f  function object, with double operator () (double)
+      * \param df  derivative of f, with double operator () (double)
+      * \param rMin  lower bound of tabulated domain
+      * \param rMax  upper bound of tabulated domain
+      * \param nInterval  number of intervals (>= 1)
+      */
+      template <class F, class D>
+      void setupHermite(F const & f, D const & df,
+                        double rMin, double rMax, int nInterval);
+
+      /**
+      * Construct a cubic Hermite interpolant of tabulated values.
+      *
+      * \param values  values at rMin + i*dr, for i = 0, ..., nInterval
+      * \param derivatives  derivatives at the same points
+      * \param rMin  lower bound of tabulated domain
+      * \param rMax  upper bound of tabulated domain
+      */
+      void setupHermite(Array<double> const & values,
+                        Array<double> const & derivatives,
+                        double rMin, double rMax);
+
+      //@}
+      /// \name Evaluation
+      //@{
+
+      /**
+      * Return the interpolated value at r.
+      *
+      * \param r  argument
+      */
+      double operator () (double r) const;
+
+      /**
+      * Compute the interpolated value and derivative at r.
+      *
+      * \param r  argument
+      * \param f  value (output)
+      * \param df  derivative with respect to r (output)
+      */
+      void evaluate(double r, double& f, double& df) const;
+
+      /**
+      * Compute interpolated values at an array of arguments.
+      *
+      * \param r  array of n arguments
+      * \param n  number of arguments
+      * \param f  array of n values (output)
+      */
+      void evaluate(double const * r, int n, double* f) const;
+
+      /**
+      * Compute interpolated values and derivatives at an array.
+      *
+      * \param r  array of n arguments
+      * \param n  number of arguments
+      * \param f  array of n values (output)
+      * \param df  array of n derivatives (output)
+      */
+      void evaluate(double const * r, int n, double* f, double* df) const;
+
+      /**
+      * Estimate the maximum interpolation error.
+      *
+      * Compares the table to the function f at nSample points evenly
+      * spaced within each interval, and returns the maximum absolute
+      * difference, or the maximum difference relative to max(|f|, floor)
+      * if relative is true.
+      *
+      * \param f  tabulated function object
+      * \param nSample  number of sample points per interval
+      * \param relative  if true, return maximum relative error
+      * \param floor  lower bound on |f| used for relative errors
+      */
+      template <class F>
+      double estimateError(F const & f, int nSample = 4,
+                           bool relative = false,
+                           double floor = 1.0E-12) const;
+
+      //@}
+      /// \name Accessors
+      //@{
+
+      /**
+      * Return lower bound of tabulated domain.
+      */
+      double rMin() const;
+
+      /**
+      * Return upper bound of tabulated domain.
+      */
+      double rMax() const;
+
+      /**
+      * Return number of intervals.
+      */
+      int nInterval() const;
+
+      /**
+      * Return true if coefficients have been constructed.
+      */
+      bool isSetup() const;
+
+      //@}
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * \param ar  archive
+      * \param version  archive version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+   private:
+
+      /// Coefficients, 4 per interval, lowest power of u first.
+      DArray<double> coeffs_;
+
+      /// Lower bound of domain.
+      double rMin_;
+
+      /// Upper bound of domain.
+      double rMax_;
+
+      /// Interval width.
+      double dr_;
+
+      /// Inverse of interval width.
+      double drInv_;
+
+      /// Number of intervals.
+      int nInterval_;
+
+      /// Set domain and allocate coefficients.
+      void setDomain(double rMin, double rMax, int nInterval);
+
+      /// Return interval index and set local coordinate u.
+      int locate(double r, double& u) const;
+
+   };
+
+   // Inline member functions
+
+   /*
+   * Return interval index and local coordinate.
+   *
+   * The index is clamped to [0, nInterval_ - 1] with min and max, which
+   * compilers implement without branches.
+   */
+   inline int TabulatedFunction::locate(double r, double& u) const
+   {
+      double t = (r - rMin_)*drInv_;
+      int i = (int)std::floor(t);
+      i = i < 0 ? 0 : i;
+      i = i < nInterval_ ? i : nInterval_ - 1;
+      u = t - double(i);
+      return i;
+   }
+
+   /*
+   * Return the interpolated value at r.
+   */
+   inline double TabulatedFunction::operator () (double r) const
+   {
+      UTIL_ASSERT(nInterval_ > 0);
+      double u;
+      double const * c = coeffs_.cArray() + 4*locate(r, u);
+      return c[0] + u*(c[1] + u*(c[2] + u*c[3]));
+   }
+
+   /*
+   * Compute the interpolated value and derivative at r.
+   */
+   inline
+   void TabulatedFunction::evaluate(double r, double& f, double& df) const
+   {
+      UTIL_ASSERT(nInterval_ > 0);
+      double u;
+      double const * c = coeffs_.cArray() + 4*locate(r, u);
+      f = c[0] + u*(c[1] + u*(c[2] + u*c[3]));
+      df = (c[1] + u*(2.0*c[2] + u*3.0*c[3]))*drInv_;
+   }
+
+   inline double TabulatedFunction::rMin() const
+   {  return rMin_; }
+
+   inline double TabulatedFunction::rMax() const
+   {  return rMax_; }
+
+   inline int TabulatedFunction::nInterval() const
+   {  return nInterval_; }
+
+   inline bool TabulatedFunction::isSetup() const
+   {  return nInterval_ > 0; }
+
+   // Template member functions
+
+   /*
+   * Construct an interpolating cubic B-spline of a function.
+   */
+   template <class F>
+   void TabulatedFunction::setupBSpline(F const & f, double rMin,
+                                        double rMax, int nInterval)
+   {
+      UTIL_CHECK(nInterval >= 3);
+      UTIL_CHECK(rMax > rMin);
+      DArray<double> values;
+      values.allocate(nInterval + 1);
+      double dr = (rMax - rMin)/double(nInterval);
+      for (int i = 0; i <= nInterval; ++i) {
+         values[i] = f(rMin + i*dr);
+      }
+      setupBSpline(values, rMin, rMax);
+   }
+
+   /*
+   * Construct the cubic Hermite interpolant of a function.
+   */
+   template <class F, class D>
+   void TabulatedFunction::setupHermite(F const & f, D const & df,
+                                        double rMin, double rMax,
+                                        int nInterval)
+   {
+      UTIL_CHECK(nInterval >= 1);
+      UTIL_CHECK(rMax > rMin);
+      DArray<double> values;
+      DArray<double> derivatives;
+      values.allocate(nInterval + 1);
+      derivatives.allocate(nInterval + 1);
+      double dr = (rMax - rMin)/double(nInterval);
+      for (int i = 0; i <= nInterval; ++i) {
+         values[i] = f(rMin + i*dr);
+         derivatives[i] = df(rMin + i*dr);
+      }
+      setupHermite(values, derivatives, rMin, rMax);
+   }
+
+   /*
+   * Estimate the maximum interpolation error.
+   */
+   template <class F>
+   double TabulatedFunction::estimateError(F const & f, int nSample,
+                                           bool relative,
+                                           double floor) const
+   {
+      UTIL_CHECK(isSetup());
+      UTIL_CHECK(nSample > 0);
+      double maxError = 0.0;
+      for (int i = 0; i < nInterval_; ++i) {
+         for (int k = 0; k < nSample; ++k) {
+            double r = rMin_ + (i + (k + 0.5)/double(nSample))*dr_;
+            double exact = f(r);
+            double error = std::fabs((*this)(r) - exact);
+            if (relative) {
+               double scale = std::fabs(exact);
+               error /= (scale > floor ? scale : floor);
+            }
+            if (error > maxError) {
+               maxError = error;
+            }
+         }
+      }
+      return maxError;
+   }
+
+   /*
+   * Serialize to/from an archive.
+   */
+   template <class Archive>
+   void TabulatedFunction::serialize(Archive& ar, const unsigned int version)
+   {
+      double rMin = rMin_;
+      double rMax = rMax_;
+      int nInterval = nInterval_;
+      ar & rMin;
+      ar & rMax;
+      ar & nInterval;
+      if (Archive::is_loading()) {
+         if (nInterval > 0) {
+            setDomain(rMin, rMax, nInterval);
+         }
+      }
+      if (nInterval > 0) {
+         serializeArray(ar, coeffs_.cArray(), 4*nInterval, version);
+      }
+   }
+
+}
+#endif
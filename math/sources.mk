@@ -3,7 +3,9 @@ util_math_= \
      util/math/Rational.cpp \
      util/math/Polynomial.cpp \
      util/math/Binomial.cpp \
-     util/math/CardinalBSpline.cpp 
+     util/math/CardinalBSpline.cpp \
+     util/math/BSplineSpreader.cpp \
+     util/math/TabulatedFunction.cpp 
 
 util_math_SRCS=$(addprefix $(SRC_DIR)/, $(util_math_))
 util_math_OBJS=$(addprefix $(BLD_DIR)/, $(util_math_:.cpp=.o))
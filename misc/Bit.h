@@ -8,6 +8,8 @@
 * Distributed under the terms of the GNU General Public License.
 */
 
+#include <stdint.h>
+
 namespace Util
 {
 
@@ -74,6 +76,62 @@ namespace Util
    
    };
 
+   /**
+   * Return the number of set bits in a 64-bit word (population count).
+   *
+   * \ingroup Misc_Module
+   *
+   * \param word  64-bit unsigned integer
+   */
+   inline int bitCount(uint64_t word)
+   {
+      #if defined(__GNUC__)
+      return __builtin_popcountll(word);
+      #else
+      word = word - ((word >> 1) & 0x5555555555555555ULL);
+      word = (word & 0x3333333333333333ULL) 
+           + ((word >> 2) & 0x3333333333333333ULL);
+      word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+      return int((word * 0x0101010101010101ULL) >> 56);
+      #endif
+   }
+
+   /**
+   * Return the index of the lowest set bit in a nonzero 64-bit word.
+   *
+   * \ingroup Misc_Module
+   *
+   * \param word  64-bit unsigned integer, must be nonzero
+   */
+   inline int lowestBit(uint64_t word)
+   {
+      #if defined(__GNUC__)
+      return __builtin_ctzll(word);
+      #else
+      return bitCount((word & (~word + 1)) - 1);
+      #endif
+   }
+
+   /**
+   * Return the index of the highest set bit in a nonzero 64-bit word.
+   *
+   * \ingroup Misc_Module
+   *
+   * \param word  64-bit unsigned integer, must be nonzero
+   */
+   inline int highestBit(uint64_t word)
+   {
+      #if defined(__GNUC__)
+      return 63 - __builtin_clzll(word);
+      #else
+      int bit = 0;
+      while (word >>= 1) {
+         ++bit;
+      }
+      return bit;
+      #endif
+   }
+
    /*
    * Set this bit in the flags parameter.
    */
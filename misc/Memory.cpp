@@ -6,60 +6,347 @@
 */
 
 #include "Memory.h"
+#include <util/format/Str.h>
+#include <util/format/Lng.h>
+
+#include <typeinfo>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+#ifdef UTIL_CXX11
+#include <atomic>
+#include <mutex>
+#endif
 
 namespace Util
 {
 
-   /// Number of calls to allocate.
-   int Memory::nAllocate_ = 0;
+   // Anonymous namespace for file-scope counters
+   namespace
+   {
+
+      #ifdef UTIL_CXX11
+      typedef std::atomic<long> Counter;
+      #else
+      typedef long Counter;
+      #endif
+
+      /*
+      * Statistics for one tag, or for all memory.
+      */
+      struct Counters
+      {
+         Counter total;
+         Counter max;
+         Counter nAllocate;
+         Counter nDeallocate;
+      };
+
+      /// Statistics for all memory allocated via Memory.
+      Counters global_;
+
+      /// Statistics for each tag (index 0 for untagged memory).
+      Counters tagged_[Memory::MaxTag];
+
+      /// Names of registered tags.
+      std::string tagNames_[Memory::MaxTag];
+
+      /// Number of registered tags, including tag 0.
+      Counter nTag_;
+
+      /// Are untagged allocations attributed to per-type tags?
+      bool typeTags_ = false;
 
-   /// Number of calls to de-allocate.
-   int Memory::nDeallocate_ = 0;
+      #ifdef UTIL_CXX11
+      /// Mutex that protects tag registration.
+      std::mutex tagMutex_;
+      #endif
 
-   /// Total amount of memory allocated, in bytes.
-   int Memory::total_ = 0;
+      /*
+      * Increment total, and max if needed.
+      */
+      inline void increment(Counters& counters, long nBytes)
+      {
+         #ifdef UTIL_CXX11
+         long total = counters.total.fetch_add(nBytes) + nBytes;
+         long max = counters.max.load(std::memory_order_relaxed);
+         while (total > max) {
+            if (counters.max.compare_exchange_weak(max, total)) break;
+         }
+         counters.nAllocate.fetch_add(1, std::memory_order_relaxed);
+         #else
+         counters.total += nBytes;
+         if (counters.total > counters.max) {
+            counters.max = long(counters.total);
+         }
+         ++counters.nAllocate;
+         #endif
+      }
 
-   /// Maximum of total over course of simulation.
-   int Memory::max_ = 0;
+      /*
+      * Decrement total.
+      */
+      inline void decrement(Counters& counters, long nBytes)
+      {
+         counters.total -= nBytes;
+         ++counters.nDeallocate;
+      }
+
+      /*
+      * Register a tag, or return the id of an existing tag.
+      *
+      * Returns 0 if MaxTag tags are already registered. The caller
+      * must hold tagMutex_.
+      */
+      int findOrAddTag(std::string const & name)
+      {
+         if (nTag_ == 0) {
+            tagNames_[0] = "untagged";
+            nTag_ = 1;
+         }
+         int n = nTag_;
+         for (int i = 1; i < n; ++i) {
+            if (tagNames_[i] == name) return i;
+         }
+         if (n >= Memory::MaxTag) return 0;
+         tagNames_[n] = name;
+         nTag_ = n + 1;
+         return n;
+      }
+
+      /*
+      * Copy counters into a snapshot.
+      */
+      Memory::Snapshot makeSnapshot(Counters const & counters)
+      {
+         Memory::Snapshot snapshot;
+         snapshot.total = counters.total;
+         snapshot.max = counters.max;
+         snapshot.nAllocate = counters.nAllocate;
+         snapshot.nDeallocate = counters.nDeallocate;
+         return snapshot;
+      }
+
+   }
+
+   const int Memory::MaxTag;
 
    /*
-   * Call this to ensure compilation of this file. 
+   * Call this to ensure compilation of this file, and reset max.
    */
    void Memory::initStatic()
-   {  max_ = 0; }  
+   {  global_.max = 0; }
+
+   /*
+   * Record an allocation.
+   */
+   void Memory::recordAllocate(size_t nBytes, int tag)
+   {
+      UTIL_ASSERT(tag >= 0 && tag < MaxTag);
+      increment(global_, long(nBytes));
+      increment(tagged_[tag], long(nBytes));
+   }
+
+   /*
+   * Record a deallocation.
+   */
+   void Memory::recordDeallocate(size_t nBytes, int tag)
+   {
+      UTIL_ASSERT(tag >= 0 && tag < MaxTag);
+      decrement(global_, long(nBytes));
+      decrement(tagged_[tag], long(nBytes));
+   }
 
    /*
    * Return number of calls to allocate.
    */
-   int Memory::nAllocate()
-   {  return nAllocate_; }
+   long Memory::nAllocate()
+   {  return global_.nAllocate; }
 
    /*
    * Return number of calls to deallocate.
    */
-   int Memory::nDeallocate()
-   {  return nDeallocate_; }
+   long Memory::nDeallocate()
+   {  return global_.nDeallocate; }
 
    /*
    * Return total amount of memory allocated thus far.
    */
-   int Memory::total()
-   {  return total_; }
+   long Memory::total()
+   {  return global_.total; }
 
    /*
    * Return maximum amount of allocated memory thus far.
    */
-   int Memory::max()
-   {  return max_; }
+   long Memory::max()
+   {  return global_.max; }
 
    #ifdef UTIL_MPI
-   int Memory::max(MPI::Intracomm& communicator)
-   { 
-      int maxGlobal;
-      int maxLocal = max_;
-      communicator.Allreduce(&maxLocal, &maxGlobal, 1, MPI::INT, MPI::MAX);
+   long Memory::max(MPI::Intracomm& communicator)
+   {
+      long maxGlobal;
+      long maxLocal = global_.max;
+      communicator.Allreduce(&maxLocal, &maxGlobal, 1, MPI::LONG, MPI::MAX);
       return maxGlobal;
    }
    #endif
 
-} 
+   /*
+   * Register a named tag, or return id of an existing tag.
+   */
+   int Memory::addTag(std::string const & name)
+   {
+      int tag;
+      {
+         #ifdef UTIL_CXX11
+         std::lock_guard<std::mutex> lock(tagMutex_);
+         #endif
+         tag = findOrAddTag(name);
+      }
+      if (tag == 0) {
+         UTIL_THROW("Too many Memory tags");
+      }
+      return tag;
+   }
+
+   /*
+   * Enable or disable attribution of untagged memory to types.
+   */
+   void Memory::enableTypeTags(bool enable)
+   {  typeTags_ = enable; }
+
+   /*
+   * Are untagged allocations attributed to per-type tags?
+   */
+   bool Memory::typeTagsEnabled()
+   {  return typeTags_; }
+
+   /*
+   * Return the tag for a type, or 0 if type tags are disabled.
+   */
+   int Memory::typeTag(std::type_info const & type)
+   {
+      if (!typeTags_) return 0;
+      std::string name = type.name();
+      #ifdef __GNUC__
+      int status = 0;
+      char* demangled = abi::__cxa_demangle(type.name(), 0, 0, &status);
+      if (demangled) {
+         if (status == 0) name = demangled;
+         std::free(demangled);
+      }
+      #endif
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(tagMutex_);
+      #endif
+      return findOrAddTag(name);
+   }
+
+   /*
+   * Return number of tags.
+   */
+   int Memory::nTag()
+   {
+      long n = nTag_;
+      return n > 0 ? int(n) : 1;
+   }
+
+   /*
+   * Return name of a tag.
+   */
+   std::string Memory::tagName(int tag)
+   {
+      UTIL_CHECK(tag >= 0 && tag < nTag());
+      if (tag == 0) return std::string("untagged");
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(tagMutex_);
+      #endif
+      return tagNames_[tag];
+   }
+
+   /*
+   * Return snapshot of global statistics.
+   */
+   Memory::Snapshot Memory::snapshot()
+   {  return makeSnapshot(global_); }
+
+   /*
+   * Return snapshot of statistics for one tag.
+   */
+   Memory::Snapshot Memory::snapshot(int tag)
+   {
+      UTIL_CHECK(tag >= 0 && tag < MaxTag);
+      return makeSnapshot(tagged_[tag]);
+   }
+
+   /*
+   * Reset all high-water marks to current totals.
+   */
+   void Memory::resetMax()
+   {
+      global_.max = long(global_.total);
+      for (int i = 0; i < MaxTag; ++i) {
+         tagged_[i].max = long(tagged_[i].total);
+      }
+   }
+
+   /*
+   * Write table of statistics for all tags.
+   */
+   void Memory::report(std::ostream& out)
+   {
+      out << Str("tag", 20) << Str("total", 15) << Str("max", 15)
+          << Str("nAllocate", 12) << Str("nDeallocate", 12) << std::endl;
+      Snapshot s;
+      int n = nTag();
+      for (int i = 0; i < n; ++i) {
+         s = snapshot(i);
+         if (s.nAllocate == 0) continue;
+         out << Str(tagName(i), 20) << Lng(s.total, 15) << Lng(s.max, 15)
+             << Lng(s.nAllocate, 12) << Lng(s.nDeallocate, 12)
+             << std::endl;
+      }
+      s = snapshot();
+      out << Str("all", 20) << Lng(s.total, 15) << Lng(s.max, 15)
+          << Lng(s.nAllocate, 12) << Lng(s.nDeallocate, 12) << std::endl;
+   }
+
+   #ifdef UTIL_MPI
+   /*
+   * Write table of statistics reduced over processors.
+   */
+   void Memory::report(std::ostream& out, MPI::Intracomm& communicator)
+   {
+      // Local values: total and max for each tag, then global
+      const int n = MaxTag + 1;
+      long local[2*n];
+      long reduced[2*n];
+      Snapshot s;
+      for (int i = 0; i < MaxTag; ++i) {
+         s = snapshot(i);
+         local[2*i] = s.total;
+         local[2*i + 1] = s.max;
+      }
+      s = snapshot();
+      local[2*MaxTag] = s.total;
+      local[2*MaxTag + 1] = s.max;
+      communicator.Reduce(local, reduced, 2*n, MPI::LONG, MPI::MAX, 0);
+
+      if (communicator.Get_rank() == 0) {
+         out << Str("tag", 20) << Str("max total", 15)
+             << Str("max max", 15) << std::endl;
+         int nt = nTag();
+         for (int i = 0; i < nt; ++i) {
+            if (reduced[2*i + 1] == 0) continue;
+            out << Str(tagName(i), 20) << Lng(reduced[2*i], 15)
+                << Lng(reduced[2*i+1], 15) << std::endl;
+         }
+         out << Str("all", 20) << Lng(reduced[2*MaxTag], 15)
+             << Lng(reduced[2*MaxTag+1], 15) << std::endl;
+      }
+   }
+   #endif
+
+}
@@ -9,13 +9,71 @@
 */
 
 #include <util/global.h>
+#include <util/misc/MemoryPolicy.h>
 #include <stddef.h>
 #include <iostream>
+#include <string>
 #include <new>
+#include <cstring>
+#include <cstddef>
+#include <typeinfo>
+#ifdef UTIL_CXX11
+#include <type_traits>
+#include <utility>
+#endif
 
 namespace Util
 {
 
+   namespace MemoryDetail
+   {
+
+      /*
+      * Is Data aligned more strictly than memory from new []?
+      *
+      * Before C++17, new [] does not honor extended alignment.
+      */
+      template <typename Data>
+      struct IsOverAligned
+      {
+         #ifdef UTIL_CXX11
+         enum { value = (alignof(Data) > alignof(std::max_align_t)) };
+         #else
+         enum { value = 0 };
+         #endif
+      };
+
+      /*
+      * Array new [] and delete [], for types that are not over-aligned.
+      */
+      template <typename Data, bool OverAligned>
+      struct ArrayNew
+      {
+         static Data* create(size_t size)
+         {  return new Data[size]; }
+
+         static void destroy(Data* ptr)
+         {  delete [] ptr; }
+      };
+
+      /*
+      * Over-aligned types are never allocated with new [].
+      */
+      template <typename Data>
+      struct ArrayNew<Data, true>
+      {
+         static Data* create(size_t size)
+         {
+            UTIL_THROW("new [] of over-aligned type");
+            return 0;
+         }
+
+         static void destroy(Data* ptr)
+         {  UTIL_THROW("delete [] of over-aligned type"); }
+      };
+
+   }
+
    /**
    * Provides method to allocate array.
    *
@@ -23,6 +81,30 @@ namespace Util
    * try-catch block, and keeps track of the total memory allocated via 
    * this class.
    *
+   * Overloaded versions of allocate, deallocate and reallocate take a 
+   * MemoryPolicy argument that controls alignment, page size and NUMA 
+   * placement of the allocated block. For any policy other than the
+   * default, raw memory is obtained from MemoryPolicy::allocate and the
+   * elements are constructed in place. A block must be deallocated with
+   * the same policy that was used to allocate it. The default policy
+   * is replaced by an aligned policy for types whose alignment exceeds
+   * that of std::max_align_t, which new [] does not guarantee.
+   *
+   * Reallocation relocates existing elements with Memory::relocate,
+   * which uses memcpy for trivially copyable types and move assignment 
+   * for other types when compiled with UTIL_CXX11.
+   *
+   * All counters are 64-bit. When compiled with UTIL_CXX11 they are 
+   * atomic, so that containers may be allocated concurrently from 
+   * several threads. Memory may also be attributed to named tags, 
+   * which are registered with addTag() and attached to allocations 
+   * through the MemoryPolicy of a container. Global and per-tag 
+   * statistics, including high-water marks, are available through 
+   * snapshot() and report(). A container constructed with a tagged
+   * policy, e.g. DArray<double> a(MemoryPolicy::tagged("Average")),
+   * attributes all of its memory to that tag. After enableTypeTags(true),
+   * untagged memory is instead attributed to a tag for each element type.
+   *
    * \ingroup Misc_Module
    */
    class Memory
@@ -69,13 +151,72 @@ namespace Util
       template <typename Data>
       static void reallocate(Data*& ptr, size_t oldSize, size_t newSize);
 
+      /**
+      * Allocate a C++ array with a specified memory policy.
+      *
+      * Uses new [] if policy.isDefault(). Otherwise, obtains raw 
+      * memory from policy.allocate() and default constructs each 
+      * element in place. Memory is attributed to policy.tag(), or to
+      * the tag for type Data if policy.tag() is 0 (see enableTypeTags).
+      * 
+      * \param ptr reference to pointer (output)
+      * \param size number of elements
+      * \param policy alignment, page and placement policy
+      */
+      template <typename Data>
+      static void 
+      allocate(Data*& ptr, size_t size, MemoryPolicy const & policy);
+
+      /**
+      * Deallocate a C++ array allocated with a specified memory policy.
+      *
+      * The policy must be equal to that passed to allocate().
+      * 
+      * \param ptr reference to pointer (intput, ptr = 0 on output)
+      * \param size number of elements in existing array
+      * \param policy alignment, page and placement policy
+      */
+      template <typename Data>
+      static void 
+      deallocate(Data*& ptr, size_t size, MemoryPolicy const & policy);
+
+      /**
+      * Reallocate a C++ array with a specified memory policy.
+      *
+      * Precondition: On input, newSize > oldSize.
+      *
+      * \param ptr reference to pointer (input/output)
+      * \param oldSize number of elements in existing array
+      * \param newSize number of elements in new array
+      * \param policy alignment, page and placement policy
+      */
+      template <typename Data>
+      static void reallocate(Data*& ptr, size_t oldSize, size_t newSize,
+                             MemoryPolicy const & policy);
+
+      /**
+      * Relocate elements from one constructed array to another.
+      *
+      * Transfers the values of n elements from src to dest, where both 
+      * arrays contain constructed elements. When compiled with UTIL_CXX11,
+      * trivially copyable types are copied with memcpy and other types 
+      * are move assigned, leaving the source elements in a valid but 
+      * unspecified state. Otherwise, elements are copy assigned.
+      *
+      * \param dest  destination array (output)
+      * \param src  source array (input, possibly modified)
+      * \param n  number of elements
+      */
+      template <typename Data>
+      static void relocate(Data* dest, Data* src, size_t n);
+
       /**
       * Return number of times allocate() was called.
       *
       * Each call to reallocate() also increments nAllocate(), because 
       * allocate() is called internally. 
       */
-      static int nAllocate();
+      static long nAllocate();
 
       /**
       * Return number of times deallocate() was called.
@@ -83,105 +224,354 @@ namespace Util
       * Each call to reallocate() also increments nDeallocate(), because 
       * deallocate() is called internally. 
       */
-      static int nDeallocate();
+      static long nDeallocate();
 
       /**
-      * Return total amount of memory currently allocated.
+      * Return total amount of memory currently allocated, in bytes.
       */
-      static int total();
+      static long total();
 
       /**
       * Return the maximum amount of allocated heap memory thus far.
       *
       * This function returns the temporal maximum of total().
       */
-      static int max();
+      static long max();
 
       #ifdef UTIL_MPI
       /**
       * Return max for any processor in communicator.
       */
-      static int max(MPI::Intracomm& communicator);
+      static long max(MPI::Intracomm& communicator);
+      #endif
+
+      // Attribution of memory to named tags
+
+      /**
+      * Maximum number of distinct tags, including the untagged tag 0.
+      */
+      static const int MaxTag = 64;
+
+      /**
+      * Snapshot of memory usage statistics.
+      */
+      struct Snapshot 
+      {
+         /// Memory currently allocated, in bytes.
+         long total;
+
+         /// High-water mark of total, in bytes.
+         long max;
+
+         /// Number of allocations.
+         long nAllocate;
+
+         /// Number of deallocations.
+         long nDeallocate;
+      };
+
+      /**
+      * Register a named tag for attribution of memory usage.
+      *
+      * Returns a positive integer tag id. If a tag with the same name 
+      * already exists, its id is returned. Tag 0 is reserved for 
+      * untagged allocations. A tag is attached to allocations through
+      * MemoryPolicy::setTag(), and thus through the memory policy of a 
+      * container.
+      *
+      * \throw Exception if more than MaxTag tags are registered.
+      *
+      * \param name  name of tag (e.g., name of an owning class)
+      * \return integer tag id
+      */
+      static int addTag(std::string const & name);
+
+      /**
+      * Enable or disable attribution of untagged memory to types.
+      *
+      * If enabled, an allocation with tag 0 is attributed to a tag
+      * named after the element type, registered on first use. The tag
+      * of each type is fixed by its first untagged allocation, so this
+      * should be called before any arrays of the types of interest are
+      * allocated. Types are left untagged once MaxTag tags exist.
+      *
+      * \param enable  true to enable, false to disable
+      */
+      static void enableTypeTags(bool enable);
+
+      /**
+      * Are untagged allocations attributed to per-type tags?
+      */
+      static bool typeTagsEnabled();
+
+      /**
+      * Return number of tags, including untagged tag 0.
+      */
+      static int nTag();
+
+      /**
+      * Return name of a tag.
+      *
+      * \param tag  integer tag id, 0 <= tag < nTag()
+      */
+      static std::string tagName(int tag);
+
+      /**
+      * Return a snapshot of global memory usage statistics.
+      */
+      static Snapshot snapshot();
+
+      /**
+      * Return a snapshot of statistics for memory with one tag.
+      *
+      * \param tag  integer tag id, 0 <= tag < nTag()
+      */
+      static Snapshot snapshot(int tag);
+
+      /**
+      * Reset all high-water marks to current totals.
+      *
+      * Use this to begin measurement of peak usage in a new interval.
+      */
+      static void resetMax();
+
+      /**
+      * Write a table of memory usage statistics for all tags.
+      *
+      * \param out  output stream
+      */
+      static void report(std::ostream& out);
+
+      #ifdef UTIL_MPI
+      /**
+      * Write table of statistics reduced over all processors.
+      *
+      * For each tag, reports the maximum over processors of the 
+      * current total and of the high-water mark. Must be called on
+      * all processors of the communicator, and tags must have been
+      * registered in the same order on all processors. Output is 
+      * written only on rank 0.
+      *
+      * \param out  output stream
+      * \param communicator  MPI communicator
+      */
+      static void report(std::ostream& out, MPI::Intracomm& communicator);
       #endif
 
       /**
       * Call this just to guarantee initialization of static memory.
+      *
+      * Also resets the global high-water mark max() to zero.
       */
       static void initStatic();
    
    private: 
 
-      /// Total amount of memory allocated, in bytes. 
-      static int total_;
-   
-      /// Maximum amount of memory allocated, in bytes. 
-      static int max_;
-   
-      /// Number of calls to allocate.
-      static int nAllocate_;
-   
-      /// Number of calls to deallocate.
-      static int nDeallocate_;
+      /**
+      * Record an allocation of nBytes attributed to a tag.
+      *
+      * Updates global and per-tag counters. Thread safe if compiled 
+      * with UTIL_CXX11.
+      */
+      static void recordAllocate(size_t nBytes, int tag);
+
+      /**
+      * Record a deallocation of nBytes attributed to a tag.
+      */
+      static void recordDeallocate(size_t nBytes, int tag);
+
+      /**
+      * Return the policy used to obtain raw memory for a Data array.
+      *
+      * Returns policy, or an aligned policy with the same tag if policy
+      * is the default and Data is over-aligned.
+      */
+      template <typename Data>
+      static MemoryPolicy arrayPolicy(MemoryPolicy const & policy);
+
+      /**
+      * Return the tag to which a Data array is attributed.
+      *
+      * Returns policy.tag() if nonzero, and otherwise the tag for type
+      * Data, which is 0 unless type tags were enabled when it was set.
+      */
+      template <typename Data>
+      static int tagFor(MemoryPolicy const & policy);
+
+      /**
+      * Return the tag for a type, or 0 if type tags are disabled.
+      */
+      static int typeTag(std::type_info const & type);
    
    };
+
+   /*
+   * Return the tag to which a Data array is attributed.
+   */
+   template <typename Data>
+   inline int Memory::tagFor(MemoryPolicy const & policy)
+   {
+      if (policy.tag() != 0) return policy.tag();
+      static const int tag = typeTag(typeid(Data));
+      return tag;
+   }
+
+   /*
+   * Return the policy used to obtain raw memory for a Data array.
+   */
+   template <typename Data>
+   inline MemoryPolicy Memory::arrayPolicy(MemoryPolicy const & policy)
+   {
+      #ifdef UTIL_CXX11
+      if (policy.isDefault() && MemoryDetail::IsOverAligned<Data>::value) {
+         MemoryPolicy aligned(alignof(Data));
+         aligned.setTag(policy.tag());
+         return aligned;
+      }
+      #endif
+      return policy;
+   }
    
    /*
    * Allocate a C array.
    */
    template <typename Data>
-   void Memory::allocate(Data*& ptr, size_t size)
+   inline void Memory::allocate(Data*& ptr, size_t size)
+   {  allocate(ptr, size, MemoryPolicy()); }
+
+   /*
+   * De-allocate a C array.
+   */
+   template <typename Data>
+   inline void Memory::deallocate(Data*& ptr, size_t size)
+   {  deallocate(ptr, size, MemoryPolicy()); }
+
+   /*
+   * Re-allocate a C array (allocate and copy).
+   */
+   template <typename Data>
+   inline 
+   void Memory::reallocate(Data*& ptr, size_t oldSize, size_t newSize)
+   {  reallocate(ptr, oldSize, newSize, MemoryPolicy()); }
+
+   /*
+   * Allocate a C array with a specified memory policy.
+   */
+   template <typename Data>
+   void Memory::allocate(Data*& ptr, size_t size, 
+                         MemoryPolicy const & policy)
    {
-     if (ptr) {
+      if (ptr) {
          UTIL_THROW("Attempt to allocate to non-null pointer");
       }
+      const bool overAligned = MemoryDetail::IsOverAligned<Data>::value;
+      if (policy.isDefault() && !overAligned) {
+         try {
+            ptr = MemoryDetail::ArrayNew<Data, overAligned>::create(size);
+         } catch (std::bad_alloc&) {
+            std::cout << "Allocation error" << std::endl;
+            throw;
+         }
+         recordAllocate(size*sizeof(Data), tagFor<Data>(policy));
+         return;
+      }
+      UTIL_CHECK(size > 0);
+      MemoryPolicy rawPolicy = arrayPolicy<Data>(policy);
+      void* raw = 0;
       try {
-         ptr = new Data[size];
-         total_ += (size*sizeof(Data));
-         ++nAllocate_;
-         if (total_ > max_) max_ = total_;
+         raw = rawPolicy.allocate(size*sizeof(Data));
       } catch (std::bad_alloc&) {
          std::cout << "Allocation error" << std::endl;
          throw;
       }
+
+      // Construct elements in place
+      Data* newPtr = static_cast<Data*>(raw);
+      size_t i = 0;
+      try {
+         for ( ; i < size; ++i) {
+            new(newPtr + i) Data();
+         }
+      } catch (...) {
+         while (i > 0) {
+            --i;
+            newPtr[i].~Data();
+         }
+         rawPolicy.deallocate(raw, size*sizeof(Data));
+         throw;
+      }
+      ptr = newPtr;
+      recordAllocate(size*sizeof(Data), tagFor<Data>(policy));
    }
 
    /*
-   * De-allocate a C array.
+   * De-allocate a C array allocated with a specified memory policy.
    */
    template <typename Data>
-   void Memory::deallocate(Data*& ptr, size_t size)
+   void Memory::deallocate(Data*& ptr, size_t size, 
+                           MemoryPolicy const & policy)
    {
       // Preconditions
       UTIL_CHECK(ptr);
       UTIL_CHECK(size > 0);
 
-      delete [] ptr;
+      const bool overAligned = MemoryDetail::IsOverAligned<Data>::value;
+      if (policy.isDefault() && !overAligned) {
+         MemoryDetail::ArrayNew<Data, overAligned>::destroy(ptr);
+      } else {
+         for (size_t i = 0; i < size; ++i) {
+            ptr[i].~Data();
+         }
+         MemoryPolicy rawPolicy = arrayPolicy<Data>(policy);
+         rawPolicy.deallocate(static_cast<void*>(ptr), size*sizeof(Data));
+      }
       ptr = 0;
-      total_ -= size*sizeof(Data);
-      ++nDeallocate_;
+      recordDeallocate(size*sizeof(Data), tagFor<Data>(policy));
    }
 
    /*
-   * Re-allocate a C array (allocate and copy).
+   * Re-allocate a C array with a specified memory policy.
    */
    template <typename Data>
-   void Memory::reallocate(Data*& ptr, size_t oldSize, size_t newSize)
+   void Memory::reallocate(Data*& ptr, size_t oldSize, size_t newSize,
+                           MemoryPolicy const & policy)
    {
       UTIL_CHECK(newSize > 0);
       UTIL_CHECK(newSize > oldSize);
 
       Data* newPtr = 0;
-      allocate(newPtr, newSize);
+      allocate(newPtr, newSize, policy);
       if (oldSize > 0) {
          UTIL_CHECK(ptr);
-         for (size_t i = 0; i < oldSize; ++i) {
-            newPtr[i] = ptr[i];
-         }
+         relocate(newPtr, ptr, oldSize);
          Data* oldPtr = ptr;
-         deallocate(oldPtr, oldSize);
+         deallocate(oldPtr, oldSize, policy);
       }
       ptr = newPtr;
    }
 
+   /*
+   * Relocate elements between constructed arrays.
+   */
+   template <typename Data>
+   void Memory::relocate(Data* dest, Data* src, size_t n)
+   {
+      #ifdef UTIL_CXX11
+      if (std::is_trivially_copyable<Data>::value) {
+         if (n > 0) {
+            std::memcpy((void*)dest, (void const *)src, n*sizeof(Data));
+         }
+         return;
+      }
+      for (size_t i = 0; i < n; ++i) {
+         dest[i] = std::move(src[i]);
+      }
+      #else
+      for (size_t i = 0; i < n; ++i) {
+         dest[i] = src[i];
+      }
+      #endif
+   }
+
 } 
 #endif
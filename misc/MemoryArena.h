@@ -0,0 +1,114 @@
+#ifndef UTIL_MEMORY_ARENA_H
+#define UTIL_MEMORY_ARENA_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+#include <stddef.h>
+
+namespace Util
+{
+
+   /**
+   * Abstract base class for arena memory allocators.
+   *
+   * A MemoryArena obtains large chunks of memory from the operating
+   * system and hands out smaller blocks from these chunks. Containers
+   * may be constructed against an arena by giving them a MemoryPolicy
+   * that refers to the arena (see MemoryPolicy::MemoryPolicy(MemoryArena&)).
+   * The reset() function returns all blocks to the arena at once, while
+   * retaining chunks for reuse, so that containers that are repeatedly
+   * cleared and refilled do not need to return to the system allocator.
+   *
+   * All containers that hold memory from an arena must be deallocated or
+   * destroyed before reset() or release() is called. An arena is not
+   * thread safe: each thread should use its own arena.
+   *
+   * \ingroup Misc_Module
+   */
+   class MemoryArena
+   {
+   public:
+
+      /**
+      * Default alignment of blocks, in bytes.
+      *
+      * Blocks are aligned at least as strictly as memory returned by
+      * operator new for any fundamental type.
+      */
+      static const size_t DefaultAlignment = 16;
+
+      /**
+      * Constructor.
+      */
+      MemoryArena();
+
+      /**
+      * Destructor.
+      */
+      virtual ~MemoryArena();
+
+      /**
+      * Allocate a block of memory.
+      *
+      * \param nBytes  number of bytes required
+      * \param alignment  required alignment (power of 2)
+      * \return address of block
+      */
+      virtual void* allocate(size_t nBytes, size_t alignment) = 0;
+
+      /**
+      * Return a block of memory to the arena.
+      *
+      * \param ptr  address of block returned by allocate
+      * \param nBytes  number of bytes passed to allocate
+      * \param alignment  alignment passed to allocate
+      */
+      virtual void deallocate(void* ptr, size_t nBytes, size_t alignment) = 0;
+
+      /**
+      * Return all blocks to the arena, retaining chunks for reuse.
+      */
+      virtual void reset() = 0;
+
+      /**
+      * Return all chunks to the operating system.
+      */
+      virtual void release() = 0;
+
+      /**
+      * Return total number of bytes held in chunks.
+      */
+      virtual size_t capacity() const = 0;
+
+   private:
+
+      /// Copy constructor (private and not implemented).
+      MemoryArena(MemoryArena const & other);
+
+      /// Assignment (private and not implemented).
+      MemoryArena& operator = (MemoryArena const & other);
+
+   };
+
+   // Inline member functions
+
+   /*
+   * Constructor.
+   */
+   inline MemoryArena::MemoryArena()
+   {}
+
+   /*
+   * Destructor.
+   */
+   inline MemoryArena::~MemoryArena()
+   {}
+
+}
+#endif
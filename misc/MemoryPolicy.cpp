@@ -0,0 +1,316 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "MemoryPolicy.h"
+#include "MemoryArena.h"
+#include "Memory.h"
+
+#include <new>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Util
+{
+
+   // Anonymous namespace for file-scope utilities
+   namespace
+   {
+
+      #ifdef __linux__
+      // Linux NUMA policy constants (see linux/mempolicy.h)
+      const int MpolInterleave = 3;
+      const int MpolLocal = 4;
+      const int MpolFMemsAllowed = (1 << 2);
+
+      // Maximum number of NUMA nodes in a node mask
+      const unsigned long MaxNode = 1024;
+      const int NodeMaskLength = MaxNode/(8*sizeof(unsigned long));
+      #endif
+
+      /*
+      * Return the operating system page size, in bytes.
+      */
+      size_t pageSize()
+      {
+         static size_t size = 0;
+         if (size == 0) {
+            long value = sysconf(_SC_PAGESIZE);
+            size = (value > 0) ? size_t(value) : 4096;
+         }
+         return size;
+      }
+
+      /*
+      * Round nBytes up to the nearest multiple of unit.
+      */
+      size_t roundUp(size_t nBytes, size_t unit)
+      {  return ((nBytes + unit - 1)/unit)*unit; }
+
+   }
+
+   // Static constants
+
+   const size_t MemoryPolicy::CacheLineSize;
+   const size_t MemoryPolicy::SimdAlignment;
+   const size_t MemoryPolicy::HugePageSize;
+
+   /*
+   * Default constructor.
+   */
+   MemoryPolicy::MemoryPolicy()
+    : alignment_(0),
+      pageMode_(StandardPages),
+      placement_(FirstTouch),
+      tag_(0),
+      arena_(0)
+   {}
+
+   /*
+   * Constructor.
+   */
+   MemoryPolicy::MemoryPolicy(size_t alignment, PageMode pageMode,
+                              Placement placement)
+    : alignment_(alignment),
+      pageMode_(pageMode),
+      placement_(placement),
+      tag_(0),
+      arena_(0)
+   {
+      if (alignment_ & (alignment_ - 1)) {
+         UTIL_THROW("Alignment must be zero or a power of 2");
+      }
+      if (pageMode_ != StandardPages && alignment_ > HugePageSize) {
+         UTIL_THROW("Alignment cannot exceed huge page size");
+      }
+   }
+
+   /*
+   * Constructor for a policy that uses an arena.
+   */
+   MemoryPolicy::MemoryPolicy(MemoryArena& arena, size_t alignment)
+    : alignment_(alignment),
+      pageMode_(StandardPages),
+      placement_(FirstTouch),
+      tag_(0),
+      arena_(&arena)
+   {
+      if (alignment_ & (alignment_ - 1)) {
+         UTIL_THROW("Alignment must be zero or a power of 2");
+      }
+   }
+
+   // Static factory functions
+
+   MemoryPolicy MemoryPolicy::cacheLine()
+   {  return MemoryPolicy(CacheLineSize); }
+
+   MemoryPolicy MemoryPolicy::simd()
+   {  return MemoryPolicy(SimdAlignment); }
+
+   MemoryPolicy MemoryPolicy::hugePages(bool explicitPages)
+   {
+      if (explicitPages) {
+         return MemoryPolicy(HugePageSize, HugePages);
+      } else {
+         return MemoryPolicy(HugePageSize, TransparentHugePages);
+      }
+   }
+
+   MemoryPolicy MemoryPolicy::interleaved()
+   {  return MemoryPolicy(CacheLineSize, StandardPages, Interleaved); }
+
+   MemoryPolicy MemoryPolicy::localNode()
+   {  return MemoryPolicy(CacheLineSize, StandardPages, LocalNode); }
+
+   MemoryPolicy MemoryPolicy::tagged(std::string const & name)
+   {
+      MemoryPolicy policy;
+      policy.setTag(Memory::addTag(name));
+      return policy;
+   }
+
+   /*
+   * Allocate a raw memory block.
+   */
+   void* MemoryPolicy::allocate(size_t nBytes) const
+   {
+      UTIL_CHECK(nBytes > 0);
+      void* ptr = 0;
+
+      if (arena_) {
+         return arena_->allocate(nBytes, arenaAlignment());
+      }
+
+      #ifdef __linux__
+      if (pageMode_ != StandardPages || placement_ != FirstTouch) {
+
+         // Page-granular block obtained directly from mmap
+         size_t unit = (pageMode_ == StandardPages) ? pageSize()
+                                                    : HugePageSize;
+         size_t length = roundUp(nBytes, unit);
+
+         #ifdef MAP_HUGETLB
+         if (pageMode_ == HugePages) {
+            ptr = mmap(0, length, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr == MAP_FAILED) {
+               ptr = 0;
+            }
+         }
+         #endif
+
+         if (!ptr) {
+            // Over-allocate, then trim to an aligned block
+            size_t align = unit > alignment_ ? unit : alignment_;
+            size_t extra = (align > pageSize()) ? align : 0;
+            void* raw = mmap(0, length + extra, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) {
+               throw std::bad_alloc();
+            }
+            char* begin = (char*) raw;
+            char* aligned = (char*) roundUp((size_t)begin, align);
+            if (aligned > begin) {
+               munmap(begin, aligned - begin);
+            }
+            char* end = begin + length + extra;
+            if (aligned + length < end) {
+               munmap(aligned + length, end - (aligned + length));
+            }
+            ptr = (void*) aligned;
+            #ifdef MADV_HUGEPAGE
+            if (pageMode_ != StandardPages) {
+               madvise(ptr, length, MADV_HUGEPAGE);
+            }
+            #endif
+         }
+
+         place(ptr, length);
+         return ptr;
+      }
+      #endif
+
+      // Aligned block from the C library heap
+      size_t align = alignment_;
+      if (pageMode_ != StandardPages || placement_ != FirstTouch) {
+         if (align < pageSize()) align = pageSize();
+      }
+      if (align < sizeof(void*)) align = sizeof(void*);
+      if (posix_memalign(&ptr, align, nBytes) != 0) {
+         throw std::bad_alloc();
+      }
+      return ptr;
+   }
+
+   /*
+   * Release a raw memory block.
+   */
+   void MemoryPolicy::deallocate(void* ptr, size_t nBytes) const
+   {
+      UTIL_CHECK(ptr);
+      if (arena_) {
+         arena_->deallocate(ptr, nBytes, arenaAlignment());
+         return;
+      }
+      #ifdef __linux__
+      if (pageMode_ != StandardPages || placement_ != FirstTouch) {
+         size_t unit = (pageMode_ == StandardPages) ? pageSize()
+                                                    : HugePageSize;
+         munmap(ptr, roundUp(nBytes, unit));
+         return;
+      }
+      #endif
+      free(ptr);
+   }
+
+   /*
+   * Return alignment of blocks requested from an arena.
+   */
+   size_t MemoryPolicy::arenaAlignment() const
+   {
+      if (alignment_ > MemoryArena::DefaultAlignment) {
+         return alignment_;
+      } else {
+         return MemoryArena::DefaultAlignment;
+      }
+   }
+
+   /*
+   * Apply NUMA placement policy to a page-aligned block.
+   */
+   void MemoryPolicy::place(void* ptr, size_t nBytes) const
+   {
+      #ifdef __linux__
+      #ifdef SYS_mbind
+      if (placement_ == LocalNode) {
+         syscall(SYS_mbind, ptr, nBytes, MpolLocal, 0, 0, 0);
+      } else
+      if (placement_ == Interleaved) {
+         unsigned long mask[NodeMaskLength];
+         for (int i = 0; i < NodeMaskLength; ++i) {
+            mask[i] = 0;
+         }
+         if (syscall(SYS_get_mempolicy, 0, mask, MaxNode, 0,
+                     MpolFMemsAllowed) == 0) {
+            syscall(SYS_mbind, ptr, nBytes, MpolInterleave, mask,
+                    MaxNode + 1, 0);
+         }
+      }
+      #endif
+      #endif
+   }
+
+   /*
+   * Are huge pages available?
+   */
+   bool MemoryPolicy::hasHugePages()
+   {
+      #ifdef __linux__
+      return (access("/sys/kernel/mm/transparent_hugepage/enabled",
+                     F_OK) == 0);
+      #else
+      return false;
+      #endif
+   }
+
+   /*
+   * Is NUMA placement supported?
+   */
+   bool MemoryPolicy::hasNuma()
+   {
+      #if defined(__linux__) && defined(SYS_get_mempolicy)
+      int mode;
+      return (syscall(SYS_get_mempolicy, &mode, 0, 0, 0, 0) == 0);
+      #else
+      return false;
+      #endif
+   }
+
+   /*
+   * Equality operator.
+   */
+   bool operator == (MemoryPolicy const & a, MemoryPolicy const & b)
+   {
+      return (a.alignment() == b.alignment()
+              && a.pageMode() == b.pageMode()
+              && a.placement() == b.placement()
+              && a.tag() == b.tag()
+              && a.arena() == b.arena());
+   }
+
+   /*
+   * Inequality operator.
+   */
+   bool operator != (MemoryPolicy const & a, MemoryPolicy const & b)
+   {  return !(a == b); }
+
+}
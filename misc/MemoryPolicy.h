@@ -0,0 +1,279 @@
+#ifndef UTIL_MEMORY_POLICY_H
+#define UTIL_MEMORY_POLICY_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+#include <stddef.h>
+#include <string>
+
+namespace Util
+{
+
+   class MemoryArena;
+
+   /**
+   * Placement and alignment policy for a block of allocated memory.
+   *
+   * A MemoryPolicy describes how the raw memory for an array should
+   * be obtained from the operating system: the required alignment of
+   * the first element, whether the block should be backed by 2 MB huge
+   * pages, and how pages should be distributed among NUMA nodes.
+   *
+   * The default policy (alignment 0, standard pages, first-touch
+   * placement) is a request for the ordinary behavior of operator
+   * new []. Memory::allocate and Memory::deallocate use new [] and
+   * delete [] for the default policy, and obtain raw memory through
+   * the allocate and deallocate member functions of this class for
+   * any other policy.
+   *
+   * Huge page and NUMA placement requests are treated as hints: If
+   * explicit huge pages are not available, the allocation falls back
+   * to transparent huge pages. If the operating system does not
+   * support a requested NUMA placement, the default placement is used.
+   * Alignment requests are always honored.
+   *
+   * A policy may instead refer to a MemoryArena, from which all memory 
+   * is then obtained (see MonotonicArena and PoolArena). Page mode and 
+   * placement are then determined by the chunks held by the arena.
+   *
+   * A MemoryPolicy also carries an integer tag that is used by the
+   * Memory class to attribute allocated memory to a named category 
+   * (see Memory::addTag). The tag does not affect how memory is 
+   * obtained, and is ignored by isDefault().
+   *
+   * \ingroup Misc_Module
+   */
+   class MemoryPolicy
+   {
+   public:
+
+      /**
+      * Page size requested for a memory block.
+      */
+      enum PageMode {StandardPages, TransparentHugePages, HugePages};
+
+      /**
+      * NUMA placement requested for pages of a memory block.
+      */
+      enum Placement {FirstTouch, LocalNode, Interleaved};
+
+      /**
+      * Size of a cache line, in bytes.
+      */
+      static const size_t CacheLineSize = 64;
+
+      /**
+      * Required alignment for aligned AVX-512 loads and stores, in bytes.
+      */
+      static const size_t SimdAlignment = 64;
+
+      /**
+      * Size of a huge page, in bytes.
+      */
+      static const size_t HugePageSize = 2097152;
+
+      /**
+      * Default constructor (default alignment, pages and placement).
+      */
+      MemoryPolicy();
+
+      /**
+      * Constructor.
+      *
+      * \param alignment  required alignment in bytes (0 or a power of 2)
+      * \param pageMode  requested page size
+      * \param placement  requested NUMA page placement
+      */
+      explicit MemoryPolicy(size_t alignment,
+                            PageMode pageMode = StandardPages,
+                            Placement placement = FirstTouch);
+
+      /**
+      * Constructor for a policy that obtains memory from an arena.
+      *
+      * The arena must outlive all memory allocated with this policy.
+      *
+      * \param arena  arena allocator
+      * \param alignment  required alignment in bytes (0 or a power of 2)
+      */
+      explicit MemoryPolicy(MemoryArena& arena, size_t alignment = 0);
+
+      /**
+      * Return a policy for a block aligned to a cache line boundary.
+      */
+      static MemoryPolicy cacheLine();
+
+      /**
+      * Return a policy for a block aligned for AVX-512 vector access.
+      */
+      static MemoryPolicy simd();
+
+      /**
+      * Return a policy for a block backed by huge pages.
+      *
+      * \param explicitPages if true, request explicit (hugetlbfs) pages
+      */
+      static MemoryPolicy hugePages(bool explicitPages = false);
+
+      /**
+      * Return a policy for a block interleaved among NUMA nodes.
+      */
+      static MemoryPolicy interleaved();
+
+      /**
+      * Return a policy for a block placed on the local NUMA node.
+      */
+      static MemoryPolicy localNode();
+
+      /**
+      * Return a default policy with a named tag.
+      *
+      * The tag is registered with Memory::addTag(name). Pass the
+      * result to a container constructor to attribute all memory of
+      * the container to this tag.
+      *
+      * \param name  name of tag
+      */
+      static MemoryPolicy tagged(std::string const & name);
+
+      /**
+      * Allocate a raw block of memory according to this policy.
+      *
+      * This function only obtains and places memory; it does not
+      * construct any objects.
+      *
+      * \throw std::bad_alloc if memory cannot be obtained.
+      *
+      * \param nBytes  number of bytes to allocate (nBytes > 0)
+      * \return pointer to first byte of block
+      */
+      void* allocate(size_t nBytes) const;
+
+      /**
+      * Release a raw block of memory obtained from allocate().
+      *
+      * \param ptr  pointer returned by allocate
+      * \param nBytes  number of bytes passed to allocate
+      */
+      void deallocate(void* ptr, size_t nBytes) const;
+
+      /**
+      * Return the required alignment, in bytes (0 if default).
+      */
+      size_t alignment() const;
+
+      /**
+      * Return the requested page size mode.
+      */
+      PageMode pageMode() const;
+
+      /**
+      * Return the requested NUMA page placement.
+      */
+      Placement placement() const;
+
+      /**
+      * Return pointer to the associated arena (null if none).
+      */
+      MemoryArena* arena() const;
+
+      /**
+      * Set the integer tag used for attribution of memory usage.
+      *
+      * \param tag  tag id returned by Memory::addTag (0 if untagged)
+      */
+      void setTag(int tag);
+
+      /**
+      * Return the integer tag used for attribution of memory usage.
+      */
+      int tag() const;
+
+      /**
+      * Is this the default policy, equivalent to operator new []?
+      */
+      bool isDefault() const;
+
+      /**
+      * Are huge pages available on this system?
+      *
+      * Returns true if huge page requests are supported by the
+      * operating system. Transparent huge pages are then used as a
+      * fallback for explicit huge page requests that cannot be met.
+      */
+      static bool hasHugePages();
+
+      /**
+      * Is NUMA page placement supported on this system?
+      */
+      static bool hasNuma();
+
+   private:
+
+      /// Required alignment in bytes, 0 for default alignment.
+      size_t alignment_;
+
+      /// Requested page size.
+      PageMode pageMode_;
+
+      /// Requested NUMA placement.
+      Placement placement_;
+
+      /// Tag for attribution of memory usage.
+      int tag_;
+
+      /// Arena from which memory is obtained, if any.
+      MemoryArena* arena_;
+
+      /// Apply NUMA placement hint to a block (no-op if unsupported).
+      void place(void* ptr, size_t nBytes) const;
+
+      /// Return alignment of blocks requested from arena_.
+      size_t arenaAlignment() const;
+
+   };
+
+   /**
+   * Equality operator for MemoryPolicy objects.
+   */
+   bool operator == (MemoryPolicy const & a, MemoryPolicy const & b);
+
+   /**
+   * Inequality operator for MemoryPolicy objects.
+   */
+   bool operator != (MemoryPolicy const & a, MemoryPolicy const & b);
+
+   // Inline member functions
+
+   inline size_t MemoryPolicy::alignment() const
+   {  return alignment_; }
+
+   inline MemoryPolicy::PageMode MemoryPolicy::pageMode() const
+   {  return pageMode_; }
+
+   inline MemoryPolicy::Placement MemoryPolicy::placement() const
+   {  return placement_; }
+
+   inline MemoryArena* MemoryPolicy::arena() const
+   {  return arena_; }
+
+   inline void MemoryPolicy::setTag(int tag)
+   {  tag_ = tag; }
+
+   inline int MemoryPolicy::tag() const
+   {  return tag_; }
+
+   inline bool MemoryPolicy::isDefault() const
+   {
+      return (alignment_ == 0 && pageMode_ == StandardPages
+              && placement_ == FirstTouch && arena_ == 0);
+   }
+
+}
+#endif
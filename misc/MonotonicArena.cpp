@@ -0,0 +1,123 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "MonotonicArena.h"
+
+namespace Util
+{
+
+   const size_t MemoryArena::DefaultAlignment;
+
+   /*
+   * Constructor.
+   */
+   MonotonicArena::MonotonicArena(size_t chunkSize,
+                                  MemoryPolicy const & chunkPolicy)
+    : MemoryArena(),
+      first_(0),
+      current_(0),
+      offset_(0),
+      chunkSize_(chunkSize),
+      capacity_(0),
+      usedBefore_(0),
+      chunkPolicy_(chunkPolicy)
+   {
+      UTIL_CHECK(chunkSize_ > sizeof(Chunk));
+      if (chunkPolicy_.arena()) {
+         UTIL_THROW("Chunks of an arena cannot be obtained from an arena");
+      }
+   }
+
+   /*
+   * Destructor.
+   */
+   MonotonicArena::~MonotonicArena()
+   {  release(); }
+
+   /*
+   * Allocate a block by advancing the current position.
+   */
+   void* MonotonicArena::allocate(size_t nBytes, size_t alignment)
+   {
+      UTIL_ASSERT(alignment > 0);
+      UTIL_ASSERT((alignment & (alignment - 1)) == 0);
+      size_t begin;
+      while (current_) {
+         size_t address = (size_t)current_ + offset_;
+         begin = ((address + alignment - 1) & ~(alignment - 1))
+                 - (size_t)current_;
+         if (begin + nBytes <= current_->size) {
+            offset_ = begin + nBytes;
+            return (void*)((char*)current_ + begin);
+         }
+         // Move to next chunk (retained from before a reset), if any
+         if (!current_->next) break;
+         usedBefore_ += offset_;
+         current_ = current_->next;
+         offset_ = sizeof(Chunk);
+      }
+
+      // Add a new chunk, large enough for this block
+      Chunk* chunk = addChunk(nBytes + alignment);
+      if (current_) {
+         usedBefore_ += offset_;
+         current_->next = chunk;
+      } else {
+         first_ = chunk;
+      }
+      current_ = chunk;
+      size_t address = (size_t)current_ + sizeof(Chunk);
+      begin = ((address + alignment - 1) & ~(alignment - 1))
+              - (size_t)current_;
+      offset_ = begin + nBytes;
+      UTIL_ASSERT(offset_ <= current_->size);
+      return (void*)((char*)current_ + begin);
+   }
+
+   /*
+   * Rewind to the first chunk.
+   */
+   void MonotonicArena::reset()
+   {
+      current_ = first_;
+      offset_ = first_ ? sizeof(Chunk) : 0;
+      usedBefore_ = 0;
+   }
+
+   /*
+   * Return all chunks to the operating system.
+   */
+   void MonotonicArena::release()
+   {
+      Chunk* chunk = first_;
+      while (chunk) {
+         Chunk* next = chunk->next;
+         chunkPolicy_.deallocate((void*)chunk, chunk->size);
+         chunk = next;
+      }
+      first_ = 0;
+      current_ = 0;
+      offset_ = 0;
+      capacity_ = 0;
+      usedBefore_ = 0;
+   }
+
+   /*
+   * Obtain a new chunk with at least nBytes usable bytes.
+   */
+   MonotonicArena::Chunk* MonotonicArena::addChunk(size_t nBytes)
+   {
+      size_t size = nBytes + sizeof(Chunk);
+      if (size < chunkSize_) size = chunkSize_;
+      Chunk* chunk = (Chunk*) chunkPolicy_.allocate(size);
+      chunk->next = 0;
+      chunk->size = size;
+      capacity_ += size;
+      return chunk;
+   }
+
+}
@@ -0,0 +1,152 @@
+#ifndef UTIL_MONOTONIC_ARENA_H
+#define UTIL_MONOTONIC_ARENA_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/misc/MemoryArena.h>
+#include <util/misc/MemoryPolicy.h>
+
+namespace Util
+{
+
+   /**
+   * A monotonic (bump pointer) arena allocator.
+   *
+   * A MonotonicArena hands out blocks by advancing a pointer through
+   * a list of chunks. Individual blocks are never reused: deallocate()
+   * does nothing, and all memory is reclaimed at once by reset(). This
+   * is the cheapest possible allocator for data structures that are
+   * built, used and then discarded as a whole, such as cell and
+   * neighbor lists that are rebuilt periodically.
+   *
+   * Chunks are obtained through a MemoryPolicy, so an arena may itself
+   * be backed by huge pages or NUMA-interleaved memory.
+   *
+   * \ingroup Misc_Module
+   */
+   class MonotonicArena : public MemoryArena
+   {
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param chunkSize  minimum size of each chunk, in bytes
+      * \param chunkPolicy  policy used to obtain chunks
+      */
+      explicit
+      MonotonicArena(size_t chunkSize = 1048576,
+                     MemoryPolicy const & chunkPolicy = MemoryPolicy());
+
+      /**
+      * Destructor.
+      *
+      * Returns all chunks to the operating system.
+      */
+      virtual ~MonotonicArena();
+
+      /**
+      * Allocate a block by advancing the current position.
+      *
+      * \param nBytes  number of bytes required
+      * \param alignment  required alignment (power of 2)
+      * \return address of block
+      */
+      virtual void* allocate(size_t nBytes, size_t alignment);
+
+      /**
+      * Does nothing: memory is reclaimed only by reset().
+      *
+      * \param ptr  address of block returned by allocate
+      * \param nBytes  number of bytes passed to allocate
+      * \param alignment  alignment passed to allocate
+      */
+      virtual void deallocate(void* ptr, size_t nBytes, size_t alignment);
+
+      /**
+      * Rewind to the beginning of the first chunk.
+      */
+      virtual void reset();
+
+      /**
+      * Return all chunks to the operating system.
+      */
+      virtual void release();
+
+      /**
+      * Return total number of bytes held in chunks.
+      */
+      virtual size_t capacity() const;
+
+      /**
+      * Return number of bytes handed out since the last reset.
+      *
+      * Includes padding required for alignment.
+      */
+      size_t used() const;
+
+   private:
+
+      /*
+      * Header at the beginning of each chunk.
+      */
+      struct Chunk
+      {
+         Chunk* next;
+         size_t size;
+      };
+
+      /// First chunk in linked list of chunks.
+      Chunk* first_;
+
+      /// Chunk from which blocks are currently allocated.
+      Chunk* current_;
+
+      /// Offset of next free byte within current_ chunk.
+      size_t offset_;
+
+      /// Minimum chunk size.
+      size_t chunkSize_;
+
+      /// Total size of all chunks.
+      size_t capacity_;
+
+      /// Bytes consumed in all chunks preceding current_.
+      size_t usedBefore_;
+
+      /// Policy used to obtain chunks.
+      MemoryPolicy chunkPolicy_;
+
+      /// Obtain a new chunk of at least nBytes usable bytes.
+      Chunk* addChunk(size_t nBytes);
+
+   };
+
+   // Inline member functions
+
+   /*
+   * Blocks are not reused individually.
+   */
+   inline void 
+   MonotonicArena::deallocate(void* ptr, size_t nBytes, size_t alignment)
+   {}
+
+   /*
+   * Return total number of bytes held in chunks.
+   */
+   inline size_t MonotonicArena::capacity() const
+   {  return capacity_; }
+
+   /*
+   * Return number of bytes handed out since last reset.
+   */
+   inline size_t MonotonicArena::used() const
+   {  return usedBefore_ + offset_; }
+
+}
+#endif
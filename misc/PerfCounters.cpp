@@ -0,0 +1,187 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace Util
+{
+
+   const int PerfCounters::NEvent;
+
+   #ifdef __linux__
+   namespace
+   {
+
+      /// Hardware event configuration for each Event.
+      const unsigned long long EventConfig[PerfCounters::NEvent] =
+         {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+          PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+      /*
+      * Open one counter for the calling thread, in group of leader.
+      */
+      int openEvent(unsigned long long config, int leader)
+      {
+         struct perf_event_attr attr;
+         std::memset(&attr, 0, sizeof(attr));
+         attr.size = sizeof(attr);
+         attr.type = PERF_TYPE_HARDWARE;
+         attr.config = config;
+         attr.read_format = PERF_FORMAT_GROUP
+                          | PERF_FORMAT_TOTAL_TIME_ENABLED
+                          | PERF_FORMAT_TOTAL_TIME_RUNNING;
+         attr.exclude_kernel = 1;
+         attr.exclude_hv = 1;
+         return syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+      }
+
+   }
+   #endif
+
+   /*
+   * Constructor.
+   */
+   PerfCounters::PerfCounters()
+    : nOpen_(0),
+      error_()
+   {
+      for (int i = 0; i < NEvent; ++i) {
+         fd_[i] = -1;
+         order_[i] = -1;
+      }
+   }
+
+   /*
+   * Destructor.
+   */
+   PerfCounters::~PerfCounters()
+   {  close(); }
+
+   /*
+   * Open counters for the calling thread.
+   */
+   bool PerfCounters::open()
+   {
+      close();
+      #ifdef __linux__
+      int leader = -1;
+      for (int i = 0; i < NEvent; ++i) {
+         int fd = openEvent(EventConfig[i], leader);
+         if (fd < 0) {
+            if (error_.empty()) {
+               error_ = std::string(eventName(i)) + ": "
+                      + std::strerror(errno);
+            }
+            continue;
+         }
+         if (leader < 0) leader = fd;
+         fd_[i] = fd;
+         order_[nOpen_] = i;
+         ++nOpen_;
+      }
+      #else
+      error_ = "perf_event is not supported on this platform";
+      #endif
+      return nOpen_ > 0;
+   }
+
+   /*
+   * Close all counters.
+   */
+   void PerfCounters::close()
+   {
+      #ifdef __linux__
+      // Close group members before the leader
+      for (int j = nOpen_ - 1; j >= 0; --j) {
+         ::close(fd_[order_[j]]);
+      }
+      #endif
+      for (int i = 0; i < NEvent; ++i) {
+         fd_[i] = -1;
+         order_[i] = -1;
+      }
+      nOpen_ = 0;
+      error_.clear();
+   }
+
+   /*
+   * Read current counts and times, without scaling.
+   */
+   void PerfCounters::read(long* values, long& enabled, long& running) const
+   {
+      for (int i = 0; i < NEvent; ++i) {
+         values[i] = 0;
+      }
+      enabled = 0;
+      running = 0;
+      #ifdef __linux__
+      if (nOpen_ == 0) return;
+
+      // Group read format: number of values, time enabled, time
+      // running, then one value per event
+      unsigned long long buffer[NEvent + 3];
+      ssize_t size = ::read(fd_[order_[0]], buffer, sizeof(buffer));
+      if (size < 3*(ssize_t)sizeof(unsigned long long)) return;
+      int n = buffer[0];
+      if (n > nOpen_) n = nOpen_;
+      enabled = (long) buffer[1];
+      running = (long) buffer[2];
+      for (int j = 0; j < n; ++j) {
+         values[order_[j]] = (long) buffer[j + 3];
+      }
+      #endif
+   }
+
+   /*
+   * Read current counts, scaled for multiplexing.
+   */
+   double PerfCounters::read(long* values) const
+   {
+      long enabled, running;
+      read(values, enabled, running);
+      return scale(values, enabled, running);
+   }
+
+   /*
+   * Scale counts by enabled/running time.
+   */
+   double PerfCounters::scale(long* values, long enabled, long running)
+   {
+      if (running <= 0) {
+         for (int i = 0; i < NEvent; ++i) {
+            values[i] = 0;
+         }
+         return 0.0;
+      }
+      if (running >= enabled) return 1.0;
+      double ratio = double(enabled)/double(running);
+      for (int i = 0; i < NEvent; ++i) {
+         values[i] = (long) (double(values[i])*ratio + 0.5);
+      }
+      return double(running)/double(enabled);
+   }
+
+   /*
+   * Short name of an event.
+   */
+   const char* PerfCounters::eventName(int event)
+   {
+      static const char* names[NEvent] =
+         {"cycles", "instructions", "cacheMisses", "branchMisses"};
+      UTIL_CHECK(event >= 0 && event < NEvent);
+      return names[event];
+   }
+
+}
@@ -0,0 +1,169 @@
+#ifndef UTIL_PERF_COUNTERS_H
+#define UTIL_PERF_COUNTERS_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+#include <string>
+
+namespace Util
+{
+
+   /**
+   * Hardware performance counters for the calling thread.
+   *
+   * On Linux, open() creates a group of perf_event counters for CPU
+   * cycles, instructions, last level cache misses and branch misses,
+   * counting only the calling thread in user space. Events that cannot
+   * be opened, for example in a container or virtual machine without
+   * access to the performance monitoring unit, are marked unavailable
+   * and read as zero. On other platforms no event is available.
+   *
+   * If the kernel multiplexes the group with other events, so that it
+   * is counted for only part of the time it is enabled, counts are
+   * scaled by the ratio of enabled to running time. Scaled counts are
+   * estimates. To measure an interval, read raw counts and times at
+   * both ends, and pass the differences to scale().
+   *
+   * \ingroup Misc_Module
+   */
+   class PerfCounters
+   {
+
+   public:
+
+      /**
+      * Counted events.
+      */
+      enum Event {Cycles = 0, Instructions, CacheMisses, BranchMisses};
+
+      /// Number of counted events.
+      static const int NEvent = 4;
+
+      /**
+      * Constructor (does not open counters).
+      */
+      PerfCounters();
+
+      /**
+      * Destructor, closes counters.
+      */
+      ~PerfCounters();
+
+      /**
+      * Open counters for the calling thread.
+      *
+      * Returns true if any event is available. Otherwise, error()
+      * returns the reason.
+      */
+      bool open();
+
+      /**
+      * Close all counters.
+      */
+      void close();
+
+      /**
+      * Read current counts for the calling thread, without scaling.
+      *
+      * Writes NEvent values, in the order of Event, with zero for
+      * unavailable events, and the total times in nanoseconds for
+      * which the group has been enabled and running. Must be called
+      * by the thread that called open().
+      *
+      * \param values array of NEvent counts (output)
+      * \param enabled time enabled (output)
+      * \param running time running (output)
+      */
+      void read(long* values, long& enabled, long& running) const;
+
+      /**
+      * Read current counts for the calling thread, scaled.
+      *
+      * Equivalent to the raw read() followed by scale(), and returns
+      * the fraction of enabled time for which the group was counted.
+      *
+      * \param values array of NEvent counts (output)
+      */
+      double read(long* values) const;
+
+      /**
+      * Scale counts for multiplexing.
+      *
+      * Multiplies each value by enabled/running if running < enabled,
+      * or sets all values to zero if running is zero. Returns the
+      * running fraction running/enabled, or 0.0 if running is zero.
+      *
+      * \param values array of NEvent counts (input and output)
+      * \param enabled time enabled, or the change over an interval
+      * \param running time running, or the change over an interval
+      */
+      static double scale(long* values, long enabled, long running);
+
+      /**
+      * Is any event available?
+      */
+      bool isOpen() const;
+
+      /**
+      * Is an event available?
+      *
+      * \param event index of event, 0 <= event < NEvent
+      */
+      bool isAvailable(int event) const;
+
+      /**
+      * Reason that some events are unavailable, or empty if none.
+      */
+      std::string const & error() const;
+
+      /**
+      * Short name of an event, used in report headers.
+      *
+      * \param event index of event, 0 <= event < NEvent
+      */
+      static const char* eventName(int event);
+
+   private:
+
+      /// File descriptor for each event, or -1 if unavailable.
+      int fd_[NEvent];
+
+      /// Event index for each value in a group read, in group order.
+      int order_[NEvent];
+
+      /// Number of available events.
+      int nOpen_;
+
+      /// Reason for unavailable events.
+      std::string error_;
+
+      /// Copy constructor (private and not implemented).
+      PerfCounters(PerfCounters const &);
+
+      /// Assignment (private and not implemented).
+      PerfCounters& operator = (PerfCounters const &);
+
+   };
+
+   // Inline functions
+
+   inline bool PerfCounters::isOpen() const
+   {  return nOpen_ > 0; }
+
+   inline bool PerfCounters::isAvailable(int event) const
+   {
+      UTIL_ASSERT(event >= 0 && event < NEvent);
+      return fd_[event] >= 0;
+   }
+
+   inline std::string const & PerfCounters::error() const
+   {  return error_; }
+
+}
+#endif
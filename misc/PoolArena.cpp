@@ -0,0 +1,123 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "PoolArena.h"
+
+namespace Util
+{
+
+   const size_t PoolArena::MinBlockSize;
+   const int PoolArena::NClass;
+
+   /*
+   * Constructor.
+   */
+   PoolArena::PoolArena(size_t chunkSize, MemoryPolicy const & chunkPolicy)
+    : MemoryArena(),
+      upstream_(chunkSize, chunkPolicy)
+   {  clearFreeLists(); }
+
+   /*
+   * Destructor.
+   */
+   PoolArena::~PoolArena()
+   {}
+
+   /*
+   * Return the size class for a request.
+   */
+   int PoolArena::sizeClass(size_t nBytes, size_t alignment)
+   {
+      if (nBytes < alignment) nBytes = alignment;
+      int k = 0;
+      size_t size = MinBlockSize;
+      while (size < nBytes) {
+         size <<= 1;
+         ++k;
+      }
+      if (k >= NClass) {
+         UTIL_THROW("Request exceeds largest PoolArena size class");
+      }
+      return k;
+   }
+
+   /*
+   * Allocate a block.
+   */
+   void* PoolArena::allocate(size_t nBytes, size_t alignment)
+   {
+      if (alignment > MemoryPolicy::CacheLineSize) {
+         UTIL_THROW("PoolArena alignment cannot exceed a cache line");
+      }
+      int k = sizeClass(nBytes, alignment);
+      if (free_[k]) {
+         FreeBlock* block = free_[k];
+         free_[k] = block->next;
+         return (void*)block;
+      }
+      size_t size = blockSize(k);
+      size_t align = size < MemoryPolicy::CacheLineSize ?
+                     size : MemoryPolicy::CacheLineSize;
+      return upstream_.allocate(size, align);
+   }
+
+   /*
+   * Return a block to its free list.
+   */
+   void PoolArena::deallocate(void* ptr, size_t nBytes, size_t alignment)
+   {
+      UTIL_ASSERT(ptr);
+      int k = sizeClass(nBytes, alignment);
+      FreeBlock* block = (FreeBlock*)ptr;
+      block->next = free_[k];
+      free_[k] = block;
+   }
+
+   /*
+   * Empty free lists and rewind chunks.
+   */
+   void PoolArena::reset()
+   {
+      clearFreeLists();
+      upstream_.reset();
+   }
+
+   /*
+   * Return all chunks to the operating system.
+   */
+   void PoolArena::release()
+   {
+      clearFreeLists();
+      upstream_.release();
+   }
+
+   /*
+   * Return number of free blocks in a size class.
+   */
+   int PoolArena::nFree(int sizeClass) const
+   {
+      UTIL_CHECK(sizeClass >= 0 && sizeClass < NClass);
+      int n = 0;
+      FreeBlock* block = free_[sizeClass];
+      while (block) {
+         ++n;
+         block = block->next;
+      }
+      return n;
+   }
+
+   /*
+   * Empty all free lists.
+   */
+   void PoolArena::clearFreeLists()
+   {
+      for (int k = 0; k < NClass; ++k) {
+         free_[k] = 0;
+      }
+   }
+
+}
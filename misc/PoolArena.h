@@ -0,0 +1,157 @@
+#ifndef UTIL_POOL_ARENA_H
+#define UTIL_POOL_ARENA_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/misc/MemoryArena.h>
+#include <util/misc/MonotonicArena.h>
+
+namespace Util
+{
+
+   /**
+   * A size-class pool allocator.
+   *
+   * A PoolArena rounds each request up to a power-of-two size class,
+   * and keeps a free list of returned blocks for each class. Blocks
+   * returned by deallocate() are reused by later requests of the same
+   * class, so that growable containers (GArray, GPArray, GStack, etc.)
+   * that repeatedly grow, shrink and regrow recycle their buffers
+   * without calls to the system allocator. New blocks are carved from
+   * chunks held by an internal MonotonicArena, and reset() returns all
+   * blocks to the pool at once.
+   *
+   * Blocks of size 64 bytes or larger are aligned to a cache line.
+   * Smaller blocks are aligned to their own size. A request with an
+   * alignment larger than its size is rounded up to a block at least
+   * as large as the alignment. Alignments larger than a cache line
+   * are not supported.
+   *
+   * \ingroup Misc_Module
+   */
+   class PoolArena : public MemoryArena
+   {
+   public:
+
+      /**
+      * Smallest block size, in bytes.
+      */
+      static const size_t MinBlockSize = 16;
+
+      /**
+      * Number of size classes.
+      */
+      static const int NClass = 40;
+
+      /**
+      * Constructor.
+      *
+      * \param chunkSize  minimum size of each chunk, in bytes
+      * \param chunkPolicy  policy used to obtain chunks
+      */
+      explicit
+      PoolArena(size_t chunkSize = 1048576,
+                MemoryPolicy const & chunkPolicy = MemoryPolicy());
+
+      /**
+      * Destructor.
+      */
+      virtual ~PoolArena();
+
+      /**
+      * Allocate a block, reusing a free block of the same class if any.
+      *
+      * \param nBytes  number of bytes required
+      * \param alignment  required alignment (power of 2, <= 64)
+      * \return address of block
+      */
+      virtual void* allocate(size_t nBytes, size_t alignment);
+
+      /**
+      * Return a block to the free list for its size class.
+      *
+      * \param ptr  address of block returned by allocate
+      * \param nBytes  number of bytes passed to allocate
+      * \param alignment  alignment passed to allocate
+      */
+      virtual void deallocate(void* ptr, size_t nBytes, size_t alignment);
+
+      /**
+      * Empty all free lists and rewind the underlying chunks.
+      */
+      virtual void reset();
+
+      /**
+      * Return all chunks to the operating system.
+      */
+      virtual void release();
+
+      /**
+      * Return total number of bytes held in chunks.
+      */
+      virtual size_t capacity() const;
+
+      /**
+      * Return the block size for a given size class.
+      *
+      * \param sizeClass  index of size class, 0 <= sizeClass < NClass
+      */
+      static size_t blockSize(int sizeClass);
+
+      /**
+      * Return the size class used for a request.
+      *
+      * \param nBytes  number of bytes required
+      * \param alignment  required alignment
+      */
+      static int sizeClass(size_t nBytes, size_t alignment);
+
+      /**
+      * Return number of blocks in the free list for a size class.
+      *
+      * \param sizeClass  index of size class, 0 <= sizeClass < NClass
+      */
+      int nFree(int sizeClass) const;
+
+   private:
+
+      /*
+      * Link stored in the first bytes of a free block.
+      */
+      struct FreeBlock
+      {
+         FreeBlock* next;
+      };
+
+      /// Heads of free lists, indexed by size class.
+      FreeBlock* free_[NClass];
+
+      /// Source of new blocks.
+      MonotonicArena upstream_;
+
+      /// Empty all free lists.
+      void clearFreeLists();
+
+   };
+
+   // Inline member functions
+
+   /*
+   * Return total number of bytes held in chunks.
+   */
+   inline size_t PoolArena::capacity() const
+   {  return upstream_.capacity(); }
+
+   /*
+   * Return block size for a size class.
+   */
+   inline size_t PoolArena::blockSize(int sizeClass)
+   {  return MinBlockSize << sizeClass; }
+
+}
+#endif
@@ -0,0 +1,562 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Profiler.h"
+#include <util/format/Str.h>
+#include <util/format/Dbl.h>
+#include <util/format/Lng.h>
+
+#include <map>
+#include <sstream>
+#include <vector>
+
+#ifdef UTIL_CXX11
+#include <mutex>
+#endif
+
+namespace Util
+{
+
+   // Anonymous namespace for file-scope data
+   namespace
+   {
+
+      /*
+      * Node of a call tree: one region, entered from one parent.
+      */
+      struct Node
+      {
+         int region;
+         int parent;
+         std::vector<int> children;
+         long count;
+         double total;
+         double min;
+         double max;
+         long events[PerfCounters::NEvent];
+         long begin[PerfCounters::NEvent];
+         long beginEnabled;
+         long beginRunning;
+         bool counting;
+      };
+
+      /*
+      * Call tree for one thread. Node 0 is a root that is never exited.
+      */
+      struct Tree
+      {
+         std::vector<Node> nodes;
+         int current;
+         PerfCounters counters;
+         bool countersOpened;
+      };
+
+      /*
+      * Ordering of paths in which each path follows its parent.
+      */
+      struct PathLess
+      {
+         bool operator() (std::string const & a, std::string const & b) const
+         {
+            size_t n = a.size() < b.size() ? a.size() : b.size();
+            for (size_t i = 0; i < n; ++i) {
+               if (a[i] == b[i]) continue;
+               if (a[i] == '/') return true;
+               if (b[i] == '/') return false;
+               return (unsigned char)a[i] < (unsigned char)b[i];
+            }
+            return a.size() < b.size();
+         }
+      };
+
+      typedef std::map<std::string, Profiler::Stats, PathLess> StatsMap;
+
+      /// Names of registered regions.
+      std::vector<std::string> regionNames_;
+
+      /// Call trees of all threads that have entered a region.
+      std::vector<Tree*> trees_;
+
+      /// Are hardware event counters enabled?
+      bool countersEnabled_ = false;
+
+      /// Bit i is set if event i is counted by any thread.
+      int countedMask_ = 0;
+
+      /// First reason for an unavailable event.
+      std::string counterError_;
+
+      #ifdef UTIL_CXX11
+      /// Mutex that protects regionNames_, trees_ and counter status.
+      std::mutex mutex_;
+
+      /// Call tree of this thread.
+      thread_local Tree* treePtr_ = 0;
+      #else
+      Tree* treePtr_ = 0;
+      #endif
+
+      /*
+      * Reset statistics of a node to zero.
+      */
+      void resetNode(Node& node)
+      {
+         node.count = 0;
+         node.total = 0.0;
+         node.min = 0.0;
+         node.max = 0.0;
+         for (int i = 0; i < PerfCounters::NEvent; ++i) {
+            node.events[i] = 0;
+         }
+      }
+
+      /*
+      * Initialize a new node.
+      */
+      void initNode(Node& node, int region, int parent)
+      {
+         node.region = region;
+         node.parent = parent;
+         node.counting = false;
+         resetNode(node);
+      }
+
+      /*
+      * Return the call tree of this thread, creating it if necessary.
+      */
+      inline Tree& localTree()
+      {
+         if (!treePtr_) {
+            Tree* ptr = new Tree;
+            ptr->nodes.resize(1);
+            initNode(ptr->nodes[0], -1, -1);
+            ptr->current = 0;
+            ptr->countersOpened = false;
+            #ifdef UTIL_CXX11
+            std::lock_guard<std::mutex> lock(mutex_);
+            #endif
+            trees_.push_back(ptr);
+            treePtr_ = ptr;
+         }
+         return *treePtr_;
+      }
+
+      /*
+      * Read counters at entry to a node, opening them if necessary.
+      */
+      void startCounters(Tree& tree, Node& node)
+      {
+         if (!tree.countersOpened) {
+            tree.countersOpened = true;
+            tree.counters.open();
+            #ifdef UTIL_CXX11
+            std::lock_guard<std::mutex> lock(mutex_);
+            #endif
+            for (int i = 0; i < PerfCounters::NEvent; ++i) {
+               if (tree.counters.isAvailable(i)) countedMask_ |= (1 << i);
+            }
+            if (counterError_.empty()) {
+               counterError_ = tree.counters.error();
+            }
+         }
+         node.counting = tree.counters.isOpen();
+         if (node.counting) {
+            tree.counters.read(node.begin, node.beginEnabled,
+                               node.beginRunning);
+         }
+      }
+
+      /*
+      * Add statistics of one node to a Stats object.
+      */
+      void accumulate(Profiler::Stats& stats, Node const & node)
+      {
+         if (node.count == 0) return;
+         if (stats.count == 0 || node.min < stats.min) {
+            stats.min = node.min;
+         }
+         if (stats.count == 0 || node.max > stats.max) {
+            stats.max = node.max;
+         }
+         stats.count += node.count;
+         stats.total += node.total;
+         for (int i = 0; i < PerfCounters::NEvent; ++i) {
+            stats.events[i] += node.events[i];
+         }
+      }
+
+      /*
+      * Add statistics of a node and its descendants to a map, keyed by path.
+      */
+      void collect(Tree const & tree, int i, std::string const & path,
+                   StatsMap& map)
+      {
+         Node const & node = tree.nodes[i];
+         int n = node.children.size();
+         for (int j = 0; j < n; ++j) {
+            int k = node.children[j];
+            std::string childPath = path;
+            if (!childPath.empty()) {
+               childPath += "/";
+            }
+            childPath += regionNames_[tree.nodes[k].region];
+            Profiler::Stats& stats = map[childPath];
+            accumulate(stats, tree.nodes[k]);
+            collect(tree, k, childPath, map);
+         }
+      }
+
+      /*
+      * Return statistics for all paths, merged over threads.
+      */
+      StatsMap merge()
+      {
+         #ifdef UTIL_CXX11
+         std::lock_guard<std::mutex> lock(mutex_);
+         #endif
+         StatsMap map;
+         for (size_t i = 0; i < trees_.size(); ++i) {
+            collect(*trees_[i], 0, std::string(), map);
+         }
+         return map;
+      }
+
+      /*
+      * Split a path into the depth and the name of the last region.
+      */
+      void splitPath(std::string const & path, int& depth, std::string& name)
+      {
+         depth = 0;
+         size_t pos = path.rfind('/');
+         for (size_t i = 0; i < path.size(); ++i) {
+            if (path[i] == '/') ++depth;
+         }
+         name = (pos == std::string::npos) ? path : path.substr(pos + 1);
+      }
+
+   }
+
+   /*
+   * Register a named region, or return id of an existing region.
+   */
+   int Profiler::addRegion(std::string const & name)
+   {
+      if (name.empty() || name.find('/') != std::string::npos) {
+         std::string msg("Invalid Profiler region name: ");
+         msg += name;
+         UTIL_THROW(msg.c_str());
+      }
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      #endif
+      int n = regionNames_.size();
+      for (int i = 0; i < n; ++i) {
+         if (regionNames_[i] == name) return i;
+      }
+      regionNames_.push_back(name);
+      return n;
+   }
+
+   /*
+   * Return name of a region.
+   */
+   std::string Profiler::regionName(int id)
+   {
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      #endif
+      UTIL_CHECK(id >= 0 && id < (int)regionNames_.size());
+      return regionNames_[id];
+   }
+
+   /*
+   * Enter a region.
+   */
+   void Profiler::enter(int id)
+   {
+      Tree& tree = localTree();
+      int parent = tree.current;
+      std::vector<int> const & children = tree.nodes[parent].children;
+      int n = children.size();
+      int k = -1;
+      for (int i = 0; i < n; ++i) {
+         if (tree.nodes[children[i]].region == id) {
+            k = children[i];
+            break;
+         }
+      }
+      if (k < 0) {
+         k = tree.nodes.size();
+         tree.nodes.push_back(Node());
+         initNode(tree.nodes[k], id, parent);
+         tree.nodes[parent].children.push_back(k);
+      }
+      tree.current = k;
+      if (countersEnabled_) {
+         startCounters(tree, tree.nodes[k]);
+      }
+   }
+
+   /*
+   * Exit the current region.
+   */
+   void Profiler::exit(double dt)
+   {
+      UTIL_ASSERT(treePtr_ && treePtr_->current > 0);
+      Tree& tree = *treePtr_;
+      Node& node = tree.nodes[tree.current];
+      if (node.count == 0 || dt < node.min) node.min = dt;
+      if (node.count == 0 || dt > node.max) node.max = dt;
+      ++node.count;
+      node.total += dt;
+      if (node.counting) {
+         long end[PerfCounters::NEvent];
+         long enabled, running;
+         tree.counters.read(end, enabled, running);
+         for (int i = 0; i < PerfCounters::NEvent; ++i) {
+            end[i] -= node.begin[i];
+         }
+         PerfCounters::scale(end, enabled - node.beginEnabled,
+                             running - node.beginRunning);
+         for (int i = 0; i < PerfCounters::NEvent; ++i) {
+            node.events[i] += end[i];
+         }
+         node.counting = false;
+      }
+      tree.current = node.parent;
+   }
+
+   /*
+   * Return statistics for one path, merged over threads.
+   */
+   Profiler::Stats Profiler::stats(std::string const & path)
+   {
+      StatsMap map = merge();
+      StatsMap::const_iterator iter = map.find(path);
+      if (iter != map.end()) {
+         return iter->second;
+      }
+      Stats stats = Stats();
+      return stats;
+   }
+
+   /*
+   * Get statistics for all paths.
+   */
+   void Profiler::snapshot(std::vector<std::string>& paths,
+                           std::vector<Stats>& stats)
+   {
+      StatsMap map = merge();
+      paths.clear();
+      stats.clear();
+      StatsMap::const_iterator iter;
+      for (iter = map.begin(); iter != map.end(); ++iter) {
+         paths.push_back(iter->first);
+         stats.push_back(iter->second);
+      }
+   }
+
+   /*
+   * Enable or disable hardware event counters.
+   */
+   void Profiler::enableCounters(bool enable)
+   {  countersEnabled_ = enable; }
+
+   /*
+   * Are hardware event counters enabled?
+   */
+   bool Profiler::countersEnabled()
+   {  return countersEnabled_; }
+
+   /*
+   * Is an event counted by any thread?
+   */
+   bool Profiler::isCounted(int event)
+   {
+      UTIL_CHECK(event >= 0 && event < PerfCounters::NEvent);
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      #endif
+      return (countedMask_ & (1 << event)) != 0;
+   }
+
+   /*
+   * Reason that some events could not be counted.
+   */
+   std::string Profiler::counterError()
+   {
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      #endif
+      return counterError_;
+   }
+
+   /*
+   * Return number of threads with a call tree.
+   */
+   int Profiler::nThread()
+   {
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      #endif
+      return trees_.size();
+   }
+
+   /*
+   * Reset statistics of all nodes of all threads.
+   */
+   void Profiler::clear()
+   {
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      #endif
+      for (size_t i = 0; i < trees_.size(); ++i) {
+         std::vector<Node>& nodes = trees_[i]->nodes;
+         for (size_t j = 0; j < nodes.size(); ++j) {
+            resetNode(nodes[j]);
+         }
+      }
+   }
+
+   /*
+   * Write table of statistics for all paths.
+   */
+   void Profiler::report(std::ostream& out)
+   {
+      StatsMap map = merge();
+      bool any = false;
+      for (int i = 0; i < PerfCounters::NEvent; ++i) {
+         if (isCounted(i)) any = true;
+      }
+      std::string error = counterError();
+      bool counted = countersEnabled_ || any || !error.empty();
+      if (counted && !any) {
+         out << "Hardware counters unavailable: " << error << std::endl;
+         counted = false;
+      }
+      out << std::left << Str("region", 30) << std::right
+          << Str("count", 12) << Str("total", 14)
+          << Str("mean", 14) << Str("min", 14) << Str("max", 14);
+      if (counted) {
+         out << Str("IPC", 10) << Str("cacheMiss", 14)
+             << Str("branchMiss", 14);
+      }
+      out << std::endl;
+      StatsMap::const_iterator iter;
+      int depth;
+      std::string name;
+      for (iter = map.begin(); iter != map.end(); ++iter) {
+         Stats const & s = iter->second;
+         if (s.count == 0) continue;
+         splitPath(iter->first, depth, name);
+         out << std::left << Str(std::string(2*depth, ' ') + name, 30)
+             << std::right
+             << Lng(s.count, 12) << Dbl(s.total, 14, 6)
+             << Dbl(s.mean(), 14, 6) << Dbl(s.min, 14, 6)
+             << Dbl(s.max, 14, 6);
+         if (counted) {
+            // Instructions per cycle, and misses per call
+            if (isCounted(PerfCounters::Cycles)
+                && isCounted(PerfCounters::Instructions)) {
+               out << Dbl(s.ipc(), 10, 3);
+            } else {
+               out << Str("n/a", 10);
+            }
+            int events[2] = {PerfCounters::CacheMisses,
+                             PerfCounters::BranchMisses};
+            for (int j = 0; j < 2; ++j) {
+               if (isCounted(events[j])) {
+                  out << Dbl(s.perCall(events[j]), 14, 6);
+               } else {
+                  out << Str("n/a", 14);
+               }
+            }
+         }
+         out << std::endl;
+      }
+   }
+
+   #ifdef UTIL_MPI
+   /*
+   * Write table of total times reduced over processors.
+   */
+   void Profiler::report(std::ostream& out, MPI::Intracomm& communicator)
+   {
+      // Local values: one line "total path" per path
+      StatsMap map = merge();
+      StatsMap::const_iterator iter;
+      std::ostringstream buffer;
+      buffer.precision(17);
+      for (iter = map.begin(); iter != map.end(); ++iter) {
+         if (iter->second.count == 0) continue;
+         buffer << iter->second.total << " " << iter->first << "\n";
+      }
+      std::string local = buffer.str();
+
+      // Gather all lines on processor 0
+      int rank = communicator.Get_rank();
+      int nProc = communicator.Get_size();
+      int size = local.size();
+      std::vector<int> sizes(nProc);
+      communicator.Gather(&size, 1, MPI::INT, &sizes[0], 1, MPI::INT, 0);
+      std::vector<int> offsets(nProc, 0);
+      int totalSize = 0;
+      if (rank == 0) {
+         for (int i = 0; i < nProc; ++i) {
+            offsets[i] = totalSize;
+            totalSize += sizes[i];
+         }
+      }
+      std::vector<char> all(totalSize + 1);
+      communicator.Gatherv(local.c_str(), size, MPI::CHAR, &all[0],
+                           &sizes[0], &offsets[0], MPI::CHAR, 0);
+      if (rank != 0) return;
+
+      // Total time for each path on each processor
+      typedef std::map<std::string, std::vector<double>, PathLess> TimeMap;
+      TimeMap times;
+      for (int i = 0; i < nProc; ++i) {
+         std::istringstream in(std::string(&all[offsets[i]], sizes[i]));
+         std::string path;
+         double total;
+         while (in >> total) {
+            in.get();
+            std::getline(in, path);
+            std::vector<double>& t = times[path];
+            t.resize(nProc, 0.0);
+            t[i] = total;
+         }
+      }
+
+      out << std::left << Str("region", 30) << std::right
+          << Str("min", 14) << Str("mean", 14)
+          << Str("max", 14) << Str("imbalance", 14) << std::endl;
+      TimeMap::const_iterator titer;
+      int depth;
+      std::string name;
+      for (titer = times.begin(); titer != times.end(); ++titer) {
+         std::vector<double> const & t = titer->second;
+         double min = t[0];
+         double max = t[0];
+         double mean = 0.0;
+         for (int i = 0; i < nProc; ++i) {
+            if (t[i] < min) min = t[i];
+            if (t[i] > max) max = t[i];
+            mean += t[i];
+         }
+         mean /= double(nProc);
+         double imbalance = mean > 0.0 ? max/mean - 1.0 : 0.0;
+         splitPath(titer->first, depth, name);
+         out << std::left << Str(std::string(2*depth, ' ') + name, 30)
+             << std::right
+             << Dbl(min, 14, 6) << Dbl(mean, 14, 6) << Dbl(max, 14, 6)
+             << Dbl(imbalance, 14, 6) << std::endl;
+      }
+   }
+   #endif
+
+}
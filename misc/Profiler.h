@@ -0,0 +1,312 @@
+#ifndef UTIL_PROFILER_H
+#define UTIL_PROFILER_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/misc/Timer.h>
+#include <util/misc/PerfCounters.h>
+#include <util/global.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Util
+{
+
+   /**
+   * Hierarchical profiler for named regions of code (all static members).
+   *
+   * A region is a named section of code, registered once by addRegion().
+   * Each entry to a region is timed by a ProfileScope object, usually
+   * created by the UTIL_PROFILE_SCOPE macro:
+   * \code
+   *    void Integrator::step()
+   *    {
+   *       UTIL_PROFILE_SCOPE("step");
+   *       ...
+   *       {
+   *          UTIL_PROFILE_SCOPE("forces");
+   *          ...
+   *       }
+   *    }
+   * \endcode
+   * The macro expands to nothing unless UTIL_PROFILE is defined, so
+   * that profiling can be removed entirely at compile time.
+   *
+   * Each thread records its own call tree, in which a node is a region
+   * entered from a particular chain of enclosing regions, identified
+   * by a path such as "step/forces". For each node, the tree records
+   * the number of calls and the total, minimum and maximum time per
+   * call, measured with Timer::now(). Recording requires no locks,
+   * except when a thread first enters any region. The trees of threads
+   * that have finished are kept, and included in reports.
+   *
+   * The report() functions merge the trees of all threads, and write
+   * statistics for each path. The MPI version also writes the minimum,
+   * mean and maximum over processors of the total time in each path,
+   * and the imbalance max/mean - 1.
+   *
+   * After enableCounters(true), each node also accumulates hardware
+   * event counts from PerfCounters, read by enter() and exit() for the
+   * calling thread. The reports then include instructions per cycle and
+   * cache and branch misses per call. Events that are unavailable, for
+   * example in a container, are reported as "n/a" and time is still
+   * recorded. Counts for each call are scaled for multiplexing by
+   * PerfCounters::scale(). Reading the counters adds two system calls
+   * per call, so they are disabled by default.
+   *
+   * Functions other than enter() and exit() may not be called while
+   * another thread is recording.
+   *
+   * \ingroup Misc_Module
+   */
+   class Profiler
+   {
+
+   public:
+
+      /**
+      * Statistics for one path, merged over threads.
+      */
+      struct Stats
+      {
+         /// Number of calls.
+         long count;
+         /// Total time, in seconds.
+         double total;
+         /// Minimum time per call, in seconds.
+         double min;
+         /// Maximum time per call, in seconds.
+         double max;
+         /// Total count of each PerfCounters::Event.
+         long events[PerfCounters::NEvent];
+
+         /// Mean time per call, in seconds.
+         double mean() const
+         {  return count > 0 ? total/double(count) : 0.0; }
+
+         /// Mean count of an event per call.
+         double perCall(int event) const
+         {  return count > 0 ? double(events[event])/double(count) : 0.0; }
+
+         /// Instructions per cycle, or 0 if cycles were not counted.
+         double ipc() const
+         {
+            long cycles = events[PerfCounters::Cycles];
+            return cycles > 0 ?
+               double(events[PerfCounters::Instructions])/double(cycles)
+               : 0.0;
+         }
+
+         /**
+         * Serialize to/from an archive.
+         *
+         * \param ar      archive
+         * \param version archive version id
+         */
+         template <class Archive>
+         void serialize(Archive& ar, const unsigned int version)
+         {
+            ar & count;
+            ar & total;
+            ar & min;
+            ar & max;
+            for (int i = 0; i < PerfCounters::NEvent; ++i) {
+               ar & events[i];
+            }
+         }
+      };
+
+      /**
+      * Register a named region, and return its integer id.
+      *
+      * If a region with the same name exists, its id is returned. The
+      * name may not contain a slash. Thread safe.
+      *
+      * \param name name of region
+      */
+      static int addRegion(std::string const & name);
+
+      /**
+      * Return the name of a region.
+      *
+      * \param id integer region id
+      */
+      static std::string regionName(int id);
+
+      /**
+      * Enter a region in the call tree of this thread.
+      *
+      * \param id integer region id
+      */
+      static void enter(int id);
+
+      /**
+      * Exit the current region of this thread, after time dt.
+      *
+      * \param dt time spent in region, in seconds
+      */
+      static void exit(double dt);
+
+      /**
+      * Return statistics for a path, merged over threads.
+      *
+      * Returns zero count if the path has not been entered.
+      *
+      * \param path region names of enclosing regions and region,
+      *        separated by slashes
+      */
+      static Stats stats(std::string const & path);
+
+      /**
+      * Get statistics for all paths that have been entered.
+      *
+      * Paths are sorted so that each path follows its parent. The
+      * vectors may be serialized, e.g. to record the profile in a
+      * run log.
+      *
+      * \param paths paths of all regions (output)
+      * \param stats statistics for each path (output)
+      */
+      static void
+      snapshot(std::vector<std::string>& paths, std::vector<Stats>& stats);
+
+      /**
+      * Enable or disable hardware event counters.
+      *
+      * Counters are opened by each thread on its next call to enter().
+      *
+      * \param enable true to enable, false to disable
+      */
+      static void enableCounters(bool enable);
+
+      /**
+      * Are hardware event counters enabled?
+      */
+      static bool countersEnabled();
+
+      /**
+      * Is an event counted by any thread?
+      *
+      * \param event index of PerfCounters::Event
+      */
+      static bool isCounted(int event);
+
+      /**
+      * Reason that some events could not be counted, or empty if none.
+      */
+      static std::string counterError();
+
+      /**
+      * Return the number of threads that have entered any region.
+      */
+      static int nThread();
+
+      /**
+      * Reset statistics for all paths to zero.
+      */
+      static void clear();
+
+      /**
+      * Write a table of statistics for all paths, merged over threads.
+      *
+      * \param out output stream
+      */
+      static void report(std::ostream& out);
+
+      #ifdef UTIL_MPI
+      /**
+      * Write a table of load imbalance over processors.
+      *
+      * Must be called on all processors of the communicator. Output
+      * is written only by the processor of rank 0.
+      *
+      * \param out output stream
+      * \param communicator MPI communicator
+      */
+      static void report(std::ostream& out, MPI::Intracomm& communicator);
+      #endif
+
+   private:
+
+      /**
+      * Constructor (private and not implemented, prevents instantiation).
+      */
+      Profiler();
+
+   };
+
+   /**
+   * Times one entry to a Profiler region, from construction to destruction.
+   *
+   * \ingroup Misc_Module
+   */
+   class ProfileScope
+   {
+
+   public:
+
+      /**
+      * Constructor, enters region id.
+      *
+      * \param id integer region id, from Profiler::addRegion
+      */
+      explicit ProfileScope(int id)
+      {
+         Profiler::enter(id);
+         begin_ = Timer::now();
+      }
+
+      /**
+      * Destructor, exits region.
+      */
+      ~ProfileScope()
+      {
+         Timer::TimePoint end = Timer::now();
+         #ifdef UTIL_CXX11
+         Profiler::exit(std::chrono::duration<double>(end - begin_).count());
+         #else
+         Profiler::exit(double(end - begin_)/double(CLOCKS_PER_SEC));
+         #endif
+      }
+
+   private:
+
+      /// Time of entry.
+      Timer::TimePoint begin_;
+
+      /// Copy constructor (private and not implemented).
+      ProfileScope(ProfileScope const &);
+
+      /// Assignment (private and not implemented).
+      ProfileScope& operator = (ProfileScope const &);
+
+   };
+
+}
+
+#define UTIL_PROFILE_CONCAT_(a, b) a ## b
+#define UTIL_PROFILE_CONCAT(a, b) UTIL_PROFILE_CONCAT_(a, b)
+
+/**
+* Time the enclosing scope as a Profiler region with the given name.
+*
+* Expands to nothing unless UTIL_PROFILE is defined.
+*/
+#ifdef UTIL_PROFILE
+#define UTIL_PROFILE_SCOPE(name) \
+   static const int UTIL_PROFILE_CONCAT(utilProfileId_, __LINE__) \
+      = Util::Profiler::addRegion(name); \
+   Util::ProfileScope UTIL_PROFILE_CONCAT(utilProfileScope_, __LINE__) \
+      (UTIL_PROFILE_CONCAT(utilProfileId_, __LINE__))
+#else
+#define UTIL_PROFILE_SCOPE(name)
+#endif
+
+#endif
@@ -0,0 +1,87 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TempFile.h"
+
+#include <cstdio>
+#include <ctime>
+#include <sstream>
+
+#ifdef UTIL_CXX11
+#include <atomic>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace Util
+{
+
+   namespace
+   {
+
+      /// Number of TempFile objects created by this process.
+      #ifdef UTIL_CXX11
+      std::atomic<unsigned long> counter_(0);
+      #else
+      unsigned long counter_ = 0;
+      #endif
+
+      /*
+      * Return an integer that identifies this process, if possible.
+      */
+      unsigned long processId()
+      {
+         #if defined(__unix__) || defined(__APPLE__)
+         return (unsigned long) getpid();
+         #else
+         return (unsigned long) std::time(0);
+         #endif
+      }
+
+   }
+
+   /*
+   * Constructor.
+   */
+   TempFile::TempFile(std::string const & filename)
+    : filename_(filename),
+      name_(),
+      isCommitted_(false)
+   {
+      unsigned long count = counter_++;
+      std::ostringstream name;
+      name << filename << ".tmp" << processId() << "." << count;
+      name_ = name.str();
+   }
+
+   /*
+   * Destructor.
+   */
+   TempFile::~TempFile()
+   {
+      if (!isCommitted_) {
+         std::remove(name_.c_str());
+      }
+   }
+
+   /*
+   * Rename the temporary file to the target.
+   */
+   bool TempFile::commit()
+   {
+      UTIL_CHECK(!isCommitted_);
+      if (std::rename(name_.c_str(), filename_.c_str()) != 0) {
+         std::remove(name_.c_str());
+         return false;
+      }
+      isCommitted_ = true;
+      return true;
+   }
+
+}
@@ -0,0 +1,88 @@
+#ifndef UTIL_TEMP_FILE_H
+#define UTIL_TEMP_FILE_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+#include <string>
+
+namespace Util
+{
+
+   /**
+   * Temporary file that replaces a target file when committed.
+   *
+   * A file written to name() and then committed by commit() is renamed
+   * to the target filename, so that readers of the target never see a
+   * partially written file. If commit() is not called or fails, for
+   * example because an exception was thrown while writing, the
+   * destructor removes the temporary file. Any stream writing to name()
+   * must be closed before commit(), and should be destroyed before the
+   * TempFile, i.e., declared after it.
+   *
+   * The temporary file is in the same directory as the target, with a
+   * name that is unique to this process and object.
+   *
+   * \ingroup Misc_Module
+   */
+   class TempFile
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param filename  name of target file
+      */
+      explicit TempFile(std::string const & filename);
+
+      /**
+      * Destructor, removes the temporary file unless committed.
+      */
+      ~TempFile();
+
+      /**
+      * Return name of the temporary file.
+      */
+      std::string const & name() const;
+
+      /**
+      * Rename the temporary file to the target filename.
+      *
+      * Returns true on success. On failure, removes the temporary file
+      * and returns false.
+      */
+      bool commit();
+
+   private:
+
+      /// Name of target file.
+      std::string filename_;
+
+      /// Name of temporary file.
+      std::string name_;
+
+      /// Has the temporary file been renamed?
+      bool isCommitted_;
+
+      /// Copy constructor (private and not implemented).
+      TempFile(TempFile const &);
+
+      /// Assignment (private and not implemented).
+      TempFile& operator = (TempFile const &);
+
+   };
+
+   // Inline function
+
+   inline std::string const & TempFile::name() const
+   {  return name_; }
+
+}
+#endif
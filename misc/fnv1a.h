@@ -0,0 +1,61 @@
+#ifndef UTIL_FNV1A_H
+#define UTIL_FNV1A_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Util
+{
+
+   /// Initial value (offset basis) of a 64-bit FNV-1a hash.
+   const uint64_t Fnv1aBasis = 14695981039346656037ULL;
+
+   /**
+   * Compute the 64-bit FNV-1a hash of a block of bytes.
+   *
+   * A hash of data that is split into several blocks may be computed by
+   * passing the result for each block as the initial value for the next.
+   * FNV-1a is fast and well distributed, but is not a cryptographic
+   * hash, and so only detects accidental differences.
+   *
+   * \ingroup Misc_Module
+   *
+   * \param data  pointer to first byte
+   * \param size  number of bytes
+   * \param hash  initial value (default Fnv1aBasis)
+   * \return hash value
+   */
+   inline
+   uint64_t fnv1a(void const * data, size_t size, uint64_t hash = Fnv1aBasis)
+   {
+      unsigned char const * p = static_cast<unsigned char const *>(data);
+      for (size_t i = 0; i < size; ++i) {
+         hash ^= p[i];
+         hash *= 1099511628211ULL;
+      }
+      return hash;
+   }
+
+   /**
+   * Compute the 64-bit FNV-1a hash of a string.
+   *
+   * \ingroup Misc_Module
+   *
+   * \param s  string
+   * \param hash  initial value (default Fnv1aBasis)
+   * \return hash value
+   */
+   inline
+   uint64_t fnv1a(std::string const & s, uint64_t hash = Fnv1aBasis)
+   {  return fnv1a(s.data(), s.size(), hash); }
+
+}
+#endif
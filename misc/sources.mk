@@ -7,7 +7,13 @@ util_misc_=\
     util/misc/initStatic.cpp \
     util/misc/Log.cpp \
     util/misc/Memory.cpp \
+    util/misc/MemoryPolicy.cpp \
+    util/misc/MonotonicArena.cpp \
+    util/misc/PerfCounters.cpp \
+    util/misc/PoolArena.cpp \
+    util/misc/Profiler.cpp \
     util/misc/ReferenceCounter.cpp \
+    util/misc/TempFile.cpp \
     util/misc/CountedReference.cpp \
     util/misc/Timer.cpp \
     util/misc/ioUtil.cpp 
@@ -78,6 +78,7 @@
 #include <util/mpi/MpiTraits.h>
 #include <util/containers/DArray.h>
 #include <util/containers/DMatrix.h>
+#include <util/containers/ArrayView.h>
 
 namespace Util
 {
@@ -456,6 +457,48 @@ namespace Util
       }
    }
 
+   // ArrayView partial specializations
+
+   /**
+   * Send all elements of an ArrayView<T>.
+   *
+   * Throws an exception if their exists neither an associated MPI
+   * data type nor an explicit specialization of the scalar send<T>.
+   *
+   * \param comm   MPI communicator
+   * \param view   view of elements to send
+   * \param dest   MPI rank of destination (receiving) processor in comm
+   * \param tag    user-defined integer identifier for this message
+   */
+   template <typename T>
+   void send(MPI::Comm& comm, ArrayView<T> view, int dest, int tag)
+   {  send<T>(comm, view.cArray(), view.capacity(), dest, tag); }
+
+   /**
+   * Receive all elements of an ArrayView<T>.
+   *
+   * The number of elements received is the capacity of the view.
+   *
+   * \param comm   MPI communicator
+   * \param view   view of elements to receive
+   * \param source MPI rank of source (sending) processor in comm
+   * \param tag    user-defined integer identifier for this message
+   */
+   template <typename T>
+   void recv(MPI::Comm& comm, ArrayView<T> view, int source, int tag)
+   {  recv<T>(comm, view.cArray(), view.capacity(), source, tag); }
+
+   /**
+   * Broadcast all elements of an ArrayView<T>.
+   *
+   * \param comm   MPI communicator
+   * \param view   view of elements
+   * \param root   MPI rank of root (sending) processor in comm
+   */
+   template <typename T>
+   void bcast(MPI::Intracomm& comm, ArrayView<T> view, int root)
+   {  bcast<T>(comm, view.cArray(), view.capacity(), root); }
+
    // bool (explicit specializations)
 
    /**
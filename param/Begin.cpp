@@ -32,7 +32,7 @@ namespace Util
    */
    void Begin::readParam(std::istream &in)
    {
-      if (isIoProcessor()) {
+      if (isParamReader()) {
          in >> label_;
 
          // If this parameter is required and the label string
@@ -64,7 +64,7 @@ namespace Util
          #endif
       }
       #ifdef UTIL_MPI
-      if (hasIoCommunicator()) {
+      if (isParamBcast()) {
          if (isRequired()) {
             isActive_ = true;
          } else {
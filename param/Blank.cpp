@@ -22,7 +22,7 @@ namespace Util
    // Read a blank line
    void Blank::readParam(std::istream &in)
    {
-      if (isIoProcessor()) {
+      if (isParamReader()) {
          char buf[255];
          in.getline(buf,255);
          if (ParamComponent::echo()) {
@@ -29,7 +29,7 @@ namespace Util
    */
    void End::readParam(std::istream &in)
    {
-      if (isIoProcessor()) {
+      if (isParamReader()) {
          in >> label_;
          if (ParamComponent::echo()) {
             writeParam(Log::file());
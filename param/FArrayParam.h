@@ -165,7 +165,9 @@ namespace Util
    */
    template <typename Type, int Capacity>
    void FArrayParam<Type, Capacity>::bcastValue()
-   {  bcast<Type>(ioCommunicator(), *arrayPtr_, Capacity, 0); }
+   {
+      bcast<Type>(this->ioCommunicator(), &(*arrayPtr_)[0], Capacity, 0);
+   }
    #endif
 
 } 
@@ -167,7 +167,7 @@ namespace Util
    */
    template <typename Type, int Capacity>
    void FSArrayParam<Type, Capacity>::bcastValue()
-   {  bcast<Type>(ioCommunicator(), *arrayPtr_, Capacity, 0); }
+   {  bcast<Type>(this->ioCommunicator(), *arrayPtr_, Capacity, 0); }
    #endif
 
 } 
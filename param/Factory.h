@@ -20,6 +20,14 @@
 #endif
 
 #include <string>
+#include <vector>
+
+#ifdef UTIL_CXX11
+#include <mutex>
+#include <unordered_map>
+#else
+#include <map>
+#endif
 
 namespace Util
 {
@@ -27,6 +35,13 @@ namespace Util
    /**
    * Factory template.
    *
+   * The trySubfactories() method remembers which subfactory, if any,
+   * recognized each class name, in a hash table that is cleared whenever
+   * a subfactory is added. Later requests for the same name thus call
+   * only the factory() method of that subfactory. This assumes that the
+   * set of names recognized by each subfactory does not change once it
+   * has been added.
+   *
    * \ingroup Manager_Module
    */
    template <typename Data>
@@ -158,7 +173,8 @@ namespace Util
       * the factory(const std::string& ) method of each, and immediately
       * returns a pointer to a new object if any of them returns a non-null
       * pointer. If all of them return a null pointer, this method also
-      * returns a null pointer.
+      * returns a null pointer. The result of the search is recorded, so
+      * that later calls with the same className do not search again.
       *
       * \param  className name of subclass
       * \return base class pointer to new object, or a null pointer.
@@ -183,9 +199,23 @@ namespace Util
 
    private:
 
+      #ifdef UTIL_CXX11
+      typedef std::unordered_map<std::string, int> NameIndex;
+      #else
+      typedef std::map<std::string, int> NameIndex;
+      #endif
+
       /// Vector of pointers to child factories.
       std::vector< Factory<Data>* > subfactories_;
 
+      /// Index of subfactory that recognized each class name, or -1.
+      mutable NameIndex subfactoryIndex_;
+
+      #ifdef UTIL_CXX11
+      /// Mutex protecting subfactoryIndex_.
+      mutable std::mutex mutex_;
+      #endif
+
       /// Object to identify if this processor can do file Io.
       MpiFileIo   paramFileIo_;
 
@@ -196,7 +226,9 @@ namespace Util
    */
    template <typename Data>
    Factory<Data>::Factory()
-    : paramFileIo_()
+    : subfactories_(),
+      subfactoryIndex_(),
+      paramFileIo_()
    {}
 
    /*
@@ -235,7 +267,13 @@ namespace Util
    */
    template <typename Data>
    void Factory<Data>::addSubfactory(Factory<Data>& subfactory)
-   {  subfactories_.push_back(&subfactory); }
+   {
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      #endif
+      subfactories_.push_back(&subfactory);
+      subfactoryIndex_.clear();
+   }
 
 
 
@@ -260,7 +298,9 @@ namespace Util
       #endif
 
       // Read a first line of the form "ClassName{" into Label::buffer
-      if (paramFileIo_.isIoProcessor()) { 
+      bool isReader = paramFileIo_.isIoProcessor()
+                      || ParamComponent::replicatedInput();
+      if (isReader) { 
          Label::read(in);
 
          if (Label::isClear()) { // Label did not successfully read a string
@@ -276,8 +316,11 @@ namespace Util
 
       #ifdef UTIL_MPI
       // Broadcast the full string to all processors.
-      if (paramFileIo_.hasIoCommunicator()) {
-         bcast<std::string>(paramFileIo_.ioCommunicator(), Label::buffer(), 0);
+      if (paramFileIo_.hasIoCommunicator()
+          && !ParamComponent::replicatedInput()) {
+         std::string buffer = Label::buffer();
+         bcast<std::string>(paramFileIo_.ioCommunicator(), buffer, 0);
+         Label::setBuffer(buffer);
       }
       // Hereafter, each processor independently processes the same string.
       #endif
@@ -307,7 +350,7 @@ namespace Util
          className = Label::buffer().substr(0, length-2);
          hasData = false;
       } else {
-         if (paramFileIo_.isIoProcessor()) {
+         if (isReader) {
             className = std::string();
             Log::file() << "Invalid string: " << Label::buffer() << std::endl;
             UTIL_THROW("Invalid first line\n");
@@ -425,10 +468,39 @@ namespace Util
    Data* Factory<Data>::trySubfactories(const std::string& className) 
    const
    {
-      Data* typePtr = 0;
       int n = subfactories_.size();
+      if (n == 0) return 0;
+
+      // Look for a previous search for the same name
+      int index = 0;
+      bool found = false;
+      {
+         #ifdef UTIL_CXX11
+         std::lock_guard<std::mutex> lock(mutex_);
+         #endif
+         typename NameIndex::const_iterator iter;
+         iter = subfactoryIndex_.find(className);
+         if (iter != subfactoryIndex_.end()) {
+            index = iter->second;
+            found = true;
+         }
+      }
+      if (found) {
+         return index < 0 ? 0 : subfactories_[index]->factory(className);
+      }
+
+      // Search all subfactories, and record the result
+      Data* typePtr = 0;
+      index = -1;
       for (int i = 0; i < n && typePtr == 0; ++i) {
          typePtr = subfactories_[i]->factory(className);
+         if (typePtr) index = i;
+      }
+      {
+         #ifdef UTIL_CXX11
+         std::lock_guard<std::mutex> lock(mutex_);
+         #endif
+         subfactoryIndex_[className] = index;
       }
       return typePtr;
    }
@@ -28,6 +28,15 @@ namespace Util
       isClear_ = true;
    }
 
+   /*
+   * Set the static input buffer (static).
+   */
+   void Label::setBuffer(std::string const & buffer)
+   {
+      buffer_ = buffer;
+      isClear_ = buffer_.empty();
+   }
+
    /*
    * Extract string from input stream and store in the buffer without 
    * attempting to match (static).
@@ -95,6 +95,16 @@ namespace Util
       */
       static void clear();
 
+      /**
+      * Set the input buffer, e.g. to a string received from another
+      * processor.
+      *
+      * The buffer is clear after this call iff the string is empty.
+      *
+      * \param buffer new value of the input buffer
+      */
+      static void setBuffer(std::string const & buffer);
+
       /**
       * Explicitly set the isMatched flag.
       *
@@ -15,6 +15,16 @@
 #include <string>
 #include <vector>
 
+#ifdef UTIL_CXX11
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#else
+#include <map>
+#endif
+
 namespace Util
 {
 
@@ -32,6 +42,17 @@ namespace Util
    * Subclasses of Manager<Data> are used to manage arrays of Species, McMove,
    * and Analyzer objects.
    *
+   * Objects are created in two phases. The readParameters() and
+   * loadParameters() functions first create each object and read or load
+   * its parameters, in the order in which they appear in the file. They
+   * then call the virtual initializeObject() function for each new object.
+   * Subclasses may re-implement initializeObject() to perform expensive
+   * work that does not require the input, such as allocation and
+   * initialization of large arrays. If setNThread() has been called with
+   * a value greater than one, and the code is compiled with UTIL_CXX11,
+   * the second phase uses several threads, so that each object's memory
+   * is also first touched by the thread that initializes it.
+   *
    * \ingroup Manager_Module
    */
    template <typename Data>
@@ -168,9 +189,27 @@ namespace Util
       */
       Data& operator[] (int i) const;
 
+      /**
+      * Set the number of threads used by initializeObject().
+      *
+      * The default value is 1, for which objects are initialized in
+      * order by the calling thread. Larger values are used only when
+      * compiled with UTIL_CXX11.
+      *
+      * \param nThread maximum number of threads (>= 1)
+      */
+      void setNThread(int nThread);
+
+      /**
+      * Get the maximum number of threads used by initializeObject().
+      */
+      int nThread() const;
+
       /**
       * Return pointer to first object with specified class name.
       *
+      * Uses a hash table of the first index for each class name.
+      *
       * \param className desired class name string
       * \return pointer to specified objectd, or null if not found.
       */
@@ -203,14 +242,37 @@ namespace Util
       */
       virtual Factory<Data>* newDefaultFactory() const;
 
+      /**
+      * Complete initialization of an object after reading or loading.
+      *
+      * Called once for each object created by readParameters() or
+      * loadParameters(), after all of them have been created. If
+      * nThread() > 1, this is called concurrently for different objects,
+      * in no particular order, and so must not modify data shared with
+      * other objects or use the input. The default is empty.
+      *
+      * \param object object to initialize
+      */
+      virtual void initializeObject(Data& object)
+      {}
+
    private:
 
+      #ifdef UTIL_CXX11
+      typedef std::unordered_map<std::string, int> NameIndex;
+      #else
+      typedef std::map<std::string, int> NameIndex;
+      #endif
+
       /// Array of pointers to Data objects.
       std::vector<Data*> ptrs_;
 
       /// Array of subclass names for Data objects.
       std::vector<std::string> names_;
 
+      /// Index of first object with each subclass name.
+      NameIndex firstIndex_;
+
       /// Allocated size of ptrs_ array.
       int  capacity_;
 
@@ -223,6 +285,14 @@ namespace Util
       /// True if this manager created the object *factoryPtr_.
       bool createdFactory_;
 
+      /// Maximum number of threads for initializeObject().
+      int nThread_;
+
+      /**
+      * Call initializeObject() for objects begin, ..., size_ - 1.
+      */
+      void initializeObjects(int begin);
+
    };
 
    /*
@@ -233,10 +303,12 @@ namespace Util
     : factoryPtr_(0),
       ptrs_(),
       names_(),
+      firstIndex_(),
       capacity_(0),
       size_(0),
       uniqueNames_(uniqueNames),
-      createdFactory_(false)
+      createdFactory_(false),
+      nThread_(1)
    {}
 
    /*
@@ -359,6 +431,7 @@ namespace Util
       initFactory();
 
       // Loop over managed objects
+      int begin = size_;
       std::string name;
       Data* typePtr;
       bool  isEnd = false;
@@ -390,6 +463,8 @@ namespace Util
          }
 
       }
+
+      initializeObjects(begin);
    }
 
    /*
@@ -426,6 +501,7 @@ namespace Util
       }
       #endif
 
+      int begin = size_;
       for (int i = 0; i < size; ++i) {
          addBlank();
          name = "unknown";
@@ -439,6 +515,8 @@ namespace Util
          }
       }
       addBlank();
+
+      initializeObjects(begin);
    }
 
    /*
@@ -451,7 +529,7 @@ namespace Util
       ar << size;
       for (int i = 0; i < size; ++i) {
          ar << names_[i];
-         (ptrs_[i])->save(ar);
+         saveParamComposite(ar, *ptrs_[i]);
       }
    }
 
@@ -463,6 +541,9 @@ namespace Util
    {
       ptrs_.push_back(&data);
       names_.push_back(name);
+      if (firstIndex_.find(name) == firstIndex_.end()) {
+         firstIndex_[name] = size_;
+      }
       ++size_;
    }
 
@@ -511,14 +592,31 @@ namespace Util
    template <typename Data>
    Data* Manager<Data>::findFirst(std::string const & className)
    {
-      for (int i = 0; i < size_; ++i) {
-         if (names_[i] == className) {
-            return ptrs_[i];
-         }
+      typename NameIndex::const_iterator iter;
+      iter = firstIndex_.find(className);
+      if (iter == firstIndex_.end()) {
+         return 0;
       }
-      return 0;
+      return ptrs_[iter->second];
+   }
+
+   /*
+   * Set maximum number of threads for initializeObject().
+   */
+   template <typename Data>
+   void Manager<Data>::setNThread(int nThread)
+   {
+      UTIL_CHECK(nThread >= 1);
+      nThread_ = nThread;
    }
 
+   /*
+   * Get maximum number of threads for initializeObject().
+   */
+   template <typename Data>
+   inline int Manager<Data>::nThread() const
+   {  return nThread_; }
+
    // Protected methods
 
    /*
@@ -544,5 +642,52 @@ namespace Util
       return 0;
    }
 
+   // Private methods
+
+   /*
+   * Initialize objects begin, ..., size_ - 1, in parallel if allowed.
+   */
+   template <typename Data>
+   void Manager<Data>::initializeObjects(int begin)
+   {
+      int n = size_ - begin;
+      #ifdef UTIL_CXX11
+      int nThread = nThread_ < n ? nThread_ : n;
+      if (nThread > 1) {
+
+         // Each thread takes the next uninitialized object
+         std::atomic<int> next(begin);
+         std::exception_ptr error;
+         std::mutex mutex;
+         std::vector<std::thread> threads;
+         for (int t = 0; t < nThread; ++t) {
+            threads.push_back(std::thread([&]() {
+               int i;
+               while ((i = next++) < size_) {
+                  try {
+                     initializeObject(*ptrs_[i]);
+                  } catch (...) {
+                     std::lock_guard<std::mutex> lock(mutex);
+                     if (!error) error = std::current_exception();
+                     next = size_;
+                  }
+               }
+            }));
+         }
+         for (int t = 0; t < nThread; ++t) {
+            threads[t].join();
+         }
+         if (error) {
+            std::rethrow_exception(error);
+         }
+         return;
+
+      }
+      #endif
+      for (int i = begin; i < begin + n; ++i) {
+         initializeObject(*ptrs_[i]);
+      }
+   }
+
 }
 #endif
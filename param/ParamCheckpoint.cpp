@@ -0,0 +1,285 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "ParamCheckpoint.h"
+#include "ParamComposite.h"
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/misc/TempFile.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace Util
+{
+
+   namespace {
+
+      const char CheckpointMagic[8] = {'P','a','r','a','m','C','h','k'};
+      const int CheckpointVersion = 1;
+
+      /*
+      * Checkpoint being written by this thread, if any.
+      */
+      #ifdef UTIL_CXX11
+      thread_local ParamCheckpoint* writerPtr_ = 0;
+      #else
+      ParamCheckpoint* writerPtr_ = 0;
+      #endif
+
+      /*
+      * Sets writerPtr_ while in scope, and clears it on exit.
+      */
+      class WriterGuard
+      {
+      public:
+
+         WriterGuard(ParamCheckpoint& writer)
+         {
+            if (writerPtr_) {
+               UTIL_THROW("Nested ParamCheckpoint::write");
+            }
+            writerPtr_ = &writer;
+         }
+
+         ~WriterGuard()
+         {  writerPtr_ = 0; }
+
+      };
+
+   }
+
+   /*
+   * Constructor.
+   */
+   ParamCheckpoint::ParamCheckpoint()
+    : entries_(),
+      index_(),
+      stack_(),
+      filename_()
+   {}
+
+   /*
+   * Destructor.
+   */
+   ParamCheckpoint::~ParamCheckpoint()
+   {}
+
+   /*
+   * Save a tree and its table of contents.
+   */
+   void ParamCheckpoint::write(ParamComposite& root,
+                               std::string const & filename)
+   {
+      // Write to a temporary file, removed if an exception is thrown
+      TempFile tmp(filename);
+      Serializable::OArchive ar;
+      ar.file().open(tmp.name().c_str(), std::ios::out | std::ios::binary);
+      if (!ar.file().is_open()) {
+         std::string msg("Cannot open checkpoint file: ");
+         msg += tmp.name();
+         UTIL_THROW(msg.c_str());
+      }
+      int version = CheckpointVersion;
+      ar.pack(CheckpointMagic, 8);
+      ar << version;
+
+      // Save the tree, recording the position of each subtree
+      ParamCheckpoint writer;
+      Entry entry;
+      entry.begin = (long) ar.file().tellp();
+      entry.end = 0;
+      writer.entries_.push_back(entry);
+      writer.stack_.push_back(Frame());
+      writer.stack_.back().entry = 0;
+      {
+         WriterGuard guard(writer);
+         root.save(ar);
+      }
+      long tocOffset = (long) ar.file().tellp();
+      writer.entries_[0].end = tocOffset;
+      UTIL_CHECK(writer.stack_.size() == 1);
+
+      // Table of contents and trailer
+      int n = writer.entries_.size();
+      ar << n;
+      for (int i = 0; i < n; ++i) {
+         ar << writer.entries_[i].path;
+         ar << writer.entries_[i].begin;
+         ar << writer.entries_[i].end;
+      }
+      ar << tocOffset;
+      ar.pack(CheckpointMagic, 8);
+      ar.file().close();
+
+      if (ar.file().fail() || !tmp.commit()) {
+         std::string msg("Failed to write checkpoint file: ");
+         msg += filename;
+         UTIL_THROW(msg.c_str());
+      }
+   }
+
+   /*
+   * Record the beginning of a child subtree.
+   */
+   void ParamCheckpoint::beginSubtree(Serializable::OArchive& ar,
+                                      ParamComposite& child)
+   {
+      ParamCheckpoint* writer = writerPtr_;
+      if (!writer) return;
+      UTIL_CHECK(writer->stack_.size() > 0);
+
+      // Construct path from parent path and class name
+      Frame& parent = writer->stack_.back();
+      std::string name = child.className();
+      int count = parent.counts[name]++;
+      std::string path = writer->entries_[parent.entry].path;
+      if (!path.empty()) {
+         path += "/";
+      }
+      path += name;
+      if (count > 0) {
+         std::ostringstream suffix;
+         suffix << "#" << count;
+         path += suffix.str();
+      }
+
+      Entry entry;
+      entry.path = path;
+      entry.begin = (long) ar.file().tellp();
+      entry.end = 0;
+      writer->entries_.push_back(entry);
+      writer->stack_.push_back(Frame());
+      writer->stack_.back().entry = writer->entries_.size() - 1;
+   }
+
+   /*
+   * Record the end of the most recent open subtree.
+   */
+   void ParamCheckpoint::endSubtree(Serializable::OArchive& ar)
+   {
+      ParamCheckpoint* writer = writerPtr_;
+      if (!writer) return;
+      UTIL_CHECK(writer->stack_.size() > 1);
+      int i = writer->stack_.back().entry;
+      writer->entries_[i].end = (long) ar.file().tellp();
+      writer->stack_.pop_back();
+   }
+
+   /*
+   * Open a checkpoint file and read its table of contents.
+   */
+   void ParamCheckpoint::open(std::string const & filename)
+   {
+      entries_.clear();
+      index_.clear();
+      filename_ = filename;
+
+      Serializable::IArchive ar;
+      ar.file().open(filename.c_str(), std::ios::in | std::ios::binary);
+      if (!ar.file().is_open()) {
+         std::string msg("Cannot open checkpoint file: ");
+         msg += filename;
+         UTIL_THROW(msg.c_str());
+      }
+
+      // Header
+      char magic[8];
+      int version;
+      ar.unpack(magic, 8);
+      ar >> version;
+      if (!ar.file().good()
+          || std::memcmp(magic, CheckpointMagic, 8) != 0) {
+         UTIL_THROW("Not a parameter checkpoint file");
+      }
+      if (version != CheckpointVersion) {
+         UTIL_THROW("Unknown parameter checkpoint version");
+      }
+
+      // Trailer
+      long tocOffset;
+      ar.file().seekg(-(long)(sizeof(long) + 8), std::ios::end);
+      ar >> tocOffset;
+      ar.unpack(magic, 8);
+      if (!ar.file().good()
+          || std::memcmp(magic, CheckpointMagic, 8) != 0) {
+         UTIL_THROW("Truncated parameter checkpoint file");
+      }
+
+      // Table of contents
+      int n;
+      ar.file().seekg(tocOffset);
+      ar >> n;
+      UTIL_CHECK(n > 0);
+      entries_.resize(n);
+      for (int i = 0; i < n; ++i) {
+         ar >> entries_[i].path;
+         ar >> entries_[i].begin;
+         ar >> entries_[i].end;
+         index_[entries_[i].path] = i;
+      }
+      if (!ar.file().good()) {
+         UTIL_THROW("Corrupt parameter checkpoint index");
+      }
+   }
+
+   /*
+   * Load the whole tree.
+   */
+   void ParamCheckpoint::load(ParamComposite& root) const
+   {  load(std::string(), root); }
+
+   /*
+   * Load one subtree.
+   */
+   void ParamCheckpoint::load(std::string const & path,
+                              ParamComposite& object) const
+   {
+      Entry const & entry = entries_[find(path)];
+      Serializable::IArchive ar;
+      if (object.isIoProcessor()) {
+         ar.file().open(filename_.c_str(),
+                        std::ios::in | std::ios::binary);
+         if (!ar.file().is_open()) {
+            std::string msg("Cannot open checkpoint file: ");
+            msg += filename_;
+            UTIL_THROW(msg.c_str());
+         }
+         ar.file().seekg(entry.begin);
+      }
+      object.load(ar);
+      if (object.isIoProcessor()) {
+         if (!ar.file().good() || (long) ar.file().tellg() != entry.end) {
+            std::string msg("Inconsistent checkpoint subtree: ");
+            msg += path;
+            UTIL_THROW(msg.c_str());
+         }
+      }
+   }
+
+   /*
+   * Does the table of contents contain a path?
+   */
+   bool ParamCheckpoint::has(std::string const & path) const
+   {  return index_.find(path) != index_.end(); }
+
+   /*
+   * Return index of entry for path.
+   */
+   int ParamCheckpoint::find(std::string const & path) const
+   {
+      std::map<std::string, int>::const_iterator iter = index_.find(path);
+      if (iter == index_.end()) {
+         std::string msg("Unknown checkpoint path: ");
+         msg += path;
+         UTIL_THROW(msg.c_str());
+      }
+      return iter->second;
+   }
+
+}
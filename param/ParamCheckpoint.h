@@ -0,0 +1,219 @@
+#ifndef UTIL_PARAM_CHECKPOINT_H
+#define UTIL_PARAM_CHECKPOINT_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/archives/Serializable.h>  // typedefs
+#include <util/global.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Util
+{
+
+   class ParamComposite;
+
+   /**
+   * Checkpoint file with an index of ParamComposite subtrees.
+   *
+   * The static write() function saves a tree of ParamComposite objects
+   * to a binary file, in the format produced by save(), followed by a
+   * table of contents. The table gives the position of the data for the
+   * root and for every child ParamComposite saved through the function
+   * ParamComposite::saveParamComposite(), keyed by a label path.
+   *
+   * The path of a child is the path of its parent, a slash, and the
+   * class name of the child, or only the class name of a child of the
+   * root. The root has an empty path. If a parent has several children
+   * with the same class name, the second and later are distinguished
+   * by a suffix "#1", "#2", etc. For example, the third analyzer of
+   * class "Energy" in a manager "AnalyzerManager" that is a child of
+   * the root has the path "AnalyzerManager/Energy#2".
+   *
+   * After open(), the load() functions load the whole tree or a single
+   * subtree, seeking directly to its data, without reading anything in
+   * front of it. The table of contents is read only by open(), and each
+   * load() uses a separate file stream, so that different subtrees may
+   * be loaded concurrently by different threads into different objects.
+   *
+   * Loading a subtree calls load() for an object of the same class as
+   * that saved, and throws if this does not consume exactly the data
+   * that was saved.
+   *
+   * \ingroup Param_Module
+   */
+   class ParamCheckpoint
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      ParamCheckpoint();
+
+      /**
+      * Destructor.
+      */
+      ~ParamCheckpoint();
+
+      /**
+      * Save a tree of ParamComposite objects and its index to a file.
+      *
+      * The file is written to a temporary file that is then renamed.
+      *
+      * \throw Exception if the file cannot be written.
+      *
+      * \param root root of the tree
+      * \param filename name of checkpoint file
+      */
+      static void write(ParamComposite& root, std::string const & filename);
+
+      /**
+      * Open a checkpoint file and read its table of contents.
+      *
+      * \throw Exception if the file is not a valid checkpoint.
+      *
+      * \param filename name of checkpoint file
+      */
+      void open(std::string const & filename);
+
+      /**
+      * Load the whole tree, as saved by write().
+      *
+      * \param root root object, on which load() is called
+      */
+      void load(ParamComposite& root) const;
+
+      /**
+      * Load a subtree.
+      *
+      * Calls object.load() for an archive positioned at the beginning
+      * of the subtree with the specified path. When compiled with MPI,
+      * the file is read only by the I/O processor of the object.
+      *
+      * \throw Exception if path is not in the table of contents.
+      *
+      * \param path label path of subtree
+      * \param object object to load, of the same class as that saved
+      */
+      void load(std::string const & path, ParamComposite& object) const;
+
+      /**
+      * Does the table of contents contain a path?
+      *
+      * \param path label path of subtree
+      */
+      bool has(std::string const & path) const;
+
+      /**
+      * Number of entries in the table of contents, including the root.
+      */
+      int size() const;
+
+      /**
+      * Label path of entry i (entry 0 is the root).
+      *
+      * \param i entry index, 0 <= i < size()
+      */
+      std::string const & path(int i) const;
+
+      /**
+      * Size of the data for entry i, in bytes.
+      *
+      * \param i entry index, 0 <= i < size()
+      */
+      long dataSize(int i) const;
+
+   private:
+
+      /**
+      * Entry in the table of contents.
+      */
+      struct Entry
+      {
+         std::string path;
+         long begin;
+         long end;
+      };
+
+      /**
+      * State of one open subtree while writing.
+      */
+      struct Frame
+      {
+         /// Index of entry for this subtree.
+         int entry;
+         /// Number of children with each class name.
+         std::map<std::string, int> counts;
+      };
+
+      /// Table of contents.
+      std::vector<Entry> entries_;
+
+      /// Index in entries_ for each path.
+      std::map<std::string, int> index_;
+
+      /// Stack of open subtrees, used while writing.
+      std::vector<Frame> stack_;
+
+      /// Name of checkpoint file.
+      std::string filename_;
+
+      /// Return index of entry for path, or throw if absent.
+      int find(std::string const & path) const;
+
+      /**
+      * Record the beginning of a child subtree.
+      *
+      * Does nothing unless a checkpoint is being written by this thread.
+      */
+      static
+      void beginSubtree(Serializable::OArchive& ar, ParamComposite& child);
+
+      /**
+      * Record the end of the most recent open subtree.
+      *
+      * Does nothing unless a checkpoint is being written by this thread.
+      */
+      static void endSubtree(Serializable::OArchive& ar);
+
+   //friends:
+
+      friend class ParamComposite;
+
+   };
+
+   /*
+   * Number of entries.
+   */
+   inline int ParamCheckpoint::size() const
+   {  return entries_.size(); }
+
+   /*
+   * Path of entry i.
+   */
+   inline std::string const & ParamCheckpoint::path(int i) const
+   {
+      UTIL_CHECK(i >= 0 && i < (int)entries_.size());
+      return entries_[i].path;
+   }
+
+   /*
+   * Size of data for entry i.
+   */
+   inline long ParamCheckpoint::dataSize(int i) const
+   {
+      UTIL_CHECK(i >= 0 && i < (int)entries_.size());
+      return entries_[i].end - entries_[i].begin;
+   }
+
+}
+#endif
@@ -6,11 +6,29 @@
 */
 
 #include "ParamComponent.h"
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/archives/BinaryFileIArchive.h>
 
 namespace Util
 {
 
+   namespace {
+
+      /*
+      * Tag that precedes the binary form. The string form begins with
+      * a length that includes a terminating null, and is never zero.
+      */
+      const size_t BinaryTag = 0;
+
+      /*
+      * Version of the binary form.
+      */
+      const unsigned int BinaryVersion = 1;
+
+   }
+
    bool ParamComponent::echo_ = false;
+   bool ParamComponent::replicatedInput_ = false;
 
    /*
    * Constructor.
@@ -54,6 +72,44 @@ namespace Util
       }
    }
 
+   /*
+   * Save directly to a binary archive.
+   */
+   void ParamComponent::serialize(Serializable::OArchive& ar, 
+                                  const unsigned int version)
+   {
+      size_t tag = BinaryTag;
+      unsigned int formatVersion = BinaryVersion;
+      ar.pack(tag);
+      ar.pack(formatVersion);
+      save(ar);
+   }
+
+   /*
+   * Load from a binary archive, in binary or string form.
+   */
+   void ParamComponent::serialize(Serializable::IArchive& ar, 
+                                  const unsigned int version)
+   {
+      size_t tag;
+      ar.unpack(tag);
+      if (tag == BinaryTag) {
+         unsigned int formatVersion;
+         ar.unpack(formatVersion);
+         if (formatVersion > BinaryVersion) {
+            UTIL_THROW("Unknown ParamComponent binary format version");
+         }
+         load(ar);
+      } else {
+         // String form, in which tag is the length including a null
+         std::string str(tag, '\0');
+         ar.unpack(&str[0], tag);
+         str.resize(tag - 1);
+         std::istringstream buffer(str);
+         readParam(buffer);
+      }
+   }
+
    // Static functions
 
    /*
@@ -68,6 +124,18 @@ namespace Util
    bool ParamComponent::echo()
    {  return echo_; }
 
+   /*
+   * Enable (default) or disable replicated parameter input.
+   */
+   void ParamComponent::setReplicatedInput(bool replicated)
+   {  replicatedInput_ = replicated; }
+
+   /*
+   * Is replicated parameter input enabled?
+   */
+   bool ParamComponent::replicatedInput()
+   {  return replicatedInput_; }
+
    /*
    * This static method exists to guarantee initialization of a static 
    * constant echo_ that is defined in the same file.  Call it somewhere 
@@ -80,6 +148,7 @@ namespace Util
       static int nCall = 0;
       UTIL_CHECK(nCall == 0);
       echo_ = false; 
+      replicatedInput_ = false; 
       ++nCall;
    }
 
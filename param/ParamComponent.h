@@ -104,6 +104,30 @@ namespace Util
       template <class Archive>
       void serialize(Archive& ar, const unsigned int version);
 
+      /**
+      * Save this ParamComponent directly to a binary archive.
+      *
+      * Writes a tag and a format version, followed by the output of
+      * save(), rather than formatting the parameter file block as a
+      * string.
+      *
+      * \param ar      binary saving archive
+      * \param version version id for archive
+      */
+      void serialize(Serializable::OArchive& ar, const unsigned int version);
+
+      /**
+      * Load this ParamComponent from a binary archive.
+      *
+      * Accepts either the tagged form written by the binary overload
+      * of serialize, which is loaded by load(), or a string written by
+      * the generic serialize template, which is parsed by readParam().
+      *
+      * \param ar      binary loading archive
+      * \param version version id for archive
+      */
+      void serialize(Serializable::IArchive& ar, const unsigned int version);
+
       // Public static methods
 
       /**
@@ -130,6 +154,24 @@ namespace Util
       */
       static bool echo();
 
+      /**
+      * Enable or disable replicated parameter input.
+      *
+      * By default, parameter files are read only by the I/O processor
+      * of each communicator, and each value is then broadcast to other
+      * processors. When replicated input is enabled, every processor
+      * reads the same parameter file text from its own stream, and no
+      * values are broadcast. See ParamComposite::readParamBcast().
+      *
+      * \param replicated set true to enable, false to disable.
+      */
+      static void setReplicatedInput(bool replicated = true);
+
+      /**
+      * Is replicated parameter input enabled?
+      */
+      static bool replicatedInput();
+
    protected:
 
       /**
@@ -148,6 +190,24 @@ namespace Util
       */
       ParamComponent(const ParamComponent& other);
 
+      /**
+      * Should this processor read parameter file input?
+      *
+      * True if this is an I/O processor or if replicated input is
+      * enabled.
+      */
+      bool isParamReader() const;
+
+      #ifdef UTIL_MPI
+      /**
+      * Must values read from a parameter file be broadcast?
+      *
+      * True if this has an I/O communicator and replicated input is
+      * disabled.
+      */
+      bool isParamBcast() const;
+      #endif
+
    private:
 
       /// Indentation string, a string of spaces.
@@ -156,6 +216,9 @@ namespace Util
       /// Parameter to enable (true) or disable (false) echoing.
       static bool echo_;
 
+      /// Is every processor reading its own copy of the input?
+      static bool replicatedInput_;
+
    // friend:
 
       #ifdef UTIL_MPI
@@ -170,6 +233,22 @@ namespace Util
 
    };
 
+   // Inline methods
+
+   /*
+   * Should this processor read parameter file input?
+   */
+   inline bool ParamComponent::isParamReader() const
+   {  return isIoProcessor() || replicatedInput_; }
+
+   #ifdef UTIL_MPI
+   /*
+   * Must values read from a parameter file be broadcast?
+   */
+   inline bool ParamComponent::isParamBcast() const
+   {  return hasIoCommunicator() && !replicatedInput_; }
+   #endif
+
    /*
    * Serialize a ParamComponent as a string.
    */
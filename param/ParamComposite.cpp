@@ -9,14 +9,100 @@
 #include "Begin.h"
 #include "End.h"
 #include "Blank.h"
+#include "ParamCheckpoint.h"
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/misc/fnv1a.h>
+#include <util/misc/TempFile.h>
 #include <util/global.h>
 
 #include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <sstream>
 
 namespace Util
 {
 
+   namespace {
+
+      /*
+      * Read the remainder of a stream into a string.
+      *
+      * Returns the initial position, or -1 if the stream is not seekable.
+      */
+      std::streampos readRemainder(std::istream& in, std::string& text)
+      {
+         std::streampos start = in.tellg();
+         std::ostringstream buffer;
+         buffer << in.rdbuf();
+         text = buffer.str();
+         return start;
+      }
+
+      /*
+      * Return the number of characters of text consumed from a stream.
+      */
+      size_t consumed(std::istream& local, std::string const & text)
+      {
+         std::streampos end = local.tellg();
+         if (end == std::streampos(-1)) {
+            return text.size();
+         }
+         return (size_t) std::streamoff(end);
+      }
+
+      /*
+      * Position a stream after characters consumed from its remainder.
+      *
+      * If the stream is not seekable, it is left at end of file.
+      */
+      void skipTo(std::istream& in, std::streampos start, size_t length)
+      {
+         in.clear();
+         if (start != std::streampos(-1)) {
+            in.seekg(start + std::streamoff(length));
+         }
+      }
+
+      /*
+      * Parameter snapshot file format: magic string, version, number of
+      * characters of source text, and 64-bit hash of that text as two
+      * unsigned ints, followed by the output of save() and magic again.
+      */
+      const char SnapshotMagic[8] = {'P','a','r','a','m','S','n','p'};
+      const int SnapshotVersion = 1;
+
+      /*
+      * Read a snapshot header, and check it against text.
+      *
+      * Returns true and sets length to the number of characters of text
+      * in the snapshot key if the header is valid and the key matches.
+      */
+      bool matchSnapshot(Serializable::IArchive& ar,
+                         std::string const & text, size_t& length)
+      {
+         char magic[8];
+         int version;
+         long size;
+         unsigned int key[2];
+         ar.unpack(magic, 8);
+         ar >> version;
+         ar >> size;
+         ar.unpack(key, 2);
+         if (!ar.file().good()) return false;
+         if (std::memcmp(magic, SnapshotMagic, 8) != 0) return false;
+         if (version != SnapshotVersion) return false;
+         if (size < 0 || (size_t) size > text.size()) return false;
+         uint64_t hash = fnv1a(text.data(), (size_t) size);
+         if (key[0] != (unsigned int)(hash >> 32)) return false;
+         if (key[1] != (unsigned int)(hash & 0xffffffff)) return false;
+         length = (size_t) size;
+         return true;
+      }
+
+   }
+
    /*
    * Default Constructor.
    */
@@ -113,6 +199,157 @@ namespace Util
       }
    }
 
+   /*
+   * Read required parameter block, broadcasting input text once.
+   */
+   void ParamComposite::readParamBcast(std::istream &in)
+   {
+      #ifdef UTIL_MPI
+      if (!hasIoCommunicator()) {
+         readParam(in);
+         return;
+      }
+      MPI::Intracomm& communicator = ioCommunicator();
+
+      // Read remainder of stream on I/O processor, and broadcast it
+      std::string text;
+      std::streampos start = -1;
+      if (isIoProcessor()) {
+         start = readRemainder(in, text);
+      }
+      bcast<std::string>(communicator, text, 0);
+
+      // Read local copy on every processor
+      std::istringstream local(text);
+      bool echo = ParamComponent::echo();
+      if (!isIoProcessor()) {
+         ParamComponent::setEcho(false);
+      }
+      ParamComponent::setReplicatedInput(true);
+      try {
+         readParam(local);
+      } catch (...) {
+         ParamComponent::setReplicatedInput(false);
+         ParamComponent::setEcho(echo);
+         throw;
+      }
+      ParamComponent::setReplicatedInput(false);
+      ParamComponent::setEcho(echo);
+
+      // Reposition the input stream after the end of the block
+      if (isIoProcessor()) {
+         skipTo(in, start, consumed(local, text));
+      }
+
+      // Check that all processors agree on a hash of all values
+      if (!isParamConsistent()) {
+         UTIL_THROW("Parameters differ among processors");
+      }
+      #else
+      readParam(in);
+      #endif
+   }
+
+   /*
+   * Compare a hash of writeParam() output across processors.
+   */
+   bool ParamComposite::isParamConsistent() const
+   {
+      #ifdef UTIL_MPI
+      if (!hasIoCommunicator()) {
+         return true;
+      }
+      std::ostringstream values;
+      writeParam(values);
+      long hash = (long)(fnv1a(values.str()) >> 2);
+      long hashes[2], maxima[2];
+      hashes[0] = hash;
+      hashes[1] = -hash;
+      ioCommunicator().Allreduce(hashes, maxima, 2, MPI::LONG, MPI::MAX);
+      return maxima[0] == -maxima[1];
+      #else
+      return true;
+      #endif
+   }
+
+   /*
+   * Read required parameter block, using a binary snapshot if valid.
+   */
+   bool ParamComposite::readParamSnapshot(std::istream &in,
+                                          std::string const & filename)
+   {
+      std::string text;
+      std::streampos start = -1;
+      size_t length = 0;
+      bool isLoaded = false;
+      Serializable::IArchive ar;
+      if (isIoProcessor()) {
+         start = readRemainder(in, text);
+         ar.file().open(filename.c_str(),
+                        std::ios::in | std::ios::binary);
+         if (ar.file().is_open()) {
+            isLoaded = matchSnapshot(ar, text, length);
+         }
+      }
+      #ifdef UTIL_MPI
+      if (hasIoCommunicator()) {
+         bcast<bool>(ioCommunicator(), isLoaded, 0);
+      }
+      #endif
+
+      if (isLoaded) {
+
+         load(ar);
+         if (isIoProcessor()) {
+            char magic[8];
+            ar.unpack(magic, 8);
+            if (!ar.file().good()
+                || std::memcmp(magic, SnapshotMagic, 8) != 0) {
+               UTIL_THROW("Corrupt parameter snapshot");
+            }
+         }
+
+      } else {
+
+         std::istringstream local(text);
+         readParam(local);
+
+         // Write snapshot to a temporary file, then rename it
+         if (isIoProcessor()) {
+            length = consumed(local, text);
+            uint64_t hash = fnv1a(text.data(), length);
+            unsigned int key[2];
+            key[0] = (unsigned int)(hash >> 32);
+            key[1] = (unsigned int)(hash & 0xffffffff);
+            int version = SnapshotVersion;
+            long size = (long) length;
+            TempFile tmp(filename);
+            Serializable::OArchive oar;
+            oar.file().open(tmp.name().c_str(),
+                            std::ios::out | std::ios::binary);
+            if (oar.file().is_open()) {
+               oar.pack(SnapshotMagic, 8);
+               oar << version;
+               oar << size;
+               oar.pack(key, 2);
+               save(oar);
+               oar.pack(SnapshotMagic, 8);
+               oar.file().close();
+               if (!oar.file().fail()) {
+                  tmp.commit();
+               }
+            }
+         }
+
+      }
+
+      // Position the input stream after the end of the block
+      if (isIoProcessor()) {
+         skipTo(in, start, length);
+      }
+      return isLoaded;
+   }
+
    /*
    * Default writeParam implementation.
    */
@@ -188,7 +425,12 @@ namespace Util
    void ParamComposite::save(Serializable::OArchive& ar)
    {
       for (int i=0; i < size_; ++i) {
-         list_[i]->save(ar);
+         if (isLeaf_[i]) {
+            list_[i]->save(ar);
+         } else {
+            saveParamComposite(ar, 
+                               static_cast<ParamComposite&>(*list_[i]));
+         }
       }
    }
 
@@ -203,6 +445,17 @@ namespace Util
       }
    }
 
+   /*
+   * Save a child, recording its position in any checkpoint index.
+   */
+   void ParamComposite::saveParamComposite(Serializable::OArchive& ar,
+                                           ParamComposite& child)
+   {
+      ParamCheckpoint::beginSubtree(ar, child);
+      child.save(ar);
+      ParamCheckpoint::endSubtree(ar);
+   }
+
    /*
    * Reset list to empty state.
    */
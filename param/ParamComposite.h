@@ -164,6 +164,72 @@ namespace Util
       */
       virtual void readParamOptional(std::istream &in);
 
+      /**
+      * Read a required parameter block, broadcasting the input once.
+      *
+      * If this object has an I/O communicator, the I/O processor reads
+      * the remainder of the stream into a buffer, which is broadcast
+      * to all processors in a single operation. Every processor then
+      * calls readParam() for a local copy of the buffer, with replicated
+      * input enabled (see ParamComponent::setReplicatedInput), so that
+      * no value is broadcast individually. Only the I/O processor echoes
+      * parameters. Finally, a checksum of the output of writeParam() is
+      * compared across processors, to check that every processor read
+      * the same values. On return, the stream on the I/O processor is
+      * positioned after the end of the block if the stream is seekable,
+      * and at end of file otherwise.
+      *
+      * Every readParameters() function that is called must read only
+      * through the readParam() functions of parameters and children,
+      * and must not read directly from the stream on the I/O processor
+      * or broadcast values itself. Without an I/O communicator, this
+      * function is equivalent to readParam().
+      *
+      * \throw Exception if processors read different values.
+      *
+      * \param in input stream for reading
+      */
+      void readParamBcast(std::istream &in);
+
+      /**
+      * Do all processors hold the same parameter values?
+      *
+      * Compares a checksum of the output of writeParam() across all
+      * processors of the I/O communicator, with a single Allreduce.
+      * Must be called on all processors of that communicator. Returns
+      * true if this object has no I/O communicator.
+      */
+      bool isParamConsistent() const;
+
+      /**
+      * Read a required parameter block, using a binary snapshot if valid.
+      *
+      * The I/O processor reads the remainder of the stream. If the file
+      * named by filename is a snapshot that was created from identical
+      * text, i.e., if the text begins with the same number of characters
+      * as the text from which the snapshot was created, with the same
+      * 64-bit hash, then this object is restored by calling load() for
+      * a binary archive positioned after the snapshot header. Otherwise,
+      * the text is parsed by readParam(), and a new snapshot is written
+      * by save(). The snapshot is written to a temporary file that is
+      * then renamed, so that concurrent jobs never read a partial file.
+      * If the snapshot cannot be written, it is silently skipped. In
+      * either case, the stream on the I/O processor is positioned after
+      * the end of the block on return, if the stream is seekable.
+      *
+      * This requires that load() and save() of every object in the tree
+      * be consistent, and restore the same state as readParam(). As the
+      * key depends only on the parameter file text, a snapshot must be
+      * deleted whenever a change to the program changes this format.
+      *
+      * \throw Exception if a matching snapshot is corrupt.
+      *
+      * \param in input stream for reading
+      * \param filename name of snapshot file
+      * \return true if the snapshot was loaded, false if text was parsed
+      */
+      bool readParamSnapshot(std::istream &in, std::string const & filename);
+
       /**
       * Read the body of parameter block, without begin and end lines.
       *
@@ -262,6 +328,21 @@ namespace Util
       */
       void saveOptional(Serializable::OArchive &ar);
 
+      /**
+      * Save a child ParamComposite.
+      *
+      * Calls child.save(ar). While a ParamCheckpoint is being written,
+      * this also records the position of the child subtree in the file,
+      * so that it can later be loaded alone. The default implementation
+      * of save() saves all child ParamComposite objects in this way,
+      * and subclasses that save children explicitly should do the same.
+      *
+      * \param ar output/saving archive.
+      * \param child child ParamComposite object
+      */
+      void saveParamComposite(Serializable::OArchive &ar, 
+                              ParamComposite &child);
+
       //@}
       /// \name read* functions for child components
       /// \brief Each of these functions creates a new instance of a 
@@ -41,7 +41,7 @@ namespace Util
    */
    void Parameter::readParam(std::istream &in)
    {
-      if (isIoProcessor()) {
+      if (isParamReader()) {
 
          // Read the label and attempt to match.
          readLabel(in);
@@ -84,7 +84,7 @@ namespace Util
          #endif
       }
       #ifdef UTIL_MPI
-      if (hasIoCommunicator()) {
+      if (isParamBcast()) {
          if (isRequired()) {
             bcastValue();
             isActive_ = true;
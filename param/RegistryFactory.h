@@ -0,0 +1,303 @@
+#ifndef UTIL_REGISTRY_FACTORY_H
+#define UTIL_REGISTRY_FACTORY_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/Factory.h>         // base class template
+#include <util/global.h>
+
+#include <string>
+
+#ifdef UTIL_CXX11
+#include <unordered_map>
+#else
+#include <map>
+#endif
+
+namespace Util
+{
+
+   /**
+   * Factory that creates objects by hashed lookup of registered names.
+   *
+   * A RegistryFactory<Data> holds a hash table that maps class names to
+   * functions that create instances of subclasses of Data, and so needs
+   * no hand-written factory() method. Classes may be added to a single
+   * instance by calling add(), or to a global registry that is shared by
+   * all instances by a UTIL_REGISTER_CLASS macro, which can be placed at
+   * namespace scope in the file that defines the subclass:
+   * \code
+   *    UTIL_REGISTER_CLASS(Analyzer, EnergyAnalyzer);
+   * \endcode
+   *
+   * The factory() method first tries any subfactories, as required of
+   * all factories, then the classes added to this instance, then the
+   * global registry.
+   *
+   * Registration by UTIL_REGISTER_CLASS occurs during initialization of
+   * static objects, and so is complete before main() begins. A linker
+   * omits object files from a static library unless they are otherwise
+   * referenced, however, and registrations in such files are then lost.
+   *
+   * \ingroup Manager_Module
+   */
+   template <typename Data>
+   class RegistryFactory : public Factory<Data>
+   {
+
+   public:
+
+      /// Pointer to a function that returns a new object.
+      typedef Data* (*Creator)();
+
+      /**
+      * Constructor.
+      *
+      * \param useGlobal if true, also search the global registry.
+      */
+      RegistryFactory(bool useGlobal = true);
+
+      /**
+      * Destructor.
+      */
+      virtual ~RegistryFactory();
+
+      /**
+      * Add a class to this factory.
+      *
+      * \throw Exception if className was already added to this factory.
+      *
+      * \param className name of subclass
+      * \param creator function that creates an instance of className
+      */
+      void add(std::string const & className, Creator creator);
+
+      /**
+      * Add a subclass of Data to this factory.
+      *
+      * \param className name of subclass
+      */
+      template <typename Derived>
+      void add(std::string const & className)
+      {  add(className, &RegistryFactory<Data>::template create<Derived>); }
+
+      /**
+      * Return a pointer to a new instance of className, or null.
+      *
+      * \param className name of subclass
+      * \return base class pointer to new object, or a null pointer.
+      */
+      virtual Data* factory(const std::string& className) const;
+
+      /**
+      * Is className recognized by this factory, or its global registry?
+      *
+      * Subfactories are not searched.
+      *
+      * \param className name of subclass
+      */
+      bool has(std::string const & className) const;
+
+      /**
+      * Add a class to the global registry for Data.
+      *
+      * This is normally called through UTIL_REGISTER_CLASS.
+      *
+      * \throw Exception if className is already in the global registry.
+      *
+      * \param className name of subclass
+      * \param creator function that creates an instance of className
+      */
+      static void addGlobal(std::string const & className, Creator creator);
+
+      /**
+      * Create a new instance of a subclass of Data.
+      */
+      template <typename Derived>
+      static Data* create()
+      {  return new Derived(); }
+
+   private:
+
+      #ifdef UTIL_CXX11
+      typedef std::unordered_map<std::string, Creator> Registry;
+      #else
+      typedef std::map<std::string, Creator> Registry;
+      #endif
+
+      /// Classes added to this instance.
+      Registry registry_;
+
+      /// Should the global registry also be searched?
+      bool useGlobal_;
+
+      /// Return the global registry for Data, creating it on first use.
+      static Registry& global();
+
+      /// Add a class to a registry, throw if already present.
+      static void insert(Registry& registry, std::string const & className,
+                         Creator creator);
+
+      /// Find a creator in a registry, return null if absent.
+      static Creator find(Registry const & registry,
+                          std::string const & className);
+
+   };
+
+   /**
+   * Adds a subclass to a global registry when constructed.
+   *
+   * Static instances are created by the UTIL_REGISTER_CLASS macros.
+   *
+   * \ingroup Manager_Module
+   */
+   template <typename Data, typename Derived>
+   class FactoryRegistrar
+   {
+
+   public:
+
+      /**
+      * Constructor, registers class Derived.
+      *
+      * \param className name used to create Derived
+      */
+      FactoryRegistrar(const char* className)
+      {
+         RegistryFactory<Data>::addGlobal(className,
+                     &RegistryFactory<Data>::template create<Derived>);
+      }
+
+   };
+
+   /*
+   * Constructor.
+   */
+   template <typename Data>
+   RegistryFactory<Data>::RegistryFactory(bool useGlobal)
+    : Factory<Data>(),
+      registry_(),
+      useGlobal_(useGlobal)
+   {}
+
+   /*
+   * Destructor.
+   */
+   template <typename Data>
+   RegistryFactory<Data>::~RegistryFactory()
+   {}
+
+   /*
+   * Add a class to this factory.
+   */
+   template <typename Data>
+   void RegistryFactory<Data>::add(std::string const & className,
+                                   Creator creator)
+   {  insert(registry_, className, creator); }
+
+   /*
+   * Add a class to the global registry.
+   */
+   template <typename Data>
+   void RegistryFactory<Data>::addGlobal(std::string const & className,
+                                         Creator creator)
+   {  insert(global(), className, creator); }
+
+   /*
+   * Create an object, or return null if className is not recognized.
+   */
+   template <typename Data>
+   Data* RegistryFactory<Data>::factory(const std::string& className) const
+   {
+      Data* ptr = Factory<Data>::trySubfactories(className);
+      if (ptr) return ptr;
+
+      Creator creator = find(registry_, className);
+      if (!creator && useGlobal_) {
+         creator = find(global(), className);
+      }
+      if (creator) {
+         ptr = (*creator)();
+      }
+      return ptr;
+   }
+
+   /*
+   * Is className in this registry, or the global registry?
+   */
+   template <typename Data>
+   bool RegistryFactory<Data>::has(std::string const & className) const
+   {
+      if (find(registry_, className)) return true;
+      return useGlobal_ && find(global(), className);
+   }
+
+   /*
+   * Return the global registry, created on first use.
+   */
+   template <typename Data>
+   typename RegistryFactory<Data>::Registry& RegistryFactory<Data>::global()
+   {
+      static Registry registry;
+      return registry;
+   }
+
+   /*
+   * Add a class to a registry.
+   */
+   template <typename Data>
+   void RegistryFactory<Data>::insert(Registry& registry,
+                                      std::string const & className,
+                                      Creator creator)
+   {
+      UTIL_CHECK(creator);
+      if (registry.find(className) != registry.end()) {
+         std::string msg("Class name registered twice: ");
+         msg += className;
+         UTIL_THROW(msg.c_str());
+      }
+      registry[className] = creator;
+   }
+
+   /*
+   * Find a creator, or return null.
+   */
+   template <typename Data>
+   typename RegistryFactory<Data>::Creator
+   RegistryFactory<Data>::find(Registry const & registry,
+                               std::string const & className)
+   {
+      typename Registry::const_iterator iter = registry.find(className);
+      if (iter == registry.end()) return 0;
+      return iter->second;
+   }
+
+}
+
+#define UTIL_REGISTRY_CONCAT_(a, b) a ## b
+#define UTIL_REGISTRY_CONCAT(a, b) UTIL_REGISTRY_CONCAT_(a, b)
+
+/**
+* Register class Derived in the global RegistryFactory<Base> as name.
+*
+* Use at namespace scope, at most once per line.
+*/
+#define UTIL_REGISTER_CLASS_NAME(Base, Derived, name) \
+   static Util::FactoryRegistrar< Base, Derived > \
+      UTIL_REGISTRY_CONCAT(utilFactoryRegistrar_, __LINE__)(name)
+
+/**
+* Register class Derived in the global RegistryFactory<Base>.
+*
+* The registered name is the class name as written, which should thus
+* not include a namespace qualifier.
+*/
+#define UTIL_REGISTER_CLASS(Base, Derived) \
+   UTIL_REGISTER_CLASS_NAME(Base, Derived, #Derived)
+
+#endif
@@ -7,6 +7,7 @@ util_param_= \
     util/param/End.cpp \
     util/param/ParamComponent.cpp \
     util/param/ParamComposite.cpp \
+    util/param/ParamCheckpoint.cpp \
     util/param/Parameter.cpp \
     util/param/BracketPolicy.cpp 
 
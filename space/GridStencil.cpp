@@ -0,0 +1,230 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "GridStencil.h"
+
+namespace Util
+{
+
+   /*
+   * Default constructor.
+   */
+   GridStencil::GridStencil()
+    : offsets_(),
+      deltas_(),
+      dimensions_(0),
+      strides_(0),
+      range_(0),
+      tile_(1),
+      nTiles_(0)
+   {}
+
+   /*
+   * Constructor, set grid.
+   */
+   GridStencil::GridStencil(Grid const & grid)
+    : offsets_(),
+      deltas_(),
+      dimensions_(0),
+      strides_(0),
+      range_(0),
+      tile_(1),
+      nTiles_(0)
+   {  setGrid(grid); }
+
+   /*
+   * Destructor.
+   */
+   GridStencil::~GridStencil()
+   {}
+
+   /*
+   * Set the grid dimensions, and reset default tile dimensions.
+   */
+   void GridStencil::setGrid(Grid const & grid)
+   {
+      dimensions_ = grid.dimensions();
+      strides_[Dimension - 1] = 1;
+      for (int d = Dimension - 1; d > 0; --d) {
+         strides_[d-1] = strides_[d]*dimensions_[d];
+      }
+      IntVector tile;
+      for (int d = 0; d < Dimension - 1; ++d) {
+         tile[d] = dimensions_[d] < 8 ? dimensions_[d] : 8;
+      }
+      tile[Dimension - 1] = dimensions_[Dimension - 1];
+      setTile(tile);
+      makeTables();
+   }
+
+   /*
+   * Set dimensions of tiles.
+   */
+   void GridStencil::setTile(IntVector const & tile)
+   {
+      for (int d = 0; d < Dimension; ++d) {
+         UTIL_CHECK(tile[d] >= 1);
+         tile_[d] = tile[d];
+         nTiles_[d] = (dimensions_[d] + tile[d] - 1)/tile[d];
+      }
+   }
+
+   /*
+   * Set offsets to a cube.
+   */
+   void GridStencil::setCube(int range)
+   {
+      UTIL_CHECK(range >= 0);
+      offsets_.clear();
+      IntVector o;
+      for (o[0] = -range; o[0] <= range; ++o[0]) {
+         for (o[1] = -range; o[1] <= range; ++o[1]) {
+            for (o[2] = -range; o[2] <= range; ++o[2]) {
+               offsets_.append(o);
+            }
+         }
+      }
+      makeTables();
+   }
+
+   /*
+   * Set offsets to a half cube.
+   */
+   void GridStencil::setHalfCube(int range)
+   {
+      UTIL_CHECK(range >= 0);
+      offsets_.clear();
+      IntVector o;
+      for (o[0] = -range; o[0] <= range; ++o[0]) {
+         for (o[1] = -range; o[1] <= range; ++o[1]) {
+            for (o[2] = -range; o[2] <= range; ++o[2]) {
+               int d = 0;
+               while (d < Dimension && o[d] == 0) {
+                  ++d;
+               }
+               if (d == Dimension || o[d] > 0) {
+                  offsets_.append(o);
+               }
+            }
+         }
+      }
+      makeTables();
+   }
+
+   /*
+   * Remove all offsets.
+   */
+   void GridStencil::clear()
+   {
+      offsets_.clear();
+      makeTables();
+   }
+
+   /*
+   * Set offsets to a list.
+   */
+   void GridStencil::setOffsets(Array<IntVector> const & offsets)
+   {
+      offsets_.clear();
+      int n = offsets.capacity();
+      for (int k = 0; k < n; ++k) {
+         offsets_.append(offsets[k]);
+      }
+      makeTables();
+   }
+
+   /*
+   * Add an offset.
+   */
+   void GridStencil::addOffset(IntVector const & offset)
+   {
+      offsets_.append(offset);
+
+      // Recompute tables only if the range along some axis grows
+      int delta = 0;
+      for (int d = 0; d < Dimension; ++d) {
+         int a = offset[d] >= 0 ? offset[d] : -offset[d];
+         if (a > range_[d]) {
+            makeTables();
+            return;
+         }
+         delta += offset[d]*strides_[d];
+      }
+      deltas_.append(delta);
+   }
+
+   /*
+   * Compute ranks of all neighbors of a grid point.
+   */
+   void GridStencil::neighbors(IntVector const & position, int* ranks)
+   const
+   {
+      int const * t0 = tables_[0].cArray() + range_[0] + position[0];
+      int const * t1 = tables_[1].cArray() + range_[1] + position[1];
+      int const * t2 = tables_[2].cArray() + range_[2] + position[2];
+      int n = offsets_.size();
+      for (int k = 0; k < n; ++k) {
+         IntVector const & o = offsets_[k];
+         ranks[k] = t0[o[0]] + t1[o[1]] + t2[o[2]];
+      }
+   }
+
+   /*
+   * Get the bounds of a tile.
+   */
+   void GridStencil::tileBounds(int t, IntVector& begin, IntVector& end)
+   const
+   {
+      UTIL_ASSERT(t >= 0 && t < nTile());
+      for (int d = Dimension - 1; d >= 0; --d) {
+         int i = t % nTiles_[d];
+         t /= nTiles_[d];
+         begin[d] = i*tile_[d];
+         end[d] = begin[d] + tile_[d];
+         if (end[d] > dimensions_[d]) end[d] = dimensions_[d];
+      }
+   }
+
+   /*
+   * Recompute offset ranges, deltas, and wrap tables.
+   */
+   void GridStencil::makeTables()
+   {
+      int n = offsets_.size();
+      deltas_.clear();
+      range_ = IntVector(0);
+      for (int k = 0; k < n; ++k) {
+         IntVector const & o = offsets_[k];
+         int delta = 0;
+         for (int d = 0; d < Dimension; ++d) {
+            int a = o[d] >= 0 ? o[d] : -o[d];
+            if (a > range_[d]) range_[d] = a;
+            delta += o[d]*strides_[d];
+         }
+         deltas_.append(delta);
+      }
+
+      // Tables exist only once a grid has been set
+      if (dimensions_[0] <= 0) return;
+      for (int d = 0; d < Dimension; ++d) {
+         int size = dimensions_[d] + 2*range_[d];
+         if (tables_[d].isAllocated() && tables_[d].capacity() != size) {
+            tables_[d].deallocate();
+         }
+         if (!tables_[d].isAllocated()) {
+            tables_[d].allocate(size);
+         }
+         int n = dimensions_[d];
+         for (int j = 0; j < size; ++j) {
+            int x = (j - range_[d]) % n;
+            if (x < 0) x += n;
+            tables_[d][j] = x*strides_[d];
+         }
+      }
+   }
+
+}
@@ -0,0 +1,350 @@
+#ifndef UTIL_GRID_STENCIL_H
+#define UTIL_GRID_STENCIL_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/space/Grid.h>
+#include <util/space/IntVector.h>
+#include <util/containers/Array.h>
+#include <util/containers/DArray.h>
+#include <util/containers/GArray.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * A precomputed periodic stencil of neighbor offsets on a Grid.
+   *
+   * A GridStencil stores a list of integer offsets (e.g., the 27 cells
+   * of a 3x3x3 cube, or any custom list), and tables that yield the rank
+   * of each periodic neighbor of a grid point without division, modulo
+   * or branches. For each Cartesian axis d and each coordinate x in
+   * the range -R_d <= x < N_d + R_d, where N_d is the grid dimension
+   * and R_d is the largest absolute offset along d, the table stores
+   * the contribution to the rank of the periodic image of x. The rank
+   * of a neighbor is then a sum of Dimension table entries. For points
+   * at least R_d from every boundary, the neighbor rank is simply the
+   * point rank plus a precomputed constant per offset.
+   *
+   * The traverse() function visits every grid point, with the ranks of
+   * all of its neighbors, in a tiled (cache blocked) order. The grid is
+   * divided into rectangular tiles of dimensions set by setTile(), and
+   * tiles are visited in rank order. Tiles may be divided among threads:
+   * a call traverse(visitor, thread, nThread) visits only tiles t with
+   * t % nThread == thread, so that concurrent calls with thread = 0, ...,
+   * nThread - 1 together visit every point exactly once.
+   *
+   * Ranks are row-major ranks, as returned by Grid::rank(). They may be
+   * used directly to index a GridArray with the same dimensions only if
+   * it uses the default layout, SpaceFillingCurve::RowMajor. A GridArray
+   * with a Morton or Hilbert layout must not be indexed by these ranks.
+   *
+   * \ingroup Space_Module
+   */
+   class GridStencil
+   {
+
+   public:
+
+      /**
+      * Default constructor.
+      */
+      GridStencil();
+
+      /**
+      * Constructor, set grid.
+      *
+      * \param grid  grid with periodic boundary conditions
+      */
+      GridStencil(Grid const & grid);
+
+      /**
+      * Destructor.
+      */
+      ~GridStencil();
+
+      /// \name Setup
+      //@{
+
+      /**
+      * Set the grid dimensions.
+      *
+      * Offsets are retained, and all tables are recomputed. The default
+      * tile dimensions are reset to min(8, N_d) along every axis except
+      * the last, along which tiles span the full grid.
+      *
+      * \param grid  grid with periodic boundary conditions
+      */
+      void setGrid(Grid const & grid);
+
+      /**
+      * Set dimensions of the tiles used by traverse().
+      *
+      * \param tile  tile dimensions (each >= 1)
+      */
+      void setTile(IntVector const & tile);
+
+      /**
+      * Set offsets to a cube -range <= offset[d] <= range.
+      *
+      * For range = 1, this is the 27 point stencil of a point and its
+      * nearest neighbor cells, including the point itself. Offsets are
+      * ordered like ranks, with the last component varying fastest.
+      *
+      * \param range  maximum absolute offset (>= 0)
+      */
+      void setCube(int range = 1);
+
+      /**
+      * Set offsets to a half cube, for sums over distinct pairs.
+      *
+      * Includes the zero offset and one of each pair of offsets o and
+      * -o within the cube of specified range, namely those whose first
+      * nonzero component is positive. For range = 1 this is 14 offsets.
+      *
+      * \param range  maximum absolute offset (>= 0)
+      */
+      void setHalfCube(int range = 1);
+
+      /**
+      * Remove all offsets.
+      */
+      void clear();
+
+      /**
+      * Set offsets to a list, replacing any existing offsets.
+      *
+      * Tables are computed once, after all offsets are stored.
+      *
+      * \param offsets  array of integer offsets
+      */
+      void setOffsets(Array<IntVector> const & offsets);
+
+      /**
+      * Add an offset to the stencil.
+      *
+      * Tables are recomputed only if the offset extends the range of
+      * the stencil along some axis. To set many offsets at once, use
+      * setOffsets().
+      *
+      * \param offset  integer offset of a neighbor
+      */
+      void addOffset(IntVector const & offset);
+
+      //@}
+      /// \name Neighbor Ranks
+      //@{
+
+      /**
+      * Return the rank of the periodic image of position + offset(k).
+      *
+      * \param position  grid position, 0 <= position[d] < N_d
+      * \param k  index of offset, 0 <= k < size()
+      */
+      int neighbor(IntVector const & position, int k) const;
+
+      /**
+      * Compute ranks of all neighbors of a grid point.
+      *
+      * \param position  grid position, 0 <= position[d] < N_d
+      * \param ranks  array of size() neighbor ranks (output)
+      */
+      void neighbors(IntVector const & position, int* ranks) const;
+
+      /**
+      * Visit grid points in tiled order, with their neighbor ranks.
+      *
+      * For every grid point in tiles assigned to this thread, calls
+      * visitor(rank, ranks), where rank is the rank of the point and
+      * ranks is an array of size() ranks of its neighbors, in the order
+      * in which offsets were added.
+      *
+      * \param visitor  function object void(int, int const *)
+      * \param thread  index of this thread, 0 <= thread < nThread
+      * \param nThread  number of threads sharing the traversal
+      */
+      template <class Visitor>
+      void traverse(Visitor& visitor, int thread = 0, int nThread = 1)
+      const;
+
+      //@}
+      /// \name Accessors
+      //@{
+
+      /**
+      * Return the number of offsets.
+      */
+      int size() const;
+
+      /**
+      * Return offset k.
+      *
+      * \param k  index of offset, 0 <= k < size()
+      */
+      IntVector const & offset(int k) const;
+
+      /**
+      * Return the rank difference of offset k, for interior points.
+      *
+      * \param k  index of offset, 0 <= k < size()
+      */
+      int delta(int k) const;
+
+      /**
+      * Return the grid dimensions.
+      */
+      IntVector const & dimensions() const;
+
+      /**
+      * Return the tile dimensions.
+      */
+      IntVector const & tile() const;
+
+      /**
+      * Return the number of tiles.
+      */
+      int nTile() const;
+
+      /**
+      * Get the bounds of a tile.
+      *
+      * \param t  tile index, 0 <= t < nTile()
+      * \param begin  first position in tile (output)
+      * \param end  one past the last position in tile (output)
+      */
+      void tileBounds(int t, IntVector& begin, IntVector& end) const;
+
+      //@}
+
+   private:
+
+      /// Offsets.
+      GArray<IntVector> offsets_;
+
+      /// Rank differences of offsets, for interior points.
+      GArray<int> deltas_;
+
+      /// Wrapped rank contributions, for -range_[d] <= x < N_d + range_[d].
+      DArray<int> tables_[Dimension];
+
+      /// Grid dimensions.
+      IntVector dimensions_;
+
+      /// Rank strides along each axis.
+      IntVector strides_;
+
+      /// Maximum absolute offset along each axis.
+      IntVector range_;
+
+      /// Tile dimensions.
+      IntVector tile_;
+
+      /// Number of tiles along each axis.
+      IntVector nTiles_;
+
+      /// Recompute offset ranges, deltas, and wrap tables.
+      void makeTables();
+
+      /// Rank contribution of coordinate x along axis d, wrapped.
+      int wrapped(int d, int x) const;
+
+   };
+
+   // Inline member functions
+
+   inline int GridStencil::wrapped(int d, int x) const
+   {
+      UTIL_ASSERT(x >= -range_[d]);
+      UTIL_ASSERT(x < dimensions_[d] + range_[d]);
+      return tables_[d][x + range_[d]];
+   }
+
+   inline int GridStencil::neighbor(IntVector const & position, int k)
+   const
+   {
+      IntVector const & o = offsets_[k];
+      int rank = 0;
+      for (int d = 0; d < Dimension; ++d) {
+         rank += wrapped(d, position[d] + o[d]);
+      }
+      return rank;
+   }
+
+   inline int GridStencil::size() const
+   {  return offsets_.size(); }
+
+   inline IntVector const & GridStencil::offset(int k) const
+   {  return offsets_[k]; }
+
+   inline int GridStencil::delta(int k) const
+   {  return deltas_[k]; }
+
+   inline IntVector const & GridStencil::dimensions() const
+   {  return dimensions_; }
+
+   inline IntVector const & GridStencil::tile() const
+   {  return tile_; }
+
+   inline int GridStencil::nTile() const
+   {  return nTiles_[0]*nTiles_[1]*nTiles_[2]; }
+
+   // Template member function
+
+   /*
+   * Visit grid points in tiled order, with their neighbor ranks.
+   */
+   template <class Visitor>
+   void GridStencil::traverse(Visitor& visitor, int thread, int nThread)
+   const
+   {
+      UTIL_CHECK(nThread >= 1);
+      UTIL_CHECK(thread >= 0 && thread < nThread);
+      int n = offsets_.size();
+      if (n == 0) return;
+
+      DArray<int> ranks;
+      ranks.allocate(n);
+      int* r = ranks.cArray();
+      IntVector begin, end, p;
+      int nt = nTile();
+      for (int t = thread; t < nt; t += nThread) {
+         tileBounds(t, begin, end);
+
+         // Points in [lo, hi) along the last axis have no wrapped
+         // neighbors along that axis.
+         int lo = begin[2] > range_[2] ? begin[2] : range_[2];
+         int hi = dimensions_[2] - range_[2];
+         hi = end[2] < hi ? end[2] : hi;
+         if (hi < lo) hi = lo;
+
+         for (p[0] = begin[0]; p[0] < end[0]; ++p[0]) {
+            bool inner0 = p[0] >= range_[0]
+                          && p[0] < dimensions_[0] - range_[0];
+            for (p[1] = begin[1]; p[1] < end[1]; ++p[1]) {
+               bool inner = inner0 && p[1] >= range_[1]
+                            && p[1] < dimensions_[1] - range_[1];
+               int rank = p[0]*strides_[0] + p[1]*strides_[1] + begin[2];
+               for (p[2] = begin[2]; p[2] < end[2]; ++p[2]) {
+                  if (inner && p[2] >= lo && p[2] < hi) {
+                     for (int k = 0; k < n; ++k) {
+                        r[k] = rank + deltas_[k];
+                     }
+                  } else {
+                     neighbors(p, r);
+                  }
+                  visitor(rank, (int const *) r);
+                  ++rank;
+               }
+            }
+         }
+      }
+   }
+
+}
+#endif
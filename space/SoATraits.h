@@ -0,0 +1,117 @@
+#ifndef UTIL_SOA_TRAITS_H
+#define UTIL_SOA_TRAITS_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/space/Vector.h>
+#include <util/space/IntVector.h>
+#include <util/space/Tensor.h>
+#include <util/space/Dimension.h>
+
+namespace Util
+{
+
+   /**
+   * Component layout of a type stored in an SoAArray.
+   *
+   * Each explicit specialization defines a public typedef Scalar, the
+   * type of each component, a static const int NComponent, the number
+   * of components, and static functions get() and set() that read and
+   * write a component by a flat component index 0 <= k < NComponent.
+   * The default template is empty, so an SoAArray can only be
+   * instantiated for types with an explicit specialization.
+   *
+   * \ingroup Space_Module
+   */
+   template <typename T>
+   class SoATraits
+   {};
+
+   /**
+   * SoATraits<Vector> explicit specialization.
+   *
+   * \ingroup Space_Module
+   */
+   template <>
+   class SoATraits<Vector>
+   {
+   public:
+
+      /// Type of each component.
+      typedef double Scalar;
+
+      /// Number of components.
+      static const int NComponent = Dimension;
+
+      /// Return component k of a Vector.
+      static Scalar get(Vector const & v, int k)
+      {  return v[k]; }
+
+      /// Set component k of a Vector.
+      static void set(Vector& v, int k, Scalar s)
+      {  v[k] = s; }
+
+   };
+
+   /**
+   * SoATraits<IntVector> explicit specialization.
+   *
+   * \ingroup Space_Module
+   */
+   template <>
+   class SoATraits<IntVector>
+   {
+   public:
+
+      /// Type of each component.
+      typedef int Scalar;
+
+      /// Number of components.
+      static const int NComponent = Dimension;
+
+      /// Return component k of an IntVector.
+      static Scalar get(IntVector const & v, int k)
+      {  return v[k]; }
+
+      /// Set component k of an IntVector.
+      static void set(IntVector& v, int k, Scalar s)
+      {  v[k] = s; }
+
+   };
+
+   /**
+   * SoATraits<Tensor> explicit specialization.
+   *
+   * Component k is element (k/Dimension, k%Dimension), in row-major
+   * order.
+   *
+   * \ingroup Space_Module
+   */
+   template <>
+   class SoATraits<Tensor>
+   {
+   public:
+
+      /// Type of each component.
+      typedef double Scalar;
+
+      /// Number of components.
+      static const int NComponent = DimensionSq;
+
+      /// Return component k of a Tensor.
+      static Scalar get(Tensor const & t, int k)
+      {  return t(k/Dimension, k%Dimension); }
+
+      /// Set component k of a Tensor.
+      static void set(Tensor& t, int k, Scalar s)
+      {  t(k/Dimension, k%Dimension) = s; }
+
+   };
+
+}
+#endif
@@ -0,0 +1,300 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "SpaceFillingCurve.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <cmath>
+
+namespace Util
+{
+
+   namespace SpaceFillingCurve
+   {
+
+      namespace {
+
+         /*
+         * Spread the low 21 bits of x, so that bit i moves to bit 3i.
+         */
+         inline uint64_t spread(uint64_t x)
+         {
+            x &= 0x1fffff;
+            x = (x | x << 32) & 0x1f00000000ffffULL;
+            x = (x | x << 16) & 0x1f0000ff0000ffULL;
+            x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+            x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+            x = (x | x << 2)  & 0x1249249249249249ULL;
+            return x;
+         }
+
+         /*
+         * Inverse of spread: collect every third bit into the low bits.
+         */
+         inline uint64_t compact(uint64_t x)
+         {
+            x &= 0x1249249249249249ULL;
+            x = (x ^ (x >> 2))  & 0x10c30c30c30c30c3ULL;
+            x = (x ^ (x >> 4))  & 0x100f00f00f00f00fULL;
+            x = (x ^ (x >> 8))  & 0x1f0000ff0000ffULL;
+            x = (x ^ (x >> 16)) & 0x1f00000000ffffULL;
+            x = (x ^ (x >> 32)) & 0x1fffff;
+            return x;
+         }
+
+         /*
+         * Interleave three coordinates, with x[0] most significant.
+         */
+         inline uint64_t interleave(uint64_t const * x)
+         {  return (spread(x[0]) << 2) | (spread(x[1]) << 1) | spread(x[2]); }
+
+         /*
+         * Transform coordinates to the "transposed" Hilbert index.
+         *
+         * J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc.
+         * 707, 381 (2004). Interleaving the bits of the result gives
+         * the Hilbert index.
+         */
+         void axesToTranspose(uint64_t* x, int bits)
+         {
+            uint64_t m = uint64_t(1) << (bits - 1);
+            uint64_t p, q, t;
+
+            // Inverse undo
+            for (q = m; q > 1; q >>= 1) {
+               p = q - 1;
+               for (int i = 0; i < Dimension; ++i) {
+                  if (x[i] & q) {
+                     x[0] ^= p;
+                  } else {
+                     t = (x[0] ^ x[i]) & p;
+                     x[0] ^= t;
+                     x[i] ^= t;
+                  }
+               }
+            }
+
+            // Gray encode
+            for (int i = 1; i < Dimension; ++i) {
+               x[i] ^= x[i-1];
+            }
+            t = 0;
+            for (q = m; q > 1; q >>= 1) {
+               if (x[Dimension-1] & q) {
+                  t ^= q - 1;
+               }
+            }
+            for (int i = 0; i < Dimension; ++i) {
+               x[i] ^= t;
+            }
+         }
+
+         /*
+         * Inverse of axesToTranspose.
+         */
+         void transposeToAxes(uint64_t* x, int bits)
+         {
+            uint64_t n = uint64_t(2) << (bits - 1);
+            uint64_t p, q, t;
+
+            // Gray decode
+            t = x[Dimension-1] >> 1;
+            for (int i = Dimension - 1; i > 0; --i) {
+               x[i] ^= x[i-1];
+            }
+            x[0] ^= t;
+
+            // Undo excess work
+            for (q = 2; q != n; q <<= 1) {
+               p = q - 1;
+               for (int i = Dimension - 1; i >= 0; --i) {
+                  if (x[i] & q) {
+                     x[0] ^= p;
+                  } else {
+                     t = (x[0] ^ x[i]) & p;
+                     x[0] ^= t;
+                     x[i] ^= t;
+                  }
+               }
+            }
+         }
+
+         typedef std::pair<uint64_t, int> Key;
+
+      }
+
+      /*
+      * Return the Morton index of a grid position.
+      */
+      uint64_t mortonEncode(IntVector const & position)
+      {
+         uint64_t x[Dimension];
+         for (int d = 0; d < Dimension; ++d) {
+            UTIL_ASSERT(position[d] >= 0);
+            UTIL_ASSERT(position[d] < (1 << MaxBits));
+            x[d] = position[d];
+         }
+         return interleave(x);
+      }
+
+      /*
+      * Return the grid position of a Morton index.
+      */
+      IntVector mortonDecode(uint64_t code)
+      {
+         IntVector position;
+         position[0] = (int) compact(code >> 2);
+         position[1] = (int) compact(code >> 1);
+         position[2] = (int) compact(code);
+         return position;
+      }
+
+      /*
+      * Return the Hilbert index of a grid position.
+      */
+      uint64_t hilbertEncode(IntVector const & position, int bits)
+      {
+         UTIL_CHECK(bits >= 1 && bits <= MaxBits);
+         uint64_t x[Dimension];
+         for (int d = 0; d < Dimension; ++d) {
+            UTIL_ASSERT(position[d] >= 0);
+            UTIL_ASSERT(position[d] < (1 << bits));
+            x[d] = position[d];
+         }
+         axesToTranspose(x, bits);
+         return interleave(x);
+      }
+
+      /*
+      * Return the grid position of a Hilbert index.
+      */
+      IntVector hilbertDecode(uint64_t code, int bits)
+      {
+         UTIL_CHECK(bits >= 1 && bits <= MaxBits);
+         uint64_t x[Dimension];
+         x[0] = compact(code >> 2);
+         x[1] = compact(code >> 1);
+         x[2] = compact(code);
+         transposeToAxes(x, bits);
+         IntVector position;
+         for (int d = 0; d < Dimension; ++d) {
+            position[d] = (int) x[d];
+         }
+         return position;
+      }
+
+      /*
+      * Return the index of a grid position along a curve.
+      */
+      uint64_t encode(Type type, IntVector const & position, int bits)
+      {
+         if (type == Morton) {
+            return mortonEncode(position);
+         } else
+         if (type == Hilbert) {
+            return hilbertEncode(position, bits);
+         } else {
+            UTIL_THROW("No position independent index for RowMajor");
+         }
+         return 0;
+      }
+
+      /*
+      * Return the minimum number of bits needed for grid dimensions.
+      */
+      int bitsFor(IntVector const & dimensions)
+      {
+         int max = 1;
+         for (int d = 0; d < Dimension; ++d) {
+            if (dimensions[d] > max) max = dimensions[d];
+         }
+         int bits = 1;
+         while ((1 << bits) < max) {
+            ++bits;
+         }
+         UTIL_CHECK(bits <= MaxBits);
+         return bits;
+      }
+
+      /*
+      * Compute the curve order of all points of a grid.
+      */
+      void order(Type type, IntVector const & dimensions,
+                 int* ranks, int* inverse)
+      {
+         int size = dimensions[0]*dimensions[1]*dimensions[2];
+         if (type == RowMajor) {
+            for (int r = 0; r < size; ++r) {
+               ranks[r] = r;
+               inverse[r] = r;
+            }
+            return;
+         }
+
+         int bits = bitsFor(dimensions);
+         std::vector<Key> keys(size);
+         IntVector p;
+         int r = 0;
+         for (p[0] = 0; p[0] < dimensions[0]; ++p[0]) {
+            for (p[1] = 0; p[1] < dimensions[1]; ++p[1]) {
+               for (p[2] = 0; p[2] < dimensions[2]; ++p[2]) {
+                  keys[r] = Key(encode(type, p, bits), r);
+                  ++r;
+               }
+            }
+         }
+         std::sort(keys.begin(), keys.end());
+         for (int k = 0; k < size; ++k) {
+            inverse[k] = keys[k].second;
+            ranks[keys[k].second] = k;
+         }
+      }
+
+      /*
+      * Compute a permutation that sorts particles by cell curve index.
+      */
+      void sortParticles(Type type, Array<Vector> const & positions,
+                         Vector const & lengths, IntVector const & nCell,
+                         Array<int>& permutation)
+      {
+         int n = positions.capacity();
+         UTIL_CHECK(permutation.capacity() >= n);
+
+         int bits = (type == RowMajor) ? 0 : bitsFor(nCell);
+         double scale[Dimension];
+         for (int d = 0; d < Dimension; ++d) {
+            UTIL_CHECK(lengths[d] > 0.0);
+            UTIL_CHECK(nCell[d] > 0);
+            scale[d] = double(nCell[d])/lengths[d];
+         }
+
+         std::vector<Key> keys(n);
+         IntVector cell;
+         for (int i = 0; i < n; ++i) {
+            for (int d = 0; d < Dimension; ++d) {
+               int c = (int) std::floor(positions[i][d]*scale[d]);
+               c %= nCell[d];
+               cell[d] = c < 0 ? c + nCell[d] : c;
+            }
+            if (type == RowMajor) {
+               int rank = (cell[0]*nCell[1] + cell[1])*nCell[2] + cell[2];
+               keys[i] = Key(uint64_t(rank), i);
+            } else {
+               keys[i] = Key(encode(type, cell, bits), i);
+            }
+         }
+         std::sort(keys.begin(), keys.end());
+         for (int k = 0; k < n; ++k) {
+            permutation[k] = keys[k].second;
+         }
+      }
+
+   }
+
+}
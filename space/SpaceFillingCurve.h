@@ -0,0 +1,167 @@
+#ifndef UTIL_SPACE_FILLING_CURVE_H
+#define UTIL_SPACE_FILLING_CURVE_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/space/IntVector.h>
+#include <util/space/Vector.h>
+#include <util/containers/Array.h>
+#include <util/global.h>
+
+#include <stdint.h>
+
+namespace Util
+{
+
+   /**
+   * Space filling curves for ordering grid points and particles.
+   *
+   * A space filling curve visits every point of a grid once, such that
+   * points that are close along the curve are close in space. Storing
+   * grid data or particles in curve order keeps spatial neighbors close
+   * in memory, and so improves cache use in neighbor and force loops.
+   *
+   * Curve indices are 64 bit integers, with up to MaxBits = 21 bits per
+   * coordinate. Bits of coordinate 0 are the most significant within
+   * each group of Dimension bits, consistent with the row-major rank
+   * order of Grid, in which the last coordinate varies fastest.
+   *
+   * \ingroup Space_Module
+   */
+   namespace SpaceFillingCurve
+   {
+
+      /**
+      * Enumeration of grid orderings.
+      *
+      * RowMajor: C array order, as for Grid::rank().
+      * Morton: Z-order curve, obtained by interleaving coordinate bits.
+      * Hilbert: Hilbert curve, in which consecutive points are always
+      * nearest neighbors.
+      */
+      enum Type {RowMajor, Morton, Hilbert};
+
+      /// Maximum number of bits per coordinate.
+      const int MaxBits = 21;
+
+      /**
+      * Return the Morton (Z-order) index of a grid position.
+      *
+      * \param position  grid position, 0 <= position[d] < 2^MaxBits
+      */
+      uint64_t mortonEncode(IntVector const & position);
+
+      /**
+      * Return the grid position of a Morton index.
+      *
+      * \param code  Morton index
+      */
+      IntVector mortonDecode(uint64_t code);
+
+      /**
+      * Return the Hilbert index of a grid position.
+      *
+      * The Hilbert curve of order bits covers a cube of 2^bits points
+      * along each axis.
+      *
+      * \param position  grid position, 0 <= position[d] < 2^bits
+      * \param bits  number of bits per coordinate (1 <= bits <= MaxBits)
+      */
+      uint64_t hilbertEncode(IntVector const & position,
+                             int bits = MaxBits);
+
+      /**
+      * Return the grid position of a Hilbert index.
+      *
+      * \param code  Hilbert index
+      * \param bits  number of bits per coordinate (1 <= bits <= MaxBits)
+      */
+      IntVector hilbertDecode(uint64_t code, int bits = MaxBits);
+
+      /**
+      * Return the index of a grid position along a curve.
+      *
+      * \throw Exception if type is RowMajor, for which the index
+      * depends on grid dimensions (see Grid::rank).
+      *
+      * \param type  curve type
+      * \param position  grid position
+      * \param bits  number of bits per coordinate (Hilbert only)
+      */
+      uint64_t encode(Type type, IntVector const & position, int bits);
+
+      /**
+      * Return the minimum number of bits needed for grid dimensions.
+      *
+      * \param dimensions  grid dimensions
+      */
+      int bitsFor(IntVector const & dimensions);
+
+      /**
+      * Compute the curve order of all points of a grid.
+      *
+      * On return, ranks[r] is the position along the curve of the grid
+      * point with row-major rank r, and inverse[k] is the row-major rank
+      * of the k-th point along the curve, for 0 <= r, k < size. For a
+      * grid whose dimensions are not equal powers of 2, the curve of the
+      * enclosing cube is restricted to grid points.
+      *
+      * \param type  curve type
+      * \param dimensions  grid dimensions
+      * \param ranks  curve order of each row-major rank (output)
+      * \param inverse  row-major rank of each curve position (output)
+      */
+      void order(Type type, IntVector const & dimensions,
+                 int* ranks, int* inverse);
+
+      /**
+      * Compute a permutation that sorts particles by cell curve index.
+      *
+      * The periodic orthorhombic box with the specified lengths is
+      * divided into a grid of cells. Each particle is assigned to the
+      * cell containing its periodic image in the primary box. On return,
+      * permutation[k] is the index of the particle with the k-th lowest
+      * cell curve index, with ties broken by particle index. For
+      * RowMajor, the curve index of a cell is its row-major rank.
+      *
+      * \param type  curve type
+      * \param positions  particle positions
+      * \param lengths  box lengths
+      * \param nCell  number of cells along each axis
+      * \param permutation  array of particle indices (output)
+      */
+      void sortParticles(Type type, Array<Vector> const & positions,
+                         Vector const & lengths, IntVector const & nCell,
+                         Array<int>& permutation);
+
+      /**
+      * Apply a permutation to an array.
+      *
+      * On return, out[k] = in[permutation[k]].
+      *
+      * \param in  input array
+      * \param permutation  array of indices into in
+      * \param out  permuted array (output, distinct from in)
+      */
+      template <typename T>
+      void permute(Array<T> const & in, Array<int> const & permutation,
+                   Array<T>& out)
+      {
+         int n = permutation.capacity();
+         UTIL_CHECK(in.capacity() >= n);
+         UTIL_CHECK(out.capacity() >= n);
+         UTIL_CHECK(in.cArray() != out.cArray());
+         for (int k = 0; k < n; ++k) {
+            out[k] = in[permutation[k]];
+         }
+      }
+
+   }
+
+}
+#endif
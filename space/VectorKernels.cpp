@@ -0,0 +1,298 @@
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "VectorKernels.h"
+
+#include <cmath>
+
+namespace Util
+{
+
+   namespace VectorKernels
+   {
+
+      namespace {
+
+         #ifdef UTIL_CXX11
+         static_assert(sizeof(Vector) == Dimension*sizeof(double),
+                       "Vector must contain only its components");
+         static_assert(sizeof(Tensor) == DimensionSq*sizeof(double),
+                       "Tensor must contain only its components");
+         #endif
+
+         /*
+         * Components of an array of Vector objects, as a C array.
+         */
+         inline double const * components(Array<Vector> const & a)
+         {  return reinterpret_cast<double const *>(a.cArray()); }
+
+         inline double* components(Array<Vector>& a)
+         {  return reinterpret_cast<double*>(a.cArray()); }
+
+         /*
+         * Components of an array of Tensor objects, as a C array.
+         */
+         inline double const * components(Array<Tensor> const & a)
+         {  return reinterpret_cast<double const *>(a.cArray()); }
+
+         inline double* components(Array<Tensor>& a)
+         {  return reinterpret_cast<double*>(a.cArray()); }
+
+         /*
+         * Number of independent partial sums used in reductions.
+         */
+         const int NLane = 4;
+
+         /*
+         * Combine partial sums pairwise.
+         */
+         inline double combine(double const * s)
+         {  return (s[0] + s[1]) + (s[2] + s[3]); }
+
+      }
+
+      /*
+      * Return the sum of dot products.
+      */
+      double dot(Array<Vector> const & a, Array<Vector> const & b)
+      {
+         int n = a.capacity();
+         UTIL_CHECK(b.capacity() >= n);
+         double const * UTIL_RESTRICT pa = components(a);
+         double const * UTIL_RESTRICT pb = components(b);
+         double s[NLane] = {0.0, 0.0, 0.0, 0.0};
+         int m = n - n % NLane;
+         for (int i = 0; i < m; i += NLane) {
+            for (int l = 0; l < NLane; ++l) {
+               int k = 3*(i + l);
+               s[l] += pa[k]*pb[k] + pa[k+1]*pb[k+1] + pa[k+2]*pb[k+2];
+            }
+         }
+         for (int i = m; i < n; ++i) {
+            int k = 3*i;
+            s[i - m] += pa[k]*pb[k] + pa[k+1]*pb[k+1] + pa[k+2]*pb[k+2];
+         }
+         return combine(s);
+      }
+
+      /*
+      * Compute dot products.
+      */
+      void dot(Array<Vector> const & a, Array<Vector> const & b,
+               Array<double>& out)
+      {
+         int n = a.capacity();
+         UTIL_CHECK(b.capacity() >= n);
+         UTIL_CHECK(out.capacity() >= n);
+         double const * UTIL_RESTRICT pa = components(a);
+         double const * UTIL_RESTRICT pb = components(b);
+         double* UTIL_RESTRICT po = out.cArray();
+         for (int i = 0; i < n; ++i) {
+            int k = 3*i;
+            po[i] = pa[k]*pb[k] + pa[k+1]*pb[k+1] + pa[k+2]*pb[k+2];
+         }
+      }
+
+      /*
+      * Compute cross products.
+      */
+      void cross(Array<Vector> const & a, Array<Vector> const & b,
+                 Array<Vector>& out)
+      {
+         int n = a.capacity();
+         UTIL_CHECK(b.capacity() >= n);
+         UTIL_CHECK(out.capacity() >= n);
+         double const * UTIL_RESTRICT pa = components(a);
+         double const * UTIL_RESTRICT pb = components(b);
+         double* UTIL_RESTRICT po = components(out);
+         for (int i = 0; i < n; ++i) {
+            int k = 3*i;
+            po[k]   = pa[k+1]*pb[k+2] - pa[k+2]*pb[k+1];
+            po[k+1] = pa[k+2]*pb[k]   - pa[k]*pb[k+2];
+            po[k+2] = pa[k]*pb[k+1]   - pa[k+1]*pb[k];
+         }
+      }
+
+      /*
+      * Return the sum of square norms.
+      */
+      double normSq(Array<Vector> const & a)
+      {  return dot(a, a); }
+
+      /*
+      * Compute square norms.
+      */
+      void normSq(Array<Vector> const & a, Array<double>& out)
+      {  dot(a, a, out); }
+
+      /*
+      * Scaled addition of Vector arrays.
+      */
+      void axpy(double alpha, Array<Vector> const & x, Array<Vector>& y)
+      {
+         int n = Dimension*x.capacity();
+         UTIL_CHECK(y.capacity() >= x.capacity());
+         double const * UTIL_RESTRICT px = components(x);
+         double* UTIL_RESTRICT py = components(y);
+         for (int k = 0; k < n; ++k) {
+            py[k] += alpha*px[k];
+         }
+      }
+
+      /*
+      * Compute minimum image displacements.
+      *
+      * Output may alias input, so restrict is not used here. Rounding
+      * uses floor(x + 0.5), which compiles to a branch free instruction
+      * sequence on common targets.
+      */
+      void minimumImage(Array<Vector> const & r1, Array<Vector> const & r2,
+                        Vector const & lengths, Array<Vector>& dr)
+      {
+         int n = r1.capacity();
+         UTIL_CHECK(r2.capacity() >= n);
+         UTIL_CHECK(dr.capacity() >= n);
+         double const * p1 = components(r1);
+         double const * p2 = components(r2);
+         double* pd = components(dr);
+         double l[Dimension];
+         double lInv[Dimension];
+         for (int d = 0; d < Dimension; ++d) {
+            UTIL_CHECK(lengths[d] > 0.0);
+            l[d] = lengths[d];
+            lInv[d] = 1.0/lengths[d];
+         }
+         for (int i = 0; i < n; ++i) {
+            for (int d = 0; d < Dimension; ++d) {
+               int k = 3*i + d;
+               double x = p1[k] - p2[k];
+               pd[k] = x - l[d]*std::floor(x*lInv[d] + 0.5);
+            }
+         }
+      }
+
+      /*
+      * Accumulate a sum of outer products.
+      */
+      void outerAdd(Array<Vector> const & a, Array<Vector> const & b,
+                    Tensor& t)
+      {
+         int n = a.capacity();
+         UTIL_CHECK(b.capacity() >= n);
+         double const * UTIL_RESTRICT pa = components(a);
+         double const * UTIL_RESTRICT pb = components(b);
+
+         // s[c][l] is partial sum l of component c = 3*p + q
+         double s[DimensionSq][NLane];
+         for (int c = 0; c < DimensionSq; ++c) {
+            for (int l = 0; l < NLane; ++l) {
+               s[c][l] = 0.0;
+            }
+         }
+         for (int i = 0; i < n; ++i) {
+            int k = 3*i;
+            int l = i % NLane;
+            for (int p = 0; p < Dimension; ++p) {
+               for (int q = 0; q < Dimension; ++q) {
+                  s[3*p + q][l] += pa[k+p]*pb[k+q];
+               }
+            }
+         }
+         for (int p = 0; p < Dimension; ++p) {
+            for (int q = 0; q < Dimension; ++q) {
+               t(p, q) += combine(s[3*p + q]);
+            }
+         }
+      }
+
+      /*
+      * Accumulate symmetrized outer products.
+      */
+      void symmOuterAdd(Array<Vector> const & a, Array<Vector> const & b,
+                        Tensor& t)
+      {
+         int n = a.capacity();
+         UTIL_CHECK(b.capacity() >= n);
+         double const * UTIL_RESTRICT pa = components(a);
+         double const * UTIL_RESTRICT pb = components(b);
+
+         // Components (0,0), (1,1), (2,2), (0,1), (0,2), (1,2)
+         double s[6][NLane];
+         for (int c = 0; c < 6; ++c) {
+            for (int l = 0; l < NLane; ++l) {
+               s[c][l] = 0.0;
+            }
+         }
+         for (int i = 0; i < n; ++i) {
+            int k = 3*i;
+            int l = i % NLane;
+            s[0][l] += pa[k]*pb[k];
+            s[1][l] += pa[k+1]*pb[k+1];
+            s[2][l] += pa[k+2]*pb[k+2];
+            s[3][l] += 0.5*(pa[k]*pb[k+1] + pa[k+1]*pb[k]);
+            s[4][l] += 0.5*(pa[k]*pb[k+2] + pa[k+2]*pb[k]);
+            s[5][l] += 0.5*(pa[k+1]*pb[k+2] + pa[k+2]*pb[k+1]);
+         }
+         t(0, 0) += combine(s[0]);
+         t(1, 1) += combine(s[1]);
+         t(2, 2) += combine(s[2]);
+         double xy = combine(s[3]);
+         double xz = combine(s[4]);
+         double yz = combine(s[5]);
+         t(0, 1) += xy;
+         t(1, 0) += xy;
+         t(0, 2) += xz;
+         t(2, 0) += xz;
+         t(1, 2) += yz;
+         t(2, 1) += yz;
+      }
+
+      /*
+      * Return the sum of all tensors in an array.
+      */
+      Tensor sum(Array<Tensor> const & a)
+      {
+         int n = a.capacity();
+         double const * UTIL_RESTRICT pa = components(a);
+         double s[DimensionSq][NLane];
+         for (int c = 0; c < DimensionSq; ++c) {
+            for (int l = 0; l < NLane; ++l) {
+               s[c][l] = 0.0;
+            }
+         }
+         for (int i = 0; i < n; ++i) {
+            int l = i % NLane;
+            for (int c = 0; c < DimensionSq; ++c) {
+               s[c][l] += pa[DimensionSq*i + c];
+            }
+         }
+         Tensor result;
+         for (int p = 0; p < Dimension; ++p) {
+            for (int q = 0; q < Dimension; ++q) {
+               result(p, q) = combine(s[3*p + q]);
+            }
+         }
+         return result;
+      }
+
+      /*
+      * Scaled addition of Tensor arrays.
+      */
+      void axpy(double alpha, Array<Tensor> const & x, Array<Tensor>& y)
+      {
+         int n = DimensionSq*x.capacity();
+         UTIL_CHECK(y.capacity() >= x.capacity());
+         double const * UTIL_RESTRICT px = components(x);
+         double* UTIL_RESTRICT py = components(y);
+         for (int k = 0; k < n; ++k) {
+            py[k] += alpha*px[k];
+         }
+      }
+
+   }
+
+}
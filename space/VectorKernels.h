@@ -0,0 +1,159 @@
+#ifndef UTIL_VECTOR_KERNELS_H
+#define UTIL_VECTOR_KERNELS_H
+
+/*
+* Util Package - C++ Utilities for Scientific Computation
+*
+* Copyright 2010 - 2017, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/space/Vector.h>
+#include <util/space/Tensor.h>
+#include <util/containers/Array.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Kernels that operate on whole arrays of Vector and Tensor objects.
+   *
+   * Each function applies one operation to every element of one or more
+   * arrays, in a single loop over unaliased data that the compiler can
+   * vectorize, rather than one Vector or Tensor at a time. The number
+   * of elements is the capacity of the first input array, and all other
+   * arrays must have at least this capacity. Output arrays may not
+   * overlap input arrays, except where noted.
+   *
+   * Functions that return or accumulate a sum over elements use several
+   * independent partial sums, which are combined pairwise at the end.
+   * This removes the dependence of each addition on the previous one,
+   * and reduces round off error relative to a single running sum.
+   *
+   * \ingroup Space_Module
+   */
+   namespace VectorKernels
+   {
+
+      /// \name Vector Arrays
+      //@{
+
+      /**
+      * Return the sum of dot products a[i].b[i].
+      *
+      * \param a  first input array
+      * \param b  second input array
+      */
+      double dot(Array<Vector> const & a, Array<Vector> const & b);
+
+      /**
+      * Compute dot products, out[i] = a[i].b[i].
+      *
+      * \param a  first input array
+      * \param b  second input array
+      * \param out  array of dot products (output)
+      */
+      void dot(Array<Vector> const & a, Array<Vector> const & b,
+               Array<double>& out);
+
+      /**
+      * Compute cross products, out[i] = a[i] x b[i].
+      *
+      * \param a  first input array
+      * \param b  second input array
+      * \param out  array of cross products (output)
+      */
+      void cross(Array<Vector> const & a, Array<Vector> const & b,
+                 Array<Vector>& out);
+
+      /**
+      * Return the sum of square norms |a[i]|^2.
+      *
+      * \param a  input array
+      */
+      double normSq(Array<Vector> const & a);
+
+      /**
+      * Compute square norms, out[i] = |a[i]|^2.
+      *
+      * \param a  input array
+      * \param out  array of square norms (output)
+      */
+      void normSq(Array<Vector> const & a, Array<double>& out);
+
+      /**
+      * Scaled addition, y[i] += alpha*x[i].
+      *
+      * \param alpha  scalar factor
+      * \param x  input array
+      * \param y  array to increment (input and output)
+      */
+      void axpy(double alpha, Array<Vector> const & x, Array<Vector>& y);
+
+      /**
+      * Compute minimum image displacements in an orthorhombic box.
+      *
+      * On return, dr[i] is the periodic image of r1[i] - r2[i] with each
+      * component in the range [-lengths[d]/2, lengths[d]/2]. The output
+      * array may be the same as either input array.
+      *
+      * \param r1  first position array
+      * \param r2  second position array
+      * \param lengths  box lengths
+      * \param dr  displacements (output)
+      */
+      void minimumImage(Array<Vector> const & r1, Array<Vector> const & r2,
+                        Vector const & lengths, Array<Vector>& dr);
+
+      /**
+      * Accumulate a sum of outer products, t += sum_i a[i] b[i]^T.
+      *
+      * \param a  first input array (left, row index)
+      * \param b  second input array (right, column index)
+      * \param t  tensor to increment (input and output)
+      */
+      void outerAdd(Array<Vector> const & a, Array<Vector> const & b,
+                    Tensor& t);
+
+      /**
+      * Accumulate symmetrized outer products.
+      *
+      * Increments t by sum_i (a[i] b[i]^T + b[i] a[i]^T)/2. Only the
+      * Dimension*(Dimension+1)/2 independent components are summed. With
+      * a = pair separations and b = pair forces, this is the virial
+      * contribution to a symmetric stress tensor.
+      *
+      * \param a  first input array
+      * \param b  second input array
+      * \param t  tensor to increment (input and output, symmetric)
+      */
+      void symmOuterAdd(Array<Vector> const & a, Array<Vector> const & b,
+                        Tensor& t);
+
+      //@}
+      /// \name Tensor Arrays
+      //@{
+
+      /**
+      * Return the sum of all tensors in an array.
+      *
+      * \param a  input array
+      */
+      Tensor sum(Array<Tensor> const & a);
+
+      /**
+      * Scaled addition, y[i] += alpha*x[i].
+      *
+      * \param alpha  scalar factor
+      * \param x  input array
+      * \param y  array to increment (input and output)
+      */
+      void axpy(double alpha, Array<Tensor> const & x, Array<Tensor>& y);
+
+      //@}
+
+   }
+
+}
+#endif
@@ -1,5 +1,6 @@
 
-util_space_=util/space/Grid.cpp \
+util_space_=util/space/Grid.cpp util/space/GridStencil.cpp \
+    util/space/SpaceFillingCurve.cpp util/space/VectorKernels.cpp \
     util/space/IntVector.cpp util/space/Tensor.cpp \
     util/space/Vector.cpp 
 
@@ -6,6 +6,11 @@
 #include <test/UnitTestRunner.h>
 
 #include <util/accumulators/Average.h>
+#include <util/accumulators/TensorAverage.h>
+#include <util/accumulators/SymmTensorAverage.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+#include <util/space/Tensor.h>
 #include <util/archives/MemoryOArchive.h>
 #include <util/archives/MemoryIArchive.h>
 #include <util/archives/MemoryCounter.h>
@@ -31,6 +36,11 @@ public:
    void testSerialize();
    void testSerializeFile();
    void testSaveLoad();
+   void testTensorSampleOuter();
+   void testSymmTensorSampleOuter();
+
+   // Fill arrays a and b with sample s of a test data set.
+   void makeVectors(int s, DArray<Vector>& a, DArray<Vector>& b);
 
 };
 
@@ -145,12 +155,96 @@ void AverageTest::testSaveLoad()
    clone.output(std::cout);
 }
 
+void AverageTest::makeVectors(int s, DArray<Vector>& a, DArray<Vector>& b)
+{
+   for (int k = 0; k < a.capacity(); ++k) {
+      a[k] = Vector(0.5*k - s, 1.0 + 0.25*s*k, 2.0 - k);
+      b[k] = Vector(1.5 - 0.5*s, 0.1*k*k, 3.0*s - k + 0.5);
+   }
+}
+
+void AverageTest::testTensorSampleOuter()
+{
+   printMethod(TEST_FUNC);
+
+   TensorAverage byOuter;
+   TensorAverage bySample;
+   DArray<Vector> a, b;
+   a.allocate(7);
+   b.allocate(7);
+   Tensor t;
+   int s, i, j, k;
+   for (s = 0; s < 5; ++s) {
+      makeVectors(s, a, b);
+      byOuter.sampleOuter(a, b);
+
+      // Explicit sum of outer products
+      t.zero();
+      for (k = 0; k < a.capacity(); ++k) {
+         for (i = 0; i < Dimension; ++i) {
+            for (j = 0; j < Dimension; ++j) {
+               t(i, j) += a[k][i]*b[k][j];
+            }
+         }
+      }
+      bySample.sample(t);
+   }
+
+   for (i = 0; i < Dimension; ++i) {
+      for (j = 0; j < Dimension; ++j) {
+         TEST_ASSERT(byOuter(i, j).nSample() == 5);
+         TEST_ASSERT(eq(byOuter(i, j).average(), bySample(i, j).average()));
+         TEST_ASSERT(eq(byOuter(i, j).variance(),
+                        bySample(i, j).variance()));
+      }
+   }
+}
+
+void AverageTest::testSymmTensorSampleOuter()
+{
+   printMethod(TEST_FUNC);
+
+   SymmTensorAverage byOuter;
+   SymmTensorAverage bySample;
+   DArray<Vector> a, b;
+   a.allocate(7);
+   b.allocate(7);
+   Tensor t;
+   int s, i, j, k;
+   for (s = 0; s < 5; ++s) {
+      makeVectors(s, a, b);
+      byOuter.sampleOuter(a, b);
+
+      // Explicit symmetrized sum of outer products
+      t.zero();
+      for (k = 0; k < a.capacity(); ++k) {
+         for (i = 0; i < Dimension; ++i) {
+            for (j = 0; j < Dimension; ++j) {
+               t(i, j) += 0.5*(a[k][i]*b[k][j] + b[k][i]*a[k][j]);
+            }
+         }
+      }
+      bySample.sample(t);
+   }
+
+   for (i = 0; i < Dimension; ++i) {
+      for (j = 0; j < Dimension; ++j) {
+         TEST_ASSERT(byOuter(i, j).nSample() == 5);
+         TEST_ASSERT(eq(byOuter(i, j).average(), bySample(i, j).average()));
+         TEST_ASSERT(eq(byOuter(i, j).variance(),
+                        bySample(i, j).variance()));
+      }
+   }
+}
+
 TEST_BEGIN(AverageTest)
 TEST_ADD(AverageTest, testReadParam)
 TEST_ADD(AverageTest, testSample)
 TEST_ADD(AverageTest, testSerialize)
 TEST_ADD(AverageTest, testSerializeFile)
 TEST_ADD(AverageTest, testSaveLoad)
+TEST_ADD(AverageTest, testTensorSampleOuter)
+TEST_ADD(AverageTest, testSymmTensorSampleOuter)
 TEST_END(AverageTest)
 
 #endif
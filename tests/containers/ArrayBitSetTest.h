@@ -0,0 +1,156 @@
+#ifndef ARRAY_BIT_SET_TEST_H
+#define ARRAY_BIT_SET_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/containers/DArray.h>
+#include <util/containers/ArrayBitSet.h>
+#include <util/containers/ArrayBitSetIterator.h>
+
+using namespace Util;
+
+class ArrayBitSetTest : public UnitTest 
+{
+
+private:
+
+   typedef int Data;
+
+   const static int capacity = 200;
+
+   DArray<Data> array_;
+   ArrayBitSet<Data> set_;
+
+   int memory_;
+   
+public:
+
+   void setUp()
+   {
+      memory_ = Memory::total();
+      array_.allocate(capacity);
+      for (int i = 0; i < capacity; ++i) {
+         array_[i] = (i+1)*10 + 1;
+      }
+      set_.allocate(array_);
+   }
+
+   void tearDown()
+   {}
+  
+   void testAppendRemove();
+   void testIterator();
+   void testRank();
+   void testBatch();
+
+};
+
+void ArrayBitSetTest::testAppendRemove()
+{
+   printMethod(TEST_FUNC);
+   TEST_ASSERT(set_.nWord() == 4);
+   set_.append(array_[8]);
+   set_.append(array_[130]);
+   set_.append(array_[64]);
+   set_.append(array_[2]);
+   TEST_ASSERT(set_.size() == 4);
+   TEST_ASSERT(set_.isValid());
+   TEST_ASSERT(set_.isElement(array_[64]));
+   TEST_ASSERT(!set_.isElement(array_[63]));
+   TEST_ASSERT(set_.hasId(130));
+
+   set_.remove(array_[64]);
+   TEST_ASSERT(set_.size() == 3);
+   TEST_ASSERT(!set_.hasId(64));
+   TEST_ASSERT(set_.isValid());
+
+   try {
+      set_.remove(array_[64]);
+      TEST_ASSERT(0);
+   } catch (Exception& e) {
+      std::cout << "Caught expected Exception" << std::endl;
+   }
+   set_.clear();
+   TEST_ASSERT(set_.size() == 0);
+   TEST_ASSERT(set_.isValid());
+}
+
+void ArrayBitSetTest::testIterator()
+{
+   printMethod(TEST_FUNC);
+   int ids[] = {150, 8, 199, 63, 64, 0, 100};
+   for (int i = 0; i < 7; ++i) {
+      set_.append(array_[ids[i]]);
+   }
+   set_.remove(array_[100]);
+
+   // Iteration is in ascending address order
+   int expected[] = {0, 8, 63, 64, 150, 199};
+   ArrayBitSetIterator<Data> iterator;
+   int n = 0;
+   for (set_.begin(iterator); iterator.notEnd(); ++iterator) {
+      TEST_ASSERT(iterator.id() == expected[n]);
+      TEST_ASSERT(*iterator == array_[expected[n]]);
+      ++n;
+   }
+   TEST_ASSERT(n == 6);
+   TEST_ASSERT(iterator.isEnd());
+
+   // Empty set
+   set_.clear();
+   set_.begin(iterator);
+   TEST_ASSERT(iterator.isEnd());
+}
+
+void ArrayBitSetTest::testRank()
+{
+   printMethod(TEST_FUNC);
+   for (int i = 3; i < capacity; i += 7) {
+      set_.append(array_[i]);
+   }
+   int n = set_.size();
+   for (int j = 0; j < n; ++j) {
+      TEST_ASSERT(&set_[j] == &array_[3 + 7*j]);
+      TEST_ASSERT(set_.index(array_[3 + 7*j]) == j);
+   }
+   TEST_ASSERT(set_.index(array_[4]) == -1);
+
+   // Index is rebuilt after a change in membership
+   set_.remove(array_[3]);
+   TEST_ASSERT(set_.index(array_[10]) == 0);
+   TEST_ASSERT(&set_[0] == &array_[10]);
+   TEST_ASSERT(set_.isValid());
+}
+
+void ArrayBitSetTest::testBatch()
+{
+   printMethod(TEST_FUNC);
+   for (int i = 0; i < capacity; i += 3) {
+      set_.append(array_[i]);
+   }
+
+   DArray<int> ids;
+   ids.allocate(capacity);
+   int n = set_.getIds(&ids[0]);
+   TEST_ASSERT(n == set_.size());
+   for (int j = 0; j < n; ++j) {
+      TEST_ASSERT(ids[j] == 3*j);
+   }
+
+   int query[] = {0, 1, 2, 3, 66, 67, 198, 199};
+   bool flags[8];
+   set_.hasIds(query, 8, flags);
+   for (int j = 0; j < 8; ++j) {
+      TEST_ASSERT(flags[j] == (query[j] % 3 == 0));
+   }
+}
+
+TEST_BEGIN(ArrayBitSetTest)
+TEST_ADD(ArrayBitSetTest, testAppendRemove)
+TEST_ADD(ArrayBitSetTest, testIterator)
+TEST_ADD(ArrayBitSetTest, testRank)
+TEST_ADD(ArrayBitSetTest, testBatch)
+TEST_END(ArrayBitSetTest)
+
+#endif
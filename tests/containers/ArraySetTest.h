@@ -37,6 +37,7 @@ public:
    void testRemove();
    void testPop();
    void testIterator();
+   void testSort();
 
 };
 
@@ -191,11 +192,38 @@ void ArraySetTest::testIterator()
    TEST_ASSERT(Memory::total() == memory_);
 }
 
+void ArraySetTest::testSort()
+{
+   printMethod(TEST_FUNC);
+   {
+      set().append(array()[8]);
+      set().append(array()[4]);
+      set().append(array()[2]);
+      set().append(array()[3]);
+      set().append(array()[5]);
+      set().remove(array()[2]);
+      set().sort();
+   
+      TEST_ASSERT(set().isValid());
+      TEST_ASSERT(set().size() == 4);
+      TEST_ASSERT(&set()[0] == &array()[3]);
+      TEST_ASSERT(&set()[1] == &array()[4]);
+      TEST_ASSERT(&set()[2] == &array()[5]);
+      TEST_ASSERT(&set()[3] == &array()[8]);
+      TEST_ASSERT(set().index(array()[5]) == 2);
+   
+      delete arrayPtr;
+      delete setPtr;
+   }
+   TEST_ASSERT(Memory::total() == memory_);
+}
+
 TEST_BEGIN(ArraySetTest)
 TEST_ADD(ArraySetTest, testAppend)
 TEST_ADD(ArraySetTest, testRemove)
 TEST_ADD(ArraySetTest, testPop)
 TEST_ADD(ArraySetTest, testIterator)
+TEST_ADD(ArraySetTest, testSort)
 TEST_END(ArraySetTest)
 
 #endif
@@ -0,0 +1,273 @@
+#ifndef UTIL_ARRAY_VIEW_TEST_H
+#define UTIL_ARRAY_VIEW_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/containers/ArrayView.h>
+#include <util/containers/MatrixView.h>
+#include <util/containers/GridView.h>
+#include <util/containers/DArray.h>
+#include <util/containers/FArray.h>
+#include <util/containers/DMatrix.h>
+#include <util/containers/GridArray.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryIArchive.h>
+#include <util/archives/MemoryCounter.h>
+
+using namespace Util;
+
+class ArrayViewTest : public UnitTest
+{
+
+private:
+
+   int memory_;
+
+   // Sum elements through a read-only view.
+   static double sum(ArrayView<const double> view)
+   {
+      double const * UTIL_RESTRICT ptr = view.cArray();
+      double result = 0.0;
+      for (int i = 0; i < view.capacity(); ++i) {
+         result += ptr[i];
+      }
+      return result;
+   }
+
+public:
+
+   void setUp()
+   {  memory_ = Memory::total(); }
+
+   void tearDown() {}
+
+   void testArrayView();
+   void testMatrixView();
+   void testGridView();
+   void testSerialize();
+
+};
+
+void ArrayViewTest::testArrayView()
+{
+   printMethod(TEST_FUNC);
+   {
+      DArray<double> a;
+      a.allocate(6);
+      for (int i = 0; i < 6; ++i) {
+         a[i] = 1.0*i;
+      }
+
+      ArrayView<double> v(a);
+      TEST_ASSERT(v.capacity() == 6);
+      TEST_ASSERT(v.cArray() == a.cArray());
+      v[2] = 10.0;
+      TEST_ASSERT(a[2] == 10.0);
+
+      ArrayView<double> s = v.slice(2, 3);
+      TEST_ASSERT(s.capacity() == 3);
+      TEST_ASSERT(s[0] == 10.0);
+      TEST_ASSERT(s[2] == 4.0);
+
+      // Re-point by assignment
+      s = v.slice(4, 2);
+      TEST_ASSERT(s[1] == 5.0);
+
+      DArray<double> const & c = a;
+      TEST_ASSERT(eq(sum(c), 23.0));
+      TEST_ASSERT(eq(sum(s), 9.0));
+
+      FArray<int, 4> f;
+      ArrayView<int> fv(f);
+      TEST_ASSERT(fv.capacity() == 4);
+      fv[3] = 7;
+      TEST_ASSERT(f[3] == 7);
+
+      ArrayView<int> n;
+      TEST_ASSERT(n.isNull());
+      TEST_ASSERT(n.capacity() == 0);
+
+      #ifdef UTIL_DEBUG
+      bool thrown = false;
+      try {
+         v[6] = 1.0;
+      } catch (Exception& e) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+      #endif
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void ArrayViewTest::testMatrixView()
+{
+   printMethod(TEST_FUNC);
+   {
+      DMatrix<double> m;
+      m.allocate(4, 5);
+      for (int i = 0; i < 4; ++i) {
+         for (int j = 0; j < 5; ++j) {
+            m(i, j) = 10.0*i + j;
+         }
+      }
+
+      MatrixView<double> v(m);
+      TEST_ASSERT(v.capacity1() == 4);
+      TEST_ASSERT(v.capacity2() == 5);
+      TEST_ASSERT(v.stride() == 5);
+      TEST_ASSERT(v.isContiguous());
+      TEST_ASSERT(v(2, 3) == 23.0);
+
+      MatrixView<double> b = v.block(1, 2, 2, 3);
+      TEST_ASSERT(b.capacity1() == 2);
+      TEST_ASSERT(b.capacity2() == 3);
+      TEST_ASSERT(b.stride() == 5);
+      TEST_ASSERT(!b.isContiguous());
+      TEST_ASSERT(b(0, 0) == 12.0);
+      TEST_ASSERT(b(1, 2) == 24.0);
+      b(1, 1) = -1.0;
+      TEST_ASSERT(m(2, 3) == -1.0);
+
+      // Copies preserve the stride of a sub-block
+      MatrixView<double> b2(b);
+      TEST_ASSERT(b2.stride() == 5);
+      MatrixView<const double> cb(b);
+      TEST_ASSERT(cb.stride() == 5);
+      TEST_ASSERT(cb(1, 2) == 24.0);
+
+      ArrayView<double> r = b.row(1);
+      TEST_ASSERT(r.capacity() == 3);
+      TEST_ASSERT(r[0] == 22.0);
+      TEST_ASSERT(eq(sum(r), 22.0 - 1.0 + 24.0));
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void ArrayViewTest::testGridView()
+{
+   printMethod(TEST_FUNC);
+   {
+      GridArray<int> g;
+      IntVector dimensions(2, 3, 4);
+      g.allocate(dimensions);
+      for (int i = 0; i < g.size(); ++i) {
+         g[i] = i;
+      }
+
+      GridView<int> v(g);
+      TEST_ASSERT(v.size() == 24);
+      TEST_ASSERT(v.dimensions() == dimensions);
+      IntVector p(1, 2, 3);
+      TEST_ASSERT(v.rank(p) == g.rank(p));
+      TEST_ASSERT(v(p) == g(p));
+      TEST_ASSERT(v.position(17) == g.position(17));
+
+      ArrayView<int> line = v.line(IntVector(1, 1, 0));
+      TEST_ASSERT(line.capacity() == 4);
+      TEST_ASSERT(line[0] == g(IntVector(1, 1, 0)));
+      line[2] = -5;
+      TEST_ASSERT(g(IntVector(1, 1, 2)) == -5);
+
+      GridArray<int> const & c = g;
+      GridView<const int> cv(c);
+      TEST_ASSERT(cv[5] == 5);
+      TEST_ASSERT(cv.array().capacity() == 24);
+
+      // A view of a GridArray requires the row-major layout
+      // UTIL_THROW aborts when compiled with MPI
+      #ifndef UTIL_MPI
+      GridArray<int> h;
+      h.setLayout(SpaceFillingCurve::Morton);
+      h.allocate(IntVector(4, 4, 4));
+      bool success = false;
+      try {
+         GridView<int> hv(h);
+      } catch (Exception& e) {
+         success = true;
+      }
+      TEST_ASSERT(success);
+      #endif
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void ArrayViewTest::testSerialize()
+{
+   printMethod(TEST_FUNC);
+   {
+      DMatrix<double> m;
+      m.allocate(3, 4);
+      for (int i = 0; i < 3; ++i) {
+         for (int j = 0; j < 4; ++j) {
+            m(i, j) = 10.0*i + j;
+         }
+      }
+      MatrixView<double> v = MatrixView<double>(m).block(1, 1, 2, 2);
+
+      MemoryCounter counter;
+      counter << v;
+      int size = counter.size();
+      TEST_ASSERT(size == 2*sizeof(int) + 4*sizeof(double));
+
+      MemoryOArchive oArchive;
+      oArchive.allocate(size);
+      oArchive << v;
+
+      DMatrix<double> n;
+      n.allocate(2, 2);
+      MatrixView<double> u(n);
+      MemoryIArchive iArchive;
+      iArchive = oArchive;
+      iArchive >> u;
+      TEST_ASSERT(n(0, 0) == 11.0);
+      TEST_ASSERT(n(0, 1) == 12.0);
+      TEST_ASSERT(n(1, 0) == 21.0);
+      TEST_ASSERT(n(1, 1) == 22.0);
+
+      // ArrayView of a row, serialized through a view of another array
+      DArray<double> a;
+      a.allocate(4);
+      MemoryOArchive oArchive2;
+      oArchive2.allocate(sizeof(int) + 4*sizeof(double));
+      ArrayView<double> row = MatrixView<double>(m).row(2);
+      oArchive2 << row;
+      MemoryIArchive iArchive2;
+      iArchive2 = oArchive2;
+      ArrayView<double> av(a);
+      iArchive2 >> av;
+      TEST_ASSERT(a[3] == 23.0);
+
+      // GridView, saved and loaded through views of two GridArrays
+      GridArray<double> g;
+      GridArray<double> h;
+      IntVector dimensions(2, 3, 4);
+      g.allocate(dimensions);
+      h.allocate(dimensions);
+      for (int i = 0; i < g.size(); ++i) {
+         g[i] = 0.5*i;
+      }
+      GridView<double> gv(g);
+      MemoryOArchive oArchive3;
+      oArchive3.allocate(sizeof(IntVector) + 24*sizeof(double));
+      oArchive3 << gv;
+      MemoryIArchive iArchive3;
+      iArchive3 = oArchive3;
+      GridView<double> hv(h);
+      iArchive3 >> hv;
+      for (int i = 0; i < h.size(); ++i) {
+         TEST_ASSERT(h[i] == 0.5*i);
+      }
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+TEST_BEGIN(ArrayViewTest)
+TEST_ADD(ArrayViewTest, testArrayView)
+TEST_ADD(ArrayViewTest, testMatrixView)
+TEST_ADD(ArrayViewTest, testGridView)
+TEST_ADD(ArrayViewTest, testSerialize)
+TEST_END(ArrayViewTest)
+
+#endif
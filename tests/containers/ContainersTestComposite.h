@@ -16,9 +16,16 @@
 #include "FPArrayTest.h"
 #include "GPArrayTest.h"
 #include "ArraySetTest.h"
+#include "ArrayBitSetTest.h"
+#include "SoAArrayTest.h"
+#include "ArrayViewTest.h"
 #include "ArrayStackTest.h"
 #include "GStackTest.h"
 #include "RingBufferTest.h"
+#ifdef UTIL_CXX11
+#include "SpscRingBufferTest.h"
+#include "MpmcRingBufferTest.h"
+#endif
 #include "SSetTest.h"
 
 #include "DMatrixTest.h"
@@ -43,9 +50,16 @@ TEST_COMPOSITE_ADD_UNIT(FPArrayTest)
 TEST_COMPOSITE_ADD_UNIT(DPArrayTest)
 TEST_COMPOSITE_ADD_UNIT(GPArrayTest)
 TEST_COMPOSITE_ADD_UNIT(ArraySetTest)
+TEST_COMPOSITE_ADD_UNIT(ArrayBitSetTest)
+TEST_COMPOSITE_ADD_UNIT(SoAArrayTest)
+TEST_COMPOSITE_ADD_UNIT(ArrayViewTest)
 TEST_COMPOSITE_ADD_UNIT(ArrayStackTest)
 TEST_COMPOSITE_ADD_UNIT(GStackTest)
 TEST_COMPOSITE_ADD_UNIT(RingBufferTest)
+#ifdef UTIL_CXX11
+TEST_COMPOSITE_ADD_UNIT(SpscRingBufferTest)
+TEST_COMPOSITE_ADD_UNIT(MpmcRingBufferTest)
+#endif
 TEST_COMPOSITE_ADD_UNIT(SSetTest)
 
 TEST_COMPOSITE_ADD_UNIT(DMatrixTest)
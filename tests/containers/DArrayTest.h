@@ -36,6 +36,11 @@ public:
    void testAllocateConstructor();
    void testAllocate();
    void testReallocate();
+   void testAllocatePolicy();
+   void testTaggedConstructor();
+   #ifdef UTIL_CXX11
+   void testMove();
+   #endif
    void testSubscript();
    void testSubscriptCmplx();
    void testIterator();
@@ -137,6 +142,95 @@ void DArrayTest::testReallocate()
    TEST_ASSERT((int)Memory::total() == memory_);
 }
 
+void DArrayTest::testAllocatePolicy()
+{
+   printMethod(TEST_FUNC);
+   TEST_ASSERT((int)Memory::total() == 0);
+   {
+      DArray<Data> v;
+      v.allocate(capacity, MemoryPolicy::cacheLine());
+      TEST_ASSERT(v.capacity() == capacity );
+      TEST_ASSERT(v.memoryPolicy() == MemoryPolicy::cacheLine());
+      TEST_ASSERT(((size_t)v.cArray()) % MemoryPolicy::CacheLineSize == 0);
+      TEST_ASSERT((int)Memory::total() == capacity*sizeof(Data));
+      for (int i=0; i < capacity; i++ ) {
+         v[i] = (i+1)*10.0;
+      }
+
+      // Reallocation and copy construction preserve the policy
+      v.reallocate(capacity + 2);
+      TEST_ASSERT(((size_t)v.cArray()) % MemoryPolicy::CacheLineSize == 0);
+      TEST_ASSERT(eq(v[2], 30.0));
+      DArray<Data> u(v);
+      TEST_ASSERT(u.memoryPolicy() == MemoryPolicy::cacheLine());
+      TEST_ASSERT(((size_t)u.cArray()) % MemoryPolicy::CacheLineSize == 0);
+      TEST_ASSERT(eq(u[1], 20.0));
+
+      v.deallocate();
+      TEST_ASSERT(!v.isAllocated());
+      TEST_ASSERT((int)Memory::total() == (capacity + 2)*sizeof(Data));
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void DArrayTest::testTaggedConstructor()
+{
+   printMethod(TEST_FUNC);
+   {
+      MemoryPolicy policy = MemoryPolicy::tagged("DArrayTest");
+      int tag = policy.tag();
+      TEST_ASSERT(tag > 0);
+      TEST_ASSERT(Memory::tagName(tag) == "DArrayTest");
+
+      DArray<Data> v(policy);
+      TEST_ASSERT(!v.isAllocated());
+      TEST_ASSERT(v.memoryPolicy().tag() == tag);
+      v.allocate(capacity);
+      TEST_ASSERT(Memory::snapshot(tag).total 
+                  == long(capacity*sizeof(Data)));
+
+      // Copies inherit the tag
+      DArray<Data> u(v);
+      TEST_ASSERT(Memory::snapshot(tag).total 
+                  == long(2*capacity*sizeof(Data)));
+   }
+   TEST_ASSERT(Memory::snapshot(Memory::addTag("DArrayTest")).total == 0);
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+#ifdef UTIL_CXX11
+void DArrayTest::testMove()
+{
+   printMethod(TEST_FUNC);
+   {
+      DArray<Data> v(capacity);
+      for (int i=0; i < capacity; i++ ) {
+         v[i] = (i+1)*10.0;
+      }
+      Data* ptr = v.cArray();
+      long nAllocate = Memory::nAllocate();
+
+      // Move construction transfers memory
+      DArray<Data> u(std::move(v));
+      TEST_ASSERT(!v.isAllocated());
+      TEST_ASSERT(v.capacity() == 0);
+      TEST_ASSERT(u.capacity() == capacity);
+      TEST_ASSERT(u.cArray() == ptr);
+
+      // Move assignment releases LHS memory, capacities may differ
+      DArray<Data> w(2*capacity);
+      w = std::move(u);
+      TEST_ASSERT(!u.isAllocated());
+      TEST_ASSERT(w.capacity() == capacity);
+      TEST_ASSERT(w.cArray() == ptr);
+      TEST_ASSERT(w[1] == 20.0);
+      TEST_ASSERT(Memory::nAllocate() == nAllocate + 1);
+      TEST_ASSERT((int)Memory::total() == capacity*sizeof(Data));
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+#endif
+
 void DArrayTest::testSubscript()
 {
    printMethod(TEST_FUNC);
@@ -587,6 +681,11 @@ TEST_ADD(DArrayTest, testDefaultConstructor)
 TEST_ADD(DArrayTest, testAllocateConstructor)
 TEST_ADD(DArrayTest, testAllocate)
 TEST_ADD(DArrayTest, testReallocate)
+TEST_ADD(DArrayTest, testAllocatePolicy)
+TEST_ADD(DArrayTest, testTaggedConstructor)
+#ifdef UTIL_CXX11
+TEST_ADD(DArrayTest, testMove)
+#endif
 TEST_ADD(DArrayTest, testSubscript)
 TEST_ADD(DArrayTest, testSubscriptCmplx)
 TEST_ADD(DArrayTest, testIterator)
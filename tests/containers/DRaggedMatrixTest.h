@@ -7,6 +7,14 @@
 #include <util/containers/DRaggedMatrix.h>
 #include <util/containers/DArray.h>
 #include <util/containers/RaggedMatrix.h>
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/archives/MemoryCounter.h>
+
+#ifdef UTIL_CXX11
+#include <thread>
+#include <vector>
+#endif
 
 using namespace Util;
 
@@ -25,6 +33,14 @@ public:
 
    void testSubscript();
 
+   void testBuild();
+
+   #ifdef UTIL_CXX11
+   void testBuildThreads();
+   #endif
+
+   void testSerialize();
+
    void testCopyConstructor();
 
    void testAssignment();
@@ -76,6 +92,187 @@ void DRaggedMatrixTest::testSubscript()
    TEST_ASSERT(v(1,2) == 6 );
 } 
 
+void DRaggedMatrixTest::testBuild()
+{
+   printMethod(TEST_FUNC);
+   int memory = Memory::total();
+   {
+      DRaggedMatrix<int> v;
+
+      // Pairs (i, j) with i + j odd, stored in both rows i and j
+      const int n = 6;
+      v.beginCount(n);
+      for (int i = 0; i < n; ++i) {
+         for (int j = i + 1; j < n; ++j) {
+            if ((i + j) % 2) {
+               v.addCount(i);
+               v.addCount(j);
+            }
+         }
+      }
+      v.endCount();
+      TEST_ASSERT(v.isAllocated());
+      TEST_ASSERT(v.capacity1() == n);
+      TEST_ASSERT(v.capacity2(0) == 0);
+      TEST_ASSERT(v.offset(1) == 3);
+      for (int i = n - 1; i >= 0; --i) {
+         for (int j = n - 1; j > i; --j) {
+            if ((i + j) % 2) {
+               v.append(i, j);
+               v.append(j, i);
+            }
+         }
+      }
+      v.endFill();
+      v.sortRows();
+      TEST_ASSERT(v.capacity2(0) == 3);
+      TEST_ASSERT(v.capacity2(5) == 3);
+      TEST_ASSERT(v(0, 0) == 1);
+      TEST_ASSERT(v(0, 2) == 5);
+      TEST_ASSERT(v(3, 0) == 0);
+      TEST_ASSERT(v(3, 2) == 4);
+      TEST_ASSERT(v.dataCapacity() == 18);
+
+      // Rebuild with fewer elements reuses memory
+      int nAllocate = Memory::nAllocate();
+      v.beginCount(3);
+      v.addCount(0, 2);
+      v.addCount(2, 1);
+      v.endCount();
+      TEST_ASSERT(v.append(2, 7) == 0);
+      TEST_ASSERT(v.append(0, 9) == 0);
+      TEST_ASSERT(v.append(0, 8) == 1);
+      v.endFill();
+      TEST_ASSERT(Memory::nAllocate() == nAllocate);
+      TEST_ASSERT(v.capacity1() == 3);
+      TEST_ASSERT(v.capacity2(1) == 0);
+      TEST_ASSERT(v(0, 1) == 8);
+      TEST_ASSERT(v(2, 0) == 7);
+
+      // Incomplete fill is detected
+      v.beginCount(2);
+      v.addCount(1, 2);
+      v.endCount();
+      v.append(1, 3);
+      bool thrown = false;
+      try {
+         v.endFill();
+      } catch (Exception& e) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+
+      // Overflow of the last row is discarded, and detected
+      v.beginCount(2);
+      v.addCount(0, 1);
+      v.addCount(1, 1);
+      v.endCount();
+      TEST_ASSERT(v.append(0, 1) == 0);
+      TEST_ASSERT(v.append(1, 2) == 0);
+      TEST_ASSERT(v.append(1, 3) == -1);
+      TEST_ASSERT(v(1, 0) == 2);
+      thrown = false;
+      try {
+         v.endFill();
+      } catch (Exception& e) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+   }
+   TEST_ASSERT((int)Memory::total() == memory);
+} 
+
+#ifdef UTIL_CXX11
+void DRaggedMatrixTest::testBuildThreads()
+{
+   printMethod(TEST_FUNC);
+   int memory = Memory::total();
+   {
+      DRaggedMatrix<int> v;
+
+      // Value k is stored in row k % nRow, by thread k % nThread
+      const int nRow = 7;
+      const int nValue = 5000;
+      const int nThread = 4;
+      v.beginCount(nRow);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < nThread; ++t) {
+         threads.push_back(std::thread([&v, t] {
+            for (int k = t; k < nValue; k += nThread) {
+               v.addCount(k % nRow);
+            }
+         }));
+      }
+      for (int t = 0; t < nThread; ++t) {
+         threads[t].join();
+      }
+      v.endCount();
+      threads.clear();
+      for (int t = 0; t < nThread; ++t) {
+         threads.push_back(std::thread([&v, t] {
+            for (int k = t; k < nValue; k += nThread) {
+               v.append(k % nRow, k);
+            }
+         }));
+      }
+      for (int t = 0; t < nThread; ++t) {
+         threads[t].join();
+      }
+      v.endFill();
+      v.sortRows();
+
+      TEST_ASSERT(v.capacity1() == nRow);
+      for (int i = 0; i < nRow; ++i) {
+         int size = (nValue - i + nRow - 1)/nRow;
+         TEST_ASSERT(v.capacity2(i) == size);
+         for (int j = 0; j < size; ++j) {
+            TEST_ASSERT(v(i, j) == i + j*nRow);
+         }
+      }
+   }
+   TEST_ASSERT((int)Memory::total() == memory);
+}
+#endif
+
+void DRaggedMatrixTest::testSerialize()
+{
+   printMethod(TEST_FUNC);
+   DRaggedMatrix<double> v;
+   DArray<int> rowSizes;
+   rowSizes.allocate(3);
+   rowSizes[0] = 2;
+   rowSizes[1] = 0;
+   rowSizes[2] = 3;
+   v.allocate(rowSizes);
+   v(0,0) = 1.5;
+   v(0,1) = 2.5;
+   v(2,0) = 3.5;
+   v(2,2) = 5.5;
+
+   MemoryCounter counter;
+   counter << v;
+   TEST_ASSERT(counter.size() == 4*sizeof(int) + 5*sizeof(double));
+
+   BinaryFileOArchive oArchive;
+   openOutputFile("tmp/binary", oArchive.file());
+   oArchive << v;
+   oArchive.file().close();
+
+   DRaggedMatrix<double> u;
+   BinaryFileIArchive iArchive;
+   openInputFile("tmp/binary", iArchive.file());
+   iArchive >> u;
+   iArchive.file().close();
+
+   TEST_ASSERT(u.capacity1() == 3);
+   TEST_ASSERT(u.capacity2(0) == 2);
+   TEST_ASSERT(u.capacity2(1) == 0);
+   TEST_ASSERT(u.capacity2(2) == 3);
+   TEST_ASSERT(u(0,1) == 2.5);
+   TEST_ASSERT(u(2,0) == 3.5);
+   TEST_ASSERT(u(2,2) == 5.5);
+} 
+
 #if 0
 void DRaggedMatrixTest::testCopyConstructor()
 {
@@ -172,6 +369,11 @@ TEST_BEGIN(DRaggedMatrixTest)
 TEST_ADD(DRaggedMatrixTest, testConstructor)
 TEST_ADD(DRaggedMatrixTest, testAllocate)
 TEST_ADD(DRaggedMatrixTest, testSubscript)
+TEST_ADD(DRaggedMatrixTest, testBuild)
+#ifdef UTIL_CXX11
+TEST_ADD(DRaggedMatrixTest, testBuildThreads)
+#endif
+TEST_ADD(DRaggedMatrixTest, testSerialize)
    //TEST_ADD(DRaggedMatrixTest, testCopyConstructor);
    //TEST_ADD(DRaggedMatrixTest, testAssignment);
    //TEST_ADD(DRaggedMatrixTest, testBaseClassReference);
@@ -6,6 +6,7 @@
 
 #include <util/containers/GArray.h>
 #include <util/containers/Array.h>
+#include <util/containers/DArray.h>
 
 using namespace Util;
 
@@ -26,6 +27,9 @@ public:
    void testResize2();
    void testCopyConstructor();
    void testSerialize1File();
+   #ifdef UTIL_CXX11
+   void testMove();
+   #endif
 
 };
 
@@ -261,6 +265,58 @@ void GArrayTest::testSerialize1File()
    TEST_ASSERT(Memory::total() == memory_);
 }
 
+#ifdef UTIL_CXX11
+void GArrayTest::testMove()
+{
+   printMethod(TEST_FUNC);
+   {
+      // Growth moves elements rather than copying them
+      GArray< DArray<int> > v;
+      for (int i = 0; i < 64; ++i) {
+         DArray<int> element(3);
+         element[0] = i;
+         v.append(std::move(element));
+         TEST_ASSERT(!element.isAllocated());
+      }
+      TEST_ASSERT(v.capacity() == 64);
+      int* first = &(v[0][0]);
+      DArray<int> element(3);
+      element[0] = 64;
+      long nAllocate = Memory::nAllocate();
+      v.append(std::move(element));
+      TEST_ASSERT(v.capacity() == 128);
+      TEST_ASSERT(v.size() == 65);
+      TEST_ASSERT(Memory::nAllocate() == nAllocate + 1);
+      TEST_ASSERT(&(v[0][0]) == first);
+      for (int i = 0; i < 65; ++i) {
+         TEST_ASSERT(v[i][0] == i);
+      }
+
+      // Move construction and assignment of the array itself
+      GArray< DArray<int> > u(std::move(v));
+      TEST_ASSERT(u.size() == 65);
+      TEST_ASSERT(!v.isAllocated());
+      TEST_ASSERT(v.size() == 0);
+      TEST_ASSERT(&(u[0][0]) == first);
+      GArray< DArray<int> > w;
+      w.append(DArray<int>(2));
+      w = std::move(u);
+      TEST_ASSERT(w.size() == 65);
+      TEST_ASSERT(!u.isAllocated());
+      TEST_ASSERT(&(w[0][0]) == first);
+
+      // Appending an element of the array itself
+      GArray<int> x;
+      for (int i = 0; i < 64; ++i) {
+         x.append(i);
+      }
+      x.append(x[10]);
+      TEST_ASSERT(x[64] == 10);
+   }
+   TEST_ASSERT(Memory::total() == memory_);
+}
+#endif
+
 TEST_BEGIN(GArrayTest)
 TEST_ADD(GArrayTest, testReserve)
 TEST_ADD(GArrayTest, testConstructor)
@@ -271,6 +327,9 @@ TEST_ADD(GArrayTest, testResize1)
 TEST_ADD(GArrayTest, testResize2)
 TEST_ADD(GArrayTest, testCopyConstructor)
 TEST_ADD(GArrayTest, testSerialize1File)
+#ifdef UTIL_CXX11
+TEST_ADD(GArrayTest, testMove)
+#endif
 TEST_END(GArrayTest)
 
 #endif
@@ -36,6 +36,8 @@ public:
 
    void testAssignment();
 
+   void testLayout();
+
    #if 0
    void testSerializeFile1();
 
@@ -530,7 +532,53 @@ void GridArrayTest::testSerializeFile2()
 
 }
 #endif // if 0
- 
+
+void GridArrayTest::testLayout()
+{
+   printMethod(TEST_FUNC);
+   {
+      IntVector dimensions(3, 5, 4);
+      GridArray<int> g;
+      g.setLayout(SpaceFillingCurve::Hilbert);
+      g.allocate(dimensions);
+      TEST_ASSERT(g.layout() == SpaceFillingCurve::Hilbert);
+
+      // rank and position are inverse, and ranks are a permutation
+      IntVector p;
+      for (int i = 0; i < g.size(); ++i) {
+         g[i] = -1;
+      }
+      int r = 0;
+      for (p[0] = 0; p[0] < 3; ++p[0]) {
+         for (p[1] = 0; p[1] < 5; ++p[1]) {
+            for (p[2] = 0; p[2] < 4; ++p[2]) {
+               int rank = g.rank(p);
+               TEST_ASSERT(g.position(rank) == p);
+               TEST_ASSERT(g[rank] == -1);
+               g(p) = r;
+               ++r;
+            }
+         }
+      }
+
+      // Assignment to a row-major array preserves values by position
+      GridArray<int> h;
+      h.allocate(dimensions);
+      h = g;
+      for (r = 0; r < h.size(); ++r) {
+         TEST_ASSERT(h[r] == r);
+      }
+
+      // Copy retains layout
+      GridArray<int> c(g);
+      TEST_ASSERT(c.layout() == SpaceFillingCurve::Hilbert);
+      for (r = 0; r < c.size(); ++r) {
+         TEST_ASSERT(c[r] == g[r]);
+      }
+   }
+   TEST_ASSERT(Memory::total() == memory_);
+}
+
 TEST_BEGIN(GridArrayTest)
 TEST_ADD(GridArrayTest, testConstructor)
 TEST_ADD(GridArrayTest, testAllocate)
@@ -540,6 +588,7 @@ TEST_ADD(GridArrayTest, testShift)
 TEST_ADD(GridArrayTest, testSubscript)
 TEST_ADD(GridArrayTest, testCopyConstructor)
 TEST_ADD(GridArrayTest, testAssignment)
+TEST_ADD(GridArrayTest, testLayout)
 //TEST_ADD(GridArrayTest, testSerializeFile1)
 //TEST_ADD(GridArrayTest, testSerializeFile2)
 TEST_END(GridArrayTest)
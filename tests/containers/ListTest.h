@@ -6,6 +6,7 @@
 
 #include <util/containers/Node.h>
 #include <util/containers/List.h>
+#include <util/containers/ListArray.h>
 
 using namespace Util;
 
@@ -43,6 +44,7 @@ public:
    void testInsert3();
    void testInsert4();
    void testInsert5();
+   void testIndexedInsert();
    void dumpList();
 
 };
@@ -429,6 +431,51 @@ void ListTest::testInsert5()
 
 }
 
+void ListTest::testIndexedInsert()
+{
+   printMethod(TEST_FUNC);
+
+   const int capacity = 5000;
+   const int nList = 3;
+   ListArray<Data> array;
+   array.setIndexed(true);
+   array.allocate(capacity, nList);
+   TEST_ASSERT(array.isIndexed());
+   TEST_ASSERT(array.list(0).isIndexed());
+
+   // Insert nodes in scrambled order, cycling over lists
+   int j = 0;
+   for (int i = 0; i < capacity; ++i) {
+      j = (j + 2357) % capacity;
+      array.list(j % nList).insert(array.node(j));
+   }
+   for (int k = 0; k < nList; ++k) {
+      TEST_ASSERT(array.list(k).isValid());
+   }
+
+   // Remove every fifth node, including bounds of each list
+   for (int i = 0; i < capacity; i += 5) {
+      array.list(i % nList).remove(array.node(i));
+   }
+   array.list(1).popFront();
+   array.list(2).popBack();
+   TEST_ASSERT(array.isValid());
+
+   // Check ascending address order of each list
+   int size = 0;
+   for (int k = 0; k < nList; ++k) {
+      List<Data>& list = array.list(k);
+      ListIterator<Data> iter;
+      Data* prev = 0;
+      for (list.begin(iter); !iter.isEnd(); ++iter) {
+         Data* ptr = &(*iter);
+         TEST_ASSERT(prev < ptr);
+         prev = ptr;
+      }
+      size += list.size();
+   }
+   TEST_ASSERT(size == capacity - capacity/5 - 2);
+}
 
 /* 
 * Print integer indices of nodes in a linked list.
@@ -463,6 +510,7 @@ TEST_ADD(ListTest, testInsert2)
 TEST_ADD(ListTest, testInsert3)
 TEST_ADD(ListTest, testInsert4)
 TEST_ADD(ListTest, testInsert5)
+TEST_ADD(ListTest, testIndexedInsert)
 TEST_END(ListTest)
 
 
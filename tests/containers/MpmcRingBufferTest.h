@@ -0,0 +1,116 @@
+#ifndef UTIL_MPMC_RING_BUFFER_TEST_H
+#define UTIL_MPMC_RING_BUFFER_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/containers/MpmcRingBuffer.h>
+
+#include <thread>
+#include <vector>
+
+using namespace Util;
+
+class MpmcRingBufferTest : public UnitTest
+{
+
+private:
+
+   int memory_;
+
+   // Accumulator that records a sum and a count.
+   struct Sum
+   {
+      Sum() : sum(0), n(0) {}
+      void sample(long value) { sum += value; ++n; }
+      long sum;
+      long n;
+   };
+
+public:
+
+   void setUp()
+   {  memory_ = Memory::total(); }
+
+   void tearDown() {}
+
+   void testPushPop();
+   void testThreaded();
+
+};
+
+void MpmcRingBufferTest::testPushPop()
+{
+   printMethod(TEST_FUNC);
+   {
+      MpmcRingBuffer<long> buffer;
+      buffer.allocate(4, BackPressure::Reject);
+      TEST_ASSERT(buffer.capacity() == 4);
+
+      long in[6] = {1, 2, 3, 4, 5, 6};
+      long out[6];
+      TEST_ASSERT(buffer.push(in, 6) == 4);
+      TEST_ASSERT(buffer.size() == 4);
+      TEST_ASSERT(buffer.pop(out, 3) == 3);
+      TEST_ASSERT(out[0] == 1);
+      TEST_ASSERT(out[2] == 3);
+      TEST_ASSERT(buffer.push(in + 4, 2) == 2);
+      long value;
+      TEST_ASSERT(buffer.tryPop(value));
+      TEST_ASSERT(value == 4);
+      buffer.close();
+      TEST_ASSERT(!buffer.push(7));
+      TEST_ASSERT(buffer.pop(out, 6) == 2);
+      TEST_ASSERT(out[1] == 6);
+      TEST_ASSERT(!buffer.pop(value));
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void MpmcRingBufferTest::testThreaded()
+{
+   printMethod(TEST_FUNC);
+   {
+      const int nProducer = 3;
+      const int nConsumer = 3;
+      const long n = 10000;
+      MpmcRingBuffer<long> buffer;
+      buffer.allocate(32);
+
+      std::vector<Sum> sums(nConsumer);
+      std::vector<std::thread> consumers;
+      for (int i = 0; i < nConsumer; ++i) {
+         consumers.push_back(std::thread(
+                  [&buffer, &sums, i]() { buffer.drain(sums[i]); }));
+      }
+      std::vector<std::thread> producers;
+      for (int i = 0; i < nProducer; ++i) {
+         producers.push_back(std::thread([&buffer, n]() {
+                  for (long j = 1; j <= n; ++j) buffer.push(j); }));
+      }
+      for (int i = 0; i < nProducer; ++i) {
+         producers[i].join();
+      }
+      buffer.close();
+      for (int i = 0; i < nConsumer; ++i) {
+         consumers[i].join();
+      }
+
+      long total = 0;
+      long count = 0;
+      for (int i = 0; i < nConsumer; ++i) {
+         total += sums[i].sum;
+         count += sums[i].n;
+      }
+      TEST_ASSERT(count == nProducer*n);
+      TEST_ASSERT(total == nProducer*n*(n + 1)/2);
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+TEST_BEGIN(MpmcRingBufferTest)
+TEST_ADD(MpmcRingBufferTest, testPushPop)
+TEST_ADD(MpmcRingBufferTest, testThreaded)
+TEST_END(MpmcRingBufferTest)
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef UTIL_SOA_ARRAY_TEST_H
+#define UTIL_SOA_ARRAY_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/containers/SoAArray.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+#include <util/space/IntVector.h>
+#include <util/space/Tensor.h>
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/archives/BinaryFileIArchive.h>
+
+#include <stdint.h>
+
+using namespace Util;
+
+class SoAArrayTest : public UnitTest
+{
+private:
+
+   const static int capacity = 5;
+
+   int memory_;
+
+public:
+
+   void setUp()
+   {  memory_ = Memory::total(); }
+
+   void tearDown() {}
+
+   void testAllocate();
+   void testSubscript();
+   void testCopy();
+   void testTensor();
+   void testSerializeFile();
+
+};
+
+void SoAArrayTest::testAllocate()
+{
+   printMethod(TEST_FUNC);
+   {
+      SoAArray<Vector> v;
+      TEST_ASSERT(!v.isAllocated());
+      TEST_ASSERT(v.capacity() == 0);
+      v.allocate(capacity);
+      TEST_ASSERT(v.isAllocated());
+      TEST_ASSERT(v.capacity() == capacity);
+      TEST_ASSERT(v.stride() >= capacity);
+      TEST_ASSERT(v.stride()*sizeof(double) % 64 == 0);
+      for (int k = 0; k < Dimension; ++k) {
+         TEST_ASSERT(((uintptr_t)v.component(k)) % 64 == 0);
+         for (int i = 0; i < v.stride(); ++i) {
+            TEST_ASSERT(v.component(k)[i] == 0.0);
+         }
+      }
+      v.deallocate();
+      TEST_ASSERT(!v.isAllocated());
+      TEST_ASSERT((int)Memory::total() == memory_);
+      v.allocate(2*capacity);
+      TEST_ASSERT(v.capacity() == 2*capacity);
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void SoAArrayTest::testSubscript()
+{
+   printMethod(TEST_FUNC);
+   {
+      SoAArray<Vector> v;
+      v.allocate(capacity);
+      for (int i = 0; i < capacity; ++i) {
+         v[i] = Vector(1.0*i, 2.0*i, 3.0*i);
+      }
+      TEST_ASSERT(v(2, 1) == 4.0);
+      TEST_ASSERT(v.component(2)[3] == 9.0);
+      TEST_ASSERT(v[4][0] == 4.0);
+
+      Vector u = v[3];
+      TEST_ASSERT(u == Vector(3.0, 6.0, 9.0));
+
+      v[1] += Vector(1.0, 1.0, 1.0);
+      v[2] -= Vector(1.0, 1.0, 1.0);
+      v[0][2] = 7.0;
+      v[4] = v[1];
+
+      SoAArray<Vector> const & c = v;
+      TEST_ASSERT(c[1] == Vector(2.0, 3.0, 4.0));
+      TEST_ASSERT(c[2] == Vector(1.0, 3.0, 5.0));
+      TEST_ASSERT(c[0] == Vector(0.0, 0.0, 7.0));
+      TEST_ASSERT(c[4] == Vector(2.0, 3.0, 4.0));
+
+      SoAArray<IntVector> n;
+      n.allocate(capacity);
+      n[3] = IntVector(1, 2, 3);
+      n[3][1] += 5;
+      TEST_ASSERT(IntVector(n[3]) == IntVector(1, 7, 3));
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void SoAArrayTest::testCopy()
+{
+   printMethod(TEST_FUNC);
+   {
+      DArray<Vector> a;
+      a.allocate(capacity);
+      for (int i = 0; i < capacity; ++i) {
+         a[i] = Vector(i + 0.5, i - 0.5, 2.0*i);
+      }
+
+      SoAArray<Vector> v;
+      v.copyFrom(a);
+      TEST_ASSERT(v.capacity() == capacity);
+      for (int i = 0; i < capacity; ++i) {
+         TEST_ASSERT(v(i, 0) == i + 0.5);
+         TEST_ASSERT(v(i, 1) == i - 0.5);
+         TEST_ASSERT(v(i, 2) == 2.0*i);
+      }
+
+      DArray<Vector> b;
+      b.allocate(capacity);
+      v.copyTo(b);
+      for (int i = 0; i < capacity; ++i) {
+         TEST_ASSERT(a[i] == b[i]);
+      }
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void SoAArrayTest::testTensor()
+{
+   printMethod(TEST_FUNC);
+   {
+      SoAArray<Tensor> t;
+      t.allocate(capacity);
+      Tensor a;
+      for (int i = 0; i < Dimension; ++i) {
+         for (int j = 0; j < Dimension; ++j) {
+            a(i, j) = 10.0*i + j;
+         }
+      }
+      t[2] = a;
+      TEST_ASSERT(t[2](1, 2) == 12.0);
+      TEST_ASSERT(t(2, Dimension + 2) == 12.0);
+      t[2](0, 1) = -1.0;
+      Tensor b = t[2];
+      TEST_ASSERT(b(0, 1) == -1.0);
+      TEST_ASSERT(b(2, 0) == 20.0);
+      for (int k = 0; k < DimensionSq; ++k) {
+         TEST_ASSERT(((uintptr_t)t.component(k)) % 64 == 0);
+      }
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void SoAArrayTest::testSerializeFile()
+{
+   printMethod(TEST_FUNC);
+   {
+      SoAArray<Vector> v;
+      v.allocate(capacity);
+      for (int i = 0; i < capacity; ++i) {
+         v[i] = Vector(1.0*i, 2.0*i + 0.5, -1.0*i);
+      }
+      int i1 = 13;
+      int i2;
+
+      BinaryFileOArchive oArchive;
+      openOutputFile("tmp/binary", oArchive.file());
+      oArchive << v;
+      oArchive << i1;
+      oArchive.file().close();
+
+      SoAArray<Vector> u;
+      BinaryFileIArchive iArchive;
+      openInputFile("tmp/binary", iArchive.file());
+      iArchive >> u;
+      iArchive >> i2;
+      iArchive.file().close();
+
+      TEST_ASSERT(u.capacity() == capacity);
+      TEST_ASSERT(i2 == 13);
+      SoAArray<Vector> const & cu = u;
+      SoAArray<Vector> const & cv = v;
+      for (int i = 0; i < capacity; ++i) {
+         TEST_ASSERT(cu[i] == cv[i]);
+      }
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+TEST_BEGIN(SoAArrayTest)
+TEST_ADD(SoAArrayTest, testAllocate)
+TEST_ADD(SoAArrayTest, testSubscript)
+TEST_ADD(SoAArrayTest, testCopy)
+TEST_ADD(SoAArrayTest, testTensor)
+TEST_ADD(SoAArrayTest, testSerializeFile)
+TEST_END(SoAArrayTest)
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef UTIL_SPSC_RING_BUFFER_TEST_H
+#define UTIL_SPSC_RING_BUFFER_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/containers/SpscRingBuffer.h>
+#include <util/containers/DArray.h>
+#include <util/accumulators/AutoCorrelation.tpp>
+
+#include <thread>
+
+using namespace Util;
+
+class SpscRingBufferTest : public UnitTest
+{
+
+private:
+
+   int memory_;
+
+public:
+
+   void setUp()
+   {  memory_ = Memory::total(); }
+
+   void tearDown() {}
+
+   void testPushPop();
+   void testBatch();
+   void testMove();
+   void testThreaded();
+
+};
+
+void SpscRingBufferTest::testPushPop()
+{
+   printMethod(TEST_FUNC);
+   {
+      SpscRingBuffer<int> buffer;
+      TEST_ASSERT(!buffer.isAllocated());
+      buffer.allocate(3, BackPressure::Reject);
+      TEST_ASSERT(buffer.isAllocated());
+      TEST_ASSERT(buffer.capacity() == 4);
+
+      int value;
+      TEST_ASSERT(!buffer.tryPop(value));
+      for (int i = 0; i < 4; ++i) {
+         TEST_ASSERT(buffer.push(i));
+      }
+      TEST_ASSERT(buffer.size() == 4);
+      TEST_ASSERT(!buffer.push(4));
+      TEST_ASSERT(buffer.pop(value));
+      TEST_ASSERT(value == 0);
+      TEST_ASSERT(buffer.push(4));
+      for (int i = 1; i < 5; ++i) {
+         TEST_ASSERT(buffer.tryPop(value));
+         TEST_ASSERT(value == i);
+      }
+      TEST_ASSERT(buffer.size() == 0);
+
+      buffer.push(5);
+      buffer.close();
+      TEST_ASSERT(buffer.isClosed());
+      TEST_ASSERT(!buffer.push(6));
+      TEST_ASSERT(buffer.pop(value));
+      TEST_ASSERT(value == 5);
+      TEST_ASSERT(!buffer.pop(value));
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void SpscRingBufferTest::testBatch()
+{
+   printMethod(TEST_FUNC);
+   {
+      SpscRingBuffer<double> buffer;
+      buffer.allocate(8, BackPressure::Reject);
+      double in[12];
+      double out[12];
+      for (int i = 0; i < 12; ++i) {
+         in[i] = 0.5*i;
+      }
+      TEST_ASSERT(buffer.push(in, 5) == 5);
+      TEST_ASSERT(buffer.push(in + 5, 7) == 3);
+      TEST_ASSERT(buffer.pop(out, 6) == 6);
+      TEST_ASSERT(buffer.push(in + 8, 4) == 4);
+      TEST_ASSERT(buffer.pop(out + 6, 12) == 6);
+      for (int i = 0; i < 12; ++i) {
+         TEST_ASSERT(out[i] == in[i]);
+      }
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void SpscRingBufferTest::testMove()
+{
+   printMethod(TEST_FUNC);
+   {
+      SpscRingBuffer< DArray<double> > buffer;
+      buffer.allocate(2);
+      DArray<double> a;
+      a.allocate(10);
+      a[3] = 3.0;
+      double* ptr = a.cArray();
+      buffer.push(std::move(a));
+      TEST_ASSERT(!a.isAllocated());
+
+      DArray<double> b;
+      TEST_ASSERT(buffer.pop(b));
+      TEST_ASSERT(b.cArray() == ptr);
+      TEST_ASSERT(b[3] == 3.0);
+   }
+   TEST_ASSERT((int)Memory::total() == memory_);
+}
+
+void SpscRingBufferTest::testThreaded()
+{
+   printMethod(TEST_FUNC);
+   {
+      const int n = 20000;
+      SpscRingBuffer<double> buffer;
+      buffer.allocate(64);
+
+      AutoCorrelation<double, double> accumulator;
+      accumulator.setParam(16, 0);
+      long nSampled = 0;
+      std::thread consumer([&]() { nSampled = buffer.drain(accumulator); });
+      for (int i = 0; i < n; ++i) {
+         buffer.push(double(i % 2));
+      }
+      buffer.close();
+      consumer.join();
+
+      TEST_ASSERT(nSampled == n);
+      TEST_ASSERT(accumulator.nSample() == n);
+      // Alternating sequence, so that order is tested
+      TEST_ASSERT(eq(accumulator.autoCorrelation(0, 0.0), 0.5));
+      TEST_ASSERT(eq(accumulator.autoCorrelation(1, 0.0), 0.0));
+   }
+}
+
+TEST_BEGIN(SpscRingBufferTest)
+TEST_ADD(SpscRingBufferTest, testPushPop)
+TEST_ADD(SpscRingBufferTest, testBatch)
+TEST_ADD(SpscRingBufferTest, testMove)
+TEST_ADD(SpscRingBufferTest, testThreaded)
+TEST_END(SpscRingBufferTest)
+
+#endif
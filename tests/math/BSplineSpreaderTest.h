@@ -0,0 +1,158 @@
+#ifndef UTIL_B_SPLINE_SPREADER_TEST_H
+#define UTIL_B_SPLINE_SPREADER_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/math/BSplineSpreader.h>
+#include <util/math/CardinalBSpline.h>
+#include <util/containers/DArray.h>
+#include <util/containers/GridArray.h>
+#include <util/space/IntVector.h>
+#include <util/space/Vector.h>
+
+#include <cmath>
+
+using namespace Util;
+
+class BSplineSpreaderTest : public UnitTest
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {  Binomial::clear(); }
+
+   void initialize(DArray<Vector>& positions, DArray<double>& charges,
+                   IntVector const & dimensions, int n)
+   {
+      positions.allocate(n);
+      charges.allocate(n);
+      unsigned long seed = 12345;
+      for (int i = 0; i < n; ++i) {
+         for (int d = 0; d < Dimension; ++d) {
+            seed = seed*6364136223846793005UL + 1442695040888963407UL;
+            double r = double((seed >> 11) & 0xFFFFF)/double(0x100000);
+            // Include some positions outside the primary cell
+            positions[i][d] = (1.2*r - 0.1)*dimensions[d];
+         }
+         charges[i] = (i % 2 == 0) ? 1.0 : -0.5;
+      }
+   }
+
+   void testSpread()
+   {
+      printMethod(TEST_FUNC);
+
+      CardinalBSpline spline(3);
+      BSplineSpreader spreader(spline);
+      IntVector dimensions(16, 12, 10);
+      DArray<Vector> positions;
+      DArray<double> charges;
+      int n = 500;
+      initialize(positions, charges, dimensions, n);
+
+      GridArray<double> grid;
+      grid.allocate(dimensions);
+      for (int i = 0; i < grid.size(); ++i) {
+         grid[i] = 0.0;
+      }
+      spreader.spread(positions, charges, grid);
+
+      // Total charge is conserved
+      double total = 0.0;
+      for (int i = 0; i < n; ++i) {
+         total += charges[i];
+      }
+      double sum = 0.0;
+      for (int i = 0; i < grid.size(); ++i) {
+         sum += grid[i];
+      }
+      TEST_ASSERT(std::fabs(sum - total) < 1.0E-10);
+
+      #ifdef UTIL_CXX11
+      // Threaded result equals serial result
+      GridArray<double> grid2;
+      grid2.allocate(dimensions);
+      for (int i = 0; i < grid2.size(); ++i) {
+         grid2[i] = 0.0;
+      }
+      spreader.setNThread(3);
+      spreader.spread(positions, charges, grid2);
+      for (int i = 0; i < grid.size(); ++i) {
+         TEST_ASSERT(std::fabs(grid[i] - grid2[i]) < 1.0E-12);
+      }
+      #endif
+   }
+
+   void testInterpolate()
+   {
+      printMethod(TEST_FUNC);
+
+      CardinalBSpline spline(4);
+      BSplineSpreader spreader(spline);
+      spreader.setNThread(2);
+      IntVector dimensions(10, 10, 10);
+      DArray<Vector> positions;
+      DArray<double> charges;
+      int n = 50;
+      initialize(positions, charges, dimensions, n);
+
+      DArray<double> values;
+      DArray<Vector> gradients;
+      values.allocate(n);
+      gradients.allocate(n);
+
+      // Constant field: constant value, zero gradient
+      GridArray<double> grid;
+      grid.allocate(dimensions);
+      for (int i = 0; i < grid.size(); ++i) {
+         grid[i] = 2.5;
+      }
+      spreader.interpolate(grid, positions, values, gradients);
+      for (int i = 0; i < n; ++i) {
+         TEST_ASSERT(std::fabs(values[i] - 2.5) < 1.0E-10);
+         for (int d = 0; d < Dimension; ++d) {
+            TEST_ASSERT(std::fabs(gradients[i][d]) < 1.0E-10);
+         }
+      }
+
+      // Gradient agrees with finite differences of the value
+      IntVector p;
+      for (p[0] = 0; p[0] < dimensions[0]; ++p[0]) {
+         for (p[1] = 0; p[1] < dimensions[1]; ++p[1]) {
+            for (p[2] = 0; p[2] < dimensions[2]; ++p[2]) {
+               grid(p) = std::sin(0.6*p[0]) + std::cos(1.1*p[1])*p[2];
+            }
+         }
+      }
+      spreader.interpolate(grid, positions, values, gradients);
+      DArray<double> shifted;
+      DArray<Vector> unused;
+      shifted.allocate(n);
+      unused.allocate(n);
+      double h = 1.0E-5;
+      for (int d = 0; d < Dimension; ++d) {
+         for (int i = 0; i < n; ++i) {
+            positions[i][d] += h;
+         }
+         spreader.interpolate(grid, positions, shifted, unused);
+         for (int i = 0; i < n; ++i) {
+            positions[i][d] -= h;
+            double fd = (shifted[i] - values[i])/h;
+            TEST_ASSERT(std::fabs(fd - gradients[i][d]) < 1.0E-3);
+         }
+      }
+   }
+
+};
+
+TEST_BEGIN(BSplineSpreaderTest)
+TEST_ADD(BSplineSpreaderTest, testSpread)
+TEST_ADD(BSplineSpreaderTest, testInterpolate)
+TEST_END(BSplineSpreaderTest)
+
+#endif
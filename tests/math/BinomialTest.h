@@ -6,8 +6,15 @@
 
 #include <util/math/Binomial.h>
 #include <util/misc/Memory.h>
+#include <util/containers/DArray.h>
 
 #include <fstream>
+#include <cmath>
+
+#ifdef UTIL_CXX11
+#include <thread>
+#include <vector>
+#endif
 
 using namespace Util;
 
@@ -77,6 +84,135 @@ public:
       TEST_ASSERT(Binomial::coeff(4, 4) == 1);
    }
  
+   void testExact()
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(Binomial::exact(0, 0) == 1);
+      TEST_ASSERT(Binomial::exact(5, 2) == 10);
+      TEST_ASSERT(Binomial::exact(5, 6) == 0);
+      TEST_ASSERT(Binomial::exact(67, 33) == 14226520737620288370ULL);
+      TEST_ASSERT(Binomial::exact(200, 5) == 2535650040ULL);
+      for (int n = 0; n <= Binomial::MaxExact; ++n) {
+         for (int m = 0; m <= n; ++m) {
+            TEST_ASSERT(Binomial::exact(n, m) == Binomial::coeff64(n, m));
+         }
+      }
+
+      #ifdef UTIL_CXX11
+      // Evaluated at compile time
+      static_assert(Binomial::exact(10, 3) == 120, "C(10, 3)");
+      #endif
+   }
+
+   void testCoeff64()
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(Binomial::coeff64(67, 33) == 14226520737620288370ULL);
+      TEST_ASSERT(Binomial::coeff64(100, 3) == 161700);
+      TEST_ASSERT(Binomial::coeff64(200, 195) == 2535650040ULL);
+      TEST_ASSERT(Binomial::coeff(33, 16) == 1166803110);
+      TEST_ASSERT(Binomial::coeff(100, 3) == 161700);
+
+      // Overflow is detected
+      bool thrown = false;
+      try {
+         Binomial::coeff(34, 17);
+      } catch (Exception& e) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+      thrown = false;
+      try {
+         Binomial::coeff64(68, 34);
+      } catch (Exception& e) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+   }
+
+   void testRow()
+   {
+      printMethod(TEST_FUNC);
+      uint64_t const * row = Binomial::row(4);
+      TEST_ASSERT(row[0] == 1);
+      TEST_ASSERT(row[1] == 4);
+      TEST_ASSERT(row[2] == 6);
+      TEST_ASSERT(row[3] == 4);
+      TEST_ASSERT(row[4] == 1);
+
+      // Row sums are 2^n, which fits in 64 bits for n <= 63
+      for (int n = 0; n <= 63; ++n) {
+         row = Binomial::row(n);
+         uint64_t sum = 0;
+         for (int m = 0; m <= n; ++m) {
+            sum += row[m];
+         }
+         TEST_ASSERT(sum == (uint64_t(1) << n));
+      }
+
+      // Entries of the last row satisfy Pascal's rule exactly
+      const int n = Binomial::MaxExact;
+      row = Binomial::row(n);
+      uint64_t const * prev = Binomial::row(n - 1);
+      TEST_ASSERT(row[0] == 1);
+      TEST_ASSERT(row[n] == 1);
+      for (int m = 1; m < n; ++m) {
+         TEST_ASSERT(row[m] == prev[m - 1] + prev[m]);
+         TEST_ASSERT(row[m] == Binomial::exact(n, m));
+      }
+   }
+
+   void testLogCoeff()
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(eq(Binomial::logFactorial(0), 0.0));
+      TEST_ASSERT(eq(Binomial::logFactorial(5), std::log(120.0)));
+      TEST_ASSERT(eq(Binomial::logCoeff(30, 12),
+                     std::log(double(Binomial::coeff64(30, 12)))));
+      TEST_ASSERT(std::fabs(Binomial::logCoeff(1000, 500)
+                            - 689.4672615678512) < 1.0E-10);
+      TEST_ASSERT(std::fabs(Binomial::logCoeff(5000, 17)
+                            - 111.25998083451873) < 1.0E-10);
+
+      DArray<double> out;
+      out.allocate(1001);
+      Binomial::logRow(1000, out);
+      for (int m = 0; m <= 1000; m += 100) {
+         TEST_ASSERT(out[m] == Binomial::logCoeff(1000, m));
+      }
+      TEST_ASSERT(eq(out[0], 0.0));
+      TEST_ASSERT(eq(out[1], std::log(1000.0)));
+   }
+
+   #ifdef UTIL_CXX11
+   void testThreads()
+   {
+      printMethod(TEST_FUNC);
+      int nThread = 4;
+      std::vector<int> errors(nThread, 0);
+      std::vector<std::thread> threads;
+      for (int t = 0; t < nThread; ++t) {
+         threads.push_back(std::thread([t, &errors]() {
+            for (int n = t; n < 20000; n += 997) {
+               double x = Binomial::logCoeff(n, n/2);
+               double y = Binomial::logFactorial(n)
+                        - Binomial::logFactorial(n/2)
+                        - Binomial::logFactorial(n - n/2);
+               if (x != y) ++errors[t];
+               int k = t + n % 50;
+               if (Binomial::coeff64(k, t) != Binomial::exact(k, t)) {
+                  ++errors[t];
+               }
+            }
+         }));
+      }
+      for (int t = 0; t < nThread; ++t) {
+         threads[t].join();
+         TEST_ASSERT(errors[t] == 0);
+      }
+   }
+   #endif
+ 
 };
 
 TEST_BEGIN(BinomialTest)
@@ -85,6 +221,13 @@ TEST_ADD(BinomialTest, testReSetup)
 TEST_ADD(BinomialTest, testCoeff0)
 TEST_ADD(BinomialTest, testCoeff1)
 TEST_ADD(BinomialTest, testCoeff2)
+TEST_ADD(BinomialTest, testExact)
+TEST_ADD(BinomialTest, testCoeff64)
+TEST_ADD(BinomialTest, testRow)
+TEST_ADD(BinomialTest, testLogCoeff)
+#ifdef UTIL_CXX11
+TEST_ADD(BinomialTest, testThreads)
+#endif
 TEST_END(BinomialTest)
 
 #endif
@@ -110,6 +110,41 @@ public:
 
    }
 
+   void testWeights() 
+   {
+      printMethod(TEST_FUNC);
+
+      double u[4] = {0.001, 0.25, 0.6180339887, 0.9999};
+      double w[4*8];
+      double dw[4*8];
+      double h = 1.0E-6;
+      for (int degree = 0; degree <= 7; ++degree) {
+         CardinalBSpline s(degree);
+         int order = degree + 1;
+         s.weights(u, 4, w, dw);
+         for (int i = 0; i < 4; ++i) {
+            double sum = 0.0;
+            for (int j = 0; j < order; ++j) {
+               double x = u[i] + double(j);
+               TEST_ASSERT(std::fabs(w[i*order + j] - s(x)) < 1.0E-10);
+               if (degree > 1) {
+                  double fd = (s(x + h) - s(x - h))/(2.0*h);
+                  TEST_ASSERT(std::fabs(dw[i*order + j] - fd) < 1.0E-5);
+               }
+               sum += w[i*order + j];
+            }
+            TEST_ASSERT(std::fabs(sum - 1.0) < 1.0E-10);
+         }
+
+         // Single coordinate
+         double w1[8];
+         s.weights(u[2], w1);
+         for (int j = 0; j < order; ++j) {
+            TEST_ASSERT(eq(w1[j], w[2*order + j]));
+         }
+      }
+   }
+
    // Compute sum_i b(i + shift) over all integer i.
    double computeSum(CardinalBSpline b, double shift) 
    {
@@ -127,6 +162,7 @@ TEST_ADD(CardinalBSplineTest, testConstructor)
 TEST_ADD(CardinalBSplineTest, testPolynomial)
 TEST_ADD(CardinalBSplineTest, testEvaluate)
 TEST_ADD(CardinalBSplineTest, testSum)
+TEST_ADD(CardinalBSplineTest, testWeights)
 TEST_END(CardinalBSplineTest)
 
 #endif
@@ -0,0 +1,126 @@
+#ifndef UTIL_FIXED_POLYNOMIAL_TEST_H
+#define UTIL_FIXED_POLYNOMIAL_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/math/FixedPolynomial.h>
+#include <util/math/Polynomial.h>
+#include <util/math/Rational.h>
+#include <util/containers/DArray.h>
+
+#include <cmath>
+
+using namespace Util;
+
+class FixedPolynomialTest : public UnitTest
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {  Binomial::clear(); }
+
+   // Construct a Polynomial<Rational> with coefficients (i+1)/(i+2)(-1)^i
+   Polynomial<Rational> makePolynomial(int degree)
+   {
+      DArray<Rational> coeffs;
+      coeffs.allocate(degree + 1);
+      for (int i = 0; i <= degree; ++i) {
+         coeffs[i] = Rational(i % 2 == 0 ? i + 1 : -i - 1, i + 2);
+      }
+      return Polynomial<Rational>(coeffs);
+   }
+
+   void testConversion()
+   {
+      printMethod(TEST_FUNC);
+
+      Polynomial<Rational> r = makePolynomial(3);
+      FixedPolynomial<5> f(r);
+      for (int i = 0; i <= 3; ++i) {
+         TEST_ASSERT(eq(f[i], (double)r[i]));
+      }
+      TEST_ASSERT(f[4] == 0.0);
+      TEST_ASSERT(f[5] == 0.0);
+
+      Polynomial<double> d;
+      d = r;
+      FixedPolynomial<3> g(d);
+      TEST_ASSERT(eq(g(0.7), d.evaluate(0.7)));
+
+      bool thrown = false;
+      try {
+         FixedPolynomial<2> h(r);
+      } catch (Exception& e) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+   }
+
+   template <int N>
+   void checkEvaluate()
+   {
+      Polynomial<Rational> r = makePolynomial(N);
+      Polynomial<Rational> dr = r.differentiate();
+      FixedPolynomial<N> f(r);
+
+      double x[7] = {-1.3, -0.5, 0.0, 0.25, 0.6180339887, 1.0, 2.1};
+      double v[7];
+      double v2[7];
+      double dv[7];
+      f.evaluate(x, 7, v);
+      f.evaluate(x, 7, v2, dv);
+      for (int i = 0; i < 7; ++i) {
+         double exact = r.evaluate(x[i]);
+         double scale = 1.0 + std::fabs(exact);
+         TEST_ASSERT(std::fabs(f(x[i]) - exact) < 1.0E-12*scale);
+         TEST_ASSERT(std::fabs(f.estrin(x[i]) - exact) < 1.0E-12*scale);
+         TEST_ASSERT(std::fabs(v[i] - exact) < 1.0E-12*scale);
+         TEST_ASSERT(std::fabs(v2[i] - exact) < 1.0E-12*scale);
+         double dexact = dr.evaluate(x[i]);
+         double dscale = 1.0 + std::fabs(dexact);
+         TEST_ASSERT(std::fabs(dv[i] - dexact) < 1.0E-12*dscale);
+      }
+   }
+
+   void testEvaluate()
+   {
+      printMethod(TEST_FUNC);
+      checkEvaluate<0>();
+      checkEvaluate<1>();
+      checkEvaluate<2>();
+      checkEvaluate<3>();
+      checkEvaluate<4>();
+      checkEvaluate<5>();
+      checkEvaluate<7>();
+      checkEvaluate<8>();
+      checkEvaluate<11>();
+   }
+
+   #ifdef UTIL_CXX11
+   void testConstexpr()
+   {
+      printMethod(TEST_FUNC);
+
+      constexpr FixedPolynomial<3> p(1.0, 2.0, 3.0);
+      static_assert(p(2.0) == 17.0, "Compile time evaluation");
+      static_assert(p[3] == 0.0, "Missing coefficients are zero");
+      TEST_ASSERT(eq(p.estrin(2.0), 17.0));
+   }
+   #endif
+
+};
+
+TEST_BEGIN(FixedPolynomialTest)
+TEST_ADD(FixedPolynomialTest, testConversion)
+TEST_ADD(FixedPolynomialTest, testEvaluate)
+#ifdef UTIL_CXX11
+TEST_ADD(FixedPolynomialTest, testConstexpr)
+#endif
+TEST_END(FixedPolynomialTest)
+
+#endif
@@ -7,14 +7,20 @@
 #include "RationalTest.h"
 #include "BinomialTest.h"
 #include "PolynomialTest.h"
+#include "FixedPolynomialTest.h"
 #include "CardinalBSplineTest.h"
+#include "BSplineSpreaderTest.h"
+#include "TabulatedFunctionTest.h"
 
 TEST_COMPOSITE_BEGIN(MathTestComposite)
 TEST_COMPOSITE_ADD_UNIT(GcdTest);
 TEST_COMPOSITE_ADD_UNIT(RationalTest);
 TEST_COMPOSITE_ADD_UNIT(BinomialTest);
 TEST_COMPOSITE_ADD_UNIT(PolynomialTest);
+TEST_COMPOSITE_ADD_UNIT(FixedPolynomialTest);
 TEST_COMPOSITE_ADD_UNIT(CardinalBSplineTest);
+TEST_COMPOSITE_ADD_UNIT(BSplineSpreaderTest);
+TEST_COMPOSITE_ADD_UNIT(TabulatedFunctionTest);
 TEST_COMPOSITE_END
 
 #endif
@@ -0,0 +1,173 @@
+#ifndef UTIL_TABULATED_FUNCTION_TEST_H
+#define UTIL_TABULATED_FUNCTION_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/math/TabulatedFunction.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryIArchive.h>
+#include <util/archives/MemoryCounter.h>
+
+#include <cmath>
+
+using namespace Util;
+
+class TabulatedFunctionTest : public UnitTest
+{
+
+public:
+
+   // Smooth test function and its derivative
+   struct Function
+   {
+      double operator () (double r) const
+      {  return std::exp(-r)*std::cos(2.0*r); }
+   };
+
+   struct Derivative
+   {
+      double operator () (double r) const
+      {  return -std::exp(-r)*(std::cos(2.0*r) + 2.0*std::sin(2.0*r)); }
+   };
+
+   // Cubic polynomial and its derivative
+   struct Cubic
+   {
+      double operator () (double r) const
+      {  return 1.0 - 2.0*r + 0.5*r*r*r; }
+   };
+
+   struct CubicDerivative
+   {
+      double operator () (double r) const
+      {  return -2.0 + 1.5*r*r; }
+   };
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {  Binomial::clear(); }
+
+   void testBSpline()
+   {
+      printMethod(TEST_FUNC);
+
+      Function f;
+      Derivative df;
+      TabulatedFunction table;
+      TEST_ASSERT(!table.isSetup());
+      table.setupBSpline(f, 0.5, 4.5, 200);
+      TEST_ASSERT(table.isSetup());
+      TEST_ASSERT(table.nInterval() == 200);
+
+      // Interpolation at grid points is exact
+      for (int i = 0; i <= 200; ++i) {
+         double r = 0.5 + i*0.02;
+         TEST_ASSERT(std::fabs(table(r) - f(r)) < 1.0E-12);
+      }
+
+      double error = table.estimateError(f);
+      TEST_ASSERT(error < 5.0E-7);
+      TEST_ASSERT(table.estimateError(f, 3, true, 1.0E-3) < 1.0E-4);
+
+      // Derivative
+      double value, deriv;
+      for (int i = 0; i < 50; ++i) {
+         double r = 0.53 + i*0.079;
+         table.evaluate(r, value, deriv);
+         TEST_ASSERT(eq(value, table(r)));
+         TEST_ASSERT(std::fabs(deriv - df(r)) < 1.0E-5);
+      }
+   }
+
+   void testHermite()
+   {
+      printMethod(TEST_FUNC);
+
+      // Cubic Hermite interpolation is exact for a cubic
+      Cubic f;
+      CubicDerivative df;
+      TabulatedFunction table;
+      table.setupHermite(f, df, -1.0, 2.0, 7);
+      TEST_ASSERT(table.estimateError(f, 5) < 1.0E-12);
+      double value, deriv;
+      table.evaluate(1.3, value, deriv);
+      TEST_ASSERT(std::fabs(value - f(1.3)) < 1.0E-12);
+      TEST_ASSERT(std::fabs(deriv - df(1.3)) < 1.0E-12);
+
+      // Extrapolation uses the cubic of the last interval
+      TEST_ASSERT(std::fabs(table(2.5) - f(2.5)) < 1.0E-12);
+      TEST_ASSERT(std::fabs(table(-1.5) - f(-1.5)) < 1.0E-12);
+
+      Function g;
+      Derivative dg;
+      table.setupHermite(g, dg, 0.5, 4.5, 400);
+      TEST_ASSERT(table.estimateError(g) < 1.0E-7);
+   }
+
+   void testArrays()
+   {
+      printMethod(TEST_FUNC);
+
+      Function f;
+      TabulatedFunction table;
+      table.setupBSpline(f, 0.0, 3.0, 64);
+
+      double r[10];
+      double v[10];
+      double v2[10];
+      double dv[10];
+      for (int i = 0; i < 10; ++i) {
+         r[i] = -0.2 + 0.37*i;
+      }
+      table.evaluate(r, 10, v);
+      table.evaluate(r, 10, v2, dv);
+      for (int i = 0; i < 10; ++i) {
+         double value, deriv;
+         table.evaluate(r[i], value, deriv);
+         TEST_ASSERT(eq(v[i], value));
+         TEST_ASSERT(eq(v2[i], value));
+         TEST_ASSERT(eq(dv[i], deriv));
+      }
+   }
+
+   void testSerialize()
+   {
+      printMethod(TEST_FUNC);
+
+      Function f;
+      TabulatedFunction table;
+      table.setupBSpline(f, 0.0, 3.0, 32);
+      int size = memorySize(table);
+
+      MemoryOArchive oArchive;
+      oArchive.allocate(size);
+      oArchive << table;
+      TEST_ASSERT(oArchive.cursor() == oArchive.begin() + size);
+
+      MemoryIArchive iArchive;
+      iArchive = oArchive;
+      TabulatedFunction copy;
+      iArchive >> copy;
+      TEST_ASSERT(iArchive.cursor() == iArchive.end());
+      TEST_ASSERT(copy.nInterval() == 32);
+      TEST_ASSERT(eq(copy.rMin(), 0.0));
+      TEST_ASSERT(eq(copy.rMax(), 3.0));
+      for (int i = 0; i < 20; ++i) {
+         double r = 0.01 + 0.149*i;
+         TEST_ASSERT(eq(copy(r), table(r)));
+      }
+   }
+
+};
+
+TEST_BEGIN(TabulatedFunctionTest)
+TEST_ADD(TabulatedFunctionTest, testBSpline)
+TEST_ADD(TabulatedFunctionTest, testHermite)
+TEST_ADD(TabulatedFunctionTest, testArrays)
+TEST_ADD(TabulatedFunctionTest, testSerialize)
+TEST_END(TabulatedFunctionTest)
+
+#endif
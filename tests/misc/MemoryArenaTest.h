@@ -0,0 +1,143 @@
+#ifndef MEMORY_ARENA_TEST_H
+#define MEMORY_ARENA_TEST_H
+
+#include <util/misc/MonotonicArena.h>
+#include <util/misc/PoolArena.h>
+#include <util/misc/Memory.h>
+#include <util/containers/GArray.h>
+#include <util/containers/GPArray.h>
+#include <util/containers/GStack.h>
+#include <util/containers/DPArray.h>
+#include <util/global.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+using namespace Util;
+
+class MemoryArenaTest : public UnitTest 
+{
+
+   long mem0_;
+
+public:
+
+   void setUp()
+   {  mem0_ = Memory::total(); };
+
+   void tearDown()
+   {};
+
+   void testMonotonic() 
+   {
+      printMethod(TEST_FUNC);
+
+      MonotonicArena arena(4096);
+      TEST_ASSERT(arena.capacity() == 0);
+      void* a = arena.allocate(100, 16);
+      void* b = arena.allocate(30, 64);
+      TEST_ASSERT((size_t)a % 16 == 0);
+      TEST_ASSERT((size_t)b % 64 == 0);
+      TEST_ASSERT((char*)b >= (char*)a + 100);
+      TEST_ASSERT(arena.capacity() == 4096);
+
+      // Request larger than a chunk adds a larger chunk
+      void* c = arena.allocate(10000, 16);
+      TEST_ASSERT(c);
+      TEST_ASSERT(arena.capacity() > 4096 + 10000);
+      size_t capacity = arena.capacity();
+
+      // Reset reuses the first chunk
+      arena.reset();
+      void* d = arena.allocate(100, 16);
+      TEST_ASSERT(d == a);
+      TEST_ASSERT(arena.capacity() == capacity);
+
+      arena.release();
+      TEST_ASSERT(arena.capacity() == 0);
+   }
+
+   void testPool() 
+   {
+      printMethod(TEST_FUNC);
+
+      TEST_ASSERT(PoolArena::sizeClass(1, 1) == 0);
+      TEST_ASSERT(PoolArena::sizeClass(16, 8) == 0);
+      TEST_ASSERT(PoolArena::sizeClass(17, 8) == 1);
+      TEST_ASSERT(PoolArena::sizeClass(8, 64) == 2);
+      TEST_ASSERT(PoolArena::blockSize(2) == 64);
+
+      PoolArena pool(4096);
+      void* a = pool.allocate(40, 16);
+      void* b = pool.allocate(40, 16);
+      TEST_ASSERT(a != b);
+      TEST_ASSERT((size_t)a % 64 == 0);
+      pool.deallocate(a, 40, 16);
+      TEST_ASSERT(pool.nFree(2) == 1);
+
+      // Freed block is reused for a request of the same class
+      void* c = pool.allocate(64, 16);
+      TEST_ASSERT(c == a);
+      TEST_ASSERT(pool.nFree(2) == 0);
+
+      pool.deallocate(b, 40, 16);
+      pool.deallocate(c, 64, 16);
+      pool.reset();
+      TEST_ASSERT(pool.nFree(2) == 0);
+      TEST_ASSERT(pool.capacity() == 4096);
+   }
+
+   void testContainers() 
+   {
+      printMethod(TEST_FUNC);
+
+      PoolArena pool;
+      MemoryPolicy policy(pool);
+      TEST_ASSERT(!policy.isDefault());
+      TEST_ASSERT(policy.arena() == &pool);
+
+      int data[200];
+      for (int cycle = 0; cycle < 3; ++cycle) {
+         {
+            GArray<int> array;
+            GPArray<int> parray;
+            GStack<int> stack;
+            DPArray<int> dparray;
+            array.setMemoryPolicy(policy);
+            parray.setMemoryPolicy(policy);
+            stack.setMemoryPolicy(policy);
+            dparray.setMemoryPolicy(policy);
+            dparray.allocate(200);
+            for (int i = 0; i < 200; ++i) {
+               data[i] = i;
+               array.append(i);
+               parray.append(data[i]);
+               stack.push(data[i]);
+               dparray.append(data[i]);
+            }
+            TEST_ASSERT(array.capacity() == 256);
+            TEST_ASSERT(array[150] == 150);
+            TEST_ASSERT(parray[199] == 199);
+            TEST_ASSERT(stack.peek() == 199);
+            TEST_ASSERT(dparray[10] == 10);
+            TEST_ASSERT(Memory::total() > mem0_);
+         }
+         TEST_ASSERT(Memory::total() == mem0_);
+         if (cycle == 0) {
+            // Memory from the first cycle is recycled by later cycles
+            TEST_ASSERT(pool.nFree(PoolArena::sizeClass(1024, 16)) > 0);
+         }
+         pool.reset();
+      }
+      TEST_ASSERT(pool.capacity() == 1048576);
+   }
+
+};
+
+TEST_BEGIN(MemoryArenaTest)
+TEST_ADD(MemoryArenaTest, testMonotonic)
+TEST_ADD(MemoryArenaTest, testPool)
+TEST_ADD(MemoryArenaTest, testContainers)
+TEST_END(MemoryArenaTest)
+
+#endif
@@ -9,10 +9,30 @@
 
 using namespace Util;
 
+/*
+* Type used only to test per-type attribution.
+*/
+struct MemoryTestTyped
+{
+   double x;
+   int n;
+};
+
+#ifdef UTIL_CXX11
+/*
+* Cache-line aligned type, like the slots of MpmcRingBuffer.
+*/
+struct alignas(MemoryPolicy::CacheLineSize) MemoryTestSlot
+{
+   long sequence;
+   double data;
+};
+#endif
+
 class MemoryTest : public UnitTest 
 {
 
-   int mem0_;
+   long mem0_;
 
 public:
 
@@ -63,11 +83,193 @@ public:
       TEST_ASSERT(Memory::total() == mem0_);
    }
 
+   void testAllocatePolicy() 
+   {
+      printMethod(TEST_FUNC);
+
+      MemoryPolicy policies[4];
+      policies[0] = MemoryPolicy::simd();
+      policies[1] = MemoryPolicy::hugePages();
+      policies[2] = MemoryPolicy::hugePages(true);
+      policies[3] = MemoryPolicy::interleaved();
+
+      int n = 1000;
+      for (int j = 0; j < 4; ++j) {
+         double* ptr = 0;
+         Memory::allocate(ptr, n, policies[j]);
+         TEST_ASSERT(ptr);
+         TEST_ASSERT((size_t)ptr % policies[j].alignment() == 0);
+         TEST_ASSERT(Memory::total() == mem0_ + n*int(sizeof(double)));
+         for (int i = 0; i < n; ++i) {
+            ptr[i] = 0.1 + (double)(i);
+         }
+         Memory::reallocate(ptr, n, n + 20, policies[j]);
+         TEST_ASSERT((size_t)ptr % policies[j].alignment() == 0);
+         for (int i = 0; i < n; ++i) {
+            TEST_ASSERT(eq(ptr[i], double(i) + 0.1));
+         }
+         Memory::deallocate(ptr, n + 20, policies[j]);
+         TEST_ASSERT(ptr == 0);
+         TEST_ASSERT(Memory::total() == mem0_);
+      }
+   }
+
+   #ifdef UTIL_CXX11
+   void testOverAligned() 
+   {
+      printMethod(TEST_FUNC);
+
+      const size_t align = MemoryPolicy::CacheLineSize;
+      MemoryPolicy policies[2];
+      policies[1] = MemoryPolicy::cacheLine();
+      int n = 37;
+      for (int j = 0; j < 2; ++j) {
+         MemoryTestSlot* ptr = 0;
+         Memory::allocate(ptr, n, policies[j]);
+         TEST_ASSERT((size_t)ptr % align == 0);
+         TEST_ASSERT((size_t)(ptr + 1) % align == 0);
+         TEST_ASSERT(Memory::total() 
+                     == mem0_ + n*long(sizeof(MemoryTestSlot)));
+         for (int i = 0; i < n; ++i) {
+            ptr[i].sequence = i;
+         }
+         Memory::reallocate(ptr, n, 2*n, policies[j]);
+         TEST_ASSERT((size_t)ptr % align == 0);
+         TEST_ASSERT(ptr[n - 1].sequence == n - 1);
+         Memory::deallocate(ptr, 2*n, policies[j]);
+         TEST_ASSERT(Memory::total() == mem0_);
+      }
+   }
+   #endif
+
+   void testTypeTags() 
+   {
+      printMethod(TEST_FUNC);
+
+      TEST_ASSERT(!Memory::typeTagsEnabled());
+      Memory::enableTypeTags(true);
+      MemoryTestTyped* ptr = 0;
+      int n = 20;
+      Memory::allocate(ptr, n);
+      Memory::enableTypeTags(false);
+
+      // Find the tag named after the type
+      int tag = 0;
+      for (int i = 1; i < Memory::nTag(); ++i) {
+         if (Memory::tagName(i).find("MemoryTestTyped") 
+             != std::string::npos) {
+            tag = i;
+         }
+      }
+      TEST_ASSERT(tag > 0);
+      long nBytes = n*long(sizeof(MemoryTestTyped));
+      TEST_ASSERT(Memory::snapshot(tag).total == nBytes);
+
+      // The type keeps its tag after type tags are disabled
+      MemoryTestTyped* ptr2 = 0;
+      Memory::allocate(ptr2, n);
+      TEST_ASSERT(Memory::snapshot(tag).total == 2*nBytes);
+
+      // An explicit tag takes precedence
+      MemoryPolicy policy;
+      policy.setTag(Memory::addTag("MemoryTestC"));
+      MemoryTestTyped* ptr3 = 0;
+      Memory::allocate(ptr3, n, policy);
+      TEST_ASSERT(Memory::snapshot(tag).total == 2*nBytes);
+      TEST_ASSERT(Memory::snapshot(policy.tag()).total == nBytes);
+
+      if (verbose() > 0) {
+         printEndl();
+         Memory::report(std::cout);
+      }
+
+      Memory::deallocate(ptr, n);
+      Memory::deallocate(ptr2, n);
+      Memory::deallocate(ptr3, n, policy);
+      TEST_ASSERT(Memory::snapshot(tag).total == 0);
+      TEST_ASSERT(Memory::snapshot(policy.tag()).total == 0);
+      TEST_ASSERT(Memory::total() == mem0_);
+   }
+
+   void testInitStatic() 
+   {
+      printMethod(TEST_FUNC);
+
+      double* ptr = 0;
+      Memory::allocate(ptr, 100);
+      Memory::deallocate(ptr, 100);
+      TEST_ASSERT(Memory::max() >= 100*long(sizeof(double)));
+
+      // initStatic resets the high-water mark to zero
+      Memory::initStatic();
+      TEST_ASSERT(Memory::max() == 0);
+      Memory::allocate(ptr, 10);
+      TEST_ASSERT(Memory::max() >= 10*long(sizeof(double)));
+      Memory::deallocate(ptr, 10);
+      Memory::resetMax();
+      TEST_ASSERT(Memory::max() == Memory::total());
+   }
+
+   void testTags() 
+   {
+      printMethod(TEST_FUNC);
+
+      int tagA = Memory::addTag("MemoryTestA");
+      int tagB = Memory::addTag("MemoryTestB");
+      TEST_ASSERT(tagA > 0);
+      TEST_ASSERT(tagB > tagA);
+      TEST_ASSERT(Memory::addTag("MemoryTestA") == tagA);
+      TEST_ASSERT(Memory::tagName(tagB) == "MemoryTestB");
+      TEST_ASSERT(Memory::nTag() > tagB);
+
+      Memory::resetMax();
+      MemoryPolicy policyA;
+      policyA.setTag(tagA);
+      MemoryPolicy policyB = MemoryPolicy::cacheLine();
+      policyB.setTag(tagB);
+
+      double* ptrA = 0;
+      int* ptrB = 0;
+      Memory::allocate(ptrA, 100, policyA);
+      Memory::allocate(ptrB, 50, policyB);
+      Memory::Snapshot a = Memory::snapshot(tagA);
+      Memory::Snapshot b = Memory::snapshot(tagB);
+      TEST_ASSERT(a.total == 100*long(sizeof(double)));
+      TEST_ASSERT(b.total == 50*long(sizeof(int)));
+      TEST_ASSERT(a.nAllocate == 1);
+      TEST_ASSERT(Memory::total() == mem0_ + a.total + b.total);
+      TEST_ASSERT(Memory::max() >= Memory::total());
+
+      Memory::reallocate(ptrA, 100, 200, policyA);
+      a = Memory::snapshot(tagA);
+      TEST_ASSERT(a.total == 200*long(sizeof(double)));
+      TEST_ASSERT(a.max == 300*long(sizeof(double)));
+      TEST_ASSERT(a.nDeallocate == 1);
+
+      if (verbose() > 0) {
+         printEndl();
+         Memory::report(std::cout);
+      }
+
+      Memory::deallocate(ptrA, 200, policyA);
+      Memory::deallocate(ptrB, 50, policyB);
+      TEST_ASSERT(Memory::snapshot(tagA).total == 0);
+      TEST_ASSERT(Memory::snapshot(tagB).total == 0);
+      TEST_ASSERT(Memory::total() == mem0_);
+   }
+
 };
 
 TEST_BEGIN(MemoryTest)
 TEST_ADD(MemoryTest, testAllocate)
 TEST_ADD(MemoryTest, testReallocate)
+TEST_ADD(MemoryTest, testAllocatePolicy)
+#ifdef UTIL_CXX11
+TEST_ADD(MemoryTest, testOverAligned)
+#endif
+TEST_ADD(MemoryTest, testTags)
+TEST_ADD(MemoryTest, testTypeTags)
+TEST_ADD(MemoryTest, testInitStatic)
 TEST_END(MemoryTest)
 
 #endif
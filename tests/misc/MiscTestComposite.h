@@ -10,8 +10,12 @@
 #include "ioUtilTest.h"
 #include "XmlTest.h"
 #include "MemoryTest.h"
+#include "MemoryArenaTest.h"
 #include "ReferenceCountTest.h"
 #include "TimerTest.h"
+#include "ProfilerTest.h"
+#include "PerfCountersTest.h"
+#include "TempFileTest.h"
 
 TEST_COMPOSITE_BEGIN(MiscTestComposite)
 TEST_COMPOSITE_ADD_UNIT(ExceptionTest);
@@ -21,8 +25,12 @@ TEST_COMPOSITE_ADD_UNIT(FlagSetTest);
 TEST_COMPOSITE_ADD_UNIT(ioUtilTest);
 TEST_COMPOSITE_ADD_UNIT(XmlTest);
 TEST_COMPOSITE_ADD_UNIT(MemoryTest);
+TEST_COMPOSITE_ADD_UNIT(MemoryArenaTest);
 TEST_COMPOSITE_ADD_UNIT(ReferenceCountTest);
 TEST_COMPOSITE_ADD_UNIT(TimerTest);
+TEST_COMPOSITE_ADD_UNIT(ProfilerTest);
+TEST_COMPOSITE_ADD_UNIT(PerfCountersTest);
+TEST_COMPOSITE_ADD_UNIT(TempFileTest);
 TEST_COMPOSITE_END
 
 #endif
@@ -0,0 +1,126 @@
+#ifndef PERF_COUNTERS_TEST_H
+#define PERF_COUNTERS_TEST_H
+
+#include <util/misc/PerfCounters.h>
+#include <util/global.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+using namespace Util;
+
+class PerfCountersTest : public UnitTest
+{
+
+public:
+
+   void setUp()
+   {};
+
+   void tearDown()
+   {};
+
+   void testOpen()
+   {
+      printMethod(TEST_FUNC);
+
+      PerfCounters counters;
+      TEST_ASSERT(!counters.isOpen());
+
+      // Counters may be unavailable, e.g. in a container
+      if (counters.open()) {
+         TEST_ASSERT(counters.isOpen());
+      } else {
+         TEST_ASSERT(!counters.error().empty());
+         for (int i = 0; i < PerfCounters::NEvent; ++i) {
+            TEST_ASSERT(!counters.isAvailable(i));
+         }
+      }
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         for (int i = 0; i < PerfCounters::NEvent; ++i) {
+            std::cout << PerfCounters::eventName(i) << " "
+                      << counters.isAvailable(i) << std::endl;
+         }
+         std::cout << counters.error() << std::endl;
+      }
+
+      counters.close();
+      TEST_ASSERT(!counters.isOpen());
+   }
+
+   void testRead()
+   {
+      printMethod(TEST_FUNC);
+
+      PerfCounters counters;
+      counters.open();
+
+      long begin[PerfCounters::NEvent];
+      long end[PerfCounters::NEvent];
+      long enabled, running;
+      counters.read(begin, enabled, running);
+      TEST_ASSERT(running <= enabled);
+      volatile double sum = 0.0;
+      for (int i = 0; i < 100000; ++i) {
+         sum += 0.5*double(i);
+      }
+      counters.read(end);
+
+      for (int i = 0; i < PerfCounters::NEvent; ++i) {
+         if (counters.isAvailable(i)) {
+            TEST_ASSERT(end[i] >= begin[i]);
+         } else {
+            TEST_ASSERT(begin[i] == 0);
+            TEST_ASSERT(end[i] == 0);
+         }
+      }
+      if (counters.isAvailable(PerfCounters::Instructions)) {
+         long n = end[PerfCounters::Instructions]
+                - begin[PerfCounters::Instructions];
+         TEST_ASSERT(n > 100000);
+      }
+
+      // Scaled read
+      double fraction = counters.read(end);
+      TEST_ASSERT(fraction >= 0.0 && fraction <= 1.0);
+      if (!counters.isOpen()) {
+         TEST_ASSERT(fraction == 0.0);
+      }
+   }
+
+   void testScale()
+   {
+      printMethod(TEST_FUNC);
+
+      long values[PerfCounters::NEvent];
+      for (int i = 0; i < PerfCounters::NEvent; ++i) {
+         values[i] = 100*(i + 1);
+      }
+
+      // Not multiplexed: unchanged
+      TEST_ASSERT(PerfCounters::scale(values, 1000, 1000) == 1.0);
+      TEST_ASSERT(values[0] == 100);
+      TEST_ASSERT(values[3] == 400);
+
+      // Counted for a quarter of the time
+      TEST_ASSERT(PerfCounters::scale(values, 1000, 250) == 0.25);
+      TEST_ASSERT(values[0] == 400);
+      TEST_ASSERT(values[3] == 1600);
+
+      // Never counted
+      TEST_ASSERT(PerfCounters::scale(values, 1000, 0) == 0.0);
+      for (int i = 0; i < PerfCounters::NEvent; ++i) {
+         TEST_ASSERT(values[i] == 0);
+      }
+   }
+
+};
+
+TEST_BEGIN(PerfCountersTest)
+TEST_ADD(PerfCountersTest, testOpen)
+TEST_ADD(PerfCountersTest, testRead)
+TEST_ADD(PerfCountersTest, testScale)
+TEST_END(PerfCountersTest)
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef PROFILER_TEST_H
+#define PROFILER_TEST_H
+
+#include <util/misc/Profiler.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryIArchive.h>
+#include <util/global.h>
+
+#ifdef UTIL_MPI
+#ifndef TEST_MPI
+#define TEST_MPI
+#endif
+#endif
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef UTIL_CXX11
+#include <thread>
+#endif
+
+using namespace Util;
+
+class ProfilerTest : public UnitTest
+{
+
+   int outer_;
+   int inner_;
+
+public:
+
+   void setUp()
+   {
+      Profiler::clear();
+      outer_ = Profiler::addRegion("outer");
+      inner_ = Profiler::addRegion("inner");
+   }
+
+   void tearDown()
+   {};
+
+   /*
+   * Enter outer once, and inner n times within outer.
+   */
+   void work(int n)
+   {
+      ProfileScope outer(outer_);
+      for (int i = 0; i < n; ++i) {
+         ProfileScope inner(inner_);
+      }
+   }
+
+   void testAddRegion()
+   {
+      printMethod(TEST_FUNC);
+
+      TEST_ASSERT(Profiler::addRegion("outer") == outer_);
+      TEST_ASSERT(Profiler::regionName(inner_) == "inner");
+      TEST_ASSERT(outer_ != inner_);
+
+      // UTIL_THROW aborts when compiled with MPI
+      #ifndef UTIL_MPI
+      bool success = false;
+      try {
+         Profiler::addRegion("outer/inner");
+      } catch (Exception) {
+         success = true;
+      }
+      TEST_ASSERT(success);
+      #endif
+   }
+
+   void testNested()
+   {
+      printMethod(TEST_FUNC);
+
+      work(3);
+      work(2);
+      {
+         ProfileScope inner(inner_);
+      }
+
+      Profiler::Stats s = Profiler::stats("outer");
+      TEST_ASSERT(s.count == 2);
+      TEST_ASSERT(s.min <= s.mean());
+      TEST_ASSERT(s.mean() <= s.max);
+      Profiler::Stats t = Profiler::stats("outer/inner");
+      TEST_ASSERT(t.count == 5);
+      TEST_ASSERT(t.total <= s.total);
+      TEST_ASSERT(Profiler::stats("inner").count == 1);
+      TEST_ASSERT(Profiler::stats("inner/outer").count == 0);
+
+      std::ostringstream out;
+      Profiler::report(out);
+      TEST_ASSERT(out.str().find("  inner") != std::string::npos);
+      if (verbose() > 0) {
+         std::cout << std::endl;
+         Profiler::report(std::cout);
+      }
+
+      Profiler::clear();
+      TEST_ASSERT(Profiler::stats("outer/inner").count == 0);
+   }
+
+   void testPathOrder()
+   {
+      printMethod(TEST_FUNC);
+
+      // Names that sort below '/' in ASCII
+      int dash = Profiler::addRegion("outer-2");
+      int dot = Profiler::addRegion("outer.x");
+      int space = Profiler::addRegion("outer y");
+      {
+         ProfileScope s(space);
+      }
+      {
+         ProfileScope s(dot);
+      }
+      {
+         ProfileScope s(dash);
+      }
+      work(2);
+
+      // Each child follows its parent in the report
+      std::ostringstream out;
+      Profiler::report(out);
+      std::string text = out.str();
+      size_t outer = text.find("\nouter ");
+      size_t inner = text.find("\n  inner ");
+      TEST_ASSERT(outer != std::string::npos);
+      TEST_ASSERT(inner != std::string::npos);
+      TEST_ASSERT(outer < inner);
+      TEST_ASSERT(text.find("\n", outer + 1) == inner);
+      TEST_ASSERT(text.find("\nouter-2") > inner);
+      TEST_ASSERT(text.find("\nouter.x") > inner);
+      TEST_ASSERT(text.find("\nouter y") > inner);
+      if (verbose() > 0) {
+         std::cout << std::endl << text;
+      }
+   }
+
+   void testSnapshot()
+   {
+      printMethod(TEST_FUNC);
+
+      work(4);
+      std::vector<std::string> paths;
+      std::vector<Profiler::Stats> stats;
+      Profiler::snapshot(paths, stats);
+      TEST_ASSERT(paths.size() == stats.size());
+
+      // Each path follows its parent
+      int outer = -1;
+      int inner = -1;
+      for (int i = 0; i < (int)paths.size(); ++i) {
+         if (paths[i] == "outer") outer = i;
+         if (paths[i] == "outer/inner") inner = i;
+      }
+      TEST_ASSERT(outer >= 0);
+      TEST_ASSERT(inner == outer + 1);
+      TEST_ASSERT(stats[inner].count == 4);
+
+      // Save and reload
+      MemoryOArchive oar;
+      oar.allocate(4096);
+      oar << paths;
+      oar << stats;
+      MemoryIArchive iar;
+      iar = oar;
+      std::vector<std::string> paths2;
+      std::vector<Profiler::Stats> stats2;
+      iar >> paths2;
+      iar >> stats2;
+      TEST_ASSERT(paths2 == paths);
+      TEST_ASSERT(stats2.size() == stats.size());
+      TEST_ASSERT(stats2[inner].count == 4);
+      TEST_ASSERT(eq(stats2[inner].total, stats[inner].total));
+   }
+
+   void testCounters()
+   {
+      printMethod(TEST_FUNC);
+
+      Profiler::enableCounters(true);
+      TEST_ASSERT(Profiler::countersEnabled());
+      work(5);
+      Profiler::enableCounters(false);
+
+      // Counters may be unavailable, e.g. in a container
+      Profiler::Stats s = Profiler::stats("outer/inner");
+      TEST_ASSERT(s.count == 5);
+      if (Profiler::isCounted(PerfCounters::Instructions)) {
+         TEST_ASSERT(s.events[PerfCounters::Instructions] > 0);
+      } else {
+         TEST_ASSERT(s.events[PerfCounters::Instructions] == 0);
+         TEST_ASSERT(!Profiler::counterError().empty());
+      }
+      std::ostringstream out;
+      Profiler::report(out);
+      bool any = false;
+      for (int i = 0; i < PerfCounters::NEvent; ++i) {
+         if (Profiler::isCounted(i)) any = true;
+      }
+      if (any) {
+         TEST_ASSERT(out.str().find("IPC") != std::string::npos);
+      } else {
+         TEST_ASSERT(out.str().find("unavailable") != std::string::npos);
+      }
+      if (verbose() > 0) {
+         std::cout << std::endl << out.str();
+      }
+   }
+
+   #ifdef UTIL_PROFILE
+   void testMacro()
+   {
+      printMethod(TEST_FUNC);
+
+      for (int i = 0; i < 4; ++i) {
+         UTIL_PROFILE_SCOPE("macro");
+      }
+      TEST_ASSERT(Profiler::stats("macro").count == 4);
+   }
+   #endif
+
+   #ifdef UTIL_CXX11
+   void testThreads()
+   {
+      printMethod(TEST_FUNC);
+
+      std::thread t0([this] { work(10); });
+      std::thread t1([this] { work(20); });
+      t0.join();
+      t1.join();
+      work(1);
+
+      TEST_ASSERT(Profiler::nThread() >= 3);
+      TEST_ASSERT(Profiler::stats("outer").count == 3);
+      TEST_ASSERT(Profiler::stats("outer/inner").count == 31);
+   }
+   #endif
+
+   #ifdef UTIL_MPI
+   void testReport()
+   {
+      printMethod(TEST_FUNC);
+
+      int rank = MPI::COMM_WORLD.Get_rank();
+      work(rank + 1);
+
+      std::ostringstream out;
+      Profiler::report(out, MPI::COMM_WORLD);
+      if (rank == 0) {
+         TEST_ASSERT(out.str().find("imbalance") != std::string::npos);
+         TEST_ASSERT(out.str().find("  inner") != std::string::npos);
+         if (verbose() > 0) {
+            std::cout << std::endl << out.str();
+         }
+      } else {
+         TEST_ASSERT(out.str().empty());
+      }
+   }
+   #endif
+
+};
+
+TEST_BEGIN(ProfilerTest)
+TEST_ADD(ProfilerTest, testAddRegion)
+TEST_ADD(ProfilerTest, testNested)
+TEST_ADD(ProfilerTest, testPathOrder)
+TEST_ADD(ProfilerTest, testSnapshot)
+TEST_ADD(ProfilerTest, testCounters)
+#ifdef UTIL_PROFILE
+TEST_ADD(ProfilerTest, testMacro)
+#endif
+#ifdef UTIL_CXX11
+TEST_ADD(ProfilerTest, testThreads)
+#endif
+#ifdef UTIL_MPI
+TEST_ADD(ProfilerTest, testReport)
+#endif
+TEST_END(ProfilerTest)
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef TEMP_FILE_TEST_H
+#define TEMP_FILE_TEST_H
+
+#include <util/misc/TempFile.h>
+#include <util/global.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace Util;
+
+class TempFileTest : public UnitTest 
+{
+
+   std::string filename_;
+
+public:
+
+   void setUp()
+   {
+      filename_ = "TempFileTest.dat";
+      std::remove(filename_.c_str());
+   }
+
+   void tearDown()
+   {  std::remove(filename_.c_str()); }
+
+   bool exists(std::string const & name)
+   {
+      std::ifstream in(name.c_str());
+      return in.is_open();
+   }
+
+   void testCommit() 
+   {
+      printMethod(TEST_FUNC);
+
+      std::string name;
+      {
+         TempFile tmp(filename_);
+         name = tmp.name();
+         TEST_ASSERT(name != filename_);
+         TEST_ASSERT(name.find(filename_) == 0);
+         {
+            std::ofstream out(tmp.name().c_str());
+            out << 42 << std::endl;
+         }
+         TEST_ASSERT(exists(name));
+         TEST_ASSERT(!exists(filename_));
+         TEST_ASSERT(tmp.commit());
+         TEST_ASSERT(!exists(name));
+      }
+      TEST_ASSERT(exists(filename_));
+      std::ifstream in(filename_.c_str());
+      int value = 0;
+      in >> value;
+      TEST_ASSERT(value == 42);
+   }
+
+   void testUnique() 
+   {
+      printMethod(TEST_FUNC);
+
+      TempFile a(filename_);
+      TempFile b(filename_);
+      TEST_ASSERT(a.name() != b.name());
+   }
+
+   void testRemove() 
+   {
+      printMethod(TEST_FUNC);
+
+      // Existing target is kept if the temporary file is not committed
+      {
+         std::ofstream out(filename_.c_str());
+         out << 1 << std::endl;
+      }
+      std::string name;
+      bool thrown = false;
+      try {
+         TempFile tmp(filename_);
+         name = tmp.name();
+         std::ofstream out(tmp.name().c_str());
+         out << 2 << std::endl;
+         throw 2;
+      } catch (int) {
+         thrown = true;
+      }
+      TEST_ASSERT(thrown);
+      TEST_ASSERT(!exists(name));
+      std::ifstream in(filename_.c_str());
+      int value = 0;
+      in >> value;
+      TEST_ASSERT(value == 1);
+   }
+
+};
+
+TEST_BEGIN(TempFileTest)
+TEST_ADD(TempFileTest, testCommit)
+TEST_ADD(TempFileTest, testUnique)
+TEST_ADD(TempFileTest, testRemove)
+TEST_END(TempFileTest)
+
+#endif
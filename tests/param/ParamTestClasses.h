@@ -4,6 +4,7 @@
 #include <util/space/Vector.h>
 #include <util/space/IntVector.h>
 #include <util/containers/Matrix.h>
+#include <util/containers/DArray.h>
 #include <util/param/ParamComposite.h>
 #include <util/archives/serialize.h>
 
@@ -17,6 +18,28 @@
       A()
       { setClassName("A"); }
 
+      // Allocate and fill work array, after parameters are read.
+      virtual void allocate()
+      {}
+
+      DArray<double> const & work() const
+      {  return work_; }
+
+   protected:
+
+      // Allocate work_ with capacity n and set work_[i] = i.
+      void allocateWork(int n)
+      {
+         work_.allocate(n);
+         for (int i = 0; i < n; ++i) {
+            work_[i] = double(i);
+         }
+      }
+
+   private:
+
+      DArray<double> work_;
+
    };
 
 
@@ -54,6 +77,9 @@
          ar << m_;
       }
 
+      virtual void allocate()
+      {  allocateWork(1000*m_); }
+
    private:
 
       double x_;
@@ -84,6 +110,9 @@
       virtual void save(Serializable::OArchive& ar) 
       {  ar << m_; }
 
+      virtual void allocate()
+      {  allocateWork(1000*m_); }
+
    private:
 
       int    m_;
@@ -236,6 +265,12 @@
       Factory<A>* newDefaultFactory() const
       { return new AFactory(); }
 
+   protected:
+
+      // Allocate work arrays after all objects are read.
+      virtual void initializeObject(A& object)
+      {  object.allocate(); }
+
    };
 
    class AManagerUnique : public Manager<A>
@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 using namespace Util;
 
@@ -170,6 +171,63 @@ public:
 
    }
 
+   void testReadParamBcast()
+   {
+      printMethod(TEST_FUNC);
+
+      // Read with a broadcast of each value
+      AComposite reference;
+      reference.setIoCommunicator(communicator());
+      openFile("in/ParamComposite");
+      reference.readParam(file());
+      file().close();
+
+      // Read after a single broadcast of the file (I/O processor only)
+      object.setIoCommunicator(communicator());
+      std::ifstream in;
+      if (mpiRank() == 0) {
+         openInputFile("in/ParamComposite", in);
+      }
+      object.readParamBcast(in);
+      if (mpiRank() == 0) {
+         TEST_ASSERT(in.good() || in.eof());
+         in.close();
+      }
+      TEST_ASSERT(!ParamComponent::replicatedInput());
+      TEST_ASSERT(object.isIoProcessor() == (mpiRank() == 0));
+
+      std::ostringstream expected, actual;
+      reference.writeParam(expected);
+      object.writeParam(actual);
+      TEST_ASSERT(expected.str() == actual.str());
+   }
+
+   void testIsParamConsistent()
+   {
+      printMethod(TEST_FUNC);
+
+      // Read a different file on processor 1, without broadcasts
+      AComposite different;
+      std::ifstream in;
+      if (mpiRank() == 1) {
+         openInputFile("in/ParamCompositeAlt", in);
+      } else {
+         openInputFile("in/ParamComposite", in);
+      }
+      different.readParam(in);
+      in.close();
+      different.setIoCommunicator(communicator());
+      TEST_ASSERT(!different.isParamConsistent());
+
+      // Read the same file on every processor
+      AComposite same;
+      openInputFile("in/ParamComposite", in);
+      same.readParam(in);
+      in.close();
+      same.setIoCommunicator(communicator());
+      TEST_ASSERT(same.isParamConsistent());
+   }
+
 };
 
 
@@ -178,6 +236,8 @@ TEST_ADD(MpiParamCompositeTest, testReadWrite1)
 TEST_ADD(MpiParamCompositeTest, testReadWrite2)
 //TEST_ADD(MpiParamCompositeTest, testReadWrite3) // Doesn't work unless run from param/mpi directory
 TEST_ADD(MpiParamCompositeTest, testReadWrite4)
+TEST_ADD(MpiParamCompositeTest, testReadParamBcast)
+TEST_ADD(MpiParamCompositeTest, testIsParamConsistent)
 TEST_END(MpiParamCompositeTest)
 
 #endif // ifdef UTIL_MPI
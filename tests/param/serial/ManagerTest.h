@@ -12,6 +12,54 @@ using namespace Util;
 
 #include "../ParamTestClasses.h"
 
+#include <map>
+#ifdef UTIL_CXX11
+#include <mutex>
+#endif
+
+/*
+* Manager that records calls to initializeObject.
+*/
+class InitAManager : public AManager
+{
+
+public:
+
+   InitAManager()
+    : failName_()
+   {}
+
+   /// Number of calls to initializeObject for each object.
+   std::map<A const *, int> counts;
+
+   /// Throw from initializeObject for objects of this class.
+   void setFailName(std::string const & name)
+   {  failName_ = name; }
+
+protected:
+
+   virtual void initializeObject(A& object)
+   {
+      if (object.className() == failName_) {
+         UTIL_THROW("Initialization failed");
+      }
+      AManager::initializeObject(object);
+      #ifdef UTIL_CXX11
+      std::lock_guard<std::mutex> lock(mutex_);
+      #endif
+      ++counts[&object];
+   }
+
+private:
+
+   std::string failName_;
+
+   #ifdef UTIL_CXX11
+   std::mutex mutex_;
+   #endif
+
+};
+
 class ManagerTest : public UnitTest 
 {
 
@@ -100,6 +148,56 @@ public:
 
    }
 
+   void testInitializeObject() 
+   {
+      printMethod(TEST_FUNC);
+
+      for (int nThread = 1; nThread <= 4; nThread += 3) {
+         InitAManager manager;
+         manager.setNThread(nThread);
+         std::ifstream in;
+         openInputFile("in/Manager", in);
+         manager.readParam(in);
+         TEST_ASSERT(manager.size() == 5);
+         TEST_ASSERT(manager.counts.size() == 5);
+         for (int i = 0; i < manager.size(); ++i) {
+            TEST_ASSERT(manager.counts[&manager[i]] == 1);
+         }
+         TEST_ASSERT(manager[1].className() == "C");
+
+         // Work arrays are allocated by AManager::initializeObject
+         int m[5] = {1, 3, 3, 0, 0};
+         for (int i = 0; i < manager.size(); ++i) {
+            DArray<double> const & work = manager[i].work();
+            if (m[i] > 0) {
+               TEST_ASSERT(work.isAllocated());
+               TEST_ASSERT(work.capacity() == 1000*m[i]);
+               TEST_ASSERT(work[work.capacity() - 1] 
+                           == double(work.capacity() - 1));
+            } else {
+               TEST_ASSERT(!work.isAllocated());
+            }
+         }
+      }
+
+      // An exception thrown in a thread is rethrown
+      // UTIL_THROW aborts when compiled with MPI
+      #ifndef UTIL_MPI
+      InitAManager manager;
+      manager.setNThread(4);
+      manager.setFailName("C");
+      std::ifstream in;
+      openInputFile("in/Manager", in);
+      bool success = false;
+      try {
+         manager.readParam(in);
+      } catch (Exception) {
+         success = true;
+      }
+      TEST_ASSERT(success);
+      #endif
+   }
+
    void testManagerUnique1() 
    {
       printMethod(TEST_FUNC);
@@ -142,6 +240,7 @@ TEST_ADD(ManagerTest, testCustomFactory)
 TEST_ADD(ManagerTest, testManager)
 TEST_ADD(ManagerTest, testFindFirst)
 TEST_ADD(ManagerTest, testManagerSubfactory)
+TEST_ADD(ManagerTest, testInitializeObject)
 #ifndef UTIL_MPI
 TEST_ADD(ManagerTest, testManagerUnique1)
 TEST_ADD(ManagerTest, testManagerUnique2)
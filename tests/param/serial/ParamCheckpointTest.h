@@ -0,0 +1,230 @@
+#ifndef PARAM_CHECKPOINT_TEST_H
+#define PARAM_CHECKPOINT_TEST_H
+
+#include <util/param/ParamComposite.h>
+#include <util/param/ParamCheckpoint.h>
+#include <util/param/Manager.h>
+#include <util/param/Factory.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <cctype>
+#include <sstream>
+#include <string>
+
+#ifdef UTIL_CXX11
+#include <thread>
+#endif
+
+using namespace Util;
+
+#include "../ParamTestClasses.h"
+
+/*
+* Composite with two children, saved by the default save().
+*/
+class CheckpointComposite : public ParamComposite
+{
+
+public:
+
+   CheckpointComposite()
+   {  setClassName("CheckpointComposite"); }
+
+   virtual void readParameters(std::istream& in)
+   {
+      readParamComposite(in, b_);
+      readParamComposite(in, manager_);
+   }
+
+   virtual void loadParameters(Serializable::IArchive& ar)
+   {
+      loadParamComposite(ar, b_);
+      loadParamComposite(ar, manager_);
+   }
+
+   AManager& manager()
+   {  return manager_; }
+
+private:
+
+   BComposite b_;
+   AManager   manager_;
+
+};
+
+class ParamCheckpointTest : public UnitTest
+{
+
+public:
+
+   void setUp()
+   {  Label::clear(); }
+
+   void tearDown()
+   {  Label::clear(); }
+
+   /*
+   * Return writeParam output, without white space.
+   */
+   std::string squeeze(ParamComposite const & object)
+   {
+      std::ostringstream out;
+      object.writeParam(out);
+      std::string text = out.str();
+      std::string result;
+      for (size_t i = 0; i < text.size(); ++i) {
+         if (!std::isspace(text[i])) result += text[i];
+      }
+      return result;
+   }
+
+   /*
+   * Read in/Checkpoint and write out/checkpoint.
+   */
+   void write(CheckpointComposite& object)
+   {
+      std::ifstream in;
+      openInputFile("in/Checkpoint", in);
+      object.readParam(in);
+      in.close();
+      ParamCheckpoint::write(object, filePrefix() + "out/checkpoint");
+   }
+
+   /*
+   * Write out/checkpoint, and load all of it into clone.
+   */
+   void writeAndLoad(ParamCheckpoint& checkpoint,
+                     CheckpointComposite& clone)
+   {
+      CheckpointComposite object;
+      write(object);
+      checkpoint.open(filePrefix() + "out/checkpoint");
+      checkpoint.load(clone);
+   }
+
+   void testWrite()
+   {
+      printMethod(TEST_FUNC);
+
+      CheckpointComposite object;
+      write(object);
+
+      ParamCheckpoint checkpoint;
+      checkpoint.open(filePrefix() + "out/checkpoint");
+      TEST_ASSERT(checkpoint.size() == 8);
+      TEST_ASSERT(checkpoint.path(0) == "");
+      TEST_ASSERT(checkpoint.path(1) == "BComposite");
+      TEST_ASSERT(checkpoint.path(2) == "AManager");
+      TEST_ASSERT(checkpoint.has("AManager/B"));
+      TEST_ASSERT(checkpoint.has("AManager/C"));
+      TEST_ASSERT(checkpoint.has("AManager/B#1"));
+      TEST_ASSERT(checkpoint.has("AManager/F#1"));
+      TEST_ASSERT(!checkpoint.has("AManager/F#2"));
+      TEST_ASSERT(checkpoint.dataSize(0) > checkpoint.dataSize(2));
+      TEST_ASSERT(checkpoint.dataSize(2) > checkpoint.dataSize(3));
+   }
+
+   void testLoad()
+   {
+      printMethod(TEST_FUNC);
+
+      CheckpointComposite object;
+      write(object);
+
+      ParamCheckpoint checkpoint;
+      checkpoint.open(filePrefix() + "out/checkpoint");
+      CheckpointComposite clone;
+      checkpoint.load(clone);
+      TEST_ASSERT(clone.manager().size() == 5);
+
+      // Compare to an ordinary save and load
+      Serializable::OArchive oar;
+      openOutputFile("out/binary", oar.file());
+      object.save(oar);
+      oar.file().close();
+      CheckpointComposite other;
+      Serializable::IArchive iar;
+      openInputFile("out/binary", iar.file());
+      other.load(iar);
+      iar.file().close();
+      TEST_ASSERT(squeeze(clone) == squeeze(other));
+   }
+
+   void testLoadSubtree()
+   {
+      printMethod(TEST_FUNC);
+
+      ParamCheckpoint checkpoint;
+      CheckpointComposite clone;
+      writeAndLoad(checkpoint, clone);
+
+      B b;
+      checkpoint.load("AManager/B#1", b);
+      TEST_ASSERT(squeeze(b) == squeeze(clone.manager()[2]));
+
+      AManager manager;
+      checkpoint.load("AManager", manager);
+      TEST_ASSERT(squeeze(manager) == squeeze(clone.manager()));
+
+      bool success = false;
+      try {
+         checkpoint.load("AManager/D", b);
+      } catch (Exception) {
+         success = true;
+      }
+      TEST_ASSERT(success);
+
+      // Loading an object of the wrong class is detected
+      success = false;
+      C c;
+      try {
+         checkpoint.load("AManager/B", c);
+      } catch (Exception) {
+         success = true;
+      }
+      TEST_ASSERT(success);
+   }
+
+   #ifdef UTIL_CXX11
+   void testLoadThreads()
+   {
+      printMethod(TEST_FUNC);
+
+      ParamCheckpoint checkpoint;
+      CheckpointComposite clone;
+      writeAndLoad(checkpoint, clone);
+
+      B b0, b1;
+      C c;
+      BComposite composite;
+      std::thread t0([&] { checkpoint.load("AManager/B", b0); });
+      std::thread t1([&] { checkpoint.load("AManager/B#1", b1); });
+      std::thread t2([&] { checkpoint.load("AManager/C", c); });
+      std::thread t3([&] { checkpoint.load("BComposite", composite); });
+      t0.join();
+      t1.join();
+      t2.join();
+      t3.join();
+
+      TEST_ASSERT(squeeze(b0) == squeeze(clone.manager()[0]));
+      TEST_ASSERT(squeeze(c) == squeeze(clone.manager()[1]));
+      TEST_ASSERT(squeeze(b1) == squeeze(clone.manager()[2]));
+      TEST_ASSERT(squeeze(b0) != squeeze(b1));
+      TEST_ASSERT(squeeze(composite).find("Thunk") != std::string::npos);
+   }
+   #endif
+
+};
+
+TEST_BEGIN(ParamCheckpointTest)
+TEST_ADD(ParamCheckpointTest, testWrite)
+TEST_ADD(ParamCheckpointTest, testLoad)
+TEST_ADD(ParamCheckpointTest, testLoadSubtree)
+#ifdef UTIL_CXX11
+TEST_ADD(ParamCheckpointTest, testLoadThreads)
+#endif
+TEST_END(ParamCheckpointTest)
+
+#endif
@@ -22,7 +22,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <cstdio>
 
 using namespace Util;
 
@@ -476,6 +478,44 @@ public:
       ParamComponent::setEcho(false);
    }
 
+   void testReadParamSnapshot()
+   {
+      printMethod(TEST_FUNC);
+
+      std::string snapshot = filePrefix() + "out/snapshot.bin";
+      std::remove(snapshot.c_str());
+      std::string next;
+
+      // No snapshot: parse text and create snapshot
+      BComposite original;
+      openInputFile("in/BComposite", file_);
+      TEST_ASSERT(!original.readParamSnapshot(file_, snapshot));
+      file_ >> next;
+      TEST_ASSERT(next == "Finish");
+      file_.close();
+
+      // Matching snapshot: load it
+      BComposite clone;
+      openInputFile("in/BComposite", file_);
+      TEST_ASSERT(clone.readParamSnapshot(file_, snapshot));
+      file_ >> next;
+      TEST_ASSERT(next == "Finish");
+      file_.close();
+
+      std::ostringstream expected, actual;
+      original.writeParam(expected);
+      clone.writeParam(actual);
+      TEST_ASSERT(expected.str() == actual.str());
+
+      // Changed text: parse it again
+      BComposite changed;
+      std::string text = "BComposite{\n  value0  38\n  value1  2984509\n"
+                         "  value2  867.987\n  str  Thunk\n}\n";
+      std::istringstream in(text);
+      TEST_ASSERT(!changed.readParamSnapshot(in, snapshot));
+      std::remove(snapshot.c_str());
+   }
+
    void testMemoryArchiveSerialize() 
    {
       printMethod(TEST_FUNC);
@@ -516,6 +556,7 @@ TEST_ADD(ParamCompositeTest, testFSArray)
 TEST_ADD(ParamCompositeTest, testSaveLoadWrite)
 TEST_ADD(ParamCompositeTest, testReadSaveLoadWrite1)
 TEST_ADD(ParamCompositeTest, testReadSaveLoadWrite2)
+TEST_ADD(ParamCompositeTest, testReadParamSnapshot)
 //TEST_ADD(ParamCompositeTest, testMemoryArchiveSerialize)
 TEST_END(ParamCompositeTest)
 
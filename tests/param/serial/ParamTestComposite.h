@@ -8,6 +8,8 @@
 #include "ParameterTest.h"
 #include "ParamCompositeTest.h"
 #include "ManagerTest.h"
+#include "RegistryFactoryTest.h"
+#include "ParamCheckpointTest.h"
 //#include "TextCompositeTest.h"
 
 TEST_COMPOSITE_BEGIN(ParamTestComposite)
@@ -16,6 +18,8 @@ TEST_COMPOSITE_ADD_UNIT(BeginEndTest);
 TEST_COMPOSITE_ADD_UNIT(ParameterTest);
 TEST_COMPOSITE_ADD_UNIT(ParamCompositeTest);
 TEST_COMPOSITE_ADD_UNIT(ManagerTest);
+TEST_COMPOSITE_ADD_UNIT(RegistryFactoryTest);
+TEST_COMPOSITE_ADD_UNIT(ParamCheckpointTest);
 //#ifndef UTIL_MPI
 //TEST_COMPOSITE_ADD_UNIT(TextCompositeTest);
 //#endif
@@ -1427,6 +1427,50 @@ public:
       delete presentPrm2;
    }
 
+   void testDMatrixParamDoubleSerialize() 
+   {
+      printMethod(TEST_FUNC);
+      DMatrix<double> requiredVal;
+      requiredVal.allocate(2, 2);
+      DMatrixParam<double> requiredPrm("Required", requiredVal, 2, 2);
+
+      std::ifstream in;
+      openInputFile("in/MatrixParamDouble", in);
+      requiredPrm.readParam(in);
+      TEST_ASSERT(Label::isClear());
+
+      // Save in binary form, and in the string form used previously
+      Serializable::OArchive oar;
+      openOutputFile("out/binary", oar.file());
+      oar & requiredPrm;
+      std::ostringstream buffer;
+      requiredPrm.writeParam(buffer);
+      std::string str = buffer.str();
+      oar & str;
+      oar.file().close();
+
+      // Load both forms
+      DMatrix<double> binaryVal;
+      DMatrix<double> stringVal;
+      binaryVal.allocate(2, 2);
+      stringVal.allocate(2, 2);
+      DMatrixParam<double> binaryPrm("Required", binaryVal, 2, 2);
+      DMatrixParam<double> stringPrm("Required", stringVal, 2, 2);
+
+      Serializable::IArchive iar;
+      openInputFile("out/binary", iar.file());
+      iar & binaryPrm;
+      iar & stringPrm;
+      iar.file().close();
+
+      for (int i = 0; i < 2; ++i) {
+         for (int j = 0; j < 2; ++j) {
+            TEST_ASSERT(binaryVal(i, j) == requiredVal(i, j));
+            TEST_ASSERT(eq(stringVal(i, j), requiredVal(i, j)));
+         }
+      }
+   }
+
    // DSymmMatrixParam
 
    void testDSymmMatrixParamDoubleWrite() {
@@ -1669,6 +1713,7 @@ TEST_ADD(ParameterTest, testDMatrixParamDoubleWrite)
 TEST_ADD(ParameterTest, testDMatrixParamDoubleRead)
 #ifndef UTIL_MPI
 TEST_ADD(ParameterTest, testDMatrixParamDoubleReadSaveLoad)
+TEST_ADD(ParameterTest, testDMatrixParamDoubleSerialize)
 #endif
 TEST_ADD(ParameterTest, testDSymmMatrixParamDoubleWrite)
 TEST_ADD(ParameterTest, testDSymmMatrixParamDoubleRead)
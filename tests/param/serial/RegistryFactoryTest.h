@@ -0,0 +1,147 @@
+#ifndef REGISTRY_FACTORY_TEST_H
+#define REGISTRY_FACTORY_TEST_H
+
+#include <util/param/ParamComposite.h>
+#include <util/param/Manager.h>
+#include <util/param/RegistryFactory.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+using namespace Util;
+
+#include "../ParamTestClasses.h"
+
+UTIL_REGISTER_CLASS(A, B);
+UTIL_REGISTER_CLASS(A, C);
+UTIL_REGISTER_CLASS_NAME(A, F, "F");
+
+class RegistryFactoryTest : public UnitTest
+{
+
+public:
+
+   void testGlobal()
+   {
+      printMethod(TEST_FUNC);
+
+      RegistryFactory<A> factory;
+      TEST_ASSERT(factory.has("B"));
+      TEST_ASSERT(factory.has("F"));
+      TEST_ASSERT(!factory.has("D"));
+
+      A* ptr = factory.factory("C");
+      TEST_ASSERT(ptr != 0);
+      TEST_ASSERT(ptr->className() == "C");
+      delete ptr;
+
+      ptr = factory.factory("D");
+      TEST_ASSERT(ptr == 0);
+
+      RegistryFactory<A> local(false);
+      TEST_ASSERT(!local.has("B"));
+      TEST_ASSERT(local.factory("B") == 0);
+   }
+
+   void testAdd()
+   {
+      printMethod(TEST_FUNC);
+
+      RegistryFactory<A> factory;
+      factory.add<D>("D");
+      TEST_ASSERT(factory.has("D"));
+
+      A* ptr = factory.factory("D");
+      TEST_ASSERT(ptr != 0);
+      TEST_ASSERT(ptr->className() == "D");
+      delete ptr;
+
+      // Classes added to one instance are not seen by others
+      RegistryFactory<A> other;
+      TEST_ASSERT(!other.has("D"));
+
+      bool success = false;
+      try {
+         factory.add<D>("D");
+      } catch (Exception) {
+         success = true;
+      }
+      TEST_ASSERT(success);
+   }
+
+   void testSubfactory()
+   {
+      printMethod(TEST_FUNC);
+
+      RegistryFactory<A> factory;
+      CustomAFactory subfactory;
+      factory.addSubfactory(subfactory);
+
+      // Repeated requests use the recorded subfactory index
+      A* ptr;
+      for (int i = 0; i < 3; ++i) {
+         ptr = factory.factory("D");
+         TEST_ASSERT(ptr != 0);
+         TEST_ASSERT(ptr->className() == "D");
+         delete ptr;
+
+         ptr = factory.factory("B");
+         TEST_ASSERT(ptr != 0);
+         TEST_ASSERT(ptr->className() == "B");
+         delete ptr;
+
+         ptr = factory.factory("G");
+         TEST_ASSERT(ptr == 0);
+      }
+   }
+
+   void testManager()
+   {
+      printMethod(TEST_FUNC);
+
+      RegistryFactory<A> factory;
+      CustomAFactory subfactory;
+      factory.addSubfactory(subfactory);
+
+      AManager manager;
+      manager.setFactory(factory);
+      std::ifstream in;
+      openInputFile("in/CustomManager", in);
+      manager.readParam(in);
+      TEST_ASSERT(manager.size() == 2);
+
+      A* ptr = manager.findFirst("D");
+      TEST_ASSERT(ptr == &manager[1]);
+      ptr = manager.findFirst("B");
+      TEST_ASSERT(ptr == &manager[0]);
+      TEST_ASSERT(manager.findFirst("C") == 0);
+   }
+
+   void testFindFirst()
+   {
+      printMethod(TEST_FUNC);
+
+      AManager manager;
+      std::ifstream in;
+      openInputFile("in/Manager", in);
+      manager.readParam(in);
+      TEST_ASSERT(manager.size() == 5);
+
+      // First of several objects with the same name
+      TEST_ASSERT(manager.findFirst("B") == &manager[0]);
+      TEST_ASSERT(manager.findFirst("C") == &manager[1]);
+      TEST_ASSERT(manager.findFirst("F") == &manager[3]);
+      TEST_ASSERT(manager.findFirst("D") == 0);
+   }
+
+};
+
+TEST_BEGIN(RegistryFactoryTest)
+TEST_ADD(RegistryFactoryTest, testGlobal)
+TEST_ADD(RegistryFactoryTest, testAdd)
+TEST_ADD(RegistryFactoryTest, testSubfactory)
+TEST_ADD(RegistryFactoryTest, testManager)
+TEST_ADD(RegistryFactoryTest, testFindFirst)
+TEST_END(RegistryFactoryTest)
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef UTIL_GRID_STENCIL_TEST_H
+#define UTIL_GRID_STENCIL_TEST_H
+
+#include <util/space/GridStencil.h>
+#include <util/space/Grid.h>
+#include <util/space/IntVector.h>
+#include <util/containers/DArray.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+using namespace Util;
+
+class GridStencilTest : public UnitTest 
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   // Rank of periodic image of position + offset, by Grid::shift
+   int shiftedRank(Grid const & grid, IntVector position, 
+                   IntVector const & offset)
+   {
+      position += offset;
+      grid.shift(position);
+      return grid.rank(position);
+   }
+
+   // Checks visitor ranks against Grid, and counts visits
+   struct Checker
+   {
+      Grid const * gridPtr;
+      GridStencil const * stencilPtr;
+      DArray<int>* countsPtr;
+      int nError;
+
+      void operator () (int rank, int const * ranks)
+      {
+         ++(*countsPtr)[rank];
+         IntVector p = gridPtr->position(rank);
+         for (int k = 0; k < stencilPtr->size(); ++k) {
+            IntVector q = p;
+            q += stencilPtr->offset(k);
+            gridPtr->shift(q);
+            if (ranks[k] != gridPtr->rank(q)) ++nError;
+         }
+      }
+   };
+
+   void testCube()
+   {
+      printMethod(TEST_FUNC);
+      Grid grid(IntVector(5, 6, 7));
+      GridStencil stencil(grid);
+      stencil.setCube();
+      TEST_ASSERT(stencil.size() == 27);
+      TEST_ASSERT(stencil.delta(13) == 0);
+      TEST_ASSERT(stencil.delta(26) == 6*7 + 7 + 1);
+
+      DArray<int> ranks;
+      ranks.allocate(27);
+      IntVector p;
+      for (p[0] = 0; p[0] < 5; ++p[0]) {
+         for (p[1] = 0; p[1] < 6; ++p[1]) {
+            for (p[2] = 0; p[2] < 7; ++p[2]) {
+               stencil.neighbors(p, ranks.cArray());
+               for (int k = 0; k < 27; ++k) {
+                  int expected = shiftedRank(grid, p, stencil.offset(k));
+                  TEST_ASSERT(ranks[k] == expected);
+                  TEST_ASSERT(stencil.neighbor(p, k) == expected);
+               }
+            }
+         }
+      }
+   }
+
+   void testHalfCube()
+   {
+      printMethod(TEST_FUNC);
+      Grid grid(IntVector(4, 4, 4));
+      GridStencil stencil(grid);
+      stencil.setHalfCube();
+      TEST_ASSERT(stencil.size() == 14);
+      stencil.setHalfCube(2);
+      TEST_ASSERT(stencil.size() == 63);
+      for (int k = 0; k < stencil.size(); ++k) {
+         for (int m = 0; m < stencil.size(); ++m) {
+            IntVector sum = stencil.offset(k);
+            sum += stencil.offset(m);
+            // No offset is included together with its negative
+            if (sum == IntVector(0)) {
+               TEST_ASSERT(k == m);
+               TEST_ASSERT(stencil.offset(k) == IntVector(0));
+            }
+         }
+      }
+   }
+
+   void testTraverse()
+   {
+      printMethod(TEST_FUNC);
+      Grid grid(IntVector(9, 10, 11));
+      GridStencil stencil(grid);
+      stencil.setCube();
+      stencil.addOffset(IntVector(0, 0, 3));
+      stencil.addOffset(IntVector(-2, 4, -1));
+      TEST_ASSERT(stencil.size() == 29);
+
+      DArray<int> counts;
+      counts.allocate(grid.size());
+      for (int i = 0; i < grid.size(); ++i) {
+         counts[i] = 0;
+      }
+      Checker checker;
+      checker.gridPtr = &grid;
+      checker.stencilPtr = &stencil;
+      checker.countsPtr = &counts;
+      checker.nError = 0;
+
+      // Default tiles, all tiles in one call
+      stencil.traverse(checker);
+      TEST_ASSERT(checker.nError == 0);
+      for (int i = 0; i < grid.size(); ++i) {
+         TEST_ASSERT(counts[i] == 1);
+      }
+
+      // Small tiles, divided among 3 "threads"
+      stencil.setTile(IntVector(4, 3, 5));
+      TEST_ASSERT(stencil.nTile() == 3*4*3);
+      for (int t = 0; t < 3; ++t) {
+         stencil.traverse(checker, t, 3);
+      }
+      TEST_ASSERT(checker.nError == 0);
+      for (int i = 0; i < grid.size(); ++i) {
+         TEST_ASSERT(counts[i] == 2);
+      }
+   }
+
+   void testSetOffsets()
+   {
+      printMethod(TEST_FUNC);
+      Grid grid(IntVector(7, 8, 9));
+
+      // Offsets added one at a time, with and without range growth
+      GridStencil added(grid);
+      DArray<IntVector> offsets;
+      offsets.allocate(6);
+      offsets[0] = IntVector(0, 0, 0);
+      offsets[1] = IntVector(1, 0, -1);
+      offsets[2] = IntVector(-1, 1, 0);
+      offsets[3] = IntVector(0, -3, 2);
+      offsets[4] = IntVector(1, 1, 1);
+      offsets[5] = IntVector(-2, 0, 4);
+      for (int k = 0; k < offsets.capacity(); ++k) {
+         added.addOffset(offsets[k]);
+      }
+
+      GridStencil bulk(grid);
+      bulk.setCube();
+      bulk.setOffsets(offsets);
+      TEST_ASSERT(bulk.size() == 6);
+      TEST_ASSERT(added.size() == 6);
+
+      IntVector p;
+      for (int k = 0; k < bulk.size(); ++k) {
+         TEST_ASSERT(bulk.offset(k) == offsets[k]);
+         TEST_ASSERT(added.delta(k) == bulk.delta(k));
+         IntVector c(3, 4, 4);
+         IntVector q = c;
+         q += offsets[k];
+         TEST_ASSERT(bulk.delta(k) == grid.rank(q) - grid.rank(c));
+         for (p[0] = 0; p[0] < 7; ++p[0]) {
+            for (p[1] = 0; p[1] < 8; ++p[1]) {
+               for (p[2] = 0; p[2] < 9; ++p[2]) {
+                  IntVector q = p;
+                  q += offsets[k];
+                  grid.shift(q);
+                  int rank = grid.rank(q);
+                  TEST_ASSERT(added.neighbor(p, k) == rank);
+                  TEST_ASSERT(bulk.neighbor(p, k) == rank);
+               }
+            }
+         }
+      }
+   }
+
+};
+
+TEST_BEGIN(GridStencilTest)
+TEST_ADD(GridStencilTest, testCube)
+TEST_ADD(GridStencilTest, testHalfCube)
+TEST_ADD(GridStencilTest, testTraverse)
+TEST_ADD(GridStencilTest, testSetOffsets)
+TEST_END(GridStencilTest)
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef UTIL_SPACE_FILLING_CURVE_TEST_H
+#define UTIL_SPACE_FILLING_CURVE_TEST_H
+
+#include <util/space/SpaceFillingCurve.h>
+#include <util/space/IntVector.h>
+#include <util/space/Vector.h>
+#include <util/containers/DArray.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+using namespace Util;
+
+class SpaceFillingCurveTest : public UnitTest 
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   void testMorton()
+   {
+      printMethod(TEST_FUNC);
+      using namespace SpaceFillingCurve;
+
+      TEST_ASSERT(mortonEncode(IntVector(0, 0, 1)) == 1);
+      TEST_ASSERT(mortonEncode(IntVector(0, 1, 0)) == 2);
+      TEST_ASSERT(mortonEncode(IntVector(1, 0, 0)) == 4);
+      TEST_ASSERT(mortonEncode(IntVector(1, 1, 1)) == 7);
+      TEST_ASSERT(mortonEncode(IntVector(0, 0, 2)) == 8);
+
+      IntVector p(1234567, 3, 2097151);
+      TEST_ASSERT(mortonDecode(mortonEncode(p)) == p);
+   }
+
+   void testHilbert()
+   {
+      printMethod(TEST_FUNC);
+      using namespace SpaceFillingCurve;
+
+      // The curve visits each point of a cube once, in unit steps
+      int bits = 3;
+      int n = 1 << bits;
+      int size = n*n*n;
+      DArray<int> visited;
+      visited.allocate(size);
+      for (int i = 0; i < size; ++i) {
+         visited[i] = 0;
+      }
+      IntVector prev = hilbertDecode(0, bits);
+      TEST_ASSERT(prev == IntVector(0));
+      for (int k = 0; k < size; ++k) {
+         IntVector p = hilbertDecode(k, bits);
+         TEST_ASSERT(hilbertEncode(p, bits) == uint64_t(k));
+         ++visited[(p[0]*n + p[1])*n + p[2]];
+         if (k > 0) {
+            int step = 0;
+            for (int d = 0; d < Dimension; ++d) {
+               int a = p[d] - prev[d];
+               step += a >= 0 ? a : -a;
+            }
+            TEST_ASSERT(step == 1);
+         }
+         prev = p;
+      }
+      for (int i = 0; i < size; ++i) {
+         TEST_ASSERT(visited[i] == 1);
+      }
+
+      IntVector q(1234567, 3, 2097151);
+      TEST_ASSERT(hilbertDecode(hilbertEncode(q)) == q);
+   }
+
+   void testOrder()
+   {
+      printMethod(TEST_FUNC);
+      using namespace SpaceFillingCurve;
+
+      IntVector dimensions(3, 5, 6);
+      int size = 90;
+      DArray<int> ranks;
+      DArray<int> inverse;
+      ranks.allocate(size);
+      inverse.allocate(size);
+      order(Morton, dimensions, ranks.cArray(), inverse.cArray());
+      for (int r = 0; r < size; ++r) {
+         TEST_ASSERT(inverse[ranks[r]] == r);
+      }
+      // Points (0,0,0), (0,0,1), (0,1,0), (0,1,1) come first
+      TEST_ASSERT(inverse[0] == 0);
+      TEST_ASSERT(inverse[1] == 1);
+      TEST_ASSERT(inverse[2] == 6);
+      TEST_ASSERT(inverse[3] == 7);
+   }
+
+   void testSortParticles()
+   {
+      printMethod(TEST_FUNC);
+      using namespace SpaceFillingCurve;
+
+      int n = 200;
+      DArray<Vector> positions;
+      DArray<Vector> sorted;
+      DArray<int> permutation;
+      positions.allocate(n);
+      sorted.allocate(n);
+      permutation.allocate(n);
+      Vector lengths(4.0, 5.0, 6.0);
+      unsigned long seed = 987;
+      for (int i = 0; i < n; ++i) {
+         for (int d = 0; d < Dimension; ++d) {
+            seed = seed*6364136223846793005UL + 1442695040888963407UL;
+            double r = double((seed >> 11) & 0xFFFFF)/double(0x100000);
+            positions[i][d] = (1.4*r - 0.2)*lengths[d];
+         }
+      }
+      IntVector nCell(4, 5, 6);
+      int bits = bitsFor(nCell);
+      Type types[2] = {Hilbert, RowMajor};
+      for (int t = 0; t < 2; ++t) {
+         sortParticles(types[t], positions, lengths, nCell, permutation);
+         permute(positions, permutation, sorted);
+
+         // Permutation is a bijection, and cell indices are sorted,
+         // with ties broken by particle index
+         DArray<int> count;
+         count.allocate(n);
+         for (int i = 0; i < n; ++i) {
+            count[i] = 0;
+         }
+         uint64_t prev = 0;
+         for (int k = 0; k < n; ++k) {
+            ++count[permutation[k]];
+            TEST_ASSERT(sorted[k] == positions[permutation[k]]);
+            IntVector cell;
+            for (int d = 0; d < Dimension; ++d) {
+               int c = (int)std::floor(sorted[k][d]/lengths[d]*nCell[d]);
+               cell[d] = ((c % nCell[d]) + nCell[d]) % nCell[d];
+            }
+            uint64_t code;
+            if (types[t] == RowMajor) {
+               code = (cell[0]*nCell[1] + cell[1])*nCell[2] + cell[2];
+            } else {
+               code = hilbertEncode(cell, bits);
+            }
+            TEST_ASSERT(code >= prev);
+            if (k > 0 && code == prev) {
+               TEST_ASSERT(permutation[k] > permutation[k - 1]);
+            }
+            prev = code;
+         }
+         for (int i = 0; i < n; ++i) {
+            TEST_ASSERT(count[i] == 1);
+         }
+      }
+   }
+
+};
+
+TEST_BEGIN(SpaceFillingCurveTest)
+TEST_ADD(SpaceFillingCurveTest, testMorton)
+TEST_ADD(SpaceFillingCurveTest, testHilbert)
+TEST_ADD(SpaceFillingCurveTest, testOrder)
+TEST_ADD(SpaceFillingCurveTest, testSortParticles)
+TEST_END(SpaceFillingCurveTest)
+
+#endif
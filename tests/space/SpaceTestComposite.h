@@ -7,12 +7,18 @@
 #include "IntVectorTest.h"
 #include "TensorTest.h"
 #include "GridTest.h"
+#include "GridStencilTest.h"
+#include "SpaceFillingCurveTest.h"
+#include "VectorKernelsTest.h"
 
 TEST_COMPOSITE_BEGIN(SpaceTestComposite)
 TEST_COMPOSITE_ADD_UNIT(VectorTest);
 TEST_COMPOSITE_ADD_UNIT(IntVectorTest);
 TEST_COMPOSITE_ADD_UNIT(TensorTest);
 TEST_COMPOSITE_ADD_UNIT(GridTest);
+TEST_COMPOSITE_ADD_UNIT(GridStencilTest);
+TEST_COMPOSITE_ADD_UNIT(SpaceFillingCurveTest);
+TEST_COMPOSITE_ADD_UNIT(VectorKernelsTest);
 TEST_COMPOSITE_END
 
 #endif
@@ -0,0 +1,198 @@
+#ifndef UTIL_VECTOR_KERNELS_TEST_H
+#define UTIL_VECTOR_KERNELS_TEST_H
+
+#include <util/space/VectorKernels.h>
+#include <util/space/Vector.h>
+#include <util/space/Tensor.h>
+#include <util/containers/DArray.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <cmath>
+
+using namespace Util;
+
+class VectorKernelsTest : public UnitTest
+{
+
+   DArray<Vector> a_;
+   DArray<Vector> b_;
+
+public:
+
+   void setUp()
+   {
+      // Odd size, to exercise remainders of partial sum loops
+      int n = 13;
+      a_.allocate(n);
+      b_.allocate(n);
+      for (int i = 0; i < n; ++i) {
+         for (int d = 0; d < Dimension; ++d) {
+            a_[i][d] = std::sin(1.0 + i + 0.7*d);
+            b_[i][d] = std::cos(0.3*i - 1.1*d);
+         }
+      }
+   }
+
+   void tearDown()
+   {}
+
+   void testDot()
+   {
+      printMethod(TEST_FUNC);
+      int n = a_.capacity();
+      DArray<double> out;
+      out.allocate(n);
+      VectorKernels::dot(a_, b_, out);
+      double sum = 0.0;
+      for (int i = 0; i < n; ++i) {
+         TEST_ASSERT(eq(out[i], a_[i].dot(b_[i])));
+         sum += a_[i].dot(b_[i]);
+      }
+      TEST_ASSERT(eq(VectorKernels::dot(a_, b_), sum));
+
+      VectorKernels::normSq(a_, out);
+      sum = 0.0;
+      for (int i = 0; i < n; ++i) {
+         TEST_ASSERT(eq(out[i], a_[i].square()));
+         sum += a_[i].square();
+      }
+      TEST_ASSERT(eq(VectorKernels::normSq(a_), sum));
+   }
+
+   void testCross()
+   {
+      printMethod(TEST_FUNC);
+      int n = a_.capacity();
+      DArray<Vector> out;
+      out.allocate(n);
+      VectorKernels::cross(a_, b_, out);
+      Vector c;
+      for (int i = 0; i < n; ++i) {
+         c.cross(a_[i], b_[i]);
+         for (int d = 0; d < Dimension; ++d) {
+            TEST_ASSERT(eq(out[i][d], c[d]));
+         }
+      }
+   }
+
+   void testAxpy()
+   {
+      printMethod(TEST_FUNC);
+      int n = a_.capacity();
+      DArray<Vector> y;
+      y = b_;
+      VectorKernels::axpy(-0.5, a_, y);
+      Vector c;
+      for (int i = 0; i < n; ++i) {
+         c.multiply(a_[i], -0.5);
+         c += b_[i];
+         for (int d = 0; d < Dimension; ++d) {
+            TEST_ASSERT(eq(y[i][d], c[d]));
+         }
+      }
+
+      DArray<Tensor> s, t;
+      s.allocate(n);
+      t.allocate(n);
+      for (int i = 0; i < n; ++i) {
+         s[i].dyad(a_[i], b_[i]);
+         t[i].dyad(b_[i], b_[i]);
+      }
+      VectorKernels::axpy(2.0, s, t);
+      Tensor u;
+      for (int i = 0; i < n; ++i) {
+         u.dyad(b_[i], b_[i]);
+         for (int j = 0; j < Dimension; ++j) {
+            for (int k = 0; k < Dimension; ++k) {
+               TEST_ASSERT(eq(t[i](j, k), u(j, k) + 2.0*s[i](j, k)));
+            }
+         }
+      }
+   }
+
+   void testMinimumImage()
+   {
+      printMethod(TEST_FUNC);
+      int n = a_.capacity();
+      Vector lengths(1.0, 1.5, 0.8);
+      DArray<Vector> r1, r2, dr;
+      r1.allocate(n);
+      r2.allocate(n);
+      dr.allocate(n);
+      for (int i = 0; i < n; ++i) {
+         for (int d = 0; d < Dimension; ++d) {
+            r1[i][d] = 3.0*a_[i][d];
+            r2[i][d] = -2.0*b_[i][d];
+         }
+      }
+      VectorKernels::minimumImage(r1, r2, lengths, dr);
+      for (int i = 0; i < n; ++i) {
+         for (int d = 0; d < Dimension; ++d) {
+            double x = dr[i][d];
+            TEST_ASSERT(x >= -0.5*lengths[d] - 1.0E-12);
+            TEST_ASSERT(x <= 0.5*lengths[d] + 1.0E-12);
+            double m = (r1[i][d] - r2[i][d] - x)/lengths[d];
+            TEST_ASSERT(eq(m, std::floor(m + 0.5)));
+         }
+      }
+
+      // Output aliases first input
+      VectorKernels::minimumImage(r1, r2, lengths, r1);
+      for (int i = 0; i < n; ++i) {
+         TEST_ASSERT(r1[i] == dr[i]);
+      }
+   }
+
+   void testOuter()
+   {
+      printMethod(TEST_FUNC);
+      int n = a_.capacity();
+      Tensor t, s, u, expected, symm;
+      t.zero();
+      s.zero();
+      expected.zero();
+      symm.zero();
+      for (int i = 0; i < n; ++i) {
+         u.dyad(a_[i], b_[i]);
+         expected += u;
+      }
+      u.transpose(expected);
+      symm.add(expected, u);
+      symm /= 2.0;
+
+      VectorKernels::outerAdd(a_, b_, t);
+      VectorKernels::symmOuterAdd(a_, b_, s);
+      for (int j = 0; j < Dimension; ++j) {
+         for (int k = 0; k < Dimension; ++k) {
+            TEST_ASSERT(eq(t(j, k), expected(j, k)));
+            TEST_ASSERT(eq(s(j, k), symm(j, k)));
+            TEST_ASSERT(s(j, k) == s(k, j));
+         }
+      }
+
+      DArray<Tensor> array;
+      array.allocate(n);
+      for (int i = 0; i < n; ++i) {
+         array[i].dyad(a_[i], b_[i]);
+      }
+      u = VectorKernels::sum(array);
+      for (int j = 0; j < Dimension; ++j) {
+         for (int k = 0; k < Dimension; ++k) {
+            TEST_ASSERT(eq(u(j, k), expected(j, k)));
+         }
+      }
+   }
+
+};
+
+TEST_BEGIN(VectorKernelsTest)
+TEST_ADD(VectorKernelsTest, testDot)
+TEST_ADD(VectorKernelsTest, testCross)
+TEST_ADD(VectorKernelsTest, testAxpy)
+TEST_ADD(VectorKernelsTest, testMinimumImage)
+TEST_ADD(VectorKernelsTest, testOuter)
+TEST_END(VectorKernelsTest)
+
+#endif